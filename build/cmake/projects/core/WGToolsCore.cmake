@@ -27,6 +27,7 @@ LIST( APPEND BW_LIBRARY_PROJECTS
 	core_reflection			core/lib/core_reflection
 	core_string_utils		core/lib/core_string_utils
 	core_object				core/lib/core_object
+	core_version_control	core/lib/core_version_control
 
 	#Tools Common
 	core_logging				core/lib/core_logging
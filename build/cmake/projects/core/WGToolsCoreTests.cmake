@@ -23,7 +23,10 @@ IF( WG_UNIT_TESTS_ENABLED )
 		string_utils_unit_test				core/lib/core_string_utils/unit_test
 		qt_common_unit_test					core/lib/core_qt_common/unit_test
 		wg_types_unit_test					core/lib/wg_types/unit_test
+		wg_memory_unit_test					core/lib/wg_memory/unit_test
+		version_control_unit_test			core/lib/core_version_control/unit_test
 		curve_editor_unit_test				core/plugins/plg_curve_editor/unit_test
+		node_editor_unit_test				core/plugins/plg_node_editor/unit_test
 		)
 
 	IF(MSVC)
@@ -4,6 +4,7 @@
 #include "core_generic_plugin_manager/generic_plugin_manager.hpp"
 #include "core_generic_plugin_manager/folder_plugin_loader.hpp"
 #include "core_generic_plugin_manager/config_plugin_loader.hpp"
+#include "core_generic_plugin_manager/plugin_dependency_graph.hpp"
 #include "core_generic_plugin/interfaces/i_application.hpp"
 #include "core_generic_plugin/interfaces/i_component_context.hpp"
 #include "core_logging/logging.hpp"
@@ -49,7 +50,7 @@ static const wchar_t* const defaultConfigFileName = L"plugins_ui.txt";
 static const wchar_t* const defaultConfigFileName = L"plugins_ui_mac.txt";
 #endif
 
-bool getPlugins(std::vector<std::wstring>& plugins, const wchar_t* configFile)
+bool getPlugins(std::vector<PluginDeclaration>& plugins, const wchar_t* configFile)
 {
 	wchar_t path[MAX_PATH];
 	::GetModuleFileNameW(NULL, path, MAX_PATH);
@@ -59,14 +60,27 @@ bool getPlugins(std::vector<std::wstring>& plugins, const wchar_t* configFile)
 	{
 		::PathAppendW(path, pluginsFolder);
 
-		return ConfigPluginLoader::getPlugins(plugins, std::wstring(path) + std::wstring(defaultConfigFileName))
-			|| FolderPluginLoader::getPluginsCustomPath(plugins, path);
+		if (ConfigPluginLoader::getPluginDeclarations(plugins, std::wstring(path) + std::wstring(defaultConfigFileName)))
+		{
+			return true;
+		}
+
+		std::vector<std::wstring> pluginNames;
+		if (!FolderPluginLoader::getPluginsCustomPath(pluginNames, path))
+		{
+			return false;
+		}
+		for (const auto& pluginName : pluginNames)
+		{
+			plugins.emplace_back(pluginName);
+		}
+		return true;
 	}
 	else
 	{
 		::PathAppendW(path, pluginsFolder);
 		::PathAppendW(path, configFile);
-		return ConfigPluginLoader::getPlugins(plugins, path);
+		return ConfigPluginLoader::getPluginDeclarations(plugins, path);
 	}
 }
 }
@@ -124,6 +138,10 @@ int Main(int argc, char** argv)
 	NGTAllocator::enableDebugOutput(allocatorDebugOutput);
 	NGTAllocator::enableStackTraces(allocatorStackTraces);
 	NGTAllocator::enableLeakDetection(allocatorLeakDetection);
+	if (auto allocatorSampleRate = clp->getParam("--allocatorSampleRate"))
+	{
+		NGTAllocator::setStackSampleRate(strtoul(allocatorSampleRate, nullptr, 10));
+	}
 
 	setCustomLoggingHandle([](LogLevel level, const char* message)
 	{
@@ -140,7 +158,7 @@ int Main(int argc, char** argv)
 	config = clp->getParamStrW("--config");
 #endif // _CONFIG_FILE_NAME
 
-	std::vector<std::wstring> plugins;
+	std::vector<PluginDeclaration> plugins;
 	if (!getPlugins(plugins, config.c_str()) || plugins.empty())
 	{
 		return 2; // failed to find any plugins!
@@ -155,7 +173,8 @@ int Main(int argc, char** argv)
 		auto globalContext = contextManager.getGlobalContext();
 		globalContext->registerInterface(new MemoryPluginContextCreator);
 		globalContext->registerInterface(clp);
-		pluginManager.loadPlugins(plugins);
+		pluginManager.loadPlugins(PluginDependencyGraph(plugins));
+		pluginManager.scheduleDeferredPlugins();
 
 		IApplication* application = contextManager.getGlobalContext()->queryInterface<IApplication>();
 		if (application != NULL)
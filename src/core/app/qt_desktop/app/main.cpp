@@ -4,6 +4,7 @@
 #include "core_generic_plugin_manager/generic_plugin_manager.hpp"
 #include "core_generic_plugin_manager/folder_plugin_loader.hpp"
 #include "core_generic_plugin_manager/config_plugin_loader.hpp"
+#include "core_generic_plugin_manager/plugin_dependency_graph.hpp"
 
 #include "core_wgtf_app/command_line_parser.hpp"
 #include "core_wgtf_app/memory_plugin_context_creator.hpp"
@@ -14,6 +15,8 @@
 #include <QFile>
 #include <QTextStream>
 #include <csignal>
+#include <cstdlib>
+#include <algorithm>
 
 #include "core_common/platform_path.hpp"
 #include "core_common/platform_dbg.hpp"
@@ -59,7 +62,7 @@ static const wchar_t* const pluginsFolder = L"plugins\\";
 static const wchar_t* const pluginsFolder = L"../Resources/plugins/";
 #endif // __APPLE__
 
-bool getPlugins(std::vector<std::wstring>& plugins, const wchar_t* configFile, bool preQtPlugins)
+bool getPlugins(std::vector<PluginDeclaration>& plugins, const wchar_t* configFile, bool preQtPlugins)
 {
 	wchar_t path[MAX_PATH];
 	::GetModuleFileNameW(NULL, path, MAX_PATH);
@@ -83,15 +86,52 @@ bool getPlugins(std::vector<std::wstring>& plugins, const wchar_t* configFile, b
 #endif
 #endif
 
-		return ConfigPluginLoader::getPlugins(plugins, std::wstring(path) + filename) ||
-		FolderPluginLoader::getPluginsCustomPath(plugins, path);
+		if (ConfigPluginLoader::getPluginDeclarations(plugins, std::wstring(path) + filename))
+		{
+			return true;
+		}
+
+		std::vector<std::wstring> pluginNames;
+		if (!FolderPluginLoader::getPluginsCustomPath(pluginNames, path))
+		{
+			return false;
+		}
+		for (const auto& pluginName : pluginNames)
+		{
+			plugins.emplace_back(pluginName);
+		}
+		return true;
 	}
 	else
 	{
 		::PathAppendW(path, pluginsFolder);
 		::PathAppendW(path, configFile);
-		return ConfigPluginLoader::getPlugins(plugins, path);
+		return ConfigPluginLoader::getPluginDeclarations(plugins, path);
+	}
+}
+
+/**
+* Builds one dependency graph from the pre and post Qt plugins and splits the plugins
+* needed at startup back into the two lists, in dependency order.
+*/
+PluginDependencyGraph getStartupPlugins(const std::vector<PluginDeclaration>& preDeclarations,
+                                        const std::vector<PluginDeclaration>& postDeclarations,
+                                        std::vector<std::wstring>& prePlugins, std::vector<std::wstring>& postPlugins)
+{
+	PluginDependencyGraph graph(preDeclarations);
+	for (const auto& declaration : postDeclarations)
+	{
+		graph.addPlugin(declaration);
+	}
+
+	for (const auto& pluginName : graph.getStartupPlugins())
+	{
+		auto isPrePlugin = std::any_of(
+		preDeclarations.begin(), preDeclarations.end(),
+		[&pluginName](const PluginDeclaration& declaration) { return declaration.name_ == pluginName; });
+		(isPrePlugin ? prePlugins : postPlugins).push_back(pluginName);
 	}
+	return graph;
 }
 
 struct PluginManagerHelper
@@ -134,6 +174,7 @@ struct PluginManagerHelper
 
 	std::vector<std::wstring> prePlugins;
 	std::vector<std::wstring> postPlugins;
+	PluginDependencyGraph dependencyGraph;
 
 	QtDesktopApplication* desktopApp = nullptr;
 	QtFramework* framework           = nullptr;
@@ -245,6 +286,9 @@ void PluginManagerHelper::init(CommandLineParser* clp, QApplication& app, QLocal
 
 	pluginManager.runLoadStep(postPlugins);
 
+	// Deferred plugins may need Qt, so they can only be started once it is set up
+	pluginManager.deferPlugins(dependencyGraph);
+
 	pluginManager.runInitiliseStep(prePlugins);
 
 	auto definitionManager = globalContext->queryInterface<IDefinitionManager>();
@@ -253,11 +297,13 @@ void PluginManagerHelper::init(CommandLineParser* clp, QApplication& app, QLocal
 	framework->initialise(*globalContext);
 
 	pluginManager.runInitiliseStep(postPlugins);
+	pluginManager.scheduleDeferredPlugins(*desktopApp);
 }
 
 //------------------------------------------------------------------------------
 PluginManagerHelper::~PluginManagerHelper()
 {
+	pluginManager.unloadDeferredPlugins();
 	pluginManager.runFinaliseStep(postPlugins);
 	if (framework) framework->finalise();
 	if (desktopApp) desktopApp->finalise();
@@ -351,6 +397,10 @@ int Main(int argc, char** argv)
 	NGTAllocator::enableDebugOutput(clp->getFlag("--allocatorDebugOutput"));
 	NGTAllocator::enableStackTraces(clp->getFlag("--allocatorStackTraces"));
 	NGTAllocator::enableLeakDetection(clp->getFlag("--allocatorLeakDetection"));
+	if (auto allocatorSampleRate = clp->getParam("--allocatorSampleRate"))
+	{
+		NGTAllocator::setStackSampleRate(strtoul(allocatorSampleRate, nullptr, 10));
+	}
 
 	const bool unattended = clp->getFlag("-unattended");
 
@@ -400,24 +450,28 @@ int Main(int argc, char** argv)
 		s_StaticInitPluginFunc();
 	}
 
-	std::vector<std::wstring>& prePlugins = AppCommonPrivate::getPluginManagerHelper()->getPrePlugins();
-	if (!getPlugins(prePlugins, preConfig.c_str(), true) || prePlugins.empty())
+	std::vector<PluginDeclaration> preDeclarations;
+	if (!getPlugins(preDeclarations, preConfig.c_str(), true) || preDeclarations.empty())
 	{
         return 2; // failed to find any plugins!
 	}
 
-	std::vector<std::wstring>& postPlugins = AppCommonPrivate::getPluginManagerHelper()->getPostPlugins();
+	std::vector<PluginDeclaration> postDeclarations;
 
 	if (unattended)
 	{
-		postPlugins.push_back(L"plugins/plg_automation");
+		postDeclarations.emplace_back(L"plugins/plg_automation");
 	}
 
-	if (!getPlugins(postPlugins, postConfig.c_str(), false) || postPlugins.empty())
+	if (!getPlugins(postDeclarations, postConfig.c_str(), false) || postDeclarations.empty())
 	{
         return 2; // failed to find any plugins!
 	}
 
+	auto& helper = AppCommonPrivate::getPluginManagerHelper();
+	helper->dependencyGraph =
+	getStartupPlugins(preDeclarations, postDeclarations, helper->getPrePlugins(), helper->getPostPlugins());
+
 	int result = 1;
 	{
 		QLocalServer server;
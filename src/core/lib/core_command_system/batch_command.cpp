@@ -63,7 +63,7 @@ CommandDescription BatchCommand::getCommandDescription(const ObjectHandle& argum
 		return nullptr;
 	}
 
-	auto object = GenericObject::create();
+	auto object = GenericObject::createShaped();
 	object->set("Name", params->description_);
 	object->set("Type", "Custom");
 	return std::move(object);
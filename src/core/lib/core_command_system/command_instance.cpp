@@ -28,7 +28,7 @@ namespace RPURU = ReflectedPropertyUndoRedoUtility;
 //==============================================================================
 CommandInstance::CommandInstance()
     : defManager_(nullptr), status_(Complete), arguments_(nullptr), pCmdSysProvider_(nullptr), commandId_(""),
-      contextObject_(nullptr), errorCode_(CommandErrorCode::COMMAND_NO_ERROR)
+      contextObject_(nullptr), errorCode_(CommandErrorCode::COMMAND_NO_ERROR), progress_()
 {
 }
 
@@ -47,8 +47,17 @@ void CommandInstance::waitForCompletion()
 {
 	std::unique_lock<std::mutex> lock(mutex_);
 
+	// Poll often so completion is noticed quickly, but only notify listeners at the sample rate
+	auto nextProgress = std::chrono::steady_clock::now() + CommandProgress::SAMPLE_INTERVAL;
 	while (!completeStatus_.wait_for(lock, std::chrono::milliseconds(1), [this] { return status_ == Complete; }))
 	{
+		auto now = std::chrono::steady_clock::now();
+		if (now < nextProgress)
+		{
+			continue;
+		}
+		nextProgress = now + CommandProgress::SAMPLE_INTERVAL;
+
 		lock.unlock();
 		getCommand()->fireProgressMade(*this);
 		lock.lock();
@@ -204,6 +213,7 @@ void CommandInstance::execute()
 {
 	const Command* command = getCommand();
 	Variant result;
+	CommandProgressScope progressScope(progress_);
 	if (command->customUndo())
 	{
 		result = command->execute(arguments_);
@@ -3,6 +3,7 @@
 
 #include "reflection_undo_redo_data.hpp"
 #include "custom_undo_redo_data.hpp"
+#include "command_progress.hpp"
 
 #include "core_serialization/resizing_memory_stream.hpp"
 #include "core_serialization_xml/xml_serializer.hpp"
@@ -112,6 +113,15 @@ public:
 
 	ObjectHandle getCommandDescription() const;
 
+	/**
+	 *	Progress published by the command while it executes.
+	 *	Commands publish through CommandProgress::current(), listeners sample it.
+	 */
+	const CommandProgress& getProgress() const
+	{
+		return progress_;
+	}
+
 	void consolidateUndoRedoData(CommandInstance* parentInstance);
 
 	/**
@@ -153,6 +163,7 @@ private:
 	CommandErrorCode errorCode_;
 	std::vector<UndoRedoDataPtr> undoRedoData_;
     mutable ManagedObject<GenericObject> description_;
+	CommandProgress progress_;
 };
 } // end namespace wgt
 #endif // COMMAND_INSTANCE_HPP
@@ -0,0 +1,1028 @@
+#include "command_journal.hpp"
+
+#include "core_common/assert.hpp"
+#include "core_logging/logging.hpp"
+#include "wg_types/hash_utilities.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#include "core_common/ngt_windows.hpp"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace wgt
+{
+namespace
+{
+const uint32_t s_JournalMagic = 0x4c4a4357; // "WCJL"
+const uint32_t s_IndexMagic = 0x58494357; // "WCIX"
+const uint32_t s_Version = 1;
+
+// Compact once dead records make up most of a journal at least this large
+const uint64_t s_MinCompactSize = 1 << 20;
+const uint64_t s_MinIndexCapacity = 256;
+
+enum RecordType : uint32_t
+{
+	RECORD_ENTRY = 1,
+	RECORD_TRUNCATE = 2,
+	RECORD_SELECT = 3
+};
+
+struct JournalHeader
+{
+	uint32_t magic_;
+	uint32_t version_;
+	// changes whenever the journal is rewritten
+	uint64_t generation_;
+};
+
+struct RecordHeader
+{
+	uint32_t type_;
+	uint32_t value_;
+	uint64_t size_;
+	uint64_t checksum_;
+};
+
+// Followed by capacity_ entry offsets
+struct IndexHeader
+{
+	uint32_t magic_;
+	uint32_t version_;
+	uint64_t generation_;
+	// journal bytes the index accounts for
+	uint64_t journalSize_;
+	uint64_t count_;
+	int64_t selected_;
+	// bytes of live entry records
+	uint64_t liveBytes_;
+	uint64_t capacity_;
+};
+
+uint64_t computeChecksum(const RecordHeader& header, const void* data)
+{
+	auto checksum = HashUtilities::compute(data, static_cast<size_t>(header.size_));
+	HashUtilities::directCombine(checksum, (static_cast<uint64_t>(header.type_) << 32) | header.value_);
+	HashUtilities::directCombine(checksum, header.size_);
+	return checksum;
+}
+
+//==============================================================================
+// Positioned reads and writes, and a shared mapping, of a file opened for update
+class File
+{
+public:
+	File();
+	~File();
+
+	bool open(const char* path);
+	void close();
+	bool isOpen() const;
+
+	uint64_t size() const;
+	bool read(uint64_t offset, void* data, size_t size) const;
+	bool write(uint64_t offset, const void* data, size_t size);
+	bool resize(uint64_t size);
+	bool flush();
+
+	void* map();
+	void unmap();
+	bool flushMap();
+
+	static bool replace(const char* path, const char* newPath);
+
+private:
+	File(const File&);
+	File& operator=(const File&);
+
+#if defined(_WIN32)
+	HANDLE file_;
+	HANDLE mapping_;
+#else
+	int file_;
+#endif
+	void* view_;
+	size_t viewSize_;
+};
+
+#if defined(_WIN32)
+//------------------------------------------------------------------------------
+File::File() : file_(INVALID_HANDLE_VALUE), mapping_(nullptr), view_(nullptr), viewSize_(0)
+{
+}
+
+//------------------------------------------------------------------------------
+bool File::open(const char* path)
+{
+	close();
+	file_ = ::CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+	                      FILE_ATTRIBUTE_NORMAL, nullptr);
+	return file_ != INVALID_HANDLE_VALUE;
+}
+
+//------------------------------------------------------------------------------
+void File::close()
+{
+	unmap();
+	if (file_ != INVALID_HANDLE_VALUE)
+	{
+		::CloseHandle(file_);
+		file_ = INVALID_HANDLE_VALUE;
+	}
+}
+
+//------------------------------------------------------------------------------
+bool File::isOpen() const
+{
+	return file_ != INVALID_HANDLE_VALUE;
+}
+
+//------------------------------------------------------------------------------
+uint64_t File::size() const
+{
+	LARGE_INTEGER size;
+	return ::GetFileSizeEx(file_, &size) ? static_cast<uint64_t>(size.QuadPart) : 0;
+}
+
+//------------------------------------------------------------------------------
+bool File::read(uint64_t offset, void* data, size_t size) const
+{
+	OVERLAPPED overlapped = {};
+	overlapped.Offset = static_cast<DWORD>(offset);
+	overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+	DWORD count = 0;
+	return ::ReadFile(file_, data, static_cast<DWORD>(size), &count, &overlapped) && count == size;
+}
+
+//------------------------------------------------------------------------------
+bool File::write(uint64_t offset, const void* data, size_t size)
+{
+	OVERLAPPED overlapped = {};
+	overlapped.Offset = static_cast<DWORD>(offset);
+	overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+	DWORD count = 0;
+	return ::WriteFile(file_, data, static_cast<DWORD>(size), &count, &overlapped) && count == size;
+}
+
+//------------------------------------------------------------------------------
+bool File::resize(uint64_t size)
+{
+	LARGE_INTEGER position;
+	position.QuadPart = static_cast<LONGLONG>(size);
+	return ::SetFilePointerEx(file_, position, nullptr, FILE_BEGIN) && ::SetEndOfFile(file_);
+}
+
+//------------------------------------------------------------------------------
+bool File::flush()
+{
+	return ::FlushFileBuffers(file_) != FALSE;
+}
+
+//------------------------------------------------------------------------------
+void* File::map()
+{
+	unmap();
+	const auto size = this->size();
+	mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+	                                static_cast<DWORD>(size), nullptr);
+	if (mapping_ == nullptr)
+	{
+		return nullptr;
+	}
+	view_ = ::MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, static_cast<SIZE_T>(size));
+	viewSize_ = view_ != nullptr ? static_cast<size_t>(size) : 0;
+	return view_;
+}
+
+//------------------------------------------------------------------------------
+void File::unmap()
+{
+	if (view_ != nullptr)
+	{
+		::UnmapViewOfFile(view_);
+		view_ = nullptr;
+		viewSize_ = 0;
+	}
+	if (mapping_ != nullptr)
+	{
+		::CloseHandle(mapping_);
+		mapping_ = nullptr;
+	}
+}
+
+//------------------------------------------------------------------------------
+bool File::flushMap()
+{
+	return ::FlushViewOfFile(view_, viewSize_) && flush();
+}
+
+//------------------------------------------------------------------------------
+bool File::replace(const char* path, const char* newPath)
+{
+	return ::MoveFileExA(path, newPath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE;
+}
+#else
+//------------------------------------------------------------------------------
+File::File() : file_(-1), view_(nullptr), viewSize_(0)
+{
+}
+
+//------------------------------------------------------------------------------
+bool File::open(const char* path)
+{
+	close();
+	file_ = ::open(path, O_RDWR | O_CREAT, 0644);
+	return file_ != -1;
+}
+
+//------------------------------------------------------------------------------
+void File::close()
+{
+	unmap();
+	if (file_ != -1)
+	{
+		::close(file_);
+		file_ = -1;
+	}
+}
+
+//------------------------------------------------------------------------------
+bool File::isOpen() const
+{
+	return file_ != -1;
+}
+
+//------------------------------------------------------------------------------
+uint64_t File::size() const
+{
+	struct stat fileStat;
+	return ::fstat(file_, &fileStat) == 0 ? static_cast<uint64_t>(fileStat.st_size) : 0;
+}
+
+//------------------------------------------------------------------------------
+bool File::read(uint64_t offset, void* data, size_t size) const
+{
+	auto bytes = static_cast<char*>(data);
+	while (size > 0)
+	{
+		auto count = ::pread(file_, bytes, size, static_cast<off_t>(offset));
+		if (count <= 0)
+		{
+			return false;
+		}
+		bytes += count;
+		offset += count;
+		size -= count;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool File::write(uint64_t offset, const void* data, size_t size)
+{
+	auto bytes = static_cast<const char*>(data);
+	while (size > 0)
+	{
+		auto count = ::pwrite(file_, bytes, size, static_cast<off_t>(offset));
+		if (count <= 0)
+		{
+			return false;
+		}
+		bytes += count;
+		offset += count;
+		size -= count;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool File::resize(uint64_t size)
+{
+	return ::ftruncate(file_, static_cast<off_t>(size)) == 0;
+}
+
+//------------------------------------------------------------------------------
+bool File::flush()
+{
+	return ::fsync(file_) == 0;
+}
+
+//------------------------------------------------------------------------------
+void* File::map()
+{
+	unmap();
+	const auto size = static_cast<size_t>(this->size());
+	auto view = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file_, 0);
+	if (view == MAP_FAILED)
+	{
+		return nullptr;
+	}
+	view_ = view;
+	viewSize_ = size;
+	return view_;
+}
+
+//------------------------------------------------------------------------------
+void File::unmap()
+{
+	if (view_ != nullptr)
+	{
+		::munmap(view_, viewSize_);
+		view_ = nullptr;
+		viewSize_ = 0;
+	}
+}
+
+//------------------------------------------------------------------------------
+bool File::flushMap()
+{
+	return ::msync(view_, viewSize_, MS_SYNC) == 0;
+}
+
+//------------------------------------------------------------------------------
+bool File::replace(const char* path, const char* newPath)
+{
+	return ::rename(path, newPath) == 0;
+}
+#endif
+
+//------------------------------------------------------------------------------
+File::~File()
+{
+	close();
+}
+}
+
+//==============================================================================
+struct CommandJournal::Implementation
+{
+	Implementation()
+	    : header_(nullptr), offsets_(nullptr), generation_(0), count_(0), selected_(-1), liveBytes_(0),
+	      writtenSize_(0), pendingRecords_(0), pendingBase_(0), syncRecords_(16), syncInterval_(1000)
+	{
+	}
+
+	bool open(const char* path);
+	void close();
+	bool openIndex();
+	bool mapIndex();
+	bool reserveIndex(size_t count);
+
+	bool readBytes(uint64_t offset, void* data, size_t size) const;
+	bool readRecord(uint64_t offset, RecordHeader& o_header, std::string& o_data) const;
+	uint64_t entryOffset(size_t index) const;
+
+	bool replay(uint64_t offset);
+	void applyRecord(uint64_t offset, const RecordHeader& header);
+	void dropEntries(size_t count);
+	void writeRecord(RecordType type, uint32_t value, const void* data, size_t size);
+
+	void maybeSync();
+	bool flush();
+	bool shouldCompact() const;
+	bool rewrite(const std::vector<size_t>& entries);
+
+	std::string path_;
+	File journal_;
+	File index_;
+	IndexHeader* header_;
+	uint64_t* offsets_;
+	uint64_t generation_;
+
+	// State including the records not synced yet
+	size_t count_;
+	int selected_;
+	uint64_t liveBytes_;
+
+	// Journal bytes in the file, later records are buffered in pending_
+	uint64_t writtenSize_;
+	std::string pending_;
+	size_t pendingRecords_;
+	// Offsets of the entries from pendingBase_ on, which are not in the index yet
+	size_t pendingBase_;
+	std::vector<uint64_t> pendingOffsets_;
+
+	size_t syncRecords_;
+	std::chrono::milliseconds syncInterval_;
+	std::chrono::steady_clock::time_point lastSync_;
+};
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::open(const char* path)
+{
+	path_ = path;
+	if (!journal_.open(path))
+	{
+		NGT_ERROR_MSG("Failed to open command journal %s\n", path);
+		return false;
+	}
+
+	JournalHeader header;
+	if (journal_.size() < sizeof(header))
+	{
+		// A new journal, or one whose header never reached the disk
+		header.magic_ = s_JournalMagic;
+		header.version_ = s_Version;
+		header.generation_ = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+		if (!journal_.resize(0) || !journal_.write(0, &header, sizeof(header)) || !journal_.flush())
+		{
+			NGT_ERROR_MSG("Failed to create command journal %s\n", path);
+			close();
+			return false;
+		}
+	}
+	else if (!journal_.read(0, &header, sizeof(header)) || header.magic_ != s_JournalMagic ||
+	         header.version_ != s_Version)
+	{
+		NGT_ERROR_MSG("%s is not a command journal\n", path);
+		close();
+		return false;
+	}
+
+	generation_ = header.generation_;
+	writtenSize_ = journal_.size();
+	if (!openIndex())
+	{
+		NGT_ERROR_MSG("Failed to open command journal index for %s\n", path);
+		close();
+		return false;
+	}
+
+	// Only the records written after the index was last synced need replaying
+	if (!replay(header_->journalSize_) || !flush())
+	{
+		close();
+		return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+void CommandJournal::Implementation::close()
+{
+	if (header_ != nullptr)
+	{
+		flush();
+	}
+	index_.close();
+	journal_.close();
+	header_ = nullptr;
+	offsets_ = nullptr;
+	count_ = 0;
+	selected_ = -1;
+	liveBytes_ = 0;
+	writtenSize_ = 0;
+	pending_.clear();
+	pendingRecords_ = 0;
+	pendingBase_ = 0;
+	pendingOffsets_.clear();
+}
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::openIndex()
+{
+	const auto indexPath = path_ + ".idx";
+	if (!index_.open(indexPath.c_str()))
+	{
+		return false;
+	}
+
+	IndexHeader header;
+	const bool valid = index_.size() >= sizeof(header) && index_.read(0, &header, sizeof(header)) &&
+	header.magic_ == s_IndexMagic && header.version_ == s_Version && header.generation_ == generation_ &&
+	header.journalSize_ >= sizeof(JournalHeader) && header.journalSize_ <= writtenSize_ &&
+	header.count_ <= header.capacity_ && header.selected_ < static_cast<int64_t>(header.count_) &&
+	index_.size() >= sizeof(header) + header.capacity_ * sizeof(uint64_t);
+	if (!valid)
+	{
+		// Missing, or left behind by another journal; rebuild it from every record
+		header.magic_ = s_IndexMagic;
+		header.version_ = s_Version;
+		header.generation_ = generation_;
+		header.journalSize_ = sizeof(JournalHeader);
+		header.count_ = 0;
+		header.selected_ = -1;
+		header.liveBytes_ = 0;
+		header.capacity_ = s_MinIndexCapacity;
+		if (!index_.resize(sizeof(header) + header.capacity_ * sizeof(uint64_t)) ||
+		    !index_.write(0, &header, sizeof(header)))
+		{
+			return false;
+		}
+	}
+
+	if (!mapIndex())
+	{
+		return false;
+	}
+	count_ = static_cast<size_t>(header_->count_);
+	selected_ = static_cast<int>(header_->selected_);
+	liveBytes_ = header_->liveBytes_;
+	pendingBase_ = count_;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::mapIndex()
+{
+	header_ = static_cast<IndexHeader*>(index_.map());
+	offsets_ = header_ != nullptr ? reinterpret_cast<uint64_t*>(header_ + 1) : nullptr;
+	return header_ != nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::reserveIndex(size_t count)
+{
+	auto capacity = header_->capacity_;
+	if (count <= capacity)
+	{
+		return true;
+	}
+	while (capacity < count)
+	{
+		capacity *= 2;
+	}
+
+	index_.unmap();
+	header_ = nullptr;
+	offsets_ = nullptr;
+	if (!index_.resize(sizeof(IndexHeader) + capacity * sizeof(uint64_t)) || !mapIndex())
+	{
+		return false;
+	}
+	header_->capacity_ = capacity;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::readBytes(uint64_t offset, void* data, size_t size) const
+{
+	if (offset + size <= writtenSize_)
+	{
+		return journal_.read(offset, data, size);
+	}
+	if (offset >= writtenSize_ && offset + size <= writtenSize_ + pending_.size())
+	{
+		memcpy(data, pending_.data() + (offset - writtenSize_), size);
+		return true;
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::readRecord(uint64_t offset, RecordHeader& o_header, std::string& o_data) const
+{
+	if (!readBytes(offset, &o_header, sizeof(o_header)))
+	{
+		return false;
+	}
+
+	const auto available = writtenSize_ + pending_.size() - offset - sizeof(o_header);
+	if (o_header.size_ > available)
+	{
+		return false;
+	}
+
+	o_data.resize(static_cast<size_t>(o_header.size_));
+	if (!o_data.empty() && !readBytes(offset + sizeof(o_header), &o_data[0], o_data.size()))
+	{
+		return false;
+	}
+	return o_header.checksum_ == computeChecksum(o_header, o_data.data());
+}
+
+//------------------------------------------------------------------------------
+uint64_t CommandJournal::Implementation::entryOffset(size_t index) const
+{
+	TF_ASSERT(index < count_);
+	return index >= pendingBase_ ? pendingOffsets_[index - pendingBase_] : offsets_[index];
+}
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::replay(uint64_t offset)
+{
+	RecordHeader header;
+	std::string data;
+	while (offset < writtenSize_)
+	{
+		if (!readRecord(offset, header, data))
+		{
+			NGT_WARNING_MSG("Dropping %llu bytes of incomplete records from command journal %s\n",
+			                static_cast<unsigned long long>(writtenSize_ - offset), path_.c_str());
+			writtenSize_ = offset;
+			return journal_.resize(offset) && journal_.flush();
+		}
+		applyRecord(offset, header);
+		offset += sizeof(header) + header.size_;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------------
+void CommandJournal::Implementation::applyRecord(uint64_t offset, const RecordHeader& header)
+{
+	switch (header.type_)
+	{
+	case RECORD_ENTRY:
+		TF_ASSERT(count_ == pendingBase_ + pendingOffsets_.size());
+		pendingOffsets_.push_back(offset);
+		++count_;
+		liveBytes_ += sizeof(header) + header.size_;
+		break;
+
+	case RECORD_TRUNCATE:
+		dropEntries(header.value_);
+		break;
+
+	case RECORD_SELECT:
+		selected_ = static_cast<int>(static_cast<int32_t>(header.value_));
+		break;
+
+	default:
+		NGT_WARNING_MSG("Skipping unknown record type %u in command journal %s\n", header.type_, path_.c_str());
+		break;
+	}
+}
+
+//------------------------------------------------------------------------------
+void CommandJournal::Implementation::dropEntries(size_t count)
+{
+	if (count >= count_)
+	{
+		return;
+	}
+
+	for (auto i = count; i < count_; ++i)
+	{
+		RecordHeader header;
+		if (readBytes(entryOffset(i), &header, sizeof(header)))
+		{
+			liveBytes_ -= std::min<uint64_t>(liveBytes_, sizeof(header) + header.size_);
+		}
+	}
+
+	if (count < pendingBase_)
+	{
+		// The index entries from count on are only overwritten once the journal
+		// records replacing them are on disk
+		pendingOffsets_.clear();
+		pendingBase_ = count;
+	}
+	else
+	{
+		pendingOffsets_.resize(count - pendingBase_);
+	}
+	count_ = count;
+}
+
+//------------------------------------------------------------------------------
+void CommandJournal::Implementation::writeRecord(RecordType type, uint32_t value, const void* data, size_t size)
+{
+	RecordHeader header;
+	header.type_ = type;
+	header.value_ = value;
+	header.size_ = size;
+	header.checksum_ = computeChecksum(header, data);
+
+	const auto offset = writtenSize_ + pending_.size();
+	pending_.append(reinterpret_cast<const char*>(&header), sizeof(header));
+	if (size > 0)
+	{
+		pending_.append(static_cast<const char*>(data), size);
+	}
+	++pendingRecords_;
+	applyRecord(offset, header);
+}
+
+//------------------------------------------------------------------------------
+void CommandJournal::Implementation::maybeSync()
+{
+	if (pendingRecords_ >= syncRecords_ || std::chrono::steady_clock::now() - lastSync_ >= syncInterval_)
+	{
+		flush();
+		if (shouldCompact())
+		{
+			std::vector<size_t> entries(count_);
+			for (size_t i = 0; i < count_; ++i)
+			{
+				entries[i] = i;
+			}
+			rewrite(entries);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::flush()
+{
+	lastSync_ = std::chrono::steady_clock::now();
+	if (header_ == nullptr)
+	{
+		return false;
+	}
+	if (pending_.empty() && header_->journalSize_ == writtenSize_)
+	{
+		return true;
+	}
+
+	if (!pending_.empty())
+	{
+		if (!journal_.write(writtenSize_, pending_.data(), pending_.size()))
+		{
+			NGT_ERROR_MSG("Failed to write command journal %s\n", path_.c_str());
+			return false;
+		}
+		writtenSize_ += pending_.size();
+		pending_.clear();
+		pendingRecords_ = 0;
+	}
+	if (!journal_.flush())
+	{
+		NGT_ERROR_MSG("Failed to sync command journal %s\n", path_.c_str());
+		return false;
+	}
+
+	// The records are on disk, so the index may now refer to them
+	if (!reserveIndex(count_))
+	{
+		NGT_ERROR_MSG("Failed to grow command journal index for %s\n", path_.c_str());
+		return false;
+	}
+	std::copy(pendingOffsets_.begin(), pendingOffsets_.end(), offsets_ + pendingBase_);
+	pendingBase_ = count_;
+	pendingOffsets_.clear();
+
+	header_->count_ = count_;
+	header_->selected_ = selected_;
+	header_->liveBytes_ = liveBytes_;
+	header_->journalSize_ = writtenSize_;
+	return index_.flushMap();
+}
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::shouldCompact() const
+{
+	return writtenSize_ > s_MinCompactSize && writtenSize_ - sizeof(JournalHeader) > 2 * liveBytes_;
+}
+
+//------------------------------------------------------------------------------
+bool CommandJournal::Implementation::rewrite(const std::vector<size_t>& entries)
+{
+	if (!flush())
+	{
+		return false;
+	}
+
+	const auto tempPath = path_ + ".tmp";
+	File temp;
+	if (!temp.open(tempPath.c_str()) || !temp.resize(0))
+	{
+		NGT_ERROR_MSG("Failed to create %s\n", tempPath.c_str());
+		return false;
+	}
+
+	JournalHeader journalHeader;
+	journalHeader.magic_ = s_JournalMagic;
+	journalHeader.version_ = s_Version;
+	journalHeader.generation_ = generation_ + 1;
+	bool written = temp.write(0, &journalHeader, sizeof(journalHeader));
+
+	uint64_t offset = sizeof(journalHeader);
+	std::vector<uint64_t> offsets;
+	offsets.reserve(entries.size());
+	uint64_t liveBytes = 0;
+	int selected = -1;
+	RecordHeader header;
+	std::string data;
+	for (auto index : entries)
+	{
+		written = written && readRecord(entryOffset(index), header, data) &&
+		temp.write(offset, &header, sizeof(header)) &&
+		(data.empty() || temp.write(offset + sizeof(header), data.data(), data.size()));
+		if (!written)
+		{
+			break;
+		}
+		if (static_cast<int>(index) <= selected_)
+		{
+			selected = static_cast<int>(offsets.size());
+		}
+		offsets.push_back(offset);
+		offset += sizeof(header) + data.size();
+		liveBytes += sizeof(header) + data.size();
+	}
+
+	header.type_ = RECORD_SELECT;
+	header.value_ = static_cast<uint32_t>(selected);
+	header.size_ = 0;
+	header.checksum_ = computeChecksum(header, nullptr);
+	written = written && temp.write(offset, &header, sizeof(header)) && temp.flush();
+	offset += sizeof(header);
+	temp.close();
+
+	if (!written)
+	{
+		NGT_ERROR_MSG("Failed to compact command journal %s\n", path_.c_str());
+		std::remove(tempPath.c_str());
+		return false;
+	}
+
+	// An index left pointing at the old journal is rebuilt on open, as the generation differs
+	journal_.close();
+	index_.unmap();
+	header_ = nullptr;
+	offsets_ = nullptr;
+	if (!File::replace(tempPath.c_str(), path_.c_str()))
+	{
+		NGT_ERROR_MSG("Failed to replace command journal %s\n", path_.c_str());
+		std::remove(tempPath.c_str());
+		return journal_.open(path_.c_str()) && mapIndex();
+	}
+	if (!journal_.open(path_.c_str()))
+	{
+		NGT_ERROR_MSG("Failed to reopen command journal %s\n", path_.c_str());
+		return false;
+	}
+
+	const auto capacity = std::max<uint64_t>(s_MinIndexCapacity, offsets.size());
+	if (!index_.resize(sizeof(IndexHeader) + capacity * sizeof(uint64_t)) || !mapIndex())
+	{
+		NGT_ERROR_MSG("Failed to rebuild command journal index for %s\n", path_.c_str());
+		journal_.close();
+		return false;
+	}
+	std::copy(offsets.begin(), offsets.end(), offsets_);
+
+	generation_ = journalHeader.generation_;
+	writtenSize_ = offset;
+	count_ = offsets.size();
+	selected_ = selected;
+	liveBytes_ = liveBytes;
+	pendingBase_ = count_;
+
+	header_->magic_ = s_IndexMagic;
+	header_->version_ = s_Version;
+	header_->journalSize_ = writtenSize_;
+	header_->count_ = count_;
+	header_->selected_ = selected_;
+	header_->liveBytes_ = liveBytes_;
+	header_->capacity_ = capacity;
+	header_->generation_ = generation_;
+	return index_.flushMap();
+}
+
+//==============================================================================
+CommandJournal::CommandJournal() : impl_(new Implementation)
+{
+}
+
+//==============================================================================
+CommandJournal::~CommandJournal()
+{
+	close();
+}
+
+//==============================================================================
+bool CommandJournal::open(const char* path)
+{
+	close();
+	return impl_->open(path);
+}
+
+//==============================================================================
+void CommandJournal::close()
+{
+	impl_->close();
+}
+
+//==============================================================================
+bool CommandJournal::isOpen() const
+{
+	return impl_->header_ != nullptr;
+}
+
+//==============================================================================
+size_t CommandJournal::size() const
+{
+	return impl_->count_;
+}
+
+//==============================================================================
+int CommandJournal::selected() const
+{
+	return std::min(impl_->selected_, static_cast<int>(impl_->count_) - 1);
+}
+
+//==============================================================================
+bool CommandJournal::read(size_t index, std::string& o_data) const
+{
+	if (!isOpen() || index >= impl_->count_)
+	{
+		return false;
+	}
+
+	RecordHeader header;
+	return impl_->readRecord(impl_->entryOffset(index), header, o_data) && header.type_ == RECORD_ENTRY;
+}
+
+//==============================================================================
+void CommandJournal::append(const void* data, size_t size)
+{
+	if (!isOpen())
+	{
+		return;
+	}
+	impl_->writeRecord(RECORD_ENTRY, 0, data, size);
+	impl_->maybeSync();
+}
+
+//==============================================================================
+void CommandJournal::truncate(size_t count)
+{
+	if (!isOpen() || count >= impl_->count_)
+	{
+		return;
+	}
+	impl_->writeRecord(RECORD_TRUNCATE, static_cast<uint32_t>(count), nullptr, 0);
+	impl_->maybeSync();
+}
+
+//==============================================================================
+bool CommandJournal::remove(const std::vector<size_t>& indices)
+{
+	if (!isOpen())
+	{
+		return false;
+	}
+
+	std::vector<size_t> entries;
+	entries.reserve(impl_->count_);
+	for (size_t i = 0; i < impl_->count_; ++i)
+	{
+		if (std::find(indices.begin(), indices.end(), i) == indices.end())
+		{
+			entries.push_back(i);
+		}
+	}
+	return entries.size() == impl_->count_ || impl_->rewrite(entries);
+}
+
+//==============================================================================
+void CommandJournal::select(int index)
+{
+	if (!isOpen() || index == impl_->selected_)
+	{
+		return;
+	}
+	impl_->writeRecord(RECORD_SELECT, static_cast<uint32_t>(index), nullptr, 0);
+	impl_->maybeSync();
+}
+
+//==============================================================================
+bool CommandJournal::sync()
+{
+	return isOpen() && impl_->flush();
+}
+
+//==============================================================================
+void CommandJournal::update()
+{
+	if (isOpen() && impl_->pendingRecords_ > 0)
+	{
+		impl_->maybeSync();
+	}
+}
+
+//==============================================================================
+bool CommandJournal::compact()
+{
+	if (!isOpen())
+	{
+		return false;
+	}
+
+	std::vector<size_t> entries(impl_->count_);
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		entries[i] = i;
+	}
+	return impl_->rewrite(entries);
+}
+
+//==============================================================================
+void CommandJournal::setSyncInterval(size_t records, int milliseconds)
+{
+	impl_->syncRecords_ = records;
+	impl_->syncInterval_ = std::chrono::milliseconds(milliseconds);
+}
+} // end namespace wgt
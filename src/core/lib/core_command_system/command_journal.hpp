@@ -0,0 +1,85 @@
+#ifndef COMMAND_JOURNAL_HPP
+#define COMMAND_JOURNAL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace wgt
+{
+/**
+ *	Append-only on-disk journal of command history entries.
+ *
+ *	Entries are opaque blocks appended as commands complete, interleaved with
+ *	records of history truncation and selection changes. Records are buffered
+ *	and written to disk together, once enough of them have built up or enough
+ *	time has passed since the last sync. The owner calls update() while idle
+ *	so that the last records do not wait for the next one.
+ *
+ *	A memory mapped index of entry offsets, kept in path + ".idx", gives random
+ *	access to any entry without reading the ones before it. The index notes how
+ *	much of the journal it accounts for, so reopening the journal, even after a
+ *	crash, only replays the records written since the last sync and drops any
+ *	torn record at the end.
+ *
+ *	Truncated and removed entries stay in the file until it is compacted, which
+ *	happens on sync once they make up most of it.
+ */
+class CommandJournal
+{
+public:
+	CommandJournal();
+	~CommandJournal();
+
+	/**
+	 *	Opens the journal at path, creating it if it does not exist.
+	 *	@return false if the file cannot be opened or is not a journal.
+	 */
+	bool open(const char* path);
+	void close();
+	bool isOpen() const;
+
+	/** Number of live entries. */
+	size_t size() const;
+
+	/** Index of the selected entry, or -1 for none. */
+	int selected() const;
+
+	bool read(size_t index, std::string& o_data) const;
+
+	void append(const void* data, size_t size);
+
+	/** Drops every entry from count onwards. */
+	void truncate(size_t count);
+
+	/** Drops the given entries, which rewrites the journal. */
+	bool remove(const std::vector<size_t>& indices);
+
+	void select(int index);
+
+	/** Writes buffered records and waits until they reach the disk. */
+	bool sync();
+
+	/**
+	 *	Syncs buffered records if the sync interval has passed since the last
+	 *	sync. Call this while idle, as records are otherwise only synced when
+	 *	another one is written.
+	 */
+	void update();
+
+	/** Rewrites the journal with only its live entries. */
+	bool compact();
+
+	/** Sync once this many records are buffered, or this long after the last sync. */
+	void setSyncInterval(size_t records, int milliseconds);
+
+private:
+	CommandJournal(const CommandJournal&);
+	CommandJournal& operator=(const CommandJournal&);
+
+	struct Implementation;
+	std::unique_ptr<Implementation> impl_;
+};
+} // end namespace wgt
+#endif // COMMAND_JOURNAL_HPP
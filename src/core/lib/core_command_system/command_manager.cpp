@@ -15,6 +15,8 @@
 #include "core_reflection/i_object_manager.hpp"
 #include "core_logging/logging.hpp"
 #include "batch_command.hpp"
+#include "command_journal.hpp"
+#include <algorithm>
 #include <atomic>
 #include <deque>
 #include <map>
@@ -25,6 +27,7 @@
 #include "wg_types/binary_block.hpp"
 #include "reflection_undo_redo_data.hpp"
 #include "core_environment_system/i_env_system.hpp"
+#include "core_serialization/binary_stream.hpp"
 #include <memory>
 
 // TODO: Remove to platform string header
@@ -40,6 +43,10 @@ namespace
 
 static const char* s_macroVersion = "_macro_ver_0_0_0";
 const int NO_SELECTION = -1;
+// Journal entries beyond this many are dropped when the history is restored
+const size_t JOURNAL_RESTORE_LIMIT = 1000;
+// Journal entries are mostly many small values, so they are written through a buffer
+const std::streamsize JOURNAL_ENTRY_BUFFER_SIZE = 4096;
 static const char* s_macro_file = "macro";
 
 struct CommandFrame
@@ -70,11 +77,7 @@ public:
 		THREAD_LOCAL_SET(currentFrame_, commandFrames_.back().get());
 	}
 
-	virtual ~HistoryEnvComponentState()
-	{
-		TF_ASSERT(commandFrames_.size() == 1);
-		commandFrames_.clear();
-	}
+	virtual ~HistoryEnvComponentState();
 
 	void saveState(IDataStream& stream);
 
@@ -82,6 +85,11 @@ public:
 
 	void resetState();
 
+	bool openJournal(const char* path);
+	void journalHistory(size_t first);
+	void journalSelect(int index);
+	void journalRemove(const std::vector<size_t>& removed);
+
 	CommandManagerImpl& cmdMgrImpl_;
 	int index_;
 	int previousSelectedIndex_;
@@ -91,6 +99,11 @@ public:
     std::vector<std::unique_ptr<CommandFrame>> commandFrames_;
 	THREAD_LOCAL(CommandFrame*) currentFrame_;
 	bool abortingBatchCommand_;
+
+	std::string journalPath_;
+	std::unique_ptr<CommandJournal> journal_;
+	// Journal entry of each history entry, as restoring skips unreadable and old entries
+	std::vector<size_t> journalEntries_;
 };
 
 bool isBatchCommand(const CommandInstancePtr& cmd)
@@ -102,7 +115,7 @@ class CommandManagerImpl : public EnvComponentT<HistoryEnvComponentState>
 {
 public:
 	CommandManagerImpl(CommandManager* pCommandManager, IEnvManager& envManager)
-	    : EnvComponentT(envManager), currentIndex_(NO_SELECTION), previousSelectedIndex_(nullptr),
+	    : EnvComponentT(envManager), currentIndex_(NO_SELECTION), previousSelectedIndex_(nullptr), openJournals_(0),
 	      ownerThreadId_(std::this_thread::get_id()), workerThreadId_(), workerMutex_(), workerWakeUp_(),
 	      ownerWakeUp_(false), commands_(), globalEventListener_(), exiting_(false), enableWorker_(true),
 	      pCommandManager_(pCommandManager), workerThread_(), batchCommand_(pCommandManager),
@@ -166,8 +179,14 @@ public:
 	void threadFunc();
 	bool executingCommandGroup();
 
+	bool openHistoryJournal(LockedStateT<HistoryEnvComponentState>& state, const char* path);
+	void closeHistoryJournal(LockedStateT<HistoryEnvComponentState>& state);
+	bool serializeEntry(const CommandInstance& instance, std::string& o_data) const;
+	CommandInstancePtr deserializeEntry(const std::string& data) const;
+
 	int currentIndex_;
 	int* previousSelectedIndex_; // always point to active state's previous selected index
+	int openJournals_; // history states with a journal open, only used on the owner thread
 	Connection updateConnection_;
 
 	std::thread::id ownerThreadId_;
@@ -209,6 +228,9 @@ private:
 	IApplication* application_;
 	void addBatchCommandToCompoundCommand(CompoundCommand* compoundCommand,
 	                                      const CommandInstancePtr& instance);
+	void serializeInstance(BinaryStream& stream, const CommandInstance& instance,
+	                       std::vector<const CommandInstance*>& o_instances) const;
+	CommandInstancePtr deserializeInstance(BinaryStream& stream, std::vector<CommandInstance*>& o_instances) const;
 };
 
 void CommandManagerImpl::clearMacros()
@@ -239,6 +261,10 @@ void CommandManagerImpl::onPreEnvironmentChanged(const EnvironmentId& oldId, con
 {
 	auto lockedState = getActiveStateT();
 	flush(lockedState);
+	if (lockedState->journal_ != nullptr)
+	{
+		lockedState->journal_->sync();
+	}
 	pCommandManager_->signalPreCommandIndexChanged(currentIndex_);
 	currentIndex_ = NO_SELECTION;
 	previousSelectedIndex_ = nullptr;
@@ -314,6 +340,15 @@ void CommandManagerImpl::update()
 	// Optimisation to early out before calling processCommands which will attempt to acquire a mutex
 	if (!ownerWakeUp_)
 	{
+		if (openJournals_ > 0)
+		{
+			// Sync journal records left buffered since the last command
+			auto lockedState = getActiveStateT();
+			if (lockedState->journal_ != nullptr)
+			{
+				lockedState->journal_->update();
+			}
+		}
 		return;
 	}
 	auto lockedState = getActiveStateT();
@@ -490,15 +525,21 @@ void CommandManagerImpl::waitForInstance(LockedStateT<HistoryEnvComponentState>&
 
 	auto it = last;
 	auto waitFor = instance;
+	auto nextProgress = std::chrono::steady_clock::now() + CommandProgress::SAMPLE_INTERVAL;
 	while (waitFor != nullptr)
 	{
 		while (waitFor->status_ != Complete)
 		{
 			processCommands(state);
 
-			// TODO: This is piggy backing on now defunct command status messages.
-			// This needs to be revised.
-			pCommandManager_->fireProgressMade(*waitFor);
+			// Listeners sample the command's progress channel, so only notify them at the sample rate
+			// rather than on every spin.
+			auto now = std::chrono::steady_clock::now();
+			if (now >= nextProgress)
+			{
+				nextProgress = now + CommandProgress::SAMPLE_INTERVAL;
+				pCommandManager_->fireProgressMade(*waitFor);
+			}
 		}
 		CommandInstancePtr parent = nullptr;
 		while (it != first)
@@ -522,6 +563,7 @@ void CommandManagerImpl::updateSelected(LockedStateT<HistoryEnvComponentState>&
 	state->index_ = value;
 	state->previousSelectedIndex_ = value;
 	currentIndex_ = value;
+	state->journalSelect(value);
 
 	pCommandManager_->signalPostCommandIndexChanged(currentIndex_);
 }
@@ -552,6 +594,7 @@ void CommandManagerImpl::removeCommands(LockedStateT<HistoryEnvComponentState>&
 {
 	flush(state);
 	int currentIndexValue = 0;
+	std::vector<size_t> removed;
 	{
 		std::unique_lock<std::mutex> lock(workerMutex_);
 
@@ -566,6 +609,7 @@ void CommandManagerImpl::removeCommands(LockedStateT<HistoryEnvComponentState>&
 		{
 			if (functor((*iter).value<CommandInstancePtr>()))
 			{
+				removed.push_back(commandIndex + removed.size());
 				iter = history_.erase(iter);
 				if (commandIndex <= currentIndexValue)
 				{
@@ -588,6 +632,12 @@ void CommandManagerImpl::removeCommands(LockedStateT<HistoryEnvComponentState>&
 		currentIndex_ = currentIndexValue;
 		state->index_ = currentIndexValue;
 	}
+
+	if (!removed.empty())
+	{
+		state->journalRemove(removed);
+		state->journalSelect(currentIndexValue);
+	}
 }
 
 //==============================================================================
@@ -809,12 +859,14 @@ void CommandManagerImpl::moveCommandIndex(LockedStateT<HistoryEnvComponentState>
 	waitForInstance(state, instance);
 	currentIndex_ = state->previousSelectedIndex_;
 	state->index_ = currentIndex_;
+	state->journalSelect(currentIndex_);
 	pCommandManager_->signalPostCommandIndexChanged(state->index_);
 }
 
 //==============================================================================
 void CommandManagerImpl::processCommands(LockedStateT<HistoryEnvComponentState>& state)
 {
+	size_t firstEntry = 0;
 	{
 		std::thread::id currentThreadId = std::this_thread::get_id();
 
@@ -895,6 +947,7 @@ void CommandManagerImpl::processCommands(LockedStateT<HistoryEnvComponentState>&
 			return;
 		}
 
+		firstEntry = std::min(history_.size(), static_cast<size_t>(currentIndex_ + 1));
 		if (static_cast<int>(history_.size()) > currentIndex_ + 1)
 		{
 			// erase all history after the current index as we have pending
@@ -910,6 +963,7 @@ void CommandManagerImpl::processCommands(LockedStateT<HistoryEnvComponentState>&
 			state->pendingHistory_.pop_front();
 		}
 	}
+	state->journalHistory(firstEntry);
 	updateSelected(state, static_cast<int>(history_.size() - 1));
 }
 
@@ -1069,12 +1123,216 @@ bool CommandManagerImpl::executingCommandGroup()
 	return count > 2;
 }
 
+//==============================================================================
+bool CommandManagerImpl::openHistoryJournal(LockedStateT<HistoryEnvComponentState>& state, const char* path)
+{
+	flush(state);
+	pCommandManager_->signalPreCommandIndexChanged(currentIndex_);
+	currentIndex_ = NO_SELECTION;
+	pCommandManager_->signalHistoryPreReset(history_);
+	const bool opened = state->openJournal(path);
+	{
+		std::unique_lock<std::mutex> lock(workerMutex_);
+		history_ = Collection(state->history_);
+	}
+	pCommandManager_->signalHistoryPostReset(history_);
+	currentIndex_ = state->index_;
+	pCommandManager_->signalPostCommandIndexChanged(currentIndex_);
+	return opened;
+}
+
+//==============================================================================
+void CommandManagerImpl::closeHistoryJournal(LockedStateT<HistoryEnvComponentState>& state)
+{
+	flush(state);
+	if (state->journal_ != nullptr)
+	{
+		--openJournals_;
+	}
+	state->journal_.reset();
+	state->journalPath_.clear();
+	state->journalEntries_.clear();
+}
+
+//==============================================================================
+bool CommandManagerImpl::serializeEntry(const CommandInstance& instance, std::string& o_data) const
+{
+	ResizingMemoryStream dataStream;
+	BinaryStream stream(dataStream);
+	stream.setBufferSize(JOURNAL_ENTRY_BUFFER_SIZE);
+	stream.setCompact(true);
+	std::vector<const CommandInstance*> instances;
+	serializeInstance(stream, instance, instances);
+
+	// Undo data is consolidated into the root instance, but still refers to the instance that recorded it
+	stream.serializeVarint(instance.undoRedoData_.size());
+	for (auto& data : instance.undoRedoData_)
+	{
+		auto reflectionData = dynamic_cast<const ReflectionUndoRedoData*>(data.get());
+		auto customData = dynamic_cast<const CustomUndoRedoData*>(data.get());
+		if (reflectionData == nullptr && customData == nullptr)
+		{
+			return false;
+		}
+
+		auto& owner = reflectionData != nullptr ? reflectionData->getCommandInstance() : customData->getCommandInstance();
+		auto found = std::find(instances.begin(), instances.end(), &owner);
+		stream << static_cast<uint8_t>(reflectionData != nullptr);
+		stream.serializeVarint(found != instances.end() ? found - instances.begin() : 0);
+		if (reflectionData != nullptr)
+		{
+			auto undoData = reflectionData->getUndoData();
+			auto redoData = reflectionData->getRedoData();
+			stream << std::string(undoData.cdata(), undoData.length());
+			stream << std::string(redoData.cdata(), redoData.length());
+		}
+	}
+
+	if (!stream.sync() || !stream.good())
+	{
+		return false;
+	}
+	o_data = dataStream.takeBuffer();
+	return true;
+}
+
+//==============================================================================
+void CommandManagerImpl::serializeInstance(BinaryStream& stream, const CommandInstance& instance,
+                                           std::vector<const CommandInstance*>& o_instances) const
+{
+	o_instances.push_back(&instance);
+	stream << instance.commandId_;
+	stream << static_cast<int32_t>(instance.errorCode_);
+
+	std::string arguments;
+	if (instance.arguments_ != nullptr)
+	{
+		ResizingMemoryStream argumentStream;
+		XMLSerializer serializer(argumentStream, pCommandManager_->getDefManager());
+		if (serializer.serialize(instance.arguments_) && serializer.sync())
+		{
+			arguments = argumentStream.takeBuffer();
+		}
+		else
+		{
+			stream.setState(std::ios_base::failbit);
+		}
+	}
+	stream << arguments;
+
+	stream.serializeVarint(instance.children_.size());
+	for (auto& child : instance.children_)
+	{
+		serializeInstance(stream, *child, o_instances);
+	}
+}
+
+//==============================================================================
+CommandInstancePtr CommandManagerImpl::deserializeEntry(const std::string& data) const
+{
+	ResizingMemoryStream dataStream(data);
+	BinaryStream stream(dataStream);
+	stream.setBufferSize(JOURNAL_ENTRY_BUFFER_SIZE);
+	stream.setCompact(true);
+	std::vector<CommandInstance*> instances;
+	auto instance = deserializeInstance(stream, instances);
+	if (instance == nullptr)
+	{
+		return nullptr;
+	}
+
+	uint64_t count = 0;
+	stream.deserializeVarint(count);
+	for (uint64_t i = 0; i < count && stream.good(); ++i)
+	{
+		uint8_t reflection = 0;
+		uint64_t owner = 0;
+		stream >> reflection;
+		stream.deserializeVarint(owner);
+		if (!stream.good() || owner >= instances.size())
+		{
+			return nullptr;
+		}
+
+		if (reflection == 0)
+		{
+			instance->undoRedoData_.emplace_back(new CustomUndoRedoData(*instances[owner]));
+			continue;
+		}
+
+		std::string undoData;
+		std::string redoData;
+		stream >> undoData >> redoData;
+		auto reflectionData = new ReflectionUndoRedoData(*instances[owner]);
+		instance->undoRedoData_.emplace_back(reflectionData);
+		reflectionData->setUndoData(BinaryBlock(undoData.data(), undoData.size(), true));
+		reflectionData->setRedoData(BinaryBlock(redoData.data(), redoData.size(), true));
+	}
+	return stream.good() ? instance : nullptr;
+}
+
+//==============================================================================
+CommandInstancePtr CommandManagerImpl::deserializeInstance(BinaryStream& stream,
+                                                           std::vector<CommandInstance*>& o_instances) const
+{
+	std::string commandId;
+	int32_t errorCode = COMMAND_NO_ERROR;
+	std::string arguments;
+	uint64_t childCount = 0;
+	stream >> commandId >> errorCode >> arguments;
+	if (!stream.good())
+	{
+		return nullptr;
+	}
+
+	auto instance = makeCommand(commandId.c_str());
+	if (instance == nullptr)
+	{
+		return nullptr;
+	}
+	o_instances.push_back(instance.get());
+	instance->errorCode_ = static_cast<CommandErrorCode>(errorCode);
+	// Restored commands are already complete, so listeners are not told about them
+	instance->status_ = Complete;
+
+	if (!arguments.empty())
+	{
+		ResizingMemoryStream argumentStream(std::move(arguments));
+		XMLSerializer serializer(argumentStream, pCommandManager_->getDefManager());
+		Variant value;
+		ObjectHandle handle;
+		if (!serializer.deserialize(value) || !value.tryCast(handle))
+		{
+			return nullptr;
+		}
+		instance->setArguments(handle);
+	}
+
+	stream.deserializeVarint(childCount);
+	for (uint64_t i = 0; i < childCount && stream.good(); ++i)
+	{
+		auto child = deserializeInstance(stream, o_instances);
+		if (child == nullptr)
+		{
+			return nullptr;
+		}
+		instance->children_.push_back(child);
+	}
+	return stream.good() ? instance : nullptr;
+}
+
 void HistoryEnvComponentState::resetState()
 {
 	index_ = NO_SELECTION;
 	previousSelectedIndex_ = NO_SELECTION;
 	pendingHistory_.clear();
 	history_.clear();
+	journalEntries_.clear();
+	if (journal_ != nullptr)
+	{
+		journal_->truncate(0);
+		journal_->select(NO_SELECTION);
+	}
 	cmdMgrImpl_.pCommandManager_->signalPreCommandIndexChanged(cmdMgrImpl_.currentIndex_);
 	cmdMgrImpl_.currentIndex_ = NO_SELECTION;
 	cmdMgrImpl_.previousSelectedIndex_ = nullptr;
@@ -1093,12 +1351,186 @@ void HistoryEnvComponentState::resetState()
 	THREAD_LOCAL_SET(currentFrame_, commandFrames_.back().get());
 }
 
+HistoryEnvComponentState::~HistoryEnvComponentState()
+{
+	TF_ASSERT(commandFrames_.size() == 1);
+	commandFrames_.clear();
+	if (journal_ != nullptr)
+	{
+		--cmdMgrImpl_.openJournals_;
+	}
+}
+
+/**
+ *	Opens the journal at path and makes it mirror the history.
+ *	An empty journal is seeded with the current history, otherwise the history
+ *	is replaced by the most recent entries in the journal. Restoring never
+ *	changes the journal, entries that are too old or cannot be read are left
+ *	in it and skipped.
+ */
+bool HistoryEnvComponentState::openJournal(const char* path)
+{
+	std::unique_ptr<CommandJournal> journal(new CommandJournal);
+	if (!journal->open(path))
+	{
+		return false;
+	}
+	if (journal_ == nullptr)
+	{
+		++cmdMgrImpl_.openJournals_;
+	}
+
+	if (journal->size() == 0)
+	{
+		journal_ = std::move(journal);
+		journalPath_ = path;
+		journalEntries_.clear();
+		journalHistory(0);
+		journalSelect(index_);
+		journal_->sync();
+		return true;
+	}
+
+	const auto size = journal->size();
+	const size_t first = size > JOURNAL_RESTORE_LIMIT ? size - JOURNAL_RESTORE_LIMIT : 0;
+	std::vector<Variant> history;
+	std::vector<size_t> entries;
+	history.reserve(size - first);
+	entries.reserve(size - first);
+	std::string data;
+	for (auto i = first; i < size; ++i)
+	{
+		auto instance = journal->read(i, data) ? cmdMgrImpl_.deserializeEntry(data) : nullptr;
+		if (instance == nullptr)
+		{
+			NGT_WARNING_MSG("Skipping unreadable entry %zu of %s\n", i, path);
+			continue;
+		}
+		history.emplace_back(instance);
+		entries.push_back(i);
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(cmdMgrImpl_.workerMutex_);
+		history_.swap(history);
+	}
+	journalEntries_.swap(entries);
+
+	// Select the last restored entry at or before the journal's selection
+	const int selected = journal->selected();
+	auto end = selected < 0 ? journalEntries_.begin() :
+	                          std::upper_bound(journalEntries_.begin(), journalEntries_.end(), static_cast<size_t>(selected));
+	index_ = static_cast<int>(end - journalEntries_.begin()) - 1;
+	previousSelectedIndex_ = index_;
+	journal_ = std::move(journal);
+	journalPath_ = path;
+	return true;
+}
+
+/**
+ *	Journals the history entries from first on, replacing any entries there.
+ */
+void HistoryEnvComponentState::journalHistory(size_t first)
+{
+	if (journal_ == nullptr)
+	{
+		return;
+	}
+
+	TF_ASSERT(first <= journalEntries_.size());
+	journal_->truncate(first < journalEntries_.size() ? journalEntries_[first] : journal_->size());
+	journalEntries_.resize(first);
+	std::string data;
+	for (auto i = first; i < history_.size(); ++i)
+	{
+		auto instance = history_[i].value<CommandInstancePtr>();
+		data.clear();
+		if (!cmdMgrImpl_.serializeEntry(*instance, data))
+		{
+			NGT_WARNING_MSG("Failed to journal command %s\n", instance->getCommandId());
+			data.clear();
+		}
+		// An empty entry keeps the journal aligned, and is skipped on restore
+		journalEntries_.push_back(journal_->size());
+		journal_->append(data.data(), data.size());
+	}
+}
+
+/**
+ *	Selects the journal entry of the history entry at index.
+ */
+void HistoryEnvComponentState::journalSelect(int index)
+{
+	if (journal_ == nullptr)
+	{
+		return;
+	}
+
+	TF_ASSERT(index < static_cast<int>(journalEntries_.size()));
+	journal_->select(index < 0 ? NO_SELECTION : static_cast<int>(journalEntries_[index]));
+}
+
+/**
+ *	Removes the journal entries of the history entries that were at the
+ *	sorted indices in removed.
+ */
+void HistoryEnvComponentState::journalRemove(const std::vector<size_t>& removed)
+{
+	if (journal_ == nullptr)
+	{
+		return;
+	}
+
+	std::vector<size_t> entries;
+	entries.reserve(removed.size());
+	for (auto index : removed)
+	{
+		TF_ASSERT(index < journalEntries_.size());
+		entries.push_back(journalEntries_[index]);
+	}
+	journal_->remove(entries);
+
+	// Entries after a removed one move down
+	std::vector<size_t> remaining;
+	remaining.reserve(journalEntries_.size() - removed.size());
+	auto next = removed.begin();
+	for (size_t i = 0; i < journalEntries_.size(); ++i)
+	{
+		if (next != removed.end() && *next == i)
+		{
+			++next;
+			continue;
+		}
+		auto entry = journalEntries_[i];
+		remaining.push_back(entry - (std::lower_bound(entries.begin(), entries.end(), entry) - entries.begin()));
+	}
+	journalEntries_.swap(remaining);
+}
+
+/**
+ *	Nothing calls this yet, journals are opened with CommandManager::openHistoryJournal
+ *	instead. It is kept so that saved environments can reopen their journal.
+ */
 void HistoryEnvComponentState::saveState(IDataStream& stream)
 {
+	// The journal already holds the history, so only where to find it is saved
+	BinaryStream binaryStream(stream);
+	if (journal_ != nullptr)
+	{
+		journal_->sync();
+	}
+	binaryStream << journalPath_;
 }
 
 void HistoryEnvComponentState::loadState(IDataStream& stream)
 {
+	BinaryStream binaryStream(stream);
+	std::string path;
+	binaryStream >> path;
+	if (binaryStream.good() && !path.empty())
+	{
+		openJournal(path.c_str());
+	}
 }
 
 }
@@ -1294,6 +1726,20 @@ IDefinitionManager& CommandManager::getDefManager() const
 	return *defManager_;
 }
 
+//==============================================================================
+bool CommandManager::openHistoryJournal(const char* path)
+{
+	auto lockedState = pImpl_->getActiveStateT();
+	return pImpl_->openHistoryJournal(lockedState, path);
+}
+
+//==============================================================================
+void CommandManager::closeHistoryJournal()
+{
+	auto lockedState = pImpl_->getActiveStateT();
+	pImpl_->closeHistoryJournal(lockedState);
+}
+
 //==============================================================================
 ISelectionContext& CommandManager::selectionContext()
 {
@@ -89,6 +89,15 @@ public:
 
 	IDefinitionManager& getDefManager() const;
 
+	/**
+	 *	Mirrors the active history in an append-only journal at path, so that it
+	 *	survives a restart. An existing journal replaces the current history
+	 *	with its most recent entries.
+	 *	@return false if the journal cannot be opened.
+	 */
+	bool openHistoryJournal(const char* path);
+	void closeHistoryJournal();
+
 private:
 	friend UndoRedoCommand;
 	void addToHistory(const CommandInstancePtr& instance);
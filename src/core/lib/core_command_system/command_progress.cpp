@@ -0,0 +1,225 @@
+#include "command_progress.hpp"
+
+#include <algorithm>
+
+namespace wgt
+{
+namespace
+{
+// Fixed point scale for the published fraction, exactly representable as a float
+const double FRACTION_SCALE = double(1 << 24);
+
+thread_local CommandProgress* s_CurrentProgress = nullptr;
+
+// Weight given to the newest rate sample when smoothing the estimate
+const double RATE_SMOOTHING = 0.2;
+}
+
+const std::chrono::milliseconds CommandProgress::SAMPLE_INTERVAL(33);
+
+//==============================================================================
+CommandProgress::CommandProgress() : labelPending_(false), fraction_(0), sequence_(0), started_(false), labelSequence_(0)
+{
+}
+
+//------------------------------------------------------------------------------
+void CommandProgress::beginTask(uint32_t steps, uint32_t weight)
+{
+	Task task;
+	task.steps_ = std::max<uint32_t>(steps, 1);
+	task.done_ = 0;
+	if (tasks_.empty())
+	{
+		task.begin_ = 0.0;
+		task.span_ = 1.0;
+		task.weight_ = 0;
+	}
+	else
+	{
+		const auto& parent = tasks_.back();
+		const auto stepSpan = parent.span_ / parent.steps_;
+		task.weight_ = std::min(weight, parent.steps_ - std::min(parent.done_, parent.steps_));
+		task.begin_ = parent.begin_ + stepSpan * parent.done_;
+		task.span_ = stepSpan * task.weight_;
+	}
+	tasks_.push_back(task);
+	if (!started_.exchange(true, std::memory_order_relaxed))
+	{
+		sequence_.fetch_add(1, std::memory_order_release);
+	}
+	publish();
+}
+
+//------------------------------------------------------------------------------
+void CommandProgress::step(uint32_t count)
+{
+	if (tasks_.empty())
+	{
+		return;
+	}
+	auto& task = tasks_.back();
+	task.done_ = std::min(task.done_ + count, task.steps_);
+	publish();
+}
+
+//------------------------------------------------------------------------------
+void CommandProgress::endTask()
+{
+	if (tasks_.empty())
+	{
+		return;
+	}
+	const auto weight = tasks_.back().weight_;
+	tasks_.pop_back();
+	if (tasks_.empty())
+	{
+		fraction_.store(static_cast<uint32_t>(FRACTION_SCALE), std::memory_order_relaxed);
+		sequence_.fetch_add(1, std::memory_order_release);
+		return;
+	}
+	step(weight);
+}
+
+//------------------------------------------------------------------------------
+void CommandProgress::setLabel(const char* label)
+{
+	pendingLabel_ = label != nullptr ? label : "";
+	labelPending_ = true;
+	publishLabel();
+}
+
+//------------------------------------------------------------------------------
+CommandProgress* CommandProgress::current()
+{
+	return s_CurrentProgress;
+}
+
+//------------------------------------------------------------------------------
+CommandProgress::Sample CommandProgress::sample() const
+{
+	Sample sample;
+	sample.sequence_ = sequence_.load(std::memory_order_acquire);
+	sample.fraction_ = static_cast<float>(fraction_.load(std::memory_order_relaxed) / FRACTION_SCALE);
+	sample.started_ = started_.load(std::memory_order_relaxed);
+	return sample;
+}
+
+//------------------------------------------------------------------------------
+bool CommandProgress::getLabel(uint32_t& io_Sequence, std::string& o_Label) const
+{
+	if (labelSequence_.load(std::memory_order_acquire) == io_Sequence)
+	{
+		return false;
+	}
+	std::lock_guard<std::mutex> guard(labelMutex_);
+	io_Sequence = labelSequence_.load(std::memory_order_relaxed);
+	o_Label = label_;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+void CommandProgress::reset()
+{
+	tasks_.clear();
+	fraction_.store(0, std::memory_order_relaxed);
+	started_.store(false, std::memory_order_relaxed);
+	sequence_.fetch_add(1, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+void CommandProgress::publish()
+{
+	const auto& task = tasks_.back();
+	const auto fraction = task.begin_ + task.span_ * task.done_ / task.steps_;
+	const auto value = static_cast<uint32_t>(std::min(fraction, 1.0) * FRACTION_SCALE);
+
+	// Skip the store when the change is below the published resolution to keep the cache line quiet
+	if (fraction_.load(std::memory_order_relaxed) != value)
+	{
+		fraction_.store(value, std::memory_order_relaxed);
+		sequence_.fetch_add(1, std::memory_order_release);
+	}
+
+	if (labelPending_)
+	{
+		publishLabel();
+	}
+}
+
+//------------------------------------------------------------------------------
+void CommandProgress::publishLabel()
+{
+	// A reader is copying the label, try again on the next update instead of waiting
+	std::unique_lock<std::mutex> lock(labelMutex_, std::try_to_lock);
+	if (!lock.owns_lock())
+	{
+		return;
+	}
+	label_.swap(pendingLabel_);
+	labelPending_ = false;
+	labelSequence_.fetch_add(1, std::memory_order_release);
+}
+
+//==============================================================================
+CommandProgressScope::CommandProgressScope(CommandProgress& progress) : previous_(s_CurrentProgress)
+{
+	s_CurrentProgress = &progress;
+}
+
+//------------------------------------------------------------------------------
+CommandProgressScope::~CommandProgressScope()
+{
+	s_CurrentProgress = previous_;
+}
+
+//==============================================================================
+ProgressEstimator::ProgressEstimator()
+{
+	reset();
+}
+
+//------------------------------------------------------------------------------
+void ProgressEstimator::reset(Clock::time_point now)
+{
+	start_ = now;
+	sequence_ = 0;
+	fraction_ = 0.0f;
+	rate_ = 0.0;
+	remaining_ = -1.0;
+}
+
+//------------------------------------------------------------------------------
+bool ProgressEstimator::update(const CommandProgress::Sample& sample, Clock::time_point now)
+{
+	if (sample.sequence_ == sequence_)
+	{
+		return false;
+	}
+	sequence_ = sample.sequence_;
+	fraction_ = sample.fraction_;
+
+	const auto elapsed = std::chrono::duration<double>(now - start_).count();
+	if (fraction_ <= 0.0f || elapsed <= 0.0)
+	{
+		return true;
+	}
+
+	// Blend the average rate into the estimate so a single slow step does not make it jump
+	const auto averageRate = fraction_ / elapsed;
+	rate_ = rate_ > 0.0 ? rate_ + RATE_SMOOTHING * (averageRate - rate_) : averageRate;
+	remaining_ = (1.0 - fraction_) / rate_;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+float ProgressEstimator::getFraction() const
+{
+	return fraction_;
+}
+
+//------------------------------------------------------------------------------
+double ProgressEstimator::getRemainingSeconds() const
+{
+	return remaining_;
+}
+} // end namespace wgt
@@ -0,0 +1,133 @@
+#ifndef COMMAND_PROGRESS_HPP
+#define COMMAND_PROGRESS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace wgt
+{
+//==============================================================================
+/**
+* Progress channel between a running command and the UI.
+*
+* The command thread publishes into atomic slots and never waits on the UI;
+* the UI samples the channel at its own rate (see ProgressEstimator).
+* Work is described as a stack of tasks: a task is split into steps, and a
+* sub-task pushed while it runs covers a number of its parent's steps, so
+* nested importers report a single monotonic fraction.
+*
+* Only the thread executing the command may call the publishing methods.
+*/
+class CommandProgress
+{
+public:
+	/** How often listeners are notified while waiting on a command. */
+	static const std::chrono::milliseconds SAMPLE_INTERVAL;
+
+	struct Sample
+	{
+		float fraction_;
+		uint32_t sequence_;
+		bool started_;
+	};
+
+	CommandProgress();
+
+	/**
+	* Starts a task split into steps.
+	* @param steps number of steps the task is split into.
+	* @param weight number of the parent task's steps this task covers, ignored for the outermost task.
+	*/
+	void beginTask(uint32_t steps, uint32_t weight = 1);
+	void step(uint32_t count = 1);
+	/** Completes the current task, advancing its parent by the task's weight. */
+	void endTask();
+
+	/** Publishes a description of the current work, dropped rather than waiting on a reader. */
+	void setLabel(const char* label);
+
+	/** Progress published by the thread currently executing a command, or nullptr. */
+	static CommandProgress* current();
+
+	Sample sample() const;
+	/** Copies the label if it changed since the sequence last seen. */
+	bool getLabel(uint32_t& io_Sequence, std::string& o_Label) const;
+
+	void reset();
+
+private:
+	friend class CommandProgressScope;
+
+	struct Task
+	{
+		double begin_;
+		double span_;
+		uint32_t steps_;
+		uint32_t done_;
+		uint32_t weight_;
+	};
+
+	void publish();
+	void publishLabel();
+
+	// Owned by the command thread
+	std::vector<Task> tasks_;
+	std::string pendingLabel_;
+	bool labelPending_;
+
+	std::atomic<uint32_t> fraction_;
+	std::atomic<uint32_t> sequence_;
+	std::atomic<bool> started_;
+
+	mutable std::mutex labelMutex_;
+	std::string label_;
+	std::atomic<uint32_t> labelSequence_;
+};
+
+//==============================================================================
+/** Makes a command's progress the current one for the executing thread. */
+class CommandProgressScope
+{
+public:
+	explicit CommandProgressScope(CommandProgress& progress);
+	~CommandProgressScope();
+
+private:
+	CommandProgress* previous_;
+};
+
+//==============================================================================
+/**
+* UI side of a CommandProgress.
+* Turns fixed rate samples into a smoothed estimate of the remaining time.
+*/
+class ProgressEstimator
+{
+public:
+	typedef std::chrono::steady_clock Clock;
+
+	ProgressEstimator();
+
+	void reset(Clock::time_point now = Clock::now());
+
+	/** Feeds a sample, returning false if nothing was published since the previous one. */
+	bool update(const CommandProgress::Sample& sample, Clock::time_point now = Clock::now());
+
+	float getFraction() const;
+
+	/** Estimated seconds remaining, or a negative value while there is too little data. */
+	double getRemainingSeconds() const;
+
+private:
+	Clock::time_point start_;
+	uint32_t sequence_;
+	float fraction_;
+	double rate_;
+	double remaining_;
+};
+} // end namespace wgt
+#endif // COMMAND_PROGRESS_HPP
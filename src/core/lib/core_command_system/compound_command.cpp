@@ -77,21 +77,41 @@ Variant CompoundCommand::execute(const ObjectHandle& arguments) const
 	subInstances_.clear();
 	subInstances_.reserve(subCommandHandles_.size());
 
+	// Each sub command is one step of the macro's progress
+	auto progress = CommandProgress::current();
+	if (progress != nullptr)
+	{
+		progress->beginTask(static_cast<uint32_t>(subCommandHandles_.size()));
+	}
+
+	auto errorCode = CommandErrorCode::COMMAND_NO_ERROR;
 	for (SubCommandHandles::size_type i = 0; i < subCommandHandles_.size(); ++i)
 	{
 		auto& subCommand = subCommandHandles_[i];
+		if (progress != nullptr)
+		{
+			progress->setLabel(subCommand.first.c_str());
+		}
 		auto instance = cmdSysProvider->queueCommand(subCommand.first.c_str(), subCommand.second);
 		TF_ASSERT(instance != nullptr);
 		cmdSysProvider->waitForInstance(instance);
-		auto errorCode = instance->getErrorCode();
+		errorCode = instance->getErrorCode();
 		if (errorCode != CommandErrorCode::COMMAND_NO_ERROR)
 		{
-			return errorCode;
+			break;
 		}
 		subInstances_.push_back(instance);
+		if (progress != nullptr)
+		{
+			progress->step();
+		}
 	}
 
-	return CommandErrorCode::COMMAND_NO_ERROR;
+	if (progress != nullptr)
+	{
+		progress->endTask();
+	}
+	return errorCode;
 }
 
 //==============================================================================
@@ -371,7 +371,7 @@ CommandDescription ReflectionUndoRedoData::getCommandDescription() const
 
 	// Create display object from cache
 	{
-		auto genericObject = GenericObject::create();
+		auto genericObject = GenericObject::createShaped();
 
 		// Single command
 		// or batch command of size 1
@@ -442,7 +442,7 @@ CommandDescription ReflectionUndoRedoData::getCommandDescription() const
 
 			for (const auto& helper : propertyCache)
 			{
-				auto childObject = GenericObject::create();
+				auto childObject = GenericObject::createShaped();
 
 				// TODO: Refactor this and the section above as they do the same thing.
 				childObject->set("Id", helper->objectId_);
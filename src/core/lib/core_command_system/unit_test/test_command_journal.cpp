@@ -0,0 +1,238 @@
+#include "pch.hpp"
+
+#include "core_command_system/command_journal.hpp"
+#include "core_command_system/command_instance.hpp"
+#include "core_command_system/command_manager.hpp"
+#include "core_reflection/property_accessor.hpp"
+#include "core_reflection_utils/reflection_controller.hpp"
+#include "test_objects.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace wgt
+{
+namespace
+{
+const char* s_journalPath = "test_command_journal.bin";
+const char* s_indexPath = "test_command_journal.bin.idx";
+
+void removeJournal()
+{
+	std::remove(s_journalPath);
+	std::remove(s_indexPath);
+}
+
+void appendEntries(CommandJournal& journal, int first, int count)
+{
+	for (int i = first; i < first + count; ++i)
+	{
+		auto entry = "entry" + std::to_string(i);
+		journal.append(entry.data(), entry.size());
+		journal.select(static_cast<int>(journal.size()) - 1);
+	}
+}
+
+std::string readEntry(const CommandJournal& journal, size_t index)
+{
+	std::string data;
+	return journal.read(index, data) ? data : std::string();
+}
+}
+
+//------------------------------------------------------------------------------
+TEST(command_journal_reopen)
+{
+	removeJournal();
+	{
+		CommandJournal journal;
+		CHECK(journal.open(s_journalPath));
+		CHECK_EQUAL(0, journal.size());
+		CHECK_EQUAL(-1, journal.selected());
+
+		appendEntries(journal, 0, 40);
+		journal.truncate(30);
+		journal.append("redo", 4);
+		journal.select(29);
+		CHECK_EQUAL(31, journal.size());
+		CHECK_EQUAL("entry5", readEntry(journal, 5));
+		CHECK_EQUAL("redo", readEntry(journal, 30));
+	}
+
+	// Records buffered when the journal closed are replayed on open
+	CommandJournal journal;
+	CHECK(journal.open(s_journalPath));
+	CHECK_EQUAL(31, journal.size());
+	CHECK_EQUAL(29, journal.selected());
+	CHECK_EQUAL("entry29", readEntry(journal, 29));
+	CHECK_EQUAL("redo", readEntry(journal, 30));
+	journal.close();
+	removeJournal();
+}
+
+//------------------------------------------------------------------------------
+TEST(command_journal_record_checksum)
+{
+	removeJournal();
+	{
+		CommandJournal journal;
+		CHECK(journal.open(s_journalPath));
+		journal.append("entry0", 6);
+		CHECK(journal.sync());
+	}
+
+	std::string contents;
+	{
+		std::ifstream file(s_journalPath, std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	removeJournal();
+
+	// Journals outlive the build that wrote them, so the checksum of a record must never change.
+	// The first record follows the 16 byte journal header: type, value, size, checksum, then the data.
+	RETURN_ON_FAIL_CHECK(contents.size() >= 16 + 24 + 6);
+	uint32_t type;
+	uint32_t value;
+	uint64_t size;
+	uint64_t checksum;
+	memcpy(&type, contents.data() + 16, sizeof(type));
+	memcpy(&value, contents.data() + 20, sizeof(value));
+	memcpy(&size, contents.data() + 24, sizeof(size));
+	memcpy(&checksum, contents.data() + 32, sizeof(checksum));
+	CHECK_EQUAL(1u, type);
+	CHECK_EQUAL(0u, value);
+	CHECK_EQUAL(6u, size);
+	CHECK_EQUAL(0x0A292E3C5AB639F7ULL, checksum);
+	CHECK_EQUAL("entry0", contents.substr(40, 6));
+}
+
+//------------------------------------------------------------------------------
+TEST(command_journal_torn_record)
+{
+	removeJournal();
+	{
+		CommandJournal journal;
+		CHECK(journal.open(s_journalPath));
+		appendEntries(journal, 0, 3);
+		CHECK(journal.sync());
+	}
+
+	// Lose the end of the last record, as if the process died while writing it
+	std::string contents;
+	{
+		std::ifstream file(s_journalPath, std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	std::remove(s_indexPath);
+	{
+		std::ofstream file(s_journalPath, std::ios::binary | std::ios::trunc);
+		file.write(contents.data(), contents.size() - 2);
+	}
+
+	CommandJournal journal;
+	CHECK(journal.open(s_journalPath));
+	CHECK_EQUAL(3, journal.size());
+	CHECK_EQUAL(1, journal.selected());
+	CHECK_EQUAL("entry2", readEntry(journal, 2));
+	journal.close();
+	removeJournal();
+}
+
+//------------------------------------------------------------------------------
+TEST(command_journal_remove_and_compact)
+{
+	removeJournal();
+	CommandJournal journal;
+	CHECK(journal.open(s_journalPath));
+	appendEntries(journal, 0, 10);
+	journal.select(8);
+
+	std::vector<size_t> removed = { 0, 1, 8 };
+	CHECK(journal.remove(removed));
+	CHECK_EQUAL(7, journal.size());
+	CHECK_EQUAL("entry2", readEntry(journal, 0));
+	// The selection moves to the closest entry before it that was kept
+	CHECK_EQUAL(5, journal.selected());
+
+	journal.truncate(2);
+	appendEntries(journal, 100, 2);
+	CHECK(journal.compact());
+	CHECK_EQUAL(4, journal.size());
+	CHECK_EQUAL("entry101", readEntry(journal, 3));
+	CHECK_EQUAL(3, journal.selected());
+
+	journal.close();
+	CHECK(journal.open(s_journalPath));
+	CHECK_EQUAL(4, journal.size());
+	CHECK_EQUAL("entry3", readEntry(journal, 1));
+	journal.close();
+	removeJournal();
+}
+
+//------------------------------------------------------------------------------
+TEST_F(TestCommandFixture, command_journal_history_round_trip)
+{
+	removeJournal();
+	auto& controller = getReflectionController();
+	auto& commandManager = static_cast<CommandManager&>(getCommandSystemProvider());
+
+	auto objHandle = ManagedObject<TestCommandObject>::make();
+	PropertyAccessor counter = klass_->bindProperty("counter", objHandle.getHandle());
+	CHECK(counter.isValid());
+	controller.setValue(counter, 1);
+	controller.setValue(counter, 2);
+
+	std::vector<std::string> commandIds;
+	auto& history = commandManager.getHistory();
+	for (auto it = history.begin(); it != history.end(); ++it)
+	{
+		commandIds.push_back((*it).value<CommandInstancePtr>()->getCommandId());
+	}
+	RETURN_ON_FAIL_CHECK(commandIds.size() == 2);
+
+	// Opening an empty journal writes the history to it
+	CHECK(commandManager.openHistoryJournal(s_journalPath));
+	commandManager.closeHistoryJournal();
+	{
+		CommandJournal journal;
+		CHECK(journal.open(s_journalPath));
+		CHECK_EQUAL(2, journal.size());
+		CHECK_EQUAL(1, journal.selected());
+		journal.append("unreadable", 10);
+		journal.select(2);
+	}
+
+	// Reopening it replaces the history with the entries read back
+	CHECK(commandManager.openHistoryJournal(s_journalPath));
+	RETURN_ON_FAIL_CHECK(history.size() == 2);
+	size_t i = 0;
+	for (auto it = history.begin(); it != history.end(); ++it)
+	{
+		auto instance = (*it).value<CommandInstancePtr>();
+		RETURN_ON_FAIL_CHECK(instance != nullptr);
+		CHECK_EQUAL(commandIds[i++], std::string(instance->getCommandId()));
+	}
+	CHECK(commandManager.canUndo());
+	CHECK(!commandManager.canRedo());
+	commandManager.closeHistoryJournal();
+
+	// Restoring skips the unreadable entry but leaves it in the journal
+	{
+		CommandJournal journal;
+		CHECK(journal.open(s_journalPath));
+		CHECK_EQUAL(3, journal.size());
+		CHECK_EQUAL("unreadable", readEntry(journal, 2));
+	}
+
+	// The undo data read back still applies
+	commandManager.undo();
+	int value = 0;
+	CHECK(controller.getValue(counter).tryCast(value));
+	CHECK_EQUAL(1, value);
+
+	removeJournal();
+}
+} // end namespace wgt
@@ -0,0 +1,141 @@
+#include "pch.hpp"
+
+#include "core_command_system/command_progress.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <thread>
+
+namespace wgt
+{
+namespace
+{
+bool closeTo(float actual, float expected)
+{
+	return std::fabs(actual - expected) < 1e-4f;
+}
+}
+
+//------------------------------------------------------------------------------
+TEST(command_progress_nested_tasks)
+{
+	CommandProgress progress;
+	CHECK(!progress.sample().started_);
+
+	// Four steps, the second of which is a sub-task covering two of them
+	progress.beginTask(4);
+	CHECK(progress.sample().started_);
+	progress.step();
+	CHECK(closeTo(progress.sample().fraction_, 0.25f));
+
+	progress.beginTask(10, 2);
+	progress.step(5);
+	CHECK(closeTo(progress.sample().fraction_, 0.5f));
+	progress.endTask();
+	CHECK(closeTo(progress.sample().fraction_, 0.75f));
+
+	// Over-reporting is clamped to the task
+	progress.step(10);
+	CHECK(closeTo(progress.sample().fraction_, 1.0f));
+	progress.endTask();
+	CHECK(closeTo(progress.sample().fraction_, 1.0f));
+
+	auto sequence = progress.sample().sequence_;
+	progress.reset();
+	CHECK(!progress.sample().started_);
+	CHECK(progress.sample().sequence_ != sequence);
+}
+
+//------------------------------------------------------------------------------
+TEST(command_progress_label_and_scope)
+{
+	CommandProgress progress;
+	CHECK(CommandProgress::current() == nullptr);
+	{
+		CommandProgressScope scope(progress);
+		CHECK(CommandProgress::current() == &progress);
+		CommandProgress::current()->setLabel("Importing terrain");
+	}
+	CHECK(CommandProgress::current() == nullptr);
+
+	uint32_t labelSequence = 0;
+	std::string label;
+	CHECK(progress.getLabel(labelSequence, label));
+	CHECK_EQUAL("Importing terrain", label);
+	CHECK(!progress.getLabel(labelSequence, label));
+}
+
+//------------------------------------------------------------------------------
+TEST(progress_estimator_remaining_time)
+{
+	typedef ProgressEstimator::Clock Clock;
+	CommandProgress progress;
+	ProgressEstimator estimator;
+	auto start = Clock::now();
+	estimator.reset(start);
+
+	progress.beginTask(100);
+	CHECK(estimator.update(progress.sample(), start));
+	CHECK(estimator.getRemainingSeconds() < 0.0);
+
+	progress.step(25);
+	CHECK(estimator.update(progress.sample(), start + std::chrono::seconds(1)));
+	CHECK(std::fabs(estimator.getRemainingSeconds() - 3.0) < 1e-3);
+
+	// Nothing new was published
+	CHECK(!estimator.update(progress.sample(), start + std::chrono::seconds(2)));
+
+	progress.step(25);
+	CHECK(estimator.update(progress.sample(), start + std::chrono::seconds(2)));
+	CHECK(closeTo(estimator.getFraction(), 0.5f));
+	CHECK(std::fabs(estimator.getRemainingSeconds() - 2.0) < 1e-3);
+}
+
+//------------------------------------------------------------------------------
+TEST(command_progress_concurrent_sampling)
+{
+	const uint32_t steps = 10000;
+	CommandProgress progress;
+	std::atomic<bool> done(false);
+	std::atomic<bool> monotonic(true);
+	std::thread sampler([&]() {
+		float last = 0.0f;
+		uint32_t labelSequence = 0;
+		std::string label;
+		while (!done)
+		{
+			// Test results are not thread safe, so only record what was seen here
+			auto sample = progress.sample();
+			if (sample.fraction_ < last)
+			{
+				monotonic = false;
+			}
+			last = sample.fraction_;
+			progress.getLabel(labelSequence, label);
+		}
+	});
+
+	progress.beginTask(steps);
+	for (uint32_t i = 0; i < steps; ++i)
+	{
+		progress.step();
+		if (i % 1000 == 0)
+		{
+			progress.setLabel("step");
+		}
+	}
+	progress.endTask();
+	done = true;
+	sampler.join();
+
+	CHECK(monotonic);
+	CHECK(closeTo(progress.sample().fraction_, 1.0f));
+
+	// A label that lost the try-lock to the sampler is published by a later step
+	uint32_t labelSequence = 0;
+	std::string label;
+	CHECK(progress.getLabel(labelSequence, label));
+	CHECK_EQUAL("step", label);
+}
+} // end namespace wgt
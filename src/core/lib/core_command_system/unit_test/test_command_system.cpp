@@ -272,6 +272,11 @@ TEST_F(TestCommandFixture, executeMacro)
 		CHECK(commandSystemProvider.getMacros().empty() == false);
 		CommandInstancePtr inst = commandSystemProvider.queueCommand("Macro1");
 		commandSystemProvider.waitForInstance(inst);
+
+		// The macro publishes a step per sub command
+		auto sample = inst->getProgress().sample();
+		CHECK(sample.started_);
+		CHECK_EQUAL(1.0f, sample.fraction_);
 		{
 			PropertyAccessor counter = klass_->bindProperty("counter", objHandle.getHandle());
 			int value = 0;
@@ -18,4 +18,58 @@ std::vector<std::string> AbstractItemModel::mimeTypes() const
 	return std::vector<std::string>();
 }
 
+//------------------------------------------------------------------------------
+void AbstractItemModel::getDataBlock(const DataBlock& block, Variant* o_Values) const
+{
+	for (int row = block.firstRow_; row < block.firstRow_ + block.rowCount_; ++row)
+	{
+		for (int column = block.firstColumn_; column < block.firstColumn_ + block.columnCount_; ++column)
+		{
+			auto pItem = item(ItemIndex(row, column, block.parent_));
+			block.setItem(row, column, pItem);
+			auto pValues = o_Values + block.offset(row, column, 0);
+			for (size_t role = 0; role < block.roleCount_; ++role)
+			{
+				pValues[role] = pItem != nullptr ? pItem->getData(row, column, block.roles_[role]) : Variant();
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void AbstractListModel::getDataBlock(const DataBlock& block, Variant* o_Values) const
+{
+	for (int row = block.firstRow_; row < block.firstRow_ + block.rowCount_; ++row)
+	{
+		auto pItem = block.parent_ == nullptr ? item(row) : nullptr;
+		for (int column = block.firstColumn_; column < block.firstColumn_ + block.columnCount_; ++column)
+		{
+			block.setItem(row, column, pItem);
+			auto pValues = o_Values + block.offset(row, column, 0);
+			for (size_t role = 0; role < block.roleCount_; ++role)
+			{
+				pValues[role] = pItem != nullptr ? pItem->getData(row, column, block.roles_[role]) : Variant();
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+void AbstractTreeModel::getDataBlock(const AbstractItemModel::DataBlock& block, Variant* o_Values) const
+{
+	for (int row = block.firstRow_; row < block.firstRow_ + block.rowCount_; ++row)
+	{
+		auto pItem = item(ItemIndex(row, block.parent_));
+		for (int column = block.firstColumn_; column < block.firstColumn_ + block.columnCount_; ++column)
+		{
+			block.setItem(row, column, pItem);
+			auto pValues = o_Values + block.offset(row, column, 0);
+			for (size_t role = 0; role < block.roleCount_; ++role)
+			{
+				pValues[role] = pItem != nullptr ? pItem->getData(row, column, block.roles_[role]) : Variant();
+			}
+		}
+	}
+}
+
 } // end namespace wgt
@@ -61,6 +61,65 @@ public:
 		const AbstractItem* parent_;
 	};
 
+	/** Describes a block of cells under one parent, and the roles to query for each cell.
+	Values for the block are laid out by row, then column, then role. */
+	struct DataBlock
+	{
+		DataBlock(const AbstractItem* parent, int firstRow, int rowCount, int firstColumn, int columnCount,
+		          const ItemRole::Id* roles, size_t roleCount)
+		    : parent_(parent), firstRow_(firstRow), rowCount_(rowCount), firstColumn_(firstColumn),
+		      columnCount_(columnCount), roles_(roles), roleCount_(roleCount), items_(nullptr)
+		{
+		}
+
+		/** Returns the number of values in the block. */
+		size_t size() const
+		{
+			return static_cast<size_t>(rowCount_) * static_cast<size_t>(columnCount_) * roleCount_;
+		}
+
+		/** Returns the position of a value in the block.
+		@param row The row of the cell, relative to the model, not the block.
+		@param column The column of the cell, relative to the model, not the block.
+		@param role The position of the role in roles_. */
+		size_t offset(int row, int column, size_t role) const
+		{
+			return (static_cast<size_t>(row - firstRow_) * static_cast<size_t>(columnCount_) +
+			        static_cast<size_t>(column - firstColumn_)) *
+			roleCount_ +
+			role;
+		}
+
+		/** Returns the position of a cell in items_.
+		@param row The row of the cell, relative to the model, not the block.
+		@param column The column of the cell, relative to the model, not the block. */
+		size_t itemOffset(int row, int column) const
+		{
+			return static_cast<size_t>(row - firstRow_) * static_cast<size_t>(columnCount_) +
+			static_cast<size_t>(column - firstColumn_);
+		}
+
+		/** Sets the item of a cell if the caller asked for items. */
+		void setItem(int row, int column, const AbstractItem* item) const
+		{
+			if (items_ != nullptr)
+			{
+				items_[itemOffset(row, column)] = item;
+			}
+		}
+
+		const AbstractItem* parent_;
+		int firstRow_;
+		int rowCount_;
+		int firstColumn_;
+		int columnCount_;
+		const ItemRole::Id* roles_;
+		size_t roleCount_;
+		/** Optional buffer of rowCount_ * columnCount_ items, filled with the item of every cell
+		so callers need not look the cells up again. */
+		const AbstractItem** items_;
+	};
+
 	typedef void VoidSignature(void);
 	typedef std::function<VoidSignature> VoidCallback;
 
@@ -127,6 +186,22 @@ public:
 		return rowCount(item) > 0;
 	}
 
+	/** Gets the data of several roles for a block of cells in one call.
+	@note The default implementation looks up every cell with item() and calls getData for each role.
+	Models which can resolve their rows once for the whole block should override this.
+	@param block The cells and roles to query.
+	@param o_Values Buffer of at least block.size() values, filled in the order given by DataBlock::offset.
+	Cells without an item are left as empty Variants.
+	Implementations also fill block.items_ through DataBlock::setItem when it is set. */
+	virtual void getDataBlock(const DataBlock& block, Variant* o_Values) const;
+
+	/** Hints that a block of cells is about to be queried, e.g. the visible window of a virtualized view.
+	@note The default implementation does nothing.
+	@param block The cells and roles which will be queried. */
+	virtual void prefetchDataBlock(const DataBlock& block) const
+	{
+	}
+
 	/** Inserts new rows with default values at the specified position for the specified parent.
 	@note A nullptr parent implies the top level.
 	@note If successful, the pre and post signals need to be fired.
@@ -453,6 +528,10 @@ public:
 	@return The number of columns. */
 	virtual int columnCount() const = 0;
 
+	/** Gets the data of several roles for a block of cells, looking up each row's item once.
+	@see AbstractItemModel::getDataBlock */
+	void getDataBlock(const DataBlock& block, Variant* o_Values) const override;
+
 	/** Inserts new rows with default values at the specified position.
 	@note If successful, the pre and post signals need to be fired.
 	@param row Row position to insert at.
@@ -816,6 +895,10 @@ public:
 	@return The number of columns. */
 	virtual int columnCount() const = 0;
 
+	/** Gets the data of several roles for a block of cells, looking up each row's item once.
+	@see AbstractItemModel::getDataBlock */
+	void getDataBlock(const AbstractItemModel::DataBlock& block, Variant* o_Values) const override;
+
 	/** Inserts new columns at the specified position.
 	@note If successful, the pre and post signals need to be fired.
 	@param column Column position to insert at.
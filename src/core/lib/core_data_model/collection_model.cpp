@@ -7,6 +7,8 @@
 #include "core_variant/collection.hpp"
 #include "reflection/reflected_collection.hpp"
 
+#include <typeinfo>
+
 namespace wgt
 {
 ITEMROLE(key)
@@ -196,6 +198,65 @@ int CollectionModel::columnCount() const
 	return 1;
 }
 
+void CollectionModel::getDataBlock(const DataBlock& block, Variant* o_Values) const
+{
+	// CollectionItem::getData seeks from the start of the collection for every cell,
+	// so read plain CollectionItems with one iterator instead.
+	// Items created by derived models may provide other data and are asked directly.
+	const Variant valueType = collection_.valueType().getName();
+	const Variant keyType = collection_.keyType().getName();
+	auto it = collection_.begin();
+	int position = 0;
+	for (int row = block.firstRow_; row < block.firstRow_ + block.rowCount_; ++row)
+	{
+		auto pItem = block.parent_ == nullptr ? item(row) : nullptr;
+		const bool direct = pItem != nullptr && typeid(*pItem) == typeid(CollectionItem);
+		if (direct)
+		{
+			it += static_cast<size_t>(row - position);
+			position = row;
+		}
+
+		for (int column = block.firstColumn_; column < block.firstColumn_ + block.columnCount_; ++column)
+		{
+			block.setItem(row, column, pItem);
+			auto pValues = o_Values + block.offset(row, column, 0);
+			for (size_t role = 0; role < block.roleCount_; ++role)
+			{
+				const auto roleId = block.roles_[role];
+				if (pItem == nullptr)
+				{
+					pValues[role] = Variant();
+				}
+				else if (!direct)
+				{
+					pValues[role] = pItem->getData(row, column, roleId);
+				}
+				else if (roleId == ItemRole::valueTypeId)
+				{
+					pValues[role] = valueType;
+				}
+				else if (roleId == ItemRole::keyTypeId)
+				{
+					pValues[role] = keyType;
+				}
+				else if (roleId == ItemRole::valueId)
+				{
+					pValues[role] = it.value();
+				}
+				else if (roleId == ItemRole::keyId)
+				{
+					pValues[role] = it.key();
+				}
+				else
+				{
+					pValues[role] = Variant();
+				}
+			}
+		}
+	}
+}
+
 bool CollectionModel::insertRows(int row, int count) /* override */
 {
 	if (readonly())
@@ -36,6 +36,10 @@ public:
 	virtual int rowCount() const override;
 	virtual int columnCount() const override;
 
+	/** Reads the rows of the block in a single pass over the collection.
+	@see AbstractItemModel::getDataBlock */
+	virtual void getDataBlock(const DataBlock& block, Variant* o_Values) const override;
+
 	virtual bool insertRows(int row, int count) override;
 	virtual bool removeRows(int row, int count) override;
 
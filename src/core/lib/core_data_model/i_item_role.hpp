@@ -3,14 +3,14 @@
 
 #include "wg_types/hash_utilities.hpp"
 
-#define ITEMROLE(ROLE)                                   \
-	namespace ItemRole                                   \
-	{                                                    \
-	namespace                                            \
-	{                                                    \
-	const char* ROLE##Name = #ROLE;                      \
-	const Id ROLE##Id = ::wgt::ItemRole::compute(#ROLE); \
-	}                                                    \
+#define ITEMROLE(ROLE)                                               \
+	namespace ItemRole                                               \
+	{                                                                \
+	namespace                                                        \
+	{                                                                \
+	const char* ROLE##Name = #ROLE;                                  \
+	constexpr Id ROLE##Id = ::wgt::ItemRole::computeConstant(#ROLE); \
+	}                                                                \
 	}
 
 namespace wgt
@@ -20,11 +20,11 @@ namespace ItemRole
 // Wrap the ItemRole's hash into a type that allows use of a visualizer for debugging purposes
 struct Id
 {
-	Id() : hash_(0)
+	constexpr Id() : hash_(0)
 	{
 	}
 
-	Id(uint64_t hash) : hash_(hash)
+	constexpr Id(uint64_t hash) : hash_(hash)
 	{
 	}
 
@@ -108,6 +108,13 @@ inline ItemRole::Id compute(const char* roleName)
 {
 	return HashUtilities::compute(roleName);
 }
+
+/** Hashes a role name literal at compile time, matching compute. */
+template <size_t N>
+constexpr ItemRole::Id computeConstant(const char (&roleName)[N])
+{
+	return ItemRole::Id(HashUtilities::computeConstant(roleName));
+}
 }
 
 // DEPRECATED
@@ -4,6 +4,7 @@
 #include "core_reflection/property_accessor_listener.hpp"
 #include "core_reflection/interfaces/i_reflection_controller.hpp"
 #include "core_reflection/i_definition_manager.hpp"
+#include "core_reflection/ref_object_id.hpp"
 
 namespace wgt
 {
@@ -203,7 +204,7 @@ ReflectedCollection::ReflectedCollection(const PropertyAccessor& pa, IReflection
     : pa_(pa), listener_(new ReflectedCollectionDetails::ReflectedCollectionListener(*this)), controller_(controller)
 {
 	auto definitionManager = const_cast<IDefinitionManager*>(pa_.getDefinitionManager());
-	definitionManager->registerPropertyAccessorListener(listener_);
+	definitionManager->registerPropertyAccessorListener(listener_, pa_.getObject().id(), pa_.getFullPath());
 
 	reset();
 }
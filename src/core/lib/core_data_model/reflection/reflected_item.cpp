@@ -7,6 +7,7 @@
 #include "core_reflection/metadata/meta_impl.hpp"
 #include "core_reflection/i_definition_manager.hpp"
 #include "core_reflection/property_accessor.hpp"
+#include "core_reflection/ref_object_id.hpp"
 #include "core_reflection/utilities/object_handle_reflection_utils.hpp"
 
 namespace wgt
@@ -57,6 +58,35 @@ void ReflectedItem::setDefinitionManager(IDefinitionManager* definitionManager)
 	definitionManager_ = definitionManager;
 }
 
+std::shared_ptr<PropertyAccessorListener> ReflectedItem::getListener() const
+{
+	if (listener_ != nullptr)
+	{
+		return listener_;
+	}
+	if (parent_ != nullptr)
+	{
+		return parent_->getListener();
+	}
+	return nullptr;
+}
+
+void ReflectedItem::setListener(const std::shared_ptr<PropertyAccessorListener>& listener)
+{
+	listener_ = listener;
+}
+
+void ReflectedItem::listenTo(const ObjectHandle& object) const
+{
+	auto listener = getListener();
+	auto definitionManager = getDefinitionManager();
+	if (listener == nullptr || definitionManager == nullptr || !object.isValid())
+	{
+		return;
+	}
+	definitionManager->registerPropertyAccessorListener(listener, object.id());
+}
+
 bool ReflectedItem::EnumerateVisibleProperties(const PropertyCallback& callback) const
 {
 	auto object = getObject();
@@ -12,6 +12,7 @@ class IReflectionController;
 class ObjectHandle;
 class IDefinitionManager;
 class IBaseProperty;
+class PropertyAccessorListener;
 typedef std::shared_ptr<IBaseProperty> IBasePropertyPtr;
 
 /**
@@ -21,11 +22,11 @@ class ReflectedItem : public GenericTreeItem
 {
 public:
 	ReflectedItem(ReflectedItem* parent, const char* path)
-	    : parent_(parent), path_(path), controller_(nullptr), definitionManager_(nullptr)
+	    : parent_(parent), path_(path), controller_(nullptr), definitionManager_(nullptr), listener_(nullptr)
 	{
 	}
 	ReflectedItem(ReflectedItem* parent, const std::string& path)
-	    : parent_(parent), path_(path), controller_(nullptr), definitionManager_(nullptr)
+	    : parent_(parent), path_(path), controller_(nullptr), definitionManager_(nullptr), listener_(nullptr)
 	{
 	}
 	virtual ~ReflectedItem()
@@ -44,6 +45,13 @@ public:
 	void setController(IReflectionController* controller);
 	IDefinitionManager* getDefinitionManager() const;
 	void setDefinitionManager(IDefinitionManager* definitionManager);
+	std::shared_ptr<PropertyAccessorListener> getListener() const;
+	void setListener(const std::shared_ptr<PropertyAccessorListener>& listener);
+
+	/**
+	 *	Subscribe the listener of the tree to changes of an object shown under this item.
+	 */
+	void listenTo(const ObjectHandle& object) const;
 
 	// IItem
 	ThumbnailData getThumbnail(int column) const
@@ -73,6 +81,7 @@ protected:
 	std::string path_;
 	IReflectionController* controller_;
 	IDefinitionManager* definitionManager_;
+	std::shared_ptr<PropertyAccessorListener> listener_;
 
 	typedef std::function<bool(IBasePropertyPtr, const std::string&)> PropertyCallback;
 	bool EnumerateVisibleProperties(const PropertyCallback& callback) const;
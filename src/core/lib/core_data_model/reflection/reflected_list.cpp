@@ -4,6 +4,8 @@
 #include "core_reflection/property_accessor_listener.hpp"
 #include "core_reflection/definition_manager.hpp"
 #include "core_reflection/interfaces/i_class_definition_details.hpp"
+#include "core_reflection/object_handle.hpp"
+#include "core_reflection/ref_object_id.hpp"
 #include "core_data_model/i_item_role.hpp"
 
 namespace wgt
@@ -29,12 +31,38 @@ ReflectedList::ReflectedList(IDefinitionManager* defManager)
     : listener_(new ReflectedListListener(*this)), defManager_(defManager)
 {
 	setSource(Collection(data_));
-	defManager_->registerPropertyAccessorListener(listener_);
+
+	// Only the objects in the list are listened to, so the subscriptions follow its rows
+	subscriptionConnections_ += connectPostRowsInserted([this](int startRow, int count) { subscribe(startRow, count); });
+	subscriptionConnections_ += connectPostRowsRemoved([this](int, int) { resubscribe(); });
+	subscriptionConnections_ += connectPostModelReset([this]() { resubscribe(); });
+	subscribe(0, static_cast<int>(collection_.size()));
 }
 
 ReflectedList::~ReflectedList()
+{
+	subscriptionConnections_.clear();
+	defManager_->deregisterPropertyAccessorListener(listener_);
+}
+
+void ReflectedList::subscribe(int startRow, int count)
+{
+	auto it = collection_.begin();
+	it += startRow;
+	for (int i = 0; i < count && it != collection_.end(); ++i, ++it)
+	{
+		ObjectHandle object;
+		if (it.value().tryCast(object) && object.isValid())
+		{
+			defManager_->registerPropertyAccessorListener(listener_, object.id());
+		}
+	}
+}
+
+void ReflectedList::resubscribe()
 {
 	defManager_->deregisterPropertyAccessorListener(listener_);
+	subscribe(0, static_cast<int>(collection_.size()));
 }
 
 size_t ReflectedListListener::findIndex(const PropertyAccessor& accessor)
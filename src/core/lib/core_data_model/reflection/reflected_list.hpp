@@ -15,9 +15,13 @@ public:
 	virtual ~ReflectedList();
 
 private:
+	void subscribe(int startRow, int count);
+	void resubscribe();
+
 	std::shared_ptr<PropertyAccessorListener> listener_;
 	IDefinitionManager* defManager_;
 	std::vector<Variant> data_;
+	ConnectionHolder subscriptionConnections_;
 
 	friend class ReflectedListListener;
 };
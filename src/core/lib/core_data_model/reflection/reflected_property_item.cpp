@@ -543,6 +543,7 @@ GenericTreeItem* ReflectedPropertyItem::getChild(size_t index) const
 		return nullptr;
 	}
 	baseProvider = reflectedRoot(baseProvider, *getDefinitionManager());
+	listenTo(baseProvider);
 	child = new ReflectedObjectItem(baseProvider, const_cast<ReflectedPropertyItem*>(this));
 	child->hidden(true);
 	children_[index] = std::unique_ptr<ReflectedItem>(child);
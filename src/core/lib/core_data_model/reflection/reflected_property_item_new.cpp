@@ -738,6 +738,7 @@ ReflectedTreeItemNew* ReflectedPropertyItemNew::getChild(size_t index) const
 		return nullptr;
 	}
 	baseProvider = reflectedRoot(baseProvider, *pDefinitionManager);
+	getModel()->listenTo(baseProvider);
 	child = new ReflectedObjectItemNew(baseProvider, const_cast<ReflectedPropertyItemNew*>(this), index);
 	impl_->children_[index] = std::unique_ptr<ReflectedTreeItemNew>(child);
 	return child;
@@ -30,10 +30,12 @@ ReflectedTreeModel::ReflectedTreeModel(const ObjectHandle& object, IDefinitionMa
     : rootItem_(object), definitionManager_(definitionManager),
       listener_(new ReflectedTreeModelPropertyListener(rootItem_))
 {
-	definitionManager_.registerPropertyAccessorListener(listener_);
-
 	rootItem_.setController(controller);
 	rootItem_.setDefinitionManager(&definitionManager_);
+
+	// Nested objects subscribe the listener as their items are created
+	rootItem_.setListener(listener_);
+	rootItem_.listenTo(object);
 	addRootItem(&rootItem_);
 }
 
@@ -7,6 +7,7 @@
 #include "core_data_model/common_data_roles.hpp"
 
 #include "core_reflection/property_accessor_listener.hpp"
+#include "core_reflection/ref_object_id.hpp"
 
 #include <vector>
 
@@ -120,7 +121,11 @@ ReflectedTreeModelNew::Implementation::Implementation(const ReflectedTreeModelNe
     : rootItem_(new ReflectedObjectItemNew(object, model)),
       listener_(new ReflectedTreeModelPropertyListener(*rootItem_.get()))
 {
-	get<IDefinitionManager>()->registerPropertyAccessorListener(listener_);
+	// Nested objects are listened to as their items are created
+	if (object.isValid())
+	{
+		get<IDefinitionManager>()->registerPropertyAccessorListener(listener_, object.id());
+	}
 }
 
 ReflectedTreeModelNew::Implementation::~Implementation()
@@ -187,6 +192,14 @@ ReflectedTreeModelNew::~ReflectedTreeModelNew()
 {
 }
 
+void ReflectedTreeModelNew::listenTo(const ObjectHandle& object) const
+{
+	if (object.isValid())
+	{
+		impl_->get<IDefinitionManager>()->registerPropertyAccessorListener(impl_->listener_, object.id());
+	}
+}
+
 AbstractItem* ReflectedTreeModelNew::item(const AbstractTreeModel::ItemIndex& index) const /* override */
 {
 	auto reflectedParent = dynamic_cast<const ReflectedTreeItemNew*>(index.parent_);
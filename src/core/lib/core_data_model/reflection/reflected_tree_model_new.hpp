@@ -100,6 +100,9 @@ public:
 private:
 	friend class ReflectedPropertyItemNew;
 
+	/** Listens to changes of an object shown in the tree. */
+	void listenTo(const ObjectHandle& object) const;
+
 	Signal<AbstractTreeModel::DataSignature> preItemDataChanged_;
 	Signal<AbstractTreeModel::DataSignature> postItemDataChanged_;
 
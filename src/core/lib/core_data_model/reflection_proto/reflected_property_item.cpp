@@ -21,6 +21,9 @@
 #include "core_reflection/base_property.hpp"
 #include "core_reflection/interfaces/i_property_path.hpp"
 
+#include <algorithm>
+#include <atomic>
+
 namespace wgt
 {
 ITEMROLE(path)
@@ -148,11 +151,40 @@ Variant getMinValue(const TypeId& typeId)
 {
 	return getValuePair(typeId).minValue_;
 }
+
+std::atomic<uint64_t> s_AccessorBinds(0);
+std::atomic<uint64_t> s_RoleHits(0);
+std::atomic<uint64_t> s_RoleMisses(0);
+
+// Roles which only depend on the property's path, metadata and value.
+// Anything depending on other properties, such as readOnly callbacks, is always queried,
+// as is the display name when metadata provides it.
+bool isCachedRole(ItemRole::Id roleId)
+{
+	static const std::vector<ItemRole::Id> s_CachedRoles = []() {
+		std::vector<ItemRole::Id> roles = {
+			ItemRole::displayId, ItemRole::pathId, ItemRole::fullPathId, ItemRole::indexPathId,
+			ItemRole::valueId, ValueRole::roleId_, ItemRole::valueTypeId, ValueTypeRole::roleId_,
+			ItemRole::isCollectionId, ItemRole::elementValueTypeId, ItemRole::elementKeyTypeId,
+			ItemRole::nameId, ItemRole::componentTypeId, ItemRole::staticStringId,
+			ItemRole::minMappedValueId, ItemRole::maxMappedValueId, ItemRole::collectionIndexId,
+			IsEnumRole::roleId_, IsThumbnailRole::roleId_, IsSliderRole::roleId_, IsColorRole::roleId_,
+			IsActionRole::roleId_, IsUrlRole::roleId_, DescriptionRole::roleId_, MinValueRole::roleId_,
+			MaxValueRole::roleId_, StepSizeRole::roleId_, DecimalsRole::roleId_, UrlIsAssetBrowserRole::roleId_,
+			UrlDialogTitleRole::roleId_, UrlDialogDefaultFolderRole::roleId_, UrlDialogNameFiltersRole::roleId_,
+			UrlDialogSelectedNameFilterRole::roleId_
+		};
+		std::sort(roles.begin(), roles.end());
+		return roles;
+	}();
+	return std::binary_search(s_CachedRoles.begin(), s_CachedRoles.end(), roleId);
+}
 }
 namespace proto
 {
 ReflectedPropertyItem::ReflectedPropertyItem(const ReflectedTreeModel& model, const std::shared_ptr< const IPropertyPath > & path, bool recordHistory)
-    : model_(model), path_(path), recordHistory_(recordHistory)
+    : model_(model), path_(path), recordHistory_(recordHistory), accessorDefinition_(nullptr), accessorBound_(false),
+      displayChecked_(false), displayCached_(false)
 {
 	auto rootObject = model_.getObject();
 	std::shared_ptr<ObjectReference> rootReference = std::dynamic_pointer_cast<ObjectReference>(rootObject.storage());
@@ -181,6 +213,45 @@ const std::shared_ptr< const IPropertyPath > & ReflectedPropertyItem::getPath()
 void ReflectedPropertyItem::setPath(const std::shared_ptr< const IPropertyPath >& path)
 {
 	path_ = path;
+	invalidateCache();
+}
+
+void ReflectedPropertyItem::invalidateCache() const
+{
+	accessorBound_ = false;
+	propertyAccessor_ = PropertyAccessor();
+	displayChecked_ = false;
+	roleCache_.clear();
+}
+
+ReflectedPropertyItem::CacheStatistics ReflectedPropertyItem::getCacheStatistics()
+{
+	CacheStatistics statistics = { s_AccessorBinds.load(), s_RoleHits.load(), s_RoleMisses.load() };
+	return statistics;
+}
+
+void ReflectedPropertyItem::resetCacheStatistics()
+{
+	s_AccessorBinds = 0;
+	s_RoleHits = 0;
+	s_RoleMisses = 0;
+}
+
+const PropertyAccessor& ReflectedPropertyItem::getPropertyAccessor(IClassDefinition* definition) const
+{
+	if (definition != accessorDefinition_)
+	{
+		invalidateCache();
+		accessorDefinition_ = definition;
+	}
+
+	if (!accessorBound_)
+	{
+		propertyAccessor_ = definition->bindProperty(path_, model_.getObject());
+		accessorBound_ = true;
+		++s_AccessorBinds;
+	}
+	return propertyAccessor_;
 }
 
 const std::string ReflectedPropertyItem::getPathName() const
@@ -261,7 +332,57 @@ Variant ReflectedPropertyItem::getData(int column, ItemRole::Id roleId) const
 		return Variant();
 	}
 
-	auto propertyAccessor = definition->bindProperty(path_, object);
+	// Bind first so that a change of definition drops the cached roles
+	getPropertyAccessor(definition);
+	if (column != 0 || !isCachedRole(roleId) ||
+	    (roleId == ItemRole::displayId && !isDisplayCached(*pDefinitionManager, definition)))
+	{
+		return getRoleData(column, roleId, pDefinitionManager, definition);
+	}
+
+	auto cached = std::find_if(roleCache_.begin(), roleCache_.end(),
+	                           [roleId](const std::pair<ItemRole::Id, Variant>& entry) { return entry.first == roleId; });
+	if (cached != roleCache_.end())
+	{
+		++s_RoleHits;
+		return cached->second;
+	}
+
+	++s_RoleMisses;
+	auto value = getRoleData(column, roleId, pDefinitionManager, definition);
+	roleCache_.emplace_back(roleId, value);
+	return value;
+}
+
+bool ReflectedPropertyItem::isDisplayCached(IDefinitionManager& definitionManager, IClassDefinition* definition) const
+{
+	if (displayChecked_)
+	{
+		return displayCached_;
+	}
+
+	// Display names from metadata are read from callbacks or other properties,
+	// only the path name can be kept
+	const auto& propertyAccessor = getPropertyAccessor(definition);
+	displayChecked_ = true;
+	displayCached_ = findFirstMetaData<MetaDisplayPathNameCallbackObj>(propertyAccessor, definitionManager) == nullptr &&
+	    findFirstMetaData<MetaDisplayNameObj>(propertyAccessor, definitionManager) == nullptr &&
+	    findFirstMetaData<MetaAttributeDisplayNameObj>(propertyAccessor, definitionManager) == nullptr;
+
+	ObjectHandle object;
+	if (displayCached_ && propertyAccessor.getValue().tryCast(object))
+	{
+		auto valueDefinition = definitionManager.getObjectDefinition(object);
+		displayCached_ = valueDefinition == nullptr ||
+		    findFirstMetaData<MetaAttributeDisplayNameObj>(*valueDefinition, definitionManager) == nullptr;
+	}
+	return displayCached_;
+}
+
+Variant ReflectedPropertyItem::getRoleData(int column, ItemRole::Id roleId, IDefinitionManager* pDefinitionManager,
+                                           IClassDefinition* definition) const
+{
+	const auto& propertyAccessor = getPropertyAccessor(definition);
 
 	if (roleId == ItemRole::displayId)
 	{
@@ -304,9 +425,7 @@ Variant ReflectedPropertyItem::getData(int column, ItemRole::Id roleId) const
 			}
 			if (attrDisplayName != nullptr)
 			{
-				propertyAccessor = definition->bindProperty(
-					attrDisplayName->getAttributeName(), object);
-				return propertyAccessor.getValue();
+				return definition->bindProperty(attrDisplayName->getAttributeName(), object).getValue();
 			}
 
 			return getPathName().c_str();
@@ -965,7 +1084,8 @@ bool ReflectedPropertyItem::setData(int column, ItemRole::Id roleId, const Varia
 		return false;
 	}
 
-	auto propertyAccessor = definition->bindProperty(path_, object);
+	// Copy the accessor, setting the value invalidates the cached one
+	auto propertyAccessor = getPropertyAccessor(definition);
 
 	if (roleId == ValueRole::roleId_)
 	{
@@ -3,8 +3,12 @@
 
 #include "core_data_model/abstract_item_model.hpp"
 #include "core_reflection/object_handle.hpp"
+#include "core_reflection/property_accessor.hpp"
 #include "core_dependency_system/depends.hpp"
 
+#include <utility>
+#include <vector>
+
 namespace wgt
 {
 class IDefinitionManager;
@@ -35,7 +39,25 @@ public:
 		return true;
 	}
 
+	/** Drops the bound accessor and the cached role values.
+	Called by the model when this property, or a property above or below it, has changed. */
+	void invalidateCache() const;
+
+	/** Counters shared by all items, for checking the hit rate of the role cache. */
+	struct CacheStatistics
+	{
+		uint64_t accessorBinds_;
+		uint64_t roleHits_;
+		uint64_t roleMisses_;
+	};
+	static CacheStatistics getCacheStatistics();
+	static void resetCacheStatistics();
+
 private:
+	const PropertyAccessor& getPropertyAccessor(IClassDefinition* definition) const;
+	Variant getRoleData(int column, ItemRole::Id roleId, IDefinitionManager* pDefinitionManager,
+	                    IClassDefinition* definition) const;
+	bool isDisplayCached(IDefinitionManager& definitionManager, IClassDefinition* definition) const;
 	const std::string getPathName() const;
 	bool isReadOnly(const PropertyAccessor& propertyAccessor) const;
 	PropertyAccessor parentCollectionPropertyAccessor(const PropertyAccessor& propertyAccessor, IClassDefinition* definition) const;
@@ -48,6 +70,15 @@ private:
 	mutable std::unique_ptr<AbstractListModel> enumModel_;
 	mutable std::unique_ptr<AbstractListModel> definitionModel_;
 
+	// The accessor is bound against the definition of the model's object,
+	// so a different definition for the same object also drops the cache
+	mutable const IClassDefinition* accessorDefinition_;
+	mutable PropertyAccessor propertyAccessor_;
+	mutable bool accessorBound_;
+	mutable bool displayChecked_;
+	mutable bool displayCached_;
+	mutable std::vector<std::pair<ItemRole::Id, Variant>> roleCache_;
+
 	// TEMP
 public:
 	ObjectHandle objectReference_;
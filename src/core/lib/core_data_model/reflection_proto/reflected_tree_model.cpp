@@ -2,6 +2,7 @@
 
 #include "core_common/assert.hpp"
 #include "core_reflection/i_definition_manager.hpp"
+#include "core_reflection/interfaces/i_class_definition.hpp"
 #include "core_data_model/i_item_role.hpp"
 #include "core_data_model/common_data_roles.hpp"
 #include "core_variant/collection.hpp"
@@ -19,6 +20,8 @@
 #include "core_common/scoped_stop_watch.hpp"
 #include "core_reflection/interfaces/i_property_path.hpp"
 #include "core_reflection/reflection_batch_query.hpp"
+#include "core_reflection/ref_object_id.hpp"
+#include "wg_types/shared_string.hpp"
 #include <algorithm>
 
 
@@ -123,6 +126,25 @@ bool isVectorType(const Variant& value)
 	return isVectorType(value.type());
 }
 
+/**
+ *	Check if one property path contains the other, e.g. "a.b" and "a.b[0].c".
+ */
+bool isRelatedPath(const std::string& lhs, const std::string& rhs)
+{
+	const auto& shorter = lhs.size() < rhs.size() ? lhs : rhs;
+	const auto& longer = lhs.size() < rhs.size() ? rhs : lhs;
+	if (longer.compare(0, shorter.size(), shorter) != 0)
+	{
+		return false;
+	}
+	if (shorter.empty() || longer.size() == shorter.size())
+	{
+		return true;
+	}
+	const auto next = longer[shorter.size()];
+	return next == IClassDefinition::DOT_OPERATOR || next == Collection::getIndexOpen();
+}
+
 }
 
 namespace proto
@@ -222,6 +244,7 @@ public:
 		{
 			return;
 		}
+		model_.invalidateProperty(property);
 
 		auto definitionManager = get<IDefinitionManager>();
 		const TypeId typeId = accessor.getType();
@@ -292,6 +315,16 @@ public:
 		}
 	}
 
+	virtual void postInvoke(const PropertyAccessor& accessor, Variant result, bool undo) override
+	{
+		// Methods can change any property of the object
+		if (accessor.getRootObject() == model_.getObject() ||
+		    model_.findProperty(accessor.getRootObject(), accessor.getFullPath()) != nullptr)
+		{
+			model_.invalidateProperties();
+		}
+	}
+
 	virtual void preInsert(const PropertyAccessor& accessor, size_t index, size_t count) override
 	{
 		auto item = model_.findProperty(accessor.getRootObject(), accessor.getFullPath());
@@ -324,6 +357,7 @@ public:
 		{
 			return;
 		}
+		model_.invalidateProperty(item);
 
 		auto propertiesIt = model_.properties_.find(item);
 		if (propertiesIt == model_.properties_.end())
@@ -429,6 +463,7 @@ public:
 		{
 			return;
 		}
+		model_.invalidateProperty(item);
 
 		auto propertiesIt = model_.properties_.find(item);
 		if (propertiesIt == model_.properties_.end())
@@ -503,9 +538,7 @@ private:
 ReflectedTreeModel::ReflectedTreeModel(const ObjectHandle& object)
     : recordHistory_(true), listener_(new ReflectedTreeModelPropertyListener(*this))
 {
-	auto definitionManager = get<IDefinitionManager>();
-	TF_ASSERT(definitionManager != nullptr);
-	definitionManager->registerPropertyAccessorListener(listener_);
+	TF_ASSERT(get<IDefinitionManager>() != nullptr);
 
 	auto rootMapping = new ItemMapping();
 	mappedItems_.insert(std::make_pair(nullptr, std::unique_ptr<ItemMapping>(rootMapping)));
@@ -536,6 +569,21 @@ void ReflectedTreeModel::setObject(const ObjectHandle& object)
 	preModelReset_();
 
 	unmapItem(nullptr);
+
+	// Properties are found through the root object, including those of nested objects
+	auto definitionManager = get<IDefinitionManager>();
+	if (definitionManager != nullptr)
+	{
+		if (object_.isValid())
+		{
+			definitionManager->deregisterPropertyAccessorListener(listener_, object_.id());
+		}
+		if (object.isValid())
+		{
+			definitionManager->registerPropertyAccessorListener(listener_, object.id());
+		}
+	}
+
 	object_ = object;
 	modelChanged_();
 
@@ -1063,6 +1111,27 @@ AbstractItem* ReflectedTreeModel::item(const ItemIndex& index) const
 	return const_cast<AbstractItem*>(item);
 }
 
+void ReflectedTreeModel::getDataBlock(const AbstractItemModel::DataBlock& block, Variant* o_Values) const
+{
+	// Map the parent once for the whole block rather than once per cell
+	auto parentMapping = const_cast<ReflectedTreeModel*>(this)->mapItem(block.parent_);
+	const auto children = parentMapping->children_.get();
+	const int childCount = children != nullptr ? static_cast<int>(children->size()) : 0;
+	for (int row = block.firstRow_; row < block.firstRow_ + block.rowCount_; ++row)
+	{
+		auto item = row >= 0 && row < childCount ? children->at(row) : nullptr;
+		for (int column = block.firstColumn_; column < block.firstColumn_ + block.columnCount_; ++column)
+		{
+			block.setItem(row, column, item);
+			auto pValues = o_Values + block.offset(row, column, 0);
+			for (size_t role = 0; role < block.roleCount_; ++role)
+			{
+				pValues[role] = item != nullptr ? item->getData(row, column, block.roles_[role]) : Variant();
+			}
+		}
+	}
+}
+
 AbstractTreeModel::ItemIndex ReflectedTreeModel::index(const AbstractItem* item) const
 {
 	if (item == nullptr)
@@ -1383,6 +1452,14 @@ const ReflectedPropertyItem* ReflectedTreeModel::findProperty(const ObjectHandle
 		return nullptr;
 	}
 
+	// Property paths are interned, so a path which was never interned cannot match
+	auto pathEntry = StringPool::find(path);
+	if (pathEntry == nullptr)
+	{
+		return nullptr;
+	}
+	const SharedString recursivePath(pathEntry);
+
 	for (auto propertiesIt = properties_.begin(); propertiesIt != properties_.end(); ++propertiesIt)
 	{
 		auto& properties = propertiesIt->second;
@@ -1394,7 +1471,7 @@ const ReflectedPropertyItem* ReflectedTreeModel::findProperty(const ObjectHandle
 				continue;
 			}
 
-			if (*property->getPath() == path)
+			if (*property->getPath() == recursivePath)
 			{
 				return property;
 			}
@@ -1463,6 +1540,38 @@ void ReflectedTreeModel::updatePath(ReflectedPropertyItem* item, IPropertyPath::
 	}
 }
 
+void ReflectedTreeModel::invalidateProperty(const ReflectedPropertyItem* item) const
+{
+	// The value of a property is part of the values above it,
+	// and the properties below it were bound through it
+	const auto& path = item->getPath()->getRecursivePath().str();
+	for (const auto& propertiesIt : properties_)
+	{
+		for (const auto& property : propertiesIt.second)
+		{
+			if (property != nullptr &&
+			    ReflectedTreeModelDetails::isRelatedPath(path, property->getPath()->getRecursivePath().str()))
+			{
+				property->invalidateCache();
+			}
+		}
+	}
+}
+
+void ReflectedTreeModel::invalidateProperties() const
+{
+	for (const auto& propertiesIt : properties_)
+	{
+		for (const auto& property : propertiesIt.second)
+		{
+			if (property != nullptr)
+			{
+				property->invalidateCache();
+			}
+		}
+	}
+}
+
 ReflectedTreeModel::ItemMapping* ReflectedTreeModel::mapItem(const AbstractItem* item)
 {
 	auto it = mappedItems_.find(item);
@@ -1504,6 +1613,10 @@ void ReflectedTreeModel::unmapItem(const AbstractItem* item)
 
 void ReflectedTreeModel::firePostItemDataChanged(const ItemIndex& index, int column, ItemRole::Id roleId, Variant value)
 {
+	if (auto property = dynamic_cast<const ReflectedPropertyItem*>(item(index)))
+	{
+		invalidateProperty(property);
+	}
 	postItemDataChanged_(index, column, roleId, value);
 }
 }
@@ -44,6 +44,8 @@ public:
 	virtual int columnCount() const override;
 	int getColumnCount() const;
 
+	virtual void getDataBlock(const AbstractItemModel::DataBlock& block, Variant* o_Values) const override;
+
 	virtual MimeData mimeData(std::vector<AbstractItemModel::ItemIndex>& indices) override;
 
 	void iterateMimeTypes(const std::function<void(const char*)>& iterFunc) const override;
@@ -89,6 +91,11 @@ protected:
 
 	void updatePath(ReflectedPropertyItem* item, IPropertyPath::ConstPtr & path );
 
+	/** Drops the cached data of a property and of every property above or below it. */
+	void invalidateProperty(const ReflectedPropertyItem* item) const;
+	/** Drops the cached data of every property. */
+	void invalidateProperties() const;
+
 	struct ItemMapping
 	{
 		const AbstractItem* parent_;
@@ -2,12 +2,17 @@
 
 #include "test_abstract_item_model.hpp"
 #include "core_data_model/collection_model.hpp"
+#include "core_data_model/common_data_roles.hpp"
+#include "core_data_model/i_item_role.hpp"
 
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
 namespace wgt
 {
+ITEMROLE(key)
+
 template <typename T>
 struct TestCollectionModelFixture : public TestAbstractItemModelFixture<CollectionModel>
 {
@@ -21,6 +26,7 @@ struct TestCollectionModelFixture : public TestAbstractItemModelFixture<Collecti
 	bool testInsertItemMapping(TestResult& result_, const char*& m_name);
 	bool testRemoveItemLinear(TestResult& result_, const char*& m_name);
 	bool testRemoveItemMapping(TestResult& result_, const char*& m_name);
+	bool testDataBlock(TestResult& result_, const char*& m_name);
 
 	T collection_;
 };
@@ -36,11 +42,13 @@ struct TestMappingCollectionModelFixture : public TestCollectionModelFixture<std
 ABSTRACT_ITEM_MODEL_TESTS
 X(InsertItemLinear)
 X(RemoveItemLinear)
+X(DataBlock)
 #undef X
 
 #define X(TEST) ABSTRACT_ITEM_MODEL_TEST_F(TestMappingCollectionModelFixture, TEST)
 X(InsertItemMapping)
 X(RemoveItemMapping)
+X(DataBlock)
 #undef X
 
 template <typename T>
@@ -551,4 +559,51 @@ bool TestCollectionModelFixture<T>::testRemoveItemMapping(TestResult& result_, c
 	return true;
 }
 
+template <typename T>
+bool TestCollectionModelFixture<T>::testDataBlock(TestResult& result_, const char*& m_name)
+{
+	for (int i = 0; i < 8; ++i)
+	{
+		CHECK(model_.insertItem(i, i * 10));
+	}
+	const auto rowCount = model_.rowCount();
+	CHECK_EQUAL(8, rowCount);
+
+	const ItemRole::Id roles[] = { ItemRole::valueId, ItemRole::keyId, ItemRole::valueTypeId, ItemRole::displayId };
+	const size_t roleCount = std::extent<decltype(roles)>::value;
+
+	// Test a block within the rows matches querying each cell
+	{
+		AbstractItemModel::DataBlock block(nullptr, 2, 4, 0, 1, roles, roleCount);
+		std::vector<Variant> values(block.size());
+		std::vector<const AbstractItem*> items(block.rowCount_ * block.columnCount_);
+		block.items_ = items.data();
+		model_.getDataBlock(block, values.data());
+		for (int row = block.firstRow_; row < block.firstRow_ + block.rowCount_; ++row)
+		{
+			const auto item = model_.item(row);
+			CHECK(item != nullptr);
+			CHECK(items[block.itemOffset(row, 0)] == item);
+			for (size_t role = 0; role < roleCount; ++role)
+			{
+				CHECK(values[block.offset(row, 0, role)] == item->getData(row, 0, roles[role]));
+			}
+		}
+	}
+
+	// Test cells past the end of the rows are left empty
+	{
+		AbstractItemModel::DataBlock block(nullptr, rowCount - 1, 2, 0, 1, roles, roleCount);
+		std::vector<Variant> values(block.size(), Variant(1));
+		model_.getDataBlock(block, values.data());
+		CHECK(values[block.offset(rowCount - 1, 0, 0)] == model_.item(rowCount - 1)->getData(0, 0, roles[0]));
+		for (size_t role = 0; role < roleCount; ++role)
+		{
+			CHECK(values[block.offset(rowCount, 0, role)].isVoid());
+		}
+	}
+
+	return true;
+}
+
 } // end namespace wgt
@@ -0,0 +1,85 @@
+#include "pch.hpp"
+
+#include "test_data_model_fixture.hpp"
+#include "core_data_model/reflection_proto/reflected_property_item.hpp"
+#include "core_data_model/reflection_proto/reflected_tree_model.hpp"
+#include "core_data_model/common_data_roles.hpp"
+#include "core_reflection/reflected_object.hpp"
+#include "core_reflection/reflection_macros.hpp"
+#include "core_reflection/metadata/meta_types.hpp"
+#include "core_reflection/i_definition_manager.hpp"
+#include "core_reflection/type_class_definition.hpp"
+#include "core_object/managed_object.hpp"
+#include "core_unit_test/unit_test.hpp"
+
+#include <memory>
+#include <string>
+
+namespace wgt
+{
+class DisplayNameTestObject
+{
+	DECLARE_REFLECTED
+
+public:
+	DisplayNameTestObject() : value_(0)
+	{
+	}
+
+	std::string name_;
+	int value_;
+};
+
+BEGIN_EXPOSE(DisplayNameTestObject, MetaNone())
+EXPOSE("name", name_)
+EXPOSE("value", value_, MetaAttributeDisplayName("name"))
+END_EXPOSE()
+
+namespace
+{
+std::string displayNameOf(const proto::ReflectedTreeModel& model, int row)
+{
+	std::string displayName;
+	auto item = model.item(AbstractTreeModel::ItemIndex(row, nullptr));
+	if (item != nullptr)
+	{
+		item->getData(row, 0, ItemRole::displayId).tryCast(displayName);
+	}
+	return displayName;
+}
+
+uint64_t roleHits()
+{
+	return proto::ReflectedPropertyItem::getCacheStatistics().roleHits_;
+}
+}
+
+TEST_F(TestDataModelFixture, reflected_property_item_attribute_display_name)
+{
+	auto definitionManager = getDefinitionManager();
+	auto definition = definitionManager->registerDefinition<TypeClassDefinition<DisplayNameTestObject>>();
+	auto object = ManagedObject<DisplayNameTestObject>(std::make_unique<DisplayNameTestObject>());
+	object->name_ = "first";
+	ObjectHandle handle = object.getHandle();
+
+	proto::ReflectedTreeModel model(handle);
+	RETURN_ON_FAIL_CHECK(model.rowCount(nullptr) == 2);
+
+	// The name item shows its path and keeps it
+	CHECK(displayNameOf(model, 0) == "name");
+	auto hits = roleHits();
+	CHECK(displayNameOf(model, 0) == "name");
+	CHECK_EQUAL(hits + 1, roleHits());
+
+	// The value item shows the name property, which is read on every query
+	CHECK(displayNameOf(model, 1) == "first");
+	hits = roleHits();
+	auto name = definition->bindProperty("name", handle);
+	RETURN_ON_FAIL_CHECK(name.isValid());
+	CHECK(name.setValue(std::string("second")));
+	CHECK(displayNameOf(model, 1) == "second");
+	object->name_ = "third";
+	CHECK(displayNameOf(model, 1) == "third");
+	CHECK_EQUAL(hits, roleHits());
+}
+} // end namespace wgt
@@ -84,7 +84,7 @@ bool InsertDefaultCommand::redo(const ObjectHandle& arguments) const /* override
 
 CommandDescription InsertDefaultCommand::getCommandDescription(const ObjectHandle& arguments) const /* override */
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
 
 	if (!arguments.isValid())
 	{
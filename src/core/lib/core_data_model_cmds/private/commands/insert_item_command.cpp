@@ -85,7 +85,7 @@ bool InsertItemCommand::redo(const ObjectHandle& arguments) const /* override */
 
 CommandDescription InsertItemCommand::getCommandDescription(const ObjectHandle& arguments) const /* override */
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
 
 	if (!arguments.isValid())
 	{
@@ -108,7 +108,7 @@ bool InsertRowsCommand::redo(const ObjectHandle& arguments) const /* override */
 
 CommandDescription InsertRowsCommand::getCommandDescription(const ObjectHandle& arguments) const /* override */
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
 
 	if (!arguments.isValid())
 	{
@@ -141,7 +141,7 @@ bool MoveItemDataCommand::redo(const ObjectHandle& arguments) const /* override
 
 CommandDescription MoveItemDataCommand::getCommandDescription(const ObjectHandle& arguments) const /* override */
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
 
 	if (!arguments.isValid())
 	{
@@ -89,7 +89,7 @@ bool RemoveItemCommand::redo(const ObjectHandle& arguments) const /* override */
 
 CommandDescription RemoveItemCommand::getCommandDescription(const ObjectHandle& arguments) const /* override */
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
 
 	if (!arguments.isValid())
 	{
@@ -204,7 +204,7 @@ bool RemoveRowsCommand::redo(const ObjectHandle& arguments) const /* override */
 
 CommandDescription RemoveRowsCommand::getCommandDescription(const ObjectHandle& arguments) const /* override */
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
 
 	if (!arguments.isValid())
 	{
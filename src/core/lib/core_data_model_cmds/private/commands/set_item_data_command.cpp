@@ -98,7 +98,7 @@ bool SetItemDataCommand::redo(const ObjectHandle& arguments) const /* override *
 
 CommandDescription SetItemDataCommand::getCommandDescription(const ObjectHandle& arguments) const /* override */
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
 
 	if (!arguments.isValid())
 	{
@@ -93,7 +93,7 @@ bool SetModelDataCommand::redo(const ObjectHandle& arguments) const /* override
 
 CommandDescription SetModelDataCommand::getCommandDescription(const ObjectHandle& arguments) const /* override */
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
 
 	if (!arguments.isValid())
 	{
@@ -1,17 +1,110 @@
 #include "config_plugin_loader.hpp"
+#include "plugin_dependency_graph.hpp"
 
 #include <fstream>
+#include <sstream>
 #include <iterator>
 #include <codecvt>
+#include <locale>
 #include <algorithm>
 
 namespace wgt
 {
 namespace ConfigPluginLoader
 {
-typedef std::istream_iterator<std::wstring, wchar_t, std::char_traits<wchar_t>> wistream_iterator;
+namespace
+{
+void splitInterfaces(const std::wstring& value, std::vector<std::string>& o_Interfaces)
+{
+	std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
+	std::wstringstream stream(value);
+	std::wstring interfaceName;
+	while (getline(stream, interfaceName, L','))
+	{
+		if (!interfaceName.empty())
+		{
+			o_Interfaces.emplace_back(conv.to_bytes(interfaceName));
+		}
+	}
+}
 
-bool getPlugins(std::vector<std::wstring>& plugins, const std::wstring& configFileName)
+bool isAttribute(const std::wstring& token)
+{
+	return token == L"lazy" || token.compare(0, 9, L"provides=") == 0 || token.compare(0, 9, L"requires=") == 0;
+}
+
+void applyAttribute(const std::wstring& token, PluginDeclaration& declaration)
+{
+	if (token == L"lazy")
+	{
+		declaration.lazy_ = true;
+	}
+	else if (token.compare(0, 9, L"provides=") == 0)
+	{
+		splitInterfaces(token.substr(9), declaration.provides_);
+	}
+	else if (token.compare(0, 9, L"requires=") == 0)
+	{
+		splitInterfaces(token.substr(9), declaration.requires_);
+	}
+}
+
+/*
+	Attributes are taken from the end of the line and everything before them is the
+	plugin path, so paths may contain spaces. A path may also be quoted, which is
+	needed when its last word would otherwise be read as an attribute.
+*/
+PluginDeclaration parseDeclaration(const std::wstring& line)
+{
+	static const wchar_t* whitespace = L" \t\r";
+
+	auto end = line.find_last_not_of(whitespace);
+	if (end == std::wstring::npos)
+	{
+		return PluginDeclaration();
+	}
+	++end;
+
+	std::vector<std::wstring> attributes;
+	for (;;)
+	{
+		auto separator = line.find_last_of(whitespace, end - 1);
+		if (separator == std::wstring::npos)
+		{
+			break;
+		}
+
+		auto token = line.substr(separator + 1, end - separator - 1);
+		if (!isAttribute(token))
+		{
+			break;
+		}
+		attributes.emplace_back(std::move(token));
+
+		end = line.find_last_not_of(whitespace, separator);
+		if (end == std::wstring::npos)
+		{
+			return PluginDeclaration();
+		}
+		++end;
+	}
+
+	const auto begin = line.find_first_not_of(whitespace);
+	auto name = line.substr(begin, end - begin);
+	if (name.size() >= 2 && name.front() == L'"' && name.back() == L'"')
+	{
+		name = name.substr(1, name.size() - 2);
+	}
+
+	PluginDeclaration declaration(name);
+	for (auto it = attributes.rbegin(); it != attributes.rend(); ++it)
+	{
+		applyAttribute(*it, declaration);
+	}
+	return declaration;
+}
+
+bool readLines(std::vector<std::wstring>& lines, const std::wstring& configFileName)
 {
 #ifdef _WIN32
 	std::wifstream inputFile(configFileName.c_str());
@@ -32,7 +125,7 @@ bool getPlugins(std::vector<std::wstring>& plugins, const std::wstring& configFi
 				continue;
 			}
 
-			plugins.emplace_back(line);
+			lines.emplace_back(line);
 		}
 
 		return true;
@@ -41,4 +134,39 @@ bool getPlugins(std::vector<std::wstring>& plugins, const std::wstring& configFi
 	return false;
 }
 }
+
+bool getPlugins(std::vector<std::wstring>& plugins, const std::wstring& configFileName)
+{
+	std::vector<PluginDeclaration> declarations;
+	if (!getPluginDeclarations(declarations, configFileName))
+	{
+		return false;
+	}
+
+	for (auto& declaration : declarations)
+	{
+		plugins.emplace_back(std::move(declaration.name_));
+	}
+	return true;
+}
+
+bool getPluginDeclarations(std::vector<PluginDeclaration>& plugins, const std::wstring& configFileName)
+{
+	std::vector<std::wstring> lines;
+	if (!readLines(lines, configFileName))
+	{
+		return false;
+	}
+
+	for (const auto& line : lines)
+	{
+		auto declaration = parseDeclaration(line);
+		if (!declaration.name_.empty())
+		{
+			plugins.emplace_back(std::move(declaration));
+		}
+	}
+	return true;
+}
+}
 } // end namespace wgt
@@ -6,9 +6,29 @@
 
 namespace wgt
 {
+struct PluginDeclaration;
+
+/**
+* Reads plugin lists from configuration files.
+*
+* Each non-empty line which does not start with '#' names a plugin. A plugin name may be
+* followed by whitespace separated attributes describing its dependencies:
+*
+* @code
+*	plugins/plg_reflection provides=IDefinitionManager,IObjectManager
+*	plugins/plg_history_ui requires=ICommandManager,IUIFramework lazy
+*	"my plugins/plg_lazy" lazy
+* @endcode
+*
+* Everything before the attributes is the plugin name, which may contain spaces. Names
+* ending in a word which reads as an attribute must be quoted.
+*
+* The attributes are ignored by getPlugins, which keeps the declared load order.
+*/
 namespace ConfigPluginLoader
 {
 bool getPlugins(std::vector<std::wstring>& plugins, const std::wstring& configFileName);
+bool getPluginDeclarations(std::vector<PluginDeclaration>& plugins, const std::wstring& configFileName);
 }
 } // end namespace wgt
 #endif // CONFIG_PLUGIN_LOADER_HPP
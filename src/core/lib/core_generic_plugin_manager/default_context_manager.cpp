@@ -286,15 +286,31 @@ bool DefaultComponentContext::deregisterInterface(IInterface* pImpl)
 //==============================================================================
 void* DefaultComponentContext::queryInterface(const TypeId& name)
 {
-	wg_read_lock_guard readGuard(lock_);
-	for (auto& interfaceIt : interfaces_)
+	void* found = findInterface(name);
+	if (found != nullptr || parentContext_ != nullptr || !interfaceResolver_)
 	{
-		void* found = interfaceIt.second->queryInterface(name);
-		if (found)
+		return found;
+	}
+
+	// Resolve outside of the lock, the resolver is expected to register interfaces
+	return interfaceResolver_(name) ? findInterface(name) : nullptr;
+}
+
+//==============================================================================
+void* DefaultComponentContext::findInterface(const TypeId& name)
+{
+	{
+		wg_read_lock_guard readGuard(lock_);
+		for (auto& interfaceIt : interfaces_)
 		{
-			return found;
+			void* found = interfaceIt.second->queryInterface(name);
+			if (found)
+			{
+				return found;
+			}
 		}
 	}
+	// The parent may start deferred plugins, so query it without holding our lock
 	if (parentContext_ == nullptr)
 	{
 		return nullptr;
@@ -302,16 +318,32 @@ void* DefaultComponentContext::queryInterface(const TypeId& name)
 	return parentContext_->queryInterface(name);
 }
 
+//==============================================================================
+void DefaultComponentContext::setInterfaceResolver(InterfaceResolver resolver)
+{
+	interfaceResolver_ = resolver;
+}
+
 //==============================================================================
 void DefaultComponentContext::queryInterface(const TypeId& name, std::vector<void*>& o_Impls)
 {
-	wg_read_lock_guard readGuard(lock_);
-	for (auto& interfaceIt : interfaces_)
+	// Every implementation is wanted, so start all the deferred plugins which provide one
+	if (parentContext_ == nullptr && interfaceResolver_)
 	{
-		void* found = interfaceIt.second->queryInterface(name);
-		if (found)
+		while (interfaceResolver_(name))
 		{
-			o_Impls.push_back(found);
+		}
+	}
+
+	{
+		wg_read_lock_guard readGuard(lock_);
+		for (auto& interfaceIt : interfaces_)
+		{
+			void* found = interfaceIt.second->queryInterface(name);
+			if (found)
+			{
+				o_Impls.push_back(found);
+			}
 		}
 	}
 	if (parentContext_ == nullptr)
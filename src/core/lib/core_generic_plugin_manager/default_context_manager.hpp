@@ -8,6 +8,7 @@
 #include <set>
 #include <map>
 #include <memory>
+#include <functional>
 
 namespace wgt
 {
@@ -29,7 +30,17 @@ public:
 
 	ConnectionHolder registerListener(IComponentContextListener& listener) override;
 
+	/**
+	* Called by the root context when a queried interface is not registered.
+	* The resolver returns true if it registered something, in which case the query is retried once.
+	* Queries for every implementation call the resolver until it returns false.
+	*/
+	typedef std::function<bool(const TypeId&)> InterfaceResolver;
+	void setInterfaceResolver(InterfaceResolver resolver);
+
 private:
+	void* findInterface(const TypeId& name);
+
 	virtual void onInterfaceRegistered(InterfaceCaster&) override;
 	virtual void onInterfaceDeregistered(InterfaceCaster&) override;
 	void deregisterListener(IComponentContextListener& listener);
@@ -47,6 +58,7 @@ private:
 	ComponentContextListeners listeners_;
 	std::wstring name_;
 	std::shared_ptr<std::function<void(IComponentContextListener&)>> disconnectSig_;
+	InterfaceResolver interfaceResolver_;
 };
 } // end namespace wgt
 #endif
@@ -6,6 +6,7 @@
 
 #include "core_generic_plugin/env_context.hpp"
 #include "core_generic_plugin/generic_plugin.hpp"
+#include "core_generic_plugin/interfaces/i_application.hpp"
 #include "core_generic_plugin/interfaces/i_command_line_parser.hpp"
 #include "core_generic_plugin/interfaces/i_component_context_creator.hpp"
 #include "core_generic_plugin/interfaces/i_memory_allocator.hpp"
@@ -24,6 +25,7 @@
 #include <algorithm>
 #include <iterator>
 #include <cstdint>
+#include <memory>
 
 #ifdef _WIN32
 #include <shlwapi.h>
@@ -53,15 +55,25 @@ GenericPluginManager::GenericPluginManager(bool applyDebugPostfix,
     : contextManager_(new PluginContextManager())
 	, applyDebugPostfix_(applyDebugPostfix)
 	, applyHybridPostfix_(applyHybridPostfix)
+	, mainThreadId_(std::this_thread::get_id())
+	, startTime_(Clock::now())
+	, loadingDeferred_(false)
 {
 	contextManager_->getGlobalContext()->registerInterface(new PluginStaticInitializer);
 	contextManager_->getGlobalContext()->registerInterface(new PluginStaticInitializerContextCreator);
+	contextManager_->setInterfaceResolver(
+	std::bind(&GenericPluginManager::resolveInterface, this, std::placeholders::_1));
 }
 
 //==============================================================================
 GenericPluginManager::~GenericPluginManager()
 {
 	TF_ASSERT(pluginCountInState(Initialise, true) == 0);
+	// Never start deferred plugins while shutting down
+	deferredPlugins_.clear();
+	startUpConnection_.disconnect();
+	contextManager_->setInterfaceResolver(nullptr);
+
 	auto toUnload = pluginLoadOrder_;
 	runFinaliseStep(toUnload);
 	runUnloadStep(toUnload);
@@ -75,6 +87,192 @@ void GenericPluginManager::loadPlugins(const PluginNameList& pluginNames)
 	runInitiliseStep(pluginNames);
 }
 
+//==============================================================================
+void GenericPluginManager::loadPlugins(const PluginDependencyGraph& graph)
+{
+	deferPlugins(graph);
+	loadPlugins(graph.getStartupPlugins());
+}
+
+//==============================================================================
+void GenericPluginManager::deferPlugins(const PluginDependencyGraph& graph)
+{
+	dependencyGraph_ = graph;
+	deferredPlugins_ = graph.getDeferredPlugins();
+}
+
+//==============================================================================
+void GenericPluginManager::unloadDeferredPlugins()
+{
+	deferredPlugins_.clear();
+	startUpConnection_.disconnect();
+
+	auto toUnload = std::move(startedDeferredPlugins_);
+	startedDeferredPlugins_.clear();
+	unloadPlugins(toUnload);
+}
+
+//==============================================================================
+bool GenericPluginManager::loadNextDeferredPlugin()
+{
+	if (deferredPlugins_.empty())
+	{
+		return false;
+	}
+	return loadDeferredPlugin(deferredPlugins_.front());
+}
+
+//==============================================================================
+bool GenericPluginManager::hasDeferredPlugins() const
+{
+	return !deferredPlugins_.empty();
+}
+
+//==============================================================================
+bool GenericPluginManager::loadDeferredPlugin(const std::wstring& pluginName)
+{
+	// Remove the plugins from the deferred list before loading them so queries made
+	// while they are starting up cannot load them a second time
+	PluginNameList toLoad;
+	for (const auto& name : dependencyGraph_.resolve(pluginName))
+	{
+		auto it = std::find(deferredPlugins_.begin(), deferredPlugins_.end(), name);
+		if (it != deferredPlugins_.end())
+		{
+			deferredPlugins_.erase(it);
+			toLoad.push_back(name);
+		}
+	}
+
+	if (toLoad.empty())
+	{
+		return false;
+	}
+
+	startedDeferredPlugins_.insert(startedDeferredPlugins_.end(), toLoad.begin(), toLoad.end());
+	const bool wasLoadingDeferred = loadingDeferred_;
+	loadingDeferred_ = true;
+	loadPlugins(toLoad);
+	loadingDeferred_ = wasLoadingDeferred;
+	return true;
+}
+
+//==============================================================================
+bool GenericPluginManager::resolveInterface(const TypeId& typeId)
+{
+	// Plugins must be started from the thread which owns the plugin manager
+	if (deferredPlugins_.empty() || std::this_thread::get_id() != mainThreadId_)
+	{
+		return false;
+	}
+
+	// Start the first provider which has not been started yet, so that repeated calls
+	// start every provider of the interface
+	for (const auto& provider : dependencyGraph_.getProviders(typeId.getName()))
+	{
+		if (std::find(deferredPlugins_.begin(), deferredPlugins_.end(), provider) != deferredPlugins_.end())
+		{
+			NGT_DEBUG_MSG("Starting deferred plugin %S on first query of %s\n", provider.c_str(), typeId.getName());
+			return loadDeferredPlugin(provider);
+		}
+	}
+	return false;
+}
+
+//==============================================================================
+void GenericPluginManager::scheduleDeferredPlugins()
+{
+	auto application = queryInterface<IApplication>();
+	if (application == nullptr)
+	{
+		logStartupReport();
+		return;
+	}
+	scheduleDeferredPlugins(*application);
+}
+
+//==============================================================================
+void GenericPluginManager::scheduleDeferredPlugins(IApplication& application)
+{
+	startUpConnection_ = application.signalStartUp.connect([this, &application]() {
+		logStartupReport();
+		if (!hasDeferredPlugins())
+		{
+			return;
+		}
+
+		auto timerId = std::make_shared<IApplication::TimerId>(0);
+		*timerId = application.startTimer(0, [this, &application, timerId]() {
+			if (!loadNextDeferredPlugin())
+			{
+				application.killTimer(*timerId);
+			}
+		});
+	});
+}
+
+//==============================================================================
+void GenericPluginManager::logStartupReport() const
+{
+	const Milliseconds elapsed = Clock::now() - startTime_;
+
+	std::vector<const PluginTiming*> sorted;
+	Milliseconds total(0);
+	size_t deferredCount = 0;
+	for (const auto& timing : timings_)
+	{
+		sorted.push_back(&timing);
+		total += timing.load_ + timing.initialise_;
+		deferredCount += timing.deferred_ ? 1 : 0;
+	}
+	std::sort(sorted.begin(), sorted.end(), [](const PluginTiming* lhs, const PluginTiming* rhs) {
+		return lhs->load_ + lhs->initialise_ > rhs->load_ + rhs->initialise_;
+	});
+
+	NGT_MSG("Plugin startup report: %.1f ms since start, %.1f ms in %d plugins (%d deferred), %d still deferred\n",
+	        elapsed.count(), total.count(), static_cast<int>(timings_.size()), static_cast<int>(deferredCount),
+	        static_cast<int>(deferredPlugins_.size()));
+	for (auto timing : sorted)
+	{
+		NGT_MSG("  %8.1f ms (load %8.1f, initialise %8.1f)%s %S\n", (timing->load_ + timing->initialise_).count(),
+		        timing->load_.count(), timing->initialise_.count(), timing->deferred_ ? " [deferred]" : "",
+		        timing->name_.c_str());
+	}
+}
+
+//==============================================================================
+GenericPluginManager::PluginTiming& GenericPluginManager::getPluginTiming(const std::wstring& name)
+{
+	auto it = std::find_if(timings_.begin(), timings_.end(),
+	                       [&name](const PluginTiming& timing) { return timing.name_ == name; });
+	if (it != timings_.end())
+	{
+		return *it;
+	}
+
+	PluginTiming timing = { name, Milliseconds(0), Milliseconds(0), loadingDeferred_ };
+	timings_.push_back(timing);
+	return timings_.back();
+}
+
+//==============================================================================
+GenericPluginManager::NotifyFunction GenericPluginManager::timeNotification(NotifyFunction func,
+                                                                            Milliseconds PluginTiming::*phase)
+{
+	return [this, func, phase](HMODULE hPlugin) {
+		const auto start = Clock::now();
+		const bool result = func(hPlugin);
+		const Milliseconds elapsed = Clock::now() - start;
+
+		auto it = findPlugin(hPlugin);
+		if (it != plugins_.end())
+		{
+			getPluginTiming(it->first).*phase += elapsed;
+		}
+		return result;
+	};
+}
+
 //==============================================================================
 void GenericPluginManager::unloadPlugins(const PluginNameList& pluginNames)
 {
@@ -90,7 +288,7 @@ void GenericPluginManager::runLoadStep(const PluginNameList& pluginNames)
 	std::transform(std::begin(pluginNames), std::end(pluginNames), std::back_inserter(plgs),
 	               std::bind(&GenericPluginManager::loadPlugin, this, std::placeholders::_1));
 
-	notifyPlugins(plgs, NotifyPlugin(*this, GenericPluginLoadState::Create));
+	notifyPlugins(plgs, timeNotification(NotifyPlugin(*this, GenericPluginLoadState::Create), &PluginTiming::load_));
 
 	notifyPlugins(plgs, NotifyPluginPostLoad(*this));
 
@@ -104,7 +302,8 @@ void GenericPluginManager::runLoadStep(const PluginNameList& pluginNames)
 void GenericPluginManager::runInitiliseStep(const PluginNameList& pluginNames)
 {
 	PluginList plgs = generateList(pluginNames, false);
-	notifyPlugins(plgs, NotifyPlugin(*this, GenericPluginLoadState::Initialise));
+	notifyPlugins(plgs, timeNotification(NotifyPlugin(*this, GenericPluginLoadState::Initialise),
+	                                     &PluginTiming::initialise_));
 
 	for (const auto& name : pluginNames)
 	{
@@ -253,14 +452,17 @@ HMODULE GenericPluginManager::loadPlugin(const std::wstring& filename)
                   initFunc(*pluginContext);
               };
 	setPluginInitDelegate(&initDelegate);
+	const auto start = Clock::now();
 	HMODULE hPlugin = ::LoadLibraryW(processedFileName.c_str());
 	// Must get last error before doing anything else
 	const bool hadError = FormatLastErrorMessage(errorMsg);
+	const Milliseconds elapsed = Clock::now() - start;
 	setPluginInitDelegate(nullptr);
 
 	if (hPlugin != nullptr)
 	{
 		plugins_[processedFileName] = hPlugin;
+		getPluginTiming(processedFileName).load_ += elapsed;
 	}
 	else
 	{
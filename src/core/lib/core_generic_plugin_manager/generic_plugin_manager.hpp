@@ -5,6 +5,10 @@
 #include "core_generic_plugin/interfaces/i_memory_allocator.hpp"
 #include "core_generic_plugin/interfaces/i_component_context.hpp"
 #include "core_generic_plugin/generic_plugin.hpp"
+#include "core_common/signal.hpp"
+#include "plugin_dependency_graph.hpp"
+#include <chrono>
+#include <thread>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -14,7 +18,10 @@
 
 namespace wgt
 {
+class IApplication;
 class IPluginContextManager;
+class PluginContextManager;
+class TypeId;
 
 class GenericPluginManager
 {
@@ -28,6 +35,35 @@ public:
 	virtual ~GenericPluginManager();
 
 	void loadPlugins(const PluginNameList& plugins);
+
+	/**
+	* Starts the plugins required at startup and defers the rest.
+	* Deferred plugins are started when one of their declared interfaces is first queried,
+	* or in the background once scheduleDeferredPlugins has been called.
+	*/
+	void loadPlugins(const PluginDependencyGraph& graph);
+
+	/**
+	* Defers the plugins of the graph which are not required at startup without loading anything.
+	* For applications which run the load and initialise steps for graph.getStartupPlugins() themselves.
+	*/
+	void deferPlugins(const PluginDependencyGraph& graph);
+
+	/**
+	* Finalises and unloads the deferred plugins which have been started, before the
+	* application tears down the plugins and services they depend on.
+	*/
+	void unloadDeferredPlugins();
+	bool loadNextDeferredPlugin();
+	bool hasDeferredPlugins() const;
+
+	/**
+	* Logs the startup report and loads the remaining deferred plugins one at a time
+	* from the application's event loop once the application has started up.
+	*/
+	void scheduleDeferredPlugins();
+	void scheduleDeferredPlugins(IApplication& application);
+	void logStartupReport() const;
 	void unloadPlugins(const PluginNameList& plugins);
 	void unloadPlugins(const PluginList& plugins);
 
@@ -54,6 +90,21 @@ private:
 	typedef std::function<bool(HMODULE)> NotifyFunction;
 	void notifyPlugins(const PluginList& plugins, NotifyFunction func);
 
+	typedef std::chrono::high_resolution_clock Clock;
+	typedef std::chrono::duration<double, std::milli> Milliseconds;
+	struct PluginTiming
+	{
+		std::wstring name_;
+		Milliseconds load_;
+		Milliseconds initialise_;
+		bool deferred_;
+	};
+	PluginTiming& getPluginTiming(const std::wstring& name);
+	NotifyFunction timeNotification(NotifyFunction func, Milliseconds PluginTiming::*phase);
+
+	bool loadDeferredPlugin(const std::wstring& pluginName);
+	bool resolveInterface(const TypeId& typeId);
+
 	HMODULE loadPlugin(const std::wstring& filename);
 	bool unloadPlugin(HMODULE hPlugin);
 	void unloadContext(HMODULE hPlugin);
@@ -68,9 +119,18 @@ private:
 	PluginStateMap pluginStates_;
 
 	std::map<std::wstring, IMemoryAllocator*> memoryContext_;
-	std::unique_ptr<IPluginContextManager> contextManager_;
+	std::unique_ptr<PluginContextManager> contextManager_;
 	bool applyDebugPostfix_;
 	bool applyHybridPostfix_;
+
+	PluginDependencyGraph dependencyGraph_;
+	PluginNameList deferredPlugins_;
+	PluginNameList startedDeferredPlugins_;
+	std::thread::id mainThreadId_;
+	Clock::time_point startTime_;
+	std::vector<PluginTiming> timings_;
+	bool loadingDeferred_;
+	Connection startUpConnection_;
 };
 } // end namespace wgt
 #endif // GENERIC_PLUGIN_MANAGER_HPP
@@ -128,4 +128,9 @@ const char* PluginContextManager::getExecutablePath() const
 {
 	return executablepath_;
 }
+
+void PluginContextManager::setInterfaceResolver(std::function<bool(const TypeId&)> resolver)
+{
+	globalContext_->setInterfaceResolver(resolver);
+}
 } // end namespace wgt
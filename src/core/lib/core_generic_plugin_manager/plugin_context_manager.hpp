@@ -10,9 +10,13 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <functional>
 
 namespace wgt
 {
+class DefaultComponentContext;
+class TypeId;
+
 class PluginContextManager : public Implements<IPluginContextManager>, public IComponentContextListener
 {
 	typedef std::vector<IComponentContextCreator*> ContextCreatorCollection;
@@ -32,6 +36,9 @@ public:
 	void setExecutablePath(const char* path) override;
 	const char* getExecutablePath() const override;
 
+	/** Resolver invoked when an interface query on the global context finds nothing. */
+	void setInterfaceResolver(std::function<bool(const TypeId&)> resolver);
+
 private:
 	typedef std::vector< std::weak_ptr< IInterface > > InterfaceCollection;
 	typedef std::map<IComponentContextCreator*, InterfaceCollection> ContextChildrenCollection;
@@ -49,7 +56,7 @@ private:
 	};
 	std::map<PluginId, std::unique_ptr<ContextMetaData>> contexts_;
 	std::map<std::string, IComponentContextCreator*> contextCreators_;
-	std::unique_ptr<IComponentContext> globalContext_;
+	std::unique_ptr<DefaultComponentContext> globalContext_;
 	const char* executablepath_;
 
 	HolderCollection<IComponentContext::ConnectionHolder> connections_;
@@ -0,0 +1,304 @@
+#include "plugin_dependency_graph.hpp"
+
+#include "core_logging/logging.hpp"
+
+#include <algorithm>
+#include <set>
+#include <cstring>
+
+namespace wgt
+{
+namespace
+{
+std::string unqualifiedName(const std::string& interfaceName)
+{
+	auto pos = interfaceName.rfind("::");
+	return pos == std::string::npos ? interfaceName : interfaceName.substr(pos + 2);
+}
+
+bool endsWith(const char* str, size_t strLen, const std::string& suffix)
+{
+	return strLen >= suffix.size() && std::strncmp(str + strLen - suffix.size(), suffix.c_str(), suffix.size()) == 0;
+}
+}
+
+//==============================================================================
+PluginDependencyGraph::PluginDependencyGraph()
+{
+}
+
+//==============================================================================
+PluginDependencyGraph::PluginDependencyGraph(const PluginDeclarations& declarations)
+{
+	for (const auto& declaration : declarations)
+	{
+		addPlugin(declaration);
+	}
+}
+
+//==============================================================================
+void PluginDependencyGraph::addPlugin(const PluginDeclaration& declaration)
+{
+	auto found = indices_.find(declaration.name_);
+	if (found != indices_.end())
+	{
+		NGT_WARNING_MSG("Plugin %S declared more than once, using the first declaration\n",
+		                declaration.name_.c_str());
+		return;
+	}
+
+	indices_[declaration.name_] = declarations_.size();
+	declarations_.push_back(declaration);
+}
+
+//==============================================================================
+bool PluginDependencyGraph::empty() const
+{
+	return declarations_.empty();
+}
+
+//==============================================================================
+const PluginDependencyGraph::PluginDeclarations& PluginDependencyGraph::getDeclarations() const
+{
+	return declarations_;
+}
+
+//==============================================================================
+PluginDependencyGraph::PluginNameList PluginDependencyGraph::getStartupPlugins() const
+{
+	std::vector<bool> selected(declarations_.size(), false);
+	for (size_t i = 0; i < declarations_.size(); ++i)
+	{
+		if (!declarations_[i].lazy_)
+		{
+			collect(i, selected);
+		}
+	}
+	return sort(selected);
+}
+
+//==============================================================================
+PluginDependencyGraph::PluginNameList PluginDependencyGraph::getDeferredPlugins() const
+{
+	std::vector<bool> selected(declarations_.size(), false);
+	for (size_t i = 0; i < declarations_.size(); ++i)
+	{
+		if (!declarations_[i].lazy_)
+		{
+			collect(i, selected);
+		}
+	}
+	selected.flip();
+	return sort(selected);
+}
+
+//==============================================================================
+PluginDependencyGraph::PluginNameList PluginDependencyGraph::resolve(const std::wstring& pluginName) const
+{
+	std::vector<bool> selected(declarations_.size(), false);
+	auto found = indices_.find(pluginName);
+	if (found != indices_.end())
+	{
+		collect(found->second, selected);
+	}
+	return sort(selected);
+}
+
+//==============================================================================
+const std::wstring* PluginDependencyGraph::findProvider(const char* typeName) const
+{
+	if (typeName == nullptr)
+	{
+		return nullptr;
+	}
+
+	for (const auto& declaration : declarations_)
+	{
+		for (const auto& provided : declaration.provides_)
+		{
+			if (matchesInterfaceName(typeName, provided))
+			{
+				return &declaration.name_;
+			}
+		}
+	}
+	return nullptr;
+}
+
+//==============================================================================
+PluginDependencyGraph::PluginNameList PluginDependencyGraph::getProviders(const char* typeName) const
+{
+	PluginNameList providers;
+	if (typeName == nullptr)
+	{
+		return providers;
+	}
+
+	for (const auto& declaration : declarations_)
+	{
+		auto provides = std::find_if(declaration.provides_.begin(), declaration.provides_.end(),
+		                             [typeName](const std::string& provided) {
+			                             return matchesInterfaceName(typeName, provided);
+			                         });
+		if (provides != declaration.provides_.end())
+		{
+			providers.push_back(declaration.name_);
+		}
+	}
+	return providers;
+}
+
+//==============================================================================
+bool PluginDependencyGraph::matchesInterfaceName(const char* typeName, const std::string& interfaceName)
+{
+	const auto name = unqualifiedName(interfaceName);
+	if (name.empty())
+	{
+		return false;
+	}
+
+	const auto typeNameLen = std::strlen(typeName);
+
+	// Demangled names, e.g. "class wgt::IFoo"
+	if (endsWith(typeName, typeNameLen, name))
+	{
+		const auto prefixLen = typeNameLen - name.size();
+		if (prefixLen == 0 || typeName[prefixLen - 1] == ' ' || typeName[prefixLen - 1] == ':')
+		{
+			return true;
+		}
+	}
+
+	// Itanium mangled names, e.g. "N3wgt4IFooE"
+	const auto mangled = std::to_string(name.size()) + name;
+	return std::strcmp(typeName, mangled.c_str()) == 0 || endsWith(typeName, typeNameLen, mangled + "E");
+}
+
+//==============================================================================
+void PluginDependencyGraph::collect(size_t index, std::vector<bool>& visited) const
+{
+	if (visited[index])
+	{
+		return;
+	}
+	visited[index] = true;
+
+	IndexList providers;
+	for (const auto& required : declarations_[index].requires_)
+	{
+		providers.clear();
+		findProviders(required, providers);
+		if (providers.empty())
+		{
+			NGT_WARNING_MSG("Plugin %S requires %s but no plugin declares it\n",
+			                declarations_[index].name_.c_str(), required.c_str());
+		}
+		for (auto provider : providers)
+		{
+			collect(provider, visited);
+		}
+	}
+}
+
+//==============================================================================
+PluginDependencyGraph::PluginNameList PluginDependencyGraph::sort(const std::vector<bool>& selected) const
+{
+	const auto count = declarations_.size();
+	std::vector<IndexList> dependents(count);
+	std::vector<size_t> pending(count, 0);
+
+	IndexList providers;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (!selected[i])
+		{
+			continue;
+		}
+
+		for (const auto& required : declarations_[i].requires_)
+		{
+			providers.clear();
+			findProviders(required, providers);
+			for (auto provider : providers)
+			{
+				if (provider != i && selected[provider])
+				{
+					dependents[provider].push_back(i);
+					++pending[i];
+				}
+			}
+		}
+	}
+
+	// Kahn's algorithm, always picking the earliest declared plugin that is ready
+	std::set<size_t> ready;
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (selected[i] && pending[i] == 0)
+		{
+			ready.insert(i);
+		}
+	}
+
+	PluginNameList result;
+	std::vector<bool> emitted(count, false);
+	for (;;)
+	{
+		while (!ready.empty())
+		{
+			auto index = *ready.begin();
+			ready.erase(ready.begin());
+			result.push_back(declarations_[index].name_);
+			emitted[index] = true;
+
+			for (auto dependent : dependents[index])
+			{
+				if (!emitted[dependent] && --pending[dependent] == 0)
+				{
+					ready.insert(dependent);
+				}
+			}
+		}
+
+		// Break cycles by releasing the earliest declared plugin still waiting
+		size_t blocked = count;
+		for (size_t i = 0; i < count; ++i)
+		{
+			if (selected[i] && !emitted[i] && pending[i] != 0)
+			{
+				blocked = i;
+				break;
+			}
+		}
+
+		if (blocked == count)
+		{
+			break;
+		}
+
+		NGT_WARNING_MSG("Plugin %S is part of a dependency cycle, falling back to declaration order\n",
+		                declarations_[blocked].name_.c_str());
+		pending[blocked] = 0;
+		ready.insert(blocked);
+	}
+
+	return result;
+}
+
+//==============================================================================
+void PluginDependencyGraph::findProviders(const std::string& interfaceName, IndexList& o_Providers) const
+{
+	const auto name = unqualifiedName(interfaceName);
+	for (size_t i = 0; i < declarations_.size(); ++i)
+	{
+		for (const auto& provided : declarations_[i].provides_)
+		{
+			if (unqualifiedName(provided) == name)
+			{
+				o_Providers.push_back(i);
+				break;
+			}
+		}
+	}
+}
+} // end namespace wgt
@@ -0,0 +1,93 @@
+#ifndef PLUGIN_DEPENDENCY_GRAPH_HPP
+#define PLUGIN_DEPENDENCY_GRAPH_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace wgt
+{
+/**
+* Describes a single plugin entry from a plugin configuration file.
+*
+* Interface names are matched against the unqualified or namespace-qualified
+* type name, e.g. "IUIFramework" or "wgt::IUIFramework".
+* Plugins which are not marked as lazy are started with the application. Lazy
+* plugins are only started when an eager plugin requires one of their interfaces,
+* when one of their interfaces is first queried, or in the background once the
+* application has started up.
+*/
+struct PluginDeclaration
+{
+	PluginDeclaration() : lazy_(false)
+	{
+	}
+
+	explicit PluginDeclaration(const std::wstring& name) : name_(name), lazy_(false)
+	{
+	}
+
+	std::wstring name_;
+	std::vector<std::string> provides_;
+	std::vector<std::string> requires_;
+	bool lazy_;
+};
+
+/**
+* Dependency graph between plugins built from their declared provided and
+* required interfaces.
+*
+* All returned lists are topologically sorted so that requirements come before
+* the plugins which depend on them. Plugins without a dependency relationship
+* keep the order in which they were declared.
+*/
+class PluginDependencyGraph
+{
+public:
+	typedef std::vector<std::wstring> PluginNameList;
+	typedef std::vector<PluginDeclaration> PluginDeclarations;
+
+	PluginDependencyGraph();
+	explicit PluginDependencyGraph(const PluginDeclarations& declarations);
+
+	void addPlugin(const PluginDeclaration& declaration);
+	bool empty() const;
+
+	const PluginDeclarations& getDeclarations() const;
+
+	/** All eager plugins along with every plugin they transitively require. */
+	PluginNameList getStartupPlugins() const;
+
+	/** Every plugin not returned by getStartupPlugins. */
+	PluginNameList getDeferredPlugins() const;
+
+	/** The plugin and all the plugins it transitively requires. */
+	PluginNameList resolve(const std::wstring& pluginName) const;
+
+	/**
+	* Finds the first declared plugin which provides the interface.
+	* @param typeName the compiler generated type name of the interface.
+	* @return the plugin name or nullptr if no plugin declares the interface.
+	*/
+	const std::wstring* findProvider(const char* typeName) const;
+
+	/**
+	* Finds every plugin which provides the interface, in declaration order.
+	* @param typeName the compiler generated type name of the interface.
+	*/
+	PluginNameList getProviders(const char* typeName) const;
+
+	static bool matchesInterfaceName(const char* typeName, const std::string& interfaceName);
+
+private:
+	typedef std::vector<size_t> IndexList;
+
+	void collect(size_t index, std::vector<bool>& visited) const;
+	PluginNameList sort(const std::vector<bool>& selected) const;
+	void findProviders(const std::string& interfaceName, IndexList& o_Providers) const;
+
+	PluginDeclarations declarations_;
+	std::unordered_map<std::wstring, size_t> indices_;
+};
+} // end namespace wgt
+#endif // PLUGIN_DEPENDENCY_GRAPH_HPP
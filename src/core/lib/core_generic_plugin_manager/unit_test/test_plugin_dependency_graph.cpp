@@ -0,0 +1,130 @@
+#include "pch.hpp"
+
+#include "core_generic_plugin_manager/config_plugin_loader.hpp"
+#include "core_generic_plugin_manager/plugin_dependency_graph.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace wgt
+{
+namespace
+{
+PluginDeclaration makeDeclaration(const wchar_t* name, std::vector<std::string> provides,
+                                  std::vector<std::string> required, bool lazy)
+{
+	PluginDeclaration declaration(name);
+	declaration.provides_ = provides;
+	declaration.requires_ = required;
+	declaration.lazy_ = lazy;
+	return declaration;
+}
+}
+
+//------------------------------------------------------------------------------
+TEST(dependency_graph_keeps_declared_order)
+{
+	PluginDependencyGraph graph;
+	graph.addPlugin(PluginDeclaration(L"plg_a"));
+	graph.addPlugin(PluginDeclaration(L"plg_b"));
+	graph.addPlugin(PluginDeclaration(L"plg_c"));
+
+	auto startup = graph.getStartupPlugins();
+	CHECK_EQUAL(3, startup.size());
+	CHECK(startup[0] == L"plg_a");
+	CHECK(startup[1] == L"plg_b");
+	CHECK(startup[2] == L"plg_c");
+	CHECK(graph.getDeferredPlugins().empty());
+}
+
+//------------------------------------------------------------------------------
+TEST(dependency_graph_defers_lazy_plugins)
+{
+	PluginDependencyGraph graph;
+	graph.addPlugin(makeDeclaration(L"plg_ui", {}, { "IReflection" }, false));
+	graph.addPlugin(makeDeclaration(L"plg_reflection", { "wgt::IReflection" }, {}, true));
+	graph.addPlugin(makeDeclaration(L"plg_history", { "IHistory" }, { "IReflection" }, true));
+
+	// Required lazy plugins are pulled into startup ahead of their dependents
+	auto startup = graph.getStartupPlugins();
+	CHECK_EQUAL(2, startup.size());
+	CHECK(startup[0] == L"plg_reflection");
+	CHECK(startup[1] == L"plg_ui");
+
+	auto deferred = graph.getDeferredPlugins();
+	CHECK_EQUAL(1, deferred.size());
+	CHECK(deferred[0] == L"plg_history");
+
+	auto resolved = graph.resolve(L"plg_history");
+	CHECK_EQUAL(2, resolved.size());
+	CHECK(resolved[0] == L"plg_reflection");
+	CHECK(resolved[1] == L"plg_history");
+}
+
+//------------------------------------------------------------------------------
+TEST(dependency_graph_finds_providers)
+{
+	PluginDependencyGraph graph;
+	graph.addPlugin(makeDeclaration(L"plg_history", { "IHistory" }, {}, true));
+
+	auto provider = graph.findProvider("class wgt::IHistory");
+	CHECK(provider != nullptr && *provider == L"plg_history");
+	provider = graph.findProvider("N3wgt8IHistoryE");
+	CHECK(provider != nullptr && *provider == L"plg_history");
+	CHECK(graph.findProvider("class wgt::INotHistory") == nullptr);
+
+	graph.addPlugin(makeDeclaration(L"plg_history_ui", { "IHistoryUI" }, {}, true));
+	graph.addPlugin(makeDeclaration(L"plg_history_log", { "wgt::IHistory" }, {}, true));
+	auto providers = graph.getProviders("class wgt::IHistory");
+	CHECK_EQUAL(2, providers.size());
+	CHECK(providers[0] == L"plg_history");
+	CHECK(providers[1] == L"plg_history_log");
+	CHECK(graph.getProviders("class wgt::INotHistory").empty());
+}
+
+//------------------------------------------------------------------------------
+TEST(dependency_graph_breaks_cycles)
+{
+	PluginDependencyGraph graph;
+	graph.addPlugin(makeDeclaration(L"plg_a", { "IA" }, { "IB" }, false));
+	graph.addPlugin(makeDeclaration(L"plg_b", { "IB" }, { "IA" }, false));
+
+	auto startup = graph.getStartupPlugins();
+	CHECK_EQUAL(2, startup.size());
+	CHECK(startup[0] == L"plg_a");
+	CHECK(startup[1] == L"plg_b");
+}
+
+//------------------------------------------------------------------------------
+TEST(config_plugin_loader_reads_declarations)
+{
+	const char* fileName = "test_plugin_declarations.txt";
+	{
+		std::ofstream file(fileName);
+		file << "# comment\n";
+		file << "plugins/plg_reflection provides=IDefinitionManager,IObjectManager\n";
+		file << "my plugins/plg_history requires=IDefinitionManager lazy\n";
+		file << "\"plugins/plg lazy\" lazy\n";
+		file << "plugins/plg plain\n";
+	}
+
+	std::vector<PluginDeclaration> declarations;
+	const bool read = ConfigPluginLoader::getPluginDeclarations(declarations, L"test_plugin_declarations.txt");
+	std::remove(fileName);
+	RETURN_ON_FAIL_CHECK(read);
+	RETURN_ON_FAIL_CHECK(declarations.size() == 4);
+
+	CHECK(declarations[0].name_ == L"plugins/plg_reflection");
+	CHECK(declarations[0].provides_ == std::vector<std::string>({ "IDefinitionManager", "IObjectManager" }));
+	CHECK(!declarations[0].lazy_);
+
+	// Paths may contain spaces, and quoted paths keep words which read as attributes
+	CHECK(declarations[1].name_ == L"my plugins/plg_history");
+	CHECK(declarations[1].requires_ == std::vector<std::string>({ "IDefinitionManager" }));
+	CHECK(declarations[1].lazy_);
+	CHECK(declarations[2].name_ == L"plugins/plg lazy");
+	CHECK(declarations[2].lazy_);
+	CHECK(declarations[3].name_ == L"plugins/plg plain");
+	CHECK(!declarations[3].lazy_);
+}
+} // end namespace wgt
@@ -410,10 +410,10 @@ bool ObjectManager::loadObjects(ISerializer& serializer)
 	bool br = false;
 	size_t objCount = 0;
 	br = serializer.deserialize(objCount);
-	for (size_t j = 0; (j < objCount) && br; j++)
+	if (br)
 	{
-		Variant variant;
-		br = serializer.deserialize(variant);
+		std::vector<Variant> objects;
+		br = serializer.deserialize(objects, objCount);
 		TF_ASSERT(br);
 	}
 	return br;
@@ -147,7 +147,8 @@ static PyObject* wrap_setattr(PyObject* self, PyObject* args, void* wrapped)
 	const bool success = pTypeConverters->toVariant(valueObject, variantValue, handle, childPath);
 	assert(success);
 
-	auto listeners = pDefinitionManager->getPropertyAccessorListeners();
+	IDefinitionManager::PropertyAccessorListeners listeners;
+	pDefinitionManager->getPropertyAccessorListeners(propertyAccessor, listeners);
 	const auto itBegin = listeners.cbegin();
 	const auto itEnd = listeners.cend();
 
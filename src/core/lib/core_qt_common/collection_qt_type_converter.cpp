@@ -131,4 +131,9 @@ bool CollectionQtTypeConverter::toQVariant(const Variant& variant, QVariant& o_q
 
 	return true;
 }
+
+void CollectionQtTypeConverter::getVariantTypes(std::vector<TypeId>& o_types) const
+{
+	o_types.push_back(TypeId::getType<Collection>());
+}
 } // end namespace wgt
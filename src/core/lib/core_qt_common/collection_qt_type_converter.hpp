@@ -19,6 +19,8 @@ public:
 	bool toVariant(const QVariant& qVariant, Variant& o_variant) const override;
 
 	bool toQVariant(const Variant& variant, QVariant& o_qVariant, QObject* parent = nullptr) const override;
+
+	void getVariantTypes(std::vector<TypeId>& o_types) const override;
 };
 } // end namespace wgt
 #endif // COLLECTION_QT_TYPE_CONVERTER_HPP
@@ -15,11 +15,16 @@
 #include <core_dependency_system/depends.hpp>
 #include <wg_types/base64.hpp>
 
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <QAbstractItemModel>
 #include <QAbstractProxyModel>
 #include <QDataStream>
+#include <QHash>
 #include <QQmlListProperty>
 #include <QString>
 #include <QUuid>
@@ -209,11 +214,14 @@ private:
 class ModelExtensionData : public IQtModelExtensionData
 {
 	typedef QMap<ItemRole::Id, QVariant> ItemData;
+	typedef QHash<QPersistentModelIndex, int> IndexCache;
+	typedef QHash<QString, int> IndexPathCache;
 
 public:
 	ModelExtensionData(QAbstractItemModel* extendedModel) 
 		: extendedModel_(extendedModel)
 		, internalModel_(nullptr)
+		, extendedRoleProvider_(nullptr)
 		, suppressNotifications_( false )
 	{
 	}
@@ -279,128 +287,111 @@ public:
 				continue;
 			}
 
-			auto roleDecoder = dynamic_cast<RoleProvider*>(extendedModel_);
-			TF_ASSERT(roleDecoder != nullptr);
-			bool decoded = roleDecoder->decodeRole(role, roleId);
+			TF_ASSERT(extendedRoleProvider_ != nullptr);
+			bool decoded = extendedRoleProvider_->decodeRole(role, roleId);
 			TF_ASSERT(decoded);
 
-			extensionRoleIds_.append(roleId);
+			extensionRoleIds_.insert(roleId);
 		}
 	}
 
-	void reset(QAbstractItemModel* internalModel)
-	{
-		save();
-		internalModel_ = internalModel;
-		load();
-		findExtensionRoles();
-	}
-
-	bool encodeRole(ItemRole::Id roleId, int& o_Role) const override
+	/**
+	 *	Finds the role providers down the proxy chain once, and translates
+	 *	every role the chain has a name for, so that looking roles up does
+	 *	not walk the chain again until the next reset.
+	 */
+	void buildRoleTables()
 	{
-		if (roleId == ItemRole::displayId)
-		{
-			o_Role = Qt::DisplayRole;
-			return true;
-		}
-
-		if (roleId == ItemRole::decorationId)
-		{
-			o_Role = Qt::DecorationRole;
-			return true;
-		}
-
-		if (extensionRoleIds_.contains(roleId))
-		{
-			auto roleProvider = dynamic_cast<RoleProvider*>(extendedModel_);
-			TF_ASSERT(roleProvider != nullptr);
-			return roleProvider->encodeRole(roleId, o_Role);
-		}
+		encodedRoles_.clear();
+		decodedRoles_.clear();
+		roleProviders_.clear();
 
+		QVector<QAbstractItemModel*> models;
+		models.append(extendedModel_);
 		auto model = internalModel_;
 		while (model != nullptr)
 		{
+			models.append(model);
 			auto roleProvider = dynamic_cast<RoleProvider*>(model);
-
-			if (roleProvider != nullptr && roleProvider->encodeRole(roleId, o_Role))
+			if (roleProvider != nullptr)
 			{
-				return true;
+				roleProviders_.append(roleProvider);
 			}
 
 			auto proxyModel = dynamic_cast<QAbstractProxyModel*>(model);
 			model = proxyModel == nullptr ? nullptr : proxyModel->sourceModel();
 		}
 
-		if (internalModel_ != nullptr)
+		// roleNames also registers the roles of providers that do so lazily
+		for (auto chainModel : models)
 		{
-			auto roleNames = internalModel_->roleNames();
+			auto roleNames = chainModel->roleNames();
 			for (auto it = roleNames.begin(); it != roleNames.end(); ++it)
 			{
-				if (roleId == ItemRole::compute(it.value().data()))
+				ItemRole::Id roleId;
+				if (decodedRoles_.count(it.key()) != 0 || !translateRole(it.key(), roleId))
 				{
-					o_Role = it.key();
-					return true;
+					continue;
+				}
+				decodedRoles_.emplace(it.key(), roleId);
+
+				int role;
+				if (encodedRoles_.count(roleId) == 0 && translateRoleId(roleId, role))
+				{
+					encodedRoles_.emplace(roleId, role);
 				}
 			}
 		}
+	}
 
-		return false;
+	void reset(QAbstractItemModel* internalModel)
+	{
+		save();
+		internalModel_ = internalModel;
+		extendedRoleProvider_ = dynamic_cast<RoleProvider*>(extendedModel_);
+		load();
+		findExtensionRoles();
+		buildRoleTables();
 	}
 
-	bool decodeRole(int role, ItemRole::Id& o_RoleId) const override
+	bool encodeRole(ItemRole::Id roleId, int& o_Role) const override
 	{
-		if (role == Qt::DisplayRole)
+		auto it = encodedRoles_.find(roleId);
+		if (it != encodedRoles_.end())
 		{
-			o_RoleId = ItemRole::displayId;
+			o_Role = it->second;
 			return true;
 		}
 
-		if (role == Qt::DecorationRole)
+		// a role registered since the last reset
+		if (!translateRoleId(roleId, o_Role))
 		{
-			o_RoleId = ItemRole::decorationId;
-			return true;
+			return false;
 		}
+		encodedRoles_.emplace(roleId, o_Role);
+		return true;
+	}
 
-		auto roleProvider = dynamic_cast<RoleProvider*>(extendedModel_);
-		TF_ASSERT(roleProvider != nullptr);
-		if (roleProvider->decodeRole(role, o_RoleId))
+	bool decodeRole(int role, ItemRole::Id& o_RoleId) const override
+	{
+		auto it = decodedRoles_.find(role);
+		if (it != decodedRoles_.end())
 		{
+			o_RoleId = it->second;
 			return true;
 		}
 
-		auto model = internalModel_;
-		while (model != nullptr)
+		if (!translateRole(role, o_RoleId))
 		{
-			auto roleProvider = dynamic_cast<RoleProvider*>(model);
-
-			if (roleProvider != nullptr && roleProvider->decodeRole(role, o_RoleId))
-			{
-				return true;
-			}
-
-			auto proxyModel = dynamic_cast<QAbstractProxyModel*>(model);
-			model = proxyModel == nullptr ? nullptr : proxyModel->sourceModel();
-		}
-
-		if (internalModel_ != nullptr)
-		{
-			auto roleNames = internalModel_->roleNames();
-			for (auto it = roleNames.begin(); it != roleNames.end(); ++it)
-			{
-				if (role == it.key())
-				{
-					o_RoleId = ItemRole::compute(it.value().data());
-					return true;
-				}
-			}
+			return false;
 		}
-
-		return false;
+		decodedRoles_.emplace(role, o_RoleId);
+		return true;
 	}
 
 	QVariant data(const QModelIndex& index, ItemRole::Id roleId) override
 	{
-		if (extensionRoleIds_.contains(roleId))
+		if (extensionRoleIds_.count(roleId) != 0)
 		{
 			auto& itemData = getItemData(index);
 			return itemData[roleId];
@@ -423,7 +414,7 @@ public:
 
 	bool setData(const QModelIndex& index, const QVariant& value, ItemRole::Id roleId) override
 	{
-		if (extensionRoleIds_.contains(roleId))
+		if (extensionRoleIds_.count(roleId) != 0)
 		{
 			auto& itemData = getItemData(index);
 
@@ -477,7 +468,7 @@ public:
 
 	QVariant headerData(int section, Qt::Orientation orientation, ItemRole::Id roleId) override
 	{
-		if (extensionRoleIds_.contains(roleId))
+		if (extensionRoleIds_.count(roleId) != 0)
 		{
 			auto& headerItemData = getHeaderData(section, orientation);
 			return headerItemData[roleId];
@@ -495,7 +486,7 @@ public:
 
 	bool setHeaderData(int section, Qt::Orientation orientation, const QVariant& value, ItemRole::Id roleId) override
 	{
-		if (extensionRoleIds_.contains(roleId))
+		if (extensionRoleIds_.count(roleId) != 0)
 		{
 			auto& headerItemData = getHeaderData(section, orientation);
 
@@ -525,26 +516,119 @@ public:
 	}
 
 private:
+	bool translateRoleId(ItemRole::Id roleId, int& o_Role) const
+	{
+		if (roleId == ItemRole::displayId)
+		{
+			o_Role = Qt::DisplayRole;
+			return true;
+		}
+
+		if (roleId == ItemRole::decorationId)
+		{
+			o_Role = Qt::DecorationRole;
+			return true;
+		}
+
+		if (extensionRoleIds_.count(roleId) != 0)
+		{
+			TF_ASSERT(extendedRoleProvider_ != nullptr);
+			return extendedRoleProvider_->encodeRole(roleId, o_Role);
+		}
+
+		for (auto roleProvider : roleProviders_)
+		{
+			if (roleProvider->encodeRole(roleId, o_Role))
+			{
+				return true;
+			}
+		}
+
+		if (internalModel_ != nullptr)
+		{
+			auto roleNames = internalModel_->roleNames();
+			for (auto it = roleNames.begin(); it != roleNames.end(); ++it)
+			{
+				if (roleId == ItemRole::compute(it.value().data()))
+				{
+					o_Role = it.key();
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	bool translateRole(int role, ItemRole::Id& o_RoleId) const
+	{
+		if (role == Qt::DisplayRole)
+		{
+			o_RoleId = ItemRole::displayId;
+			return true;
+		}
+
+		if (role == Qt::DecorationRole)
+		{
+			o_RoleId = ItemRole::decorationId;
+			return true;
+		}
+
+		TF_ASSERT(extendedRoleProvider_ != nullptr);
+		if (extendedRoleProvider_->decodeRole(role, o_RoleId))
+		{
+			return true;
+		}
+
+		for (auto roleProvider : roleProviders_)
+		{
+			if (roleProvider->decodeRole(role, o_RoleId))
+			{
+				return true;
+			}
+		}
+
+		if (internalModel_ != nullptr)
+		{
+			auto roleNames = internalModel_->roleNames();
+			for (auto it = roleNames.begin(); it != roleNames.end(); ++it)
+			{
+				if (role == it.key())
+				{
+					o_RoleId = ItemRole::compute(it.value().data());
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
 	ItemData& getItemData(const QModelIndex& index)
 	{
 		auto indexPath = data(index, ItemRole::indexPathId);
-		if (indexPath.isValid())
+		if (indexPath.isValid() && indexPath.canConvert<QString>())
 		{
-			auto it = indexPathCache_.find(indexPath);
-			if (it != indexPathCache_.end())
+			auto path = indexPath.toString();
+			auto it = indexPathCache_.constFind(path);
+			if (it != indexPathCache_.constEnd())
 			{
-				return itemData_[*it];
+				return itemData_[it.value()];
 			}
-			indexPathCache_[indexPath] = itemData_.count();
+			indexPathCache_.insert(path, itemData_.count());
 		}
 		else
 		{
-			auto it = indexCache_.find(index);
-			if (it != indexCache_.end())
+			// Persistent indexes hash on the data the model shares between
+			// them, which follows the row as rows move. Rows that share an
+			// internal id, as rows of list and proxy models do, still differ.
+			QPersistentModelIndex persistentIndex(index);
+			auto it = indexCache_.constFind(persistentIndex);
+			if (it != indexCache_.constEnd())
 			{
-				return itemData_[*it];
+				return itemData_[it.value()];
 			}
-			indexCache_[index] = itemData_.count();
+			indexCache_.insert(persistentIndex, itemData_.count());
 		}
 
 		itemData_.push_back(ItemData());
@@ -569,14 +653,19 @@ private:
 	QAbstractItemModel* internalModel_;
 
 	QVector<ItemData> itemData_;
-	QMap<QPersistentModelIndex, int> indexCache_;
-	QMap<QVariant, int> indexPathCache_;
-	QMap<QAbstractItemModel*, QPair<QVector<ItemData>, QPair<QMap<QPersistentModelIndex, int>, QMap<QVariant, int>>>> savedData_;
+	IndexCache indexCache_;
+	IndexPathCache indexPathCache_;
+	QMap<QAbstractItemModel*, QPair<QVector<ItemData>, QPair<IndexCache, IndexPathCache>>> savedData_;
 
 	std::array<QVector<ItemData>, 2> headerData_;
 	QMap<QAbstractItemModel*, std::array<QVector<ItemData>, 2>> savedHeaderData_;
 
-	QVector<ItemRole::Id> extensionRoleIds_;
+	RoleProvider* extendedRoleProvider_;
+	QVector<RoleProvider*> roleProviders_;
+	mutable std::unordered_map<ItemRole::Id, int> encodedRoles_;
+	mutable std::unordered_map<int, ItemRole::Id> decodedRoles_;
+
+	std::unordered_set<ItemRole::Id> extensionRoleIds_;
 	bool suppressNotifications_;
 };
 
@@ -1655,6 +1744,61 @@ QModelIndex WGItemView::extendedIndex(const QModelIndex& index) const
 	return impl_->extendedModel_->extendedIndex(index);
 }
 
+void WGItemView::prefetch(int firstRow, int count, const QStringList& roles)
+{
+	auto extendedModel = impl_->extendedModel_.get();
+	TF_ASSERT(extendedModel != nullptr);
+	firstRow = std::max(firstRow, 0);
+	count = std::min(count, extendedModel->rowCount(QModelIndex()) - firstRow);
+	if (count <= 0 || roles.isEmpty())
+	{
+		return;
+	}
+
+	// Map the rows down to the model that holds the data
+	QModelIndex sourceParent;
+	const QAbstractItemModel* sourceModel = nullptr;
+	int sourceFirstRow = std::numeric_limits<int>::max();
+	int sourceLastRow = -1;
+	for (int row = firstRow; row < firstRow + count; ++row)
+	{
+		auto index = extendedModel->sourceIndex(extendedModel->index(row, 0, QModelIndex()));
+		while (auto proxyModel = qobject_cast<const QAbstractProxyModel*>(index.model()))
+		{
+			index = proxyModel->mapToSource(index);
+		}
+		if (!index.isValid())
+		{
+			continue;
+		}
+
+		if (sourceModel == nullptr)
+		{
+			sourceModel = index.model();
+			sourceParent = index.parent();
+		}
+		else if (index.model() != sourceModel || index.parent() != sourceParent)
+		{
+			return;
+		}
+		sourceFirstRow = std::min(sourceFirstRow, index.row());
+		sourceLastRow = std::max(sourceLastRow, index.row());
+	}
+
+	// Sorted or filtered rows can be spread over the source, fetching everything between them is wasteful
+	const int sourceCount = sourceLastRow - sourceFirstRow + 1;
+	if (sourceModel == nullptr || sourceCount > count * 4)
+	{
+		return;
+	}
+
+	auto qtModel = dynamic_cast<QtAbstractItemModel*>(const_cast<QAbstractItemModel*>(sourceModel));
+	if (qtModel != nullptr)
+	{
+		qtModel->prefetch(sourceParent, sourceFirstRow, sourceCount, roles);
+	}
+}
+
 QModelIndexList WGItemView::getExtendedIndexes(const QItemSelection& sourceSelection) const
 {
 	QModelIndexList sourceIndexes = sourceSelection.indexes();
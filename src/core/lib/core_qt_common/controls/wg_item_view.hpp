@@ -60,6 +60,14 @@ public:
 	Q_INVOKABLE QModelIndex extendedIndex(const QModelIndex& index) const;
 	Q_INVOKABLE QModelIndexList getExtendedIndexes(const QItemSelection& sourceSelection) const;
 
+	/** Asks the model behind the view to fetch the data of a range of top level rows in one go.
+	    Rows are mapped through the extensions and proxy models, rows that end up scattered across
+	    the source model are not prefetched.
+	    @param firstRow The first row of the view to fetch.
+	    @param count The number of rows to fetch.
+	    @param roles The names of the roles to fetch for every cell. */
+	Q_INVOKABLE void prefetch(int firstRow, int count, const QStringList& roles);
+
 	/** Check if the values in the clipboard can be copied.
 	    @param indexes list of selected items to be copied.
 		@return true if one of the selected items can be copied. */
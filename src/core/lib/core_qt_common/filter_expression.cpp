@@ -1,7 +1,10 @@
 #include "filter_expression.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 
+#include "core_common/assert.hpp"
 #include "core_string_utils/string_utils.hpp"
 
 namespace wgt
@@ -9,31 +12,149 @@ namespace wgt
 namespace Detail
 {
 
-const char * stristr(const char * haystack, size_t haystackLen, const char * needle, size_t needleLen )
+char foldCase(char c)
 {
-	const char * pos = haystack;
-	auto endSearch = pos + haystackLen;
-	while (pos <= endSearch)
+	return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Case insensitive search for a needle which has already been case folded.
+StringRef::size_type find(const StringRef & this_, const std::string & str )
+{
+	if (str.length() > this_.length())
+	{
+		return (StringRef::size_type)-1;
+	}
+
+	const auto endSearch = this_.length() - str.length();
+	for (StringRef::size_type pos = 0; pos <= endSearch; ++pos)
 	{
-		if (_strnicmp(pos, needle, needleLen) == 0)
+		StringRef::size_type i = 0;
+		while (i < str.length() && foldCase(this_.data()[pos + i]) == str[i])
+		{
+			++i;
+		}
+		if (i == str.length())
 		{
 			return pos;
 		}
-		pos++;
 	}
-	return nullptr;
+	return (StringRef::size_type)-1;
 }
 
-
-StringRef::size_type find(const StringRef & this_, const StringRef & str )
+/*
+	Aho-Corasick automaton over a set of case folded terms. Transitions are
+	stored as a dense table over the classes of characters which occur in the
+	terms, with every other character sharing class 0, so a scan costs one
+	table lookup per character regardless of the number of terms.
+*/
+class TermMatcher
 {
-	auto findPos = stristr( this_.data(), this_.length(), str.data(), str.length() );
-	if (findPos != nullptr)
+public:
+	static const size_t MAX_TERMS = 64;
+
+	TermMatcher() : numClasses_(1)
 	{
-		return findPos - str.data();
+		memset(classes_, 0, sizeof(classes_));
 	}
-	return (StringRef::size_type)-1;
-}
+
+	void build(const std::vector<std::string>& terms)
+	{
+		TF_ASSERT(terms.size() <= MAX_TERMS);
+
+		for (auto& term : terms)
+		{
+			for (auto c : term)
+			{
+				auto& cls = classes_[static_cast<unsigned char>(c)];
+				if (cls == 0)
+				{
+					cls = static_cast<uint8_t>(numClasses_++);
+				}
+			}
+		}
+		for (int c = 'A'; c <= 'Z'; ++c)
+		{
+			classes_[c] = classes_[c - 'A' + 'a'];
+		}
+
+		// Build the trie, state 0 being the root
+		transitions_.assign(numClasses_, 0);
+		outputs_.assign(1, 0);
+		for (size_t i = 0; i < terms.size(); ++i)
+		{
+			uint32_t state = 0;
+			for (auto c : terms[i])
+			{
+				auto& next = transitions_[state * numClasses_ + classes_[static_cast<unsigned char>(c)]];
+				if (next == 0)
+				{
+					next = static_cast<uint32_t>(outputs_.size());
+					outputs_.push_back(0);
+					transitions_.resize(transitions_.size() + numClasses_, 0);
+				}
+				state = transitions_[state * numClasses_ + classes_[static_cast<unsigned char>(c)]];
+			}
+			outputs_[state] |= uint64_t(1) << i;
+		}
+
+		// Resolve failure links breadth first, completing the transition table
+		// so that the scan never has to follow them.
+		std::vector<uint32_t> failures(outputs_.size(), 0);
+		std::vector<uint32_t> queue;
+		queue.reserve(outputs_.size());
+		for (size_t cls = 0; cls < numClasses_; ++cls)
+		{
+			if (transitions_[cls] != 0)
+			{
+				queue.push_back(transitions_[cls]);
+			}
+		}
+		for (size_t i = 0; i < queue.size(); ++i)
+		{
+			const auto state = queue[i];
+			const auto failure = failures[state];
+			outputs_[state] |= outputs_[failure];
+			for (size_t cls = 0; cls < numClasses_; ++cls)
+			{
+				auto& next = transitions_[state * numClasses_ + cls];
+				const auto failureNext = transitions_[failure * numClasses_ + cls];
+				if (next != 0)
+				{
+					failures[next] = failureNext;
+					queue.push_back(next);
+				}
+				else
+				{
+					next = failureNext;
+				}
+			}
+		}
+	}
+
+	/*
+		Returns a bitmask of the terms found in the given string, stopping
+		early once every term in allTerms has been found.
+	*/
+	uint64_t scan(const StringRef& str, uint64_t allTerms) const
+	{
+		uint64_t found = 0;
+		uint32_t state = 0;
+		const auto data = str.data();
+		const auto length = str.length();
+		for (StringRef::size_type i = 0; i < length && found != allTerms; ++i)
+		{
+			state = transitions_[state * numClasses_ + classes_[static_cast<unsigned char>(data[i])]];
+			found |= outputs_[state];
+		}
+		return found;
+	}
+
+private:
+	uint8_t classes_[256];
+	size_t numClasses_;
+	std::vector<uint32_t> transitions_;
+	std::vector<uint64_t> outputs_;
+};
 
 template<typename TAddTokenFunc>
 void tokenize(
@@ -121,8 +242,326 @@ bool combineValue(bool a, bool b, FilterExpression::Token::Type t)
 	default: return a;
 	}
 }
+
+struct BitStack
+{
+	BitStack() : bits_(0) {}
+
+	uint64_t bits_;
+
+	void push(bool value) { bits_ = (bits_ << 1) | (value ? 1 : 0); }
+	bool pop() { bool value = (bits_ & 1) != 0; bits_ >>= 1; return value; }
+};
+
+struct VectorStack
+{
+	std::vector<bool> values_;
+
+	void push(bool value) { values_.push_back(value); }
+	bool pop() { bool value = values_.back(); values_.pop_back(); return value; }
+};
 } // namespace Detail
 
+/*
+	An expression compiled into postfix order. VALUE pushes whether a term was
+	found, END pushes a missing value (no match), NOT inverts the top of the
+	stack and the binary operators combine the top two entries. Operators are
+	emitted in the same strict left to right order the expression is read in.
+*/
+struct FilterExpression::Program
+{
+	struct Instruction
+	{
+		Token::Type type_;
+		size_t term_;
+	};
+
+	Program() : valid_(false), allTerms_(0), tokens_(nullptr), pos_(0), depth_(0), stackDepth_(0), end_(Token::END)
+	{
+	}
+
+	bool compile(const std::vector<Token>& tokens)
+	{
+		tokens_ = &tokens;
+		pos_ = 0;
+		valid_ = compileGroup();
+		tokens_ = nullptr;
+		if (!valid_)
+		{
+			return false;
+		}
+
+		if (terms_.size() <= Detail::TermMatcher::MAX_TERMS)
+		{
+			allTerms_ = terms_.size() == Detail::TermMatcher::MAX_TERMS ? ~uint64_t(0) :
+			                                                              (uint64_t(1) << terms_.size()) - 1;
+			matcher_.build(terms_);
+		}
+		return true;
+	}
+
+	bool match(const StringRef& testString) const
+	{
+		if (terms_.size() <= Detail::TermMatcher::MAX_TERMS)
+		{
+			const uint64_t found = matcher_.scan(testString, allTerms_);
+			return run([found](size_t term) { return ((found >> term) & 1) != 0; });
+		}
+
+		std::vector<bool> found(terms_.size());
+		for (size_t i = 0; i < terms_.size(); ++i)
+		{
+			found[i] = Detail::find(testString, terms_[i]) != (StringRef::size_type)-1;
+		}
+		return run([&found](size_t term) { return found[term]; });
+	}
+
+	bool requiredTerms(TermClauses& o_clauses, bool& o_exact) const
+	{
+		struct Requirement
+		{
+			bool constrained_;
+			bool exact_;
+			TermClauses clauses_;
+		};
+
+		// A disjunction of multi clause requirements is expanded up to this many
+		// clauses, beyond which only its first clauses are kept.
+		const size_t kMaxClauses = 16;
+
+		std::vector<Requirement> stack;
+		stack.reserve(stackDepth_);
+		for (auto& instruction : instructions_)
+		{
+			switch (instruction.type_)
+			{
+			case Token::VALUE:
+				stack.push_back(Requirement{ true, true, TermClauses(1, std::vector<std::string>(1, terms_[instruction.term_])) });
+				break;
+			case Token::END:
+				stack.push_back(Requirement{ false, false, TermClauses() });
+				break;
+			case Token::NOT:
+				stack.back() = Requirement{ false, false, TermClauses() };
+				break;
+			default:
+			{
+				Requirement rhs = std::move(stack.back());
+				stack.pop_back();
+				Requirement& lhs = stack.back();
+				if (instruction.type_ == Token::AND)
+				{
+					lhs.constrained_ = lhs.constrained_ || rhs.constrained_;
+					lhs.exact_ = lhs.exact_ && rhs.exact_;
+					for (auto& clause : rhs.clauses_)
+					{
+						lhs.clauses_.push_back(std::move(clause));
+					}
+					break;
+				}
+
+				// OR and XOR both need one side to match
+				if (!lhs.constrained_ || !rhs.constrained_)
+				{
+					lhs = Requirement{ false, false, TermClauses() };
+					break;
+				}
+				lhs.exact_ = lhs.exact_ && rhs.exact_ && instruction.type_ == Token::OR;
+				if (lhs.clauses_.size() * rhs.clauses_.size() > kMaxClauses)
+				{
+					lhs.clauses_.resize(1);
+					rhs.clauses_.resize(1);
+					lhs.exact_ = false;
+				}
+				TermClauses clauses;
+				for (auto& lhsClause : lhs.clauses_)
+				{
+					for (auto& rhsClause : rhs.clauses_)
+					{
+						clauses.push_back(lhsClause);
+						clauses.back().insert(clauses.back().end(), rhsClause.begin(), rhsClause.end());
+					}
+				}
+				lhs.clauses_ = std::move(clauses);
+				break;
+			}
+			}
+		}
+
+		TF_ASSERT(stack.size() == 1);
+		if (!stack.back().constrained_)
+		{
+			return false;
+		}
+		o_clauses = std::move(stack.back().clauses_);
+		o_exact = stack.back().exact_;
+		return true;
+	}
+
+	bool valid_;
+
+private:
+	template <typename TIsFound>
+	bool run(const TIsFound& isFound) const
+	{
+		if (stackDepth_ <= 64)
+		{
+			Detail::BitStack stack;
+			return run(stack, isFound);
+		}
+		Detail::VectorStack stack;
+		return run(stack, isFound);
+	}
+
+	template <typename TStack, typename TIsFound>
+	bool run(TStack& stack, const TIsFound& isFound) const
+	{
+		for (auto& instruction : instructions_)
+		{
+			switch (instruction.type_)
+			{
+			case Token::VALUE:
+				stack.push(isFound(instruction.term_));
+				break;
+			case Token::END:
+				stack.push(false);
+				break;
+			case Token::NOT:
+				stack.push(!stack.pop());
+				break;
+			default:
+			{
+				bool rhs = stack.pop();
+				bool lhs = stack.pop();
+				stack.push(Detail::combineValue(lhs, rhs, instruction.type_));
+				break;
+			}
+			}
+		}
+		return stack.pop();
+	}
+
+	const Token& getLookAhead() const
+	{
+		return pos_ < tokens_->size() ? (*tokens_)[pos_] : end_;
+	}
+
+	const Token& consume()
+	{
+		return pos_ < tokens_->size() ? (*tokens_)[pos_++] : end_;
+	}
+
+	void emit(Token::Type type, size_t term = 0)
+	{
+		instructions_.push_back(Instruction{ type, term });
+		if (type == Token::VALUE || type == Token::END)
+		{
+			stackDepth_ = std::max(stackDepth_, ++depth_);
+		}
+		else if (type != Token::NOT)
+		{
+			--depth_;
+		}
+	}
+
+	size_t addTerm(const StringRef& value)
+	{
+		std::string term(value.data(), value.length());
+		std::transform(term.begin(), term.end(), term.begin(), Detail::foldCase);
+		auto found = std::find(terms_.begin(), terms_.end(), term);
+		if (found != terms_.end())
+		{
+			return found - terms_.begin();
+		}
+		terms_.push_back(std::move(term));
+		return terms_.size() - 1;
+	}
+
+	// Mirrors the grammar of the original recursive evaluator: a group is a
+	// value followed by any number of operator/value pairs, ended by a
+	// GROUP_END or the end of the expression. A NOT is part of its value.
+	bool compileValue()
+	{
+		const Token* tok = &consume();
+		if (tok->type == Token::END)
+		{
+			emit(Token::END);
+			return true;
+		}
+
+		const bool negate = tok->type == Token::NOT;
+		if (negate)
+		{
+			tok = &consume();
+		}
+
+		if (tok->type == Token::VALUE)
+		{
+			emit(Token::VALUE, addTerm(tok->value));
+		}
+		else if (tok->type == Token::GROUP_START)
+		{
+			if (!compileGroup())
+			{
+				return false;
+			}
+		}
+		else
+		{
+			// Syntax error: Unexpected token.
+			return false;
+		}
+
+		if (negate)
+		{
+			emit(Token::NOT);
+		}
+		return true;
+	}
+
+	bool compileGroup()
+	{
+		if (!compileValue())
+		{
+			return false;
+		}
+
+		while (getLookAhead().type != Token::END)
+		{
+			const Token& opToken = consume();
+			if (opToken.type == Token::GROUP_END)
+			{
+				break;
+			}
+
+			if (!Detail::isBinaryOp(opToken.type))
+			{
+				// Syntax error: unexpected token
+				return false;
+			}
+
+			if (!compileValue())
+			{
+				return false;
+			}
+			emit(opToken.type);
+		}
+		return true;
+	}
+
+	std::vector<Instruction> instructions_;
+	std::vector<std::string> terms_;
+	Detail::TermMatcher matcher_;
+	uint64_t allTerms_;
+
+	// Compilation state
+	const std::vector<Token>* tokens_;
+	size_t pos_;
+	size_t depth_;
+	size_t stackDepth_;
+	const Token end_;
+};
+
 FilterExpression::Token::Token(Type t) : type(t), value("") 
 {
 }
@@ -146,6 +585,7 @@ void FilterExpression::reset(const StringRef& expression)
 	expression_ = std::string{expression.data(), expression.length()};
 	StringUtils::trim_string(expression_);
 	tokens_.clear();
+	program_.reset();
 
 	if (expression_.empty())
 	{
@@ -184,6 +624,10 @@ void FilterExpression::reset(const StringRef& expression)
 		}
 		tokens_.emplace_back(parsedToken);
 	});
+
+	auto program = std::make_shared<Program>();
+	program->compile(tokens_);
+	program_ = program;
 }
 
 bool FilterExpression::match(const StringRef& testString) const
@@ -193,126 +637,26 @@ bool FilterExpression::match(const StringRef& testString) const
 		return true;
 	}
 
-	class TokenEvaluator
-	{
-	public:
-		enum Result
-		{
-			MATCHED,
-			NO_MATCH,
-			SYNTAX_ERROR
-		};
-
-		TokenEvaluator(const FilterExpression& expr, StringRef testString) : 
-			expr_(expr), 
-			testString_(testString)
-		{}
-
-		Token getLookAhead() const 
-		{
-			return pos_ < (int)expr_.tokens_.size()-1 ? expr_.tokens_[pos_+1] : end_;
-		};
-
-		Token consume()
-		{
-			return pos_ < (int)expr_.tokens_.size() ? expr_.tokens_[++pos_] : end_;
-		};
-
-		Result consumeValue()
-		{
-			Token tok = consume();
-			if (tok.type == Token::END)
-			{
-				return NO_MATCH;
-			}
-
-			bool isMatched = false;
-			if (tok.type == Token::NOT)
-			{
-				isMatched = true;
-				tok = consume();
-			}
-		
-			if (tok.type == Token::VALUE)
-			{
-				if (Detail::find(testString_, tok.value) != (StringRef::size_type)-1)
-				{
-					isMatched = !isMatched;
-				}
-			}
-			else if (tok.type == Token::GROUP_START)
-			{
-				Result groupResult = consumeGroup();				
-				if (groupResult == MATCHED)
-				{
-					isMatched = !isMatched;
-				}
-				else if (groupResult == SYNTAX_ERROR)
-				{
-					return SYNTAX_ERROR;
-				}
-			}
-			else
-			{
-				// Syntax error: Unexpected token.
-				return SYNTAX_ERROR;
-			}
-
-			return isMatched ? MATCHED : NO_MATCH;
-		}
-
-		Result consumeGroup()
-		{
-			// Consume value -> operator -> value -> operator -> value -> ....
-			// Unary NOT operator is considered part of value.
-			// A group is considered a value and is recursively evaluated.
-			Result result = consumeValue();
-			if (result == SYNTAX_ERROR)
-			{
-				return SYNTAX_ERROR;
-			}
-
-			while (getLookAhead().type != Token::END)
-			{
-				Token opToken = consume();
-				if (opToken.type == Token::GROUP_END)
-				{
-					break;
-				}
-
-				if (!Detail::isBinaryOp(opToken.type))
-				{
-					// Syntax error: unexpected token
-					return SYNTAX_ERROR;
-				}
-
-				Result rhs = consumeValue();
-				if (rhs == SYNTAX_ERROR)
-				{
-					return SYNTAX_ERROR;
-				}
-				
-				bool combination = Detail::combineValue(
-					result == MATCHED ? true : false,
-					rhs == MATCHED ? true : false,
-					opToken.type);
-
-				result = combination ? MATCHED : NO_MATCH;
-			}
-
-			return result;
-		}
+	// Not currently signaling syntax error to user. Just never match if was a problem.
+	return program_->valid_ && program_->match(testString);
+}
 
-	private:
-		const FilterExpression& expr_;
-		int pos_ = -1;
-		StringRef testString_;
-		Token end_{Token::END, ""};
-	};
+bool FilterExpression::getRequiredTerms(TermClauses& o_clauses, bool& o_exact) const
+{
+	o_clauses.clear();
+	o_exact = false;
+	if (tokens_.empty())
+	{
+		return false;
+	}
 
-	// Not currently signaling syntax error to user. Just never match if was a problem.
-	TokenEvaluator evaluator(*this, testString);
-	return evaluator.consumeGroup() == TokenEvaluator::MATCHED ? true : false;
+	if (!program_->valid_)
+	{
+		// Never matches, so no string can satisfy the single empty clause
+		o_clauses.resize(1);
+		return true;
+	}
+	return program_->requiredTerms(o_clauses, o_exact);
 }
 
 size_t FilterExpression::getNumTokens() const
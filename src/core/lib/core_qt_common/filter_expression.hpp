@@ -5,6 +5,7 @@
 
 #include <QString>
 
+#include <memory>
 #include <vector>
 
 namespace wgt
@@ -17,19 +18,31 @@ public:
 
 	/*
 		Resets the expression represented by this FilterExpression instance,
-		by tokenizing the given string. This will not report any syntactical
-		errors, since FilterExpression is an "interpreter" and won't know if
-		there's a problem until you call match().
+		by tokenizing the given string. The tokens are compiled once into a
+		flat evaluation program over the unique value terms. This will not
+		report any syntactical errors, an expression with a problem simply
+		never matches.
 	*/
 	void reset(const StringRef& expression);
 
 	/*
 		Performs a a test against the given string to see if there
 		is a match. Always returns false (i.e. no match) if there is
-		a syntax error.
+		a syntax error. All value terms are searched for, case insensitively,
+		in a single pass over the string.
 	*/
 	bool match(const StringRef& testString) const;
 
+	/*
+		Collects the case folded terms a string must contain to be able to match,
+		as a list of clauses which each need at least one of their terms present.
+		o_exact is set if containing them is also sufficient for a match. Returns
+		false if the expression places no such requirement on a string, e.g. when
+		it only excludes terms.
+	*/
+	typedef std::vector<std::vector<std::string>> TermClauses;
+	bool getRequiredTerms(TermClauses& o_clauses, bool& o_exact) const;
+
 	/*
 		Returns if the expression is currently empty (i.e. equivalent to "" expression).
 	*/
@@ -68,8 +81,11 @@ public:
 	const Token& getToken(const size_t i) const;
 
 private:
+	struct Program;
+
 	std::string expression_;
 	std::vector<Token> tokens_;
+	std::shared_ptr<const Program> program_;
 };
 } // end namespace wgt
 
@@ -16,6 +16,7 @@ class QUrl;
 namespace wgt
 {
 class IQtTypeConverter;
+class QmlComponentCache;
 class QtGlobalSettings;
 class QtPalette;
 class Variant;
@@ -29,6 +30,7 @@ public:
 
 	virtual QQmlEngine* qmlEngine() const = 0;
 	virtual QFileSystemWatcher* qmlWatcher() const = 0;
+	virtual QmlComponentCache* qmlComponentCache() const = 0;
 	virtual void setIncubationTime(int msecs) = 0;
 	virtual void incubate() = 0;
 	virtual QtPalette* palette() const = 0;
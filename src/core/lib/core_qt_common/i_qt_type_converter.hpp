@@ -5,6 +5,7 @@
 #include "core_variant/variant.hpp"
 #include "core_reflection/ref_object_id.hpp"
 #include <QVariant>
+#include <vector>
 
 Q_DECLARE_METATYPE(std::shared_ptr<wgt::BinaryBlock>);
 Q_DECLARE_METATYPE(wgt::Variant);
@@ -43,6 +44,24 @@ public:
 	{
 		return false;
 	};
+
+	/**
+	 *	Optional index hint for QtTypeConverterRegistry.
+	 *	Converters which only accept Variants whose type() is exactly one of a
+	 *	known set of types should list them, so they are skipped for all others.
+	 *	Leaving this empty means the converter is tried for every Variant.
+	 */
+	virtual void getVariantTypes(std::vector<TypeId>& o_types) const
+	{
+	}
+
+	/**
+	 *	Optional index hint for QtTypeConverterRegistry.
+	 *	As getVariantTypes, but for the QVariant::userType() values accepted by toVariant.
+	 */
+	virtual void getQVariantTypes(std::vector<int>& o_types) const
+	{
+	}
 };
 
 template <typename T, typename U = T>
@@ -66,6 +85,20 @@ public:
 		return true;
 	}
 
+	void getQVariantTypes(std::vector<int>& o_types) const override
+	{
+		o_types.push_back(qMetaTypeId<U>());
+	}
+
+	void getVariantTypes(std::vector<TypeId>& o_types) const override
+	{
+		// Variant accepts any non-null pointer, so it cannot be indexed by type
+		if (TypeId::getType<T>() != TypeId::getType<Variant>())
+		{
+			o_types.push_back(TypeId::getType<T>());
+		}
+	}
+
 	bool toQVariant(const Variant& variant, QVariant& o_qVariant, QObject* parent = nullptr) const override
 	{
 		if (TypeId::getType<T>() == TypeId::getType<Variant>())
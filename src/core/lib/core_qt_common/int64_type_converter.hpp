@@ -38,6 +38,16 @@ public:
 		}
 		return false;
 	}
+
+	void getVariantTypes(std::vector<TypeId>& o_types) const override
+	{
+		o_types.push_back(TypeId::getType<typename T::value_type>());
+	}
+
+	void getQVariantTypes(std::vector<int>& o_types) const override
+	{
+		o_types.push_back(qMetaTypeId<std::shared_ptr<T>>());
+	}
 };
 
 } // end namespace wgt
@@ -120,4 +120,13 @@ bool ModelQtTypeConverter::toQVariant(const Variant& variant, QVariant& o_qVaria
 
 	return false;
 }
+
+void ModelQtTypeConverter::getVariantTypes(std::vector<TypeId>& o_types) const
+{
+	o_types.push_back(TypeId::getType<AbstractItemModel>());
+	o_types.push_back(TypeId::getType<AbstractListModel>());
+	o_types.push_back(TypeId::getType<AbstractTreeModel>());
+	o_types.push_back(TypeId::getType<AbstractTableModel>());
+	o_types.push_back(TypeId::getType<ObjectHandle>());
+}
 } // end namespace wgt
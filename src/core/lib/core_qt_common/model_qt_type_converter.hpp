@@ -10,6 +10,7 @@ class ModelQtTypeConverter : public IQtTypeConverter
 public:
 	bool toVariant(const QVariant& qVariant, Variant& o_variant) const override;
 	bool toQVariant(const Variant& variant, QVariant& o_qVariant, QObject* parent) const override;
+	void getVariantTypes(std::vector<TypeId>& o_types) const override;
 };
 } // end namespace wgt
 #endif
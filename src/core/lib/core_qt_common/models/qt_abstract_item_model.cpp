@@ -198,6 +198,10 @@ bool QtAbstractItemModel::moveRow(QObject* sourceParent, int sourceRow, QObject*
 	return result;
 }
 
+void QtAbstractItemModel::prefetch(const QModelIndex& parent, int firstRow, int count, const QStringList& roles)
+{
+}
+
 bool QtAbstractItemModel::hasChildren(const QModelIndex& parent) const
 {
 	return QAbstractItemModel::hasChildren(parent);
@@ -145,6 +145,16 @@ public:
 	@return True if the move was successful. */
 	Q_INVOKABLE bool moveRow(QObject* sourceParent, int sourceRow, QObject* destinationParent, int destinationChild);
 
+	/** Hints that a range of rows is about to be displayed, so their data can be fetched as one block.
+	Virtualized views should call this with their visible rows before creating delegates.
+	@ingroup qmlaccessible
+	@note The default implementation does nothing.
+	@param parent The parent index containing the rows.
+	@param firstRow The first row to fetch.
+	@param count The number of rows to fetch.
+	@param roles The names of the roles to fetch for every cell. */
+	Q_INVOKABLE virtual void prefetch(const QModelIndex& parent, int firstRow, int count, const QStringList& roles);
+
 	// Explicitly declare virtual functions from QAbstractItemModel to prevent them from being hidden
 
 	/** Returns the parent index of a child index.
@@ -21,8 +21,10 @@
 
 
 #include <QMimeData>
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace std {
 template <>
@@ -92,6 +94,15 @@ public:
 	@return The number of indices under the parent index. */
 	bool hasChildren(const QModelIndex& parent) const override;
 
+	/** Fetches the roles of a range of rows from the source model as one block.
+	Subsequent data() queries for those cells are served from the fetched block until
+	the next prefetch or until the source model reports a change.
+	@param parent The parent index containing the rows.
+	@param firstRow The first row to fetch.
+	@param count The number of rows to fetch.
+	@param roles The names of the roles to fetch for every cell. */
+	void prefetch(const QModelIndex& parent, int firstRow, int count, const QStringList& roles) override;
+
 	/** Gets role data from an item at an index position.
 	This converts the index and role to the format of the source model, calls
 	the source model's getData, converts the value to a Qt compatible value,
@@ -222,8 +233,13 @@ public:
 private:
 
 	QModelIndex getCachedParentIndex(const QModelIndex& childIndex) const;
+	bool getPrefetchedData(const QModelIndex& index, int role, Variant& o_Value) const;
+	void clearPrefetchedData();
 
 	mutable std::unordered_map<QModelIndex, QModelIndex>	childToParentIndexCache_;
+	std::unordered_map<QModelIndex, size_t>					prefetchedIndices_;
+	std::vector<int>										prefetchedRoles_;
+	std::vector<Variant>									prefetchedValues_;
 	AbstractItemModel&										source_;
 	ConnectionHolder										connections_;
 
@@ -273,6 +289,7 @@ QtItemModel<BaseModel>::QtItemModel(SourceType& source)
 {
 	registerInterface(*this);
 	auto changed = [this]() {
+		this->clearPrefetchedData();
 		this->modelChanged();
 		this->childToParentIndexCache_.clear();
 	};
@@ -284,6 +301,7 @@ QtItemModel<BaseModel>::QtItemModel(SourceType& source)
 	connections_.add(source_.connectPreModelReset(preReset));
 
 	auto postReset = [this]() {
+		this->clearPrefetchedData();
 		this->childToParentIndexCache_.clear();
 		this->endResetModel();
 		this->modelResetComplete();
@@ -306,6 +324,7 @@ QtItemModel<BaseModel>::QtItemModel(SourceType& source)
 
 		QList<QPersistentModelIndex> parents;
 		parents.append(modelIndex.isValid() ? modelIndex : QModelIndex());
+		this->clearPrefetchedData();
 		this->childToParentIndexCache_.clear();
 		this->layoutChanged(parents, QAbstractItemModel::VerticalSortHint);
 		this->layoutChangedComplete();
@@ -314,6 +333,7 @@ QtItemModel<BaseModel>::QtItemModel(SourceType& source)
 
 	auto postItemData = [this](const AbstractItemModel::ItemIndex& index, ItemRole::Id roleId,
 	                           const Variant& newValue) {
+		this->clearPrefetchedData();
 		auto item = source_.item(index);
 		const QModelIndex modelIndex = this->createIndex(index.row_, index.column_, item);
 
@@ -354,6 +374,7 @@ QtItemModel<BaseModel>::QtItemModel(SourceType& source)
 	connections_.add(source_.connectPreRowsInserted(preInsert));
 
 	auto postInserted = [this](const AbstractItemModel::ItemIndex& parentIndex, int startPos, int count) {
+		this->clearPrefetchedData();
 		this->childToParentIndexCache_.clear();
 		this->endInsertRows();
 	};
@@ -367,6 +388,7 @@ QtItemModel<BaseModel>::QtItemModel(SourceType& source)
 	connections_.add(source_.connectPreRowsRemoved(preErase));
 
 	auto postErased = [this](const AbstractItemModel::ItemIndex& parentIndex, int startPos, int count) {
+		this->clearPrefetchedData();
 		this->childToParentIndexCache_.clear();
 		this->endRemoveRows();
 	};
@@ -389,6 +411,7 @@ QtItemModel<BaseModel>::QtItemModel(SourceType& source)
 	auto postMoved = [this](const AbstractItemModel::ItemIndex& sourceParentIndex, int sourceFirst, int sourceLast,
 	                        const AbstractItemModel::ItemIndex& destinationParentIndex,
 	                        int destinationRow) {
+		this->clearPrefetchedData();
 		this->endMoveRows();
 		this->childToParentIndexCache_.clear();
 	};
@@ -462,6 +485,91 @@ bool QtItemModel<BaseModel>::hasChildren(const QModelIndex& parent) const
 	return source_.hasChildren(parentItem);
 }
 
+template <class BaseModel>
+void QtItemModel<BaseModel>::prefetch(const QModelIndex& parent, int firstRow, int count, const QStringList& roles)
+{
+	clearPrefetchedData();
+
+	auto parentItem = parent.isValid() ? reinterpret_cast<AbstractItem*>(parent.internalId()) : nullptr;
+	firstRow = std::max(firstRow, 0);
+	count = std::min(count, source_.rowCount(parentItem) - firstRow);
+	const int columnCount = source_.columnCount(parentItem);
+	if (count <= 0 || columnCount <= 0)
+	{
+		return;
+	}
+
+	const auto names = this->roleNames();
+	std::vector<ItemRole::Id> roleIds;
+	for (const auto& name : roles)
+	{
+		const int role = names.key(name.toUtf8(), -1);
+		ItemRole::Id roleId;
+		if (role != -1 && decodeRole(role, roleId))
+		{
+			prefetchedRoles_.push_back(role);
+			roleIds.push_back(roleId);
+		}
+	}
+	if (roleIds.empty())
+	{
+		return;
+	}
+
+	// The source resolves the items of the block along with their data, so they are not looked up again
+	std::vector<const AbstractItem*> items(static_cast<size_t>(count) * static_cast<size_t>(columnCount), nullptr);
+	AbstractItemModel::DataBlock block(parentItem, firstRow, count, 0, columnCount, roleIds.data(), roleIds.size());
+	block.items_ = items.data();
+	source_.prefetchDataBlock(block);
+	prefetchedValues_.resize(block.size());
+	source_.getDataBlock(block, prefetchedValues_.data());
+
+	prefetchedIndices_.reserve(items.size());
+	for (int row = firstRow; row < firstRow + count; ++row)
+	{
+		for (int column = 0; column < columnCount; ++column)
+		{
+			auto item = items[block.itemOffset(row, column)];
+			if (item != nullptr)
+			{
+				prefetchedIndices_[this->createIndex(row, column, const_cast<AbstractItem*>(item))] =
+				block.offset(row, column, 0);
+			}
+		}
+	}
+}
+
+template <class BaseModel>
+bool QtItemModel<BaseModel>::getPrefetchedData(const QModelIndex& index, int role, Variant& o_Value) const
+{
+	if (prefetchedIndices_.empty())
+	{
+		return false;
+	}
+
+	auto foundIndex = prefetchedIndices_.find(index);
+	if (foundIndex == prefetchedIndices_.end())
+	{
+		return false;
+	}
+
+	auto foundRole = std::find(prefetchedRoles_.begin(), prefetchedRoles_.end(), role);
+	if (foundRole == prefetchedRoles_.end())
+	{
+		return false;
+	}
+
+	o_Value = prefetchedValues_[foundIndex->second + (foundRole - prefetchedRoles_.begin())];
+	return true;
+}
+
+template <class BaseModel>
+void QtItemModel<BaseModel>::clearPrefetchedData()
+{
+	prefetchedIndices_.clear();
+	prefetchedRoles_.clear();
+	prefetchedValues_.clear();
+}
 
 //------------------------------------------------------------------------------
 template <class BaseModel>
@@ -485,6 +593,12 @@ Variant QtItemModel<BaseModel>::variantData(
 		}
 		return Variant();
 	}
+
+	Variant prefetched;
+	if (getPrefetchedData(index, role, prefetched))
+	{
+		return prefetched;
+	}
 	return item->getData(index.row(), index.column(), roleId);
 }
 
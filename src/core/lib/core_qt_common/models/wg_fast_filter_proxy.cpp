@@ -6,15 +6,19 @@
 #include "core_qt_common/interfaces/i_wgt_item_model.hpp"
 #include "core_qt_common/models/wgt_item_model_base.hpp"
 #include "core_qt_common/filter_expression.hpp"
+#include "core_qt_common/trigram_index.hpp"
 #include "wg_types/shared_string.hpp"
 #include "core_variant/variant.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 namespace wgt
 {
 
 struct WGFastFilterProxy::Impl
 {
-	Impl() : compare_(*this), filterRole_("display")
+	Impl() : compare_(*this), index_(sourceValues_), filterRole_("display"), mappedExact_(false), sourceToProxyDirty_(true)
 	{
 
 	}
@@ -48,15 +52,23 @@ struct WGFastFilterProxy::Impl
 			return QModelIndex();
 		}
 
+		if (sourceToProxyDirty_)
+		{
+			sourceToProxy_.assign(sourceValues_.size(), -1);
+			for (size_t proxyRow = 0; proxyRow < mappedItems_.size(); ++proxyRow)
+			{
+				sourceToProxy_[mappedItems_[proxyRow]] = static_cast<int>(proxyRow);
+			}
+			sourceToProxyDirty_ = false;
+		}
+
 		auto sourceRow = sourceIndex.row();
-		auto it = std::find(mappedItems_.begin(), mappedItems_.end(), sourceRow);
-		if (it == mappedItems_.end())
+		if (sourceRow < 0 || sourceRow >= static_cast<int>(sourceToProxy_.size()) || sourceToProxy_[sourceRow] == -1)
 		{
 			return QModelIndex();
 		}
 
-		auto proxyRow = std::distance(mappedItems_.begin(), it);
-		return proxyModel.index(proxyRow, sourceIndex.column());
+		return proxyModel.index(sourceToProxy_[sourceRow], sourceIndex.column());
 	}
 
 	void reset()
@@ -64,12 +76,19 @@ struct WGFastFilterProxy::Impl
 		sourceValues_.clear();
 		sortedSourceValueIndices_.clear();
 		mappedItems_.clear();
+		index_.clear();
+		mappedClauses_.clear();
+		mappedExact_ = false;
+		sourceToProxyDirty_ = true;
 	}
 
 	void cacheSourceValues(const QAbstractItemModel& sourceModel)
 	{
 		sourceValues_.clear();
 		sortedSourceValueIndices_.clear();
+		index_.clear();
+		mappedClauses_.clear();
+		mappedExact_ = false;
 
 		filterRoleId_ = -1;
 		auto roleNames = sourceModel.roleNames();
@@ -95,7 +114,7 @@ struct WGFastFilterProxy::Impl
 		QueryHelper queryHelper;
 		wgtItemModel = wgtItemModel && wgtItemModel->canUse(queryHelper) ? wgtItemModel : nullptr;
 
-		SharedString sourceValue;
+		SharedString sharedValue;
 		for (auto row = 0; row < rowCount; ++row)
 		{
 			auto sourceIndex = sourceModel.index(row, 0);
@@ -106,15 +125,18 @@ struct WGFastFilterProxy::Impl
 				auto sourceData = 
 					wgtItemModel->variantData( 
 						queryHelper, sourceIndex, filterRoleId_);
-				ok = sourceData.tryCast(sourceValue);
+				ok = sourceData.tryCast(sharedValue);
+				if (ok)
+				{
+					sourceValues_.push_back(sharedValue.str());
+				}
 			}
 
 			if (ok == false)
 			{
 				auto sourceData = sourceModel.data(sourceIndex, filterRoleId_);
-				sourceValue = sourceData.toString().toUtf8().data();
+				sourceValues_.push_back(sourceData.toString().toUtf8().data());
 			}
-			sourceValues_.push_back(sourceValue);
 		}
 
 		sortedSourceValueIndices_.reserve(rowCount);
@@ -123,23 +145,67 @@ struct WGFastFilterProxy::Impl
 			sortedSourceValueIndices_.push_back(i);
 		}
 		std::sort(sortedSourceValueIndices_.begin(), sortedSourceValueIndices_.end(), compare_);
+
+		index_.rebuild();
 	}
 
 	void map()
 	{
-		mappedItems_.clear();
+		FilterExpression::TermClauses clauses;
+		bool exact = false;
+		const bool constrained = filterExpression_.getRequiredTerms(clauses, exact);
 
-		size_t rowCount = sourceValues_.size();
-		mappedItems_.reserve(rowCount);
+		// Only the rows which contain the required terms need to be matched. If every
+		// string the new filter accepts also satisfies the terms of the last filter
+		// exactly, e.g. while more characters are typed, the last result is narrowed.
+		std::vector<int> candidates;
+		if (constrained && mappedExact_ && narrows(clauses, mappedClauses_))
+		{
+			candidates.swap(mappedItems_);
+		}
+		else if (!constrained || !index_.findCandidates(clauses, candidates))
+		{
+			candidates.resize(sourceValues_.size());
+			for (size_t row = 0; row < candidates.size(); ++row)
+			{
+				candidates[row] = static_cast<int>(row);
+			}
+		}
 
-		for (size_t row = 0; row < rowCount; ++row)
+		mappedItems_.clear();
+		mappedItems_.reserve(candidates.size());
+		for (auto row : candidates)
 		{
 			auto && sourceValue = sourceValues_[row];
-			if (filterExpression_.match(sourceValue.str()))
+			if (filterExpression_.match(sourceValue))
+			{
+				mappedItems_.push_back(row);
+			}
+		}
+
+		mappedClauses_.swap(clauses);
+		mappedExact_ = constrained && exact;
+		sourceToProxyDirty_ = true;
+	}
+
+	// Returns true if satisfying the clauses implies satisfying the previous clauses.
+	static bool narrows(const FilterExpression::TermClauses& clauses, const FilterExpression::TermClauses& previousClauses)
+	{
+		for (auto& previousClause : previousClauses)
+		{
+			auto implied = std::any_of(clauses.begin(), clauses.end(), [&previousClause](const std::vector<std::string>& clause) {
+				return std::all_of(clause.begin(), clause.end(), [&previousClause](const std::string& term) {
+					return std::any_of(previousClause.begin(), previousClause.end(), [&term](const std::string& previousTerm) {
+						return term.find(previousTerm) != std::string::npos;
+					});
+				});
+			});
+			if (!implied)
 			{
-				mappedItems_.push_back(static_cast<int>(row));
+				return false;
 			}
 		}
+		return true;
 	}
 
 	class SourceValueCompare
@@ -149,12 +215,12 @@ struct WGFastFilterProxy::Impl
 
 		bool operator()(const size_t &a, const size_t &b)
 		{
-			return _stricmp(impl_.sourceValues_[a]->c_str(), impl_.sourceValues_[b]->c_str()) < 0;
+			return _stricmp(impl_.sourceValues_[a].c_str(), impl_.sourceValues_[b].c_str()) < 0;
 		}
 
 		bool operator()(const size_t &a, const std::string &value)
 		{
-			return _stricmp( impl_.sourceValues_[a]->c_str(), value.c_str() ) < 0;
+			return _stricmp( impl_.sourceValues_[a].c_str(), value.c_str() ) < 0;
 		}
 
 	private:
@@ -163,13 +229,20 @@ struct WGFastFilterProxy::Impl
 
 	QtConnectionHolder connections_;
 	SourceValueCompare compare_;
-	std::vector<SharedString> sourceValues_;
+	std::vector<std::string> sourceValues_;
 	std::vector<size_t> sortedSourceValueIndices_;
+	TrigramIndex index_;
 	std::vector<int> mappedItems_;
 	std::string filterRole_;
 	std::string filterText_;
 	FilterExpression filterExpression_;
 	int filterRoleId_;
+	// required terms of the filter mappedItems_ was built with
+	FilterExpression::TermClauses mappedClauses_;
+	bool mappedExact_;
+	// source row -> proxy row, rebuilt on demand after mappedItems_ changes
+	std::vector<int> sourceToProxy_;
+	bool sourceToProxyDirty_;
 };
 
 WGFastFilterProxy::WGFastFilterProxy() : impl_(new Impl())
@@ -340,9 +413,9 @@ QString WGFastFilterProxy::tryComplete(const QString& str, bool multi) const
 	if (it != impl_->sortedSourceValueIndices_.end())
 	{
 		auto& sourceValue = impl_->sourceValues_[*it];
-		if (_strnicmp(sourceValue->c_str(), testStr.c_str(), testStr.size() ) == 0)
+		if (_strnicmp(sourceValue.c_str(), testStr.c_str(), testStr.size() ) == 0)
 		{
-			return (data.substr(0, pos + 1) + sourceValue.str()).c_str();
+			return (data.substr(0, pos + 1) + sourceValue).c_str();
 		}
 	}
 
@@ -458,8 +531,8 @@ void WGFastFilterProxy::onSourceDataChanged(const QModelIndex& topLeft, const QM
 	auto proxyBegin = std::lower_bound(impl_->mappedItems_.begin(), impl_->mappedItems_.end(), sourceFirst);
 	auto proxyEnd = std::upper_bound(impl_->mappedItems_.begin(), impl_->mappedItems_.end(), sourceLast);
 
-	auto proxyFirst = std::distance(impl_->mappedItems_.begin(), proxyBegin);
-	auto proxyLast = std::distance(impl_->mappedItems_.begin(), proxyEnd) - 1;
+	auto proxyFirst = static_cast<int>(std::distance(impl_->mappedItems_.begin(), proxyBegin));
+	auto proxyLast = static_cast<int>(std::distance(impl_->mappedItems_.begin(), proxyEnd)) - 1;
 
 	auto sourceCount = sourceLast - sourceFirst + 1;
 	std::vector<int> mappedItems;
@@ -470,7 +543,8 @@ void WGFastFilterProxy::onSourceDataChanged(const QModelIndex& topLeft, const QM
 		auto sourceIndex = source->index(sourceRow, 0);
 		auto sourceData = source->data(sourceIndex, impl_->filterRoleId_);
 		*it = sourceData.toString().toUtf8().data();
-		if (impl_->filterExpression_.match(it->str()))
+		impl_->index_.changeRow(sourceRow);
+		if (impl_->filterExpression_.match(*it))
 		{
 			mappedItems.push_back(sourceRow);
 		}
@@ -480,10 +554,18 @@ void WGFastFilterProxy::onSourceDataChanged(const QModelIndex& topLeft, const QM
 	auto preProxyCount = static_cast<int>(std::distance(proxyBegin, proxyEnd));
 	auto postProxyCount = static_cast<int>(mappedItems.size());
 
+	auto replaceMappedItems = [&]() {
+		auto begin = impl_->mappedItems_.begin() + proxyFirst;
+		impl_->mappedItems_.erase(begin, begin + preProxyCount);
+		impl_->mappedItems_.insert(impl_->mappedItems_.begin() + proxyFirst, mappedItems.begin(), mappedItems.end());
+		impl_->sourceToProxyDirty_ = true;
+	};
+
 	if (preProxyCount > postProxyCount)
 	{
 		auto removeCount = preProxyCount - postProxyCount;
 		beginRemoveRows(QModelIndex(), proxyFirst, proxyFirst + removeCount - 1);
+		replaceMappedItems();
 		endRemoveRows();
 		proxyLast -= removeCount;
 	}
@@ -491,11 +573,20 @@ void WGFastFilterProxy::onSourceDataChanged(const QModelIndex& topLeft, const QM
 	{
 		auto insertCount = postProxyCount - preProxyCount;
 		beginInsertRows(QModelIndex(), proxyFirst, proxyFirst + insertCount - 1);
+		replaceMappedItems();
 		endInsertRows();
 		proxyLast += insertCount;
 	}
+	else
+	{
+		replaceMappedItems();
+	}
+
+	if (proxyFirst > proxyLast)
+	{
+		return;
+	}
 
-	TF_ASSERT(proxyFirst <= proxyLast);
 	auto proxyTopLeft = index(proxyFirst, 0);
 	auto proxyBottomRight = index(proxyLast, columnCount() - 1);
 	dataChanged(proxyTopLeft, proxyBottomRight);
@@ -517,9 +608,7 @@ void WGFastFilterProxy::onSourceRowsInserted(const QModelIndex& parent, int firs
 	{
 		auto sourceIndex = source->index(sourceRow, 0);
 		auto sourceData = source->data(sourceIndex, impl_->filterRoleId_);
-		std::string sourceValue = sourceData.toString().toUtf8().data();
-		std::transform(sourceValue.begin(), sourceValue.end(), sourceValue.begin(), ::tolower);
-		sourceValues.push_back(sourceValue);
+		sourceValues.push_back(sourceData.toString().toUtf8().data());
 	}
 
 	auto sourceCount = static_cast<int>(sourceValues.size());
@@ -527,8 +616,7 @@ void WGFastFilterProxy::onSourceRowsInserted(const QModelIndex& parent, int firs
 	mappedItems.reserve(sourceCount);
 	for (auto i = 0; i < sourceCount; ++i)
 	{
-		auto sourceValue = sourceValues[i];
-		if (impl_->filterExpression_.match(sourceValue))
+		if (impl_->filterExpression_.match(sourceValues[i]))
 		{
 			mappedItems.push_back(first + i);
 		}
@@ -547,6 +635,7 @@ void WGFastFilterProxy::onSourceRowsInserted(const QModelIndex& parent, int firs
 	auto sourceBegin = impl_->sourceValues_.begin();
 	std::advance(sourceBegin, first);
 	impl_->sourceValues_.insert(sourceBegin, sourceValues.begin(), sourceValues.end());
+	impl_->index_.insertRows(first, sourceCount);
 	for (auto& sortedSourceValueIndex : impl_->sortedSourceValueIndices_)
 	{
 		if (static_cast<int>(sortedSourceValueIndex) >= first)
@@ -565,6 +654,7 @@ void WGFastFilterProxy::onSourceRowsInserted(const QModelIndex& parent, int firs
 		*it += sourceCount;
 	}
 	impl_->mappedItems_.insert(proxyBegin, mappedItems.begin(), mappedItems.end());
+	impl_->sourceToProxyDirty_ = true;
 
 	if (proxyCount > 0)
 	{
@@ -582,31 +672,10 @@ void WGFastFilterProxy::onSourceRowsRemoved(const QModelIndex& parent, int first
 	TF_ASSERT(first <= last);
 	auto sourceCount = last - first + 1;
 
-	auto proxyFirst = -1;
-	auto proxyLast = -1;
-	auto proxyShift = -1;
-	auto proxyRowCount = impl_->mappedItems_.size();
-	for (size_t proxyRow = 0; proxyRow < proxyRowCount; ++proxyRow)
-	{
-		auto sourceRow = impl_->mappedItems_[proxyRow];
-		if (sourceRow < first)
-		{
-			continue;
-		}
-
-		if (sourceRow > last)
-		{
-			proxyShift = static_cast<int>(proxyRow);
-			break;
-		}
-
-		if (proxyFirst == -1)
-		{
-			proxyFirst = static_cast<int>(proxyRow);
-		}
-		proxyLast = static_cast<int>(proxyRow);
-	}
-	TF_ASSERT(proxyFirst <= proxyLast);
+	auto proxyBegin = std::lower_bound(impl_->mappedItems_.begin(), impl_->mappedItems_.end(), first);
+	auto proxyEnd = std::upper_bound(proxyBegin, impl_->mappedItems_.end(), last);
+	auto proxyFirst = static_cast<int>(std::distance(impl_->mappedItems_.begin(), proxyBegin));
+	auto proxyLast = static_cast<int>(std::distance(impl_->mappedItems_.begin(), proxyEnd)) - 1;
 
 	auto sourceEnd = impl_->sourceValues_.begin();
 	std::advance(sourceEnd, last + 1);
@@ -614,43 +683,34 @@ void WGFastFilterProxy::onSourceRowsRemoved(const QModelIndex& parent, int first
 	TF_ASSERT(std::distance(sourceBegin, sourceEnd) <= static_cast<ptrdiff_t>(impl_->sourceValues_.size()));
 	std::advance(sourceBegin, first);
 	impl_->sourceValues_.erase(sourceBegin, sourceEnd);
-	for (auto i = 0; i < sourceCount; ++i)
-	{
-		auto it = std::find(impl_->sortedSourceValueIndices_.begin(), impl_->sortedSourceValueIndices_.end(), first + i);
-		TF_ASSERT(it != impl_->sortedSourceValueIndices_.end());
-		impl_->sortedSourceValueIndices_.erase(it);
-	}
+	impl_->index_.removeRows(first, sourceCount);
+	impl_->sortedSourceValueIndices_.erase(
+		std::remove_if(impl_->sortedSourceValueIndices_.begin(), impl_->sortedSourceValueIndices_.end(),
+			[first, last](size_t sortedSourceValueIndex) {
+			return static_cast<int>(sortedSourceValueIndex) >= first && static_cast<int>(sortedSourceValueIndex) <= last;
+		}),
+		impl_->sortedSourceValueIndices_.end());
 	for (auto& sortedSourceValueIndex : impl_->sortedSourceValueIndices_)
 	{
-		if (static_cast<int>(sortedSourceValueIndex) >= first)
+		if (static_cast<int>(sortedSourceValueIndex) > last)
 		{
 			sortedSourceValueIndex -= sourceCount;
 		}
 	}
 
-	if (proxyShift != -1)
+	for (auto it = proxyEnd; it != impl_->mappedItems_.end(); ++it)
 	{
-		auto it = impl_->mappedItems_.begin();
-		std::advance(it, proxyShift);
-		for (; it != impl_->mappedItems_.end(); ++it)
-		{
-			*it -= sourceCount;
-		}
+		*it -= sourceCount;
 	}
+	impl_->sourceToProxyDirty_ = true;
 
-	if (proxyFirst == -1)
+	if (proxyFirst > proxyLast)
 	{
 		return;
 	}
 
 	beginRemoveRows(QModelIndex(), proxyFirst, proxyLast);
-
-	auto proxyBegin = impl_->mappedItems_.begin();
-	std::advance(proxyBegin, proxyFirst);
-	auto proxyEnd = impl_->mappedItems_.begin();
-	std::advance(proxyEnd, proxyLast + 1);
-	impl_->mappedItems_.erase(proxyBegin, proxyEnd);
-
+	impl_->mappedItems_.erase(impl_->mappedItems_.begin() + proxyFirst, impl_->mappedItems_.begin() + proxyLast + 1);
 	endRemoveRows();
 }
 
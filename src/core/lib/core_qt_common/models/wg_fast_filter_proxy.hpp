@@ -23,6 +23,11 @@ namespace wgt
 * performs a substring match, but logic and grouping operators can be used for more complex
 * filters, e.g. street|road will match all strings which contain either "street" or "road".
 *
+* The filter role values are cached along with a trigram index over them, which is kept up to
+* date as source rows are inserted, removed or changed. Only the rows containing the terms an
+* expression requires are matched, and a filter which only narrows the previous one (e.g. as
+* more characters are typed) is matched against the previous result.
+*
 * This class also exposes a tryComplete method, which can be invoked from QML to implement
 * autocompletion in search fields. The call will return the first string (in alphabetical
 * order) which matches the filter substring (expressions which contain operators do not
@@ -1,12 +1,53 @@
 #include "wg_multi_edit_proxy.hpp"
 
 #include "models/role_provider.hpp"
+#include "i_qt_type_converter.hpp"
 #include "core_common/assert.hpp"
+#include "core_command_system/i_command_manager.hpp"
+
+#include <algorithm>
+#include <limits>
 
 namespace wgt
 {
 ITEMROLE(multipleValues)
 
+namespace
+{
+uint hashMergeKey(const QVector<QVariant>& key)
+{
+	// Equal keys must hash equally, so each value is hashed the way it compares. Built in Qt types
+	// compare by value and hash their string form. Reflected values are wrapped in a wgt::Variant, which
+	// hashes the value it holds. Other custom types only hash by type, equality is always checked afterwards.
+	static const int variantType = qMetaTypeId<Variant>();
+	static const int refObjectIdType = qMetaTypeId<RefObjectId>();
+
+	uint seed = 0;
+	for (const auto& value : key)
+	{
+		const int type = value.userType();
+		seed = qHash(type, seed);
+		if (type == variantType)
+		{
+			seed = qHash(static_cast<quint64>(std::hash<Variant>()(value.value<Variant>())), seed);
+		}
+		else if (type == refObjectIdType)
+		{
+			seed = qHash(static_cast<quint64>(value.value<RefObjectId>().getHash()), seed);
+		}
+		else if (type == QMetaType::QObjectStar)
+		{
+			seed = qHash(value.value<QObject*>(), seed);
+		}
+		else if (type < QMetaType::User)
+		{
+			seed = qHash(value.toString(), seed);
+		}
+	}
+	return seed;
+}
+}
+
 WGMultiEditProxy::WGMultiEditProxy()
 	: multipleValuesRole_(RoleProvider::convertRole(ItemRole::multipleValuesName))
 {
@@ -15,6 +56,7 @@ WGMultiEditProxy::WGMultiEditProxy()
 
 WGMultiEditProxy::~WGMultiEditProxy()
 {
+	qDeleteAll(mappings_);
 }
 
 void WGMultiEditProxy::addModel(QAbstractItemModel* model)
@@ -28,14 +70,11 @@ void WGMultiEditProxy::addModel(QAbstractItemModel* model)
 	sourceModels_.push_back(model);
 
 	// map root
-	auto mapping = new Mapping;
-	mappings_[QModelIndex()] = mapping;
+	resetMapping();
 	for (auto sourceModel : sourceModels_)
 	{
-		mapping->entries_[sourceModel] = Entry();
 		create_role_mapping(sourceModel);
-		connections_ +=
-		QObject::connect(sourceModel, &QAbstractItemModel::dataChanged, this, &WGMultiEditProxy::onSourceDataChanged);
+		connectSourceModel(sourceModel);
 	}
 
 	endResetModel();
@@ -52,14 +91,11 @@ void WGMultiEditProxy::removeModel(QAbstractItemModel* model)
 	sourceModels_.erase(std::remove(sourceModels_.begin(), sourceModels_.end(), model), sourceModels_.end());
 
 	// map root
-	auto mapping = new Mapping;
-	mappings_[QModelIndex()] = mapping;
+	resetMapping();
 	for (auto sourceModel : sourceModels_)
 	{
-		mapping->entries_[sourceModel] = Entry();
 		create_role_mapping(sourceModel);
-		connections_ +=
-		QObject::connect(sourceModel, &QAbstractItemModel::dataChanged, this, &WGMultiEditProxy::onSourceDataChanged);
+		connectSourceModel(sourceModel);
 	}
 
 	endResetModel();
@@ -80,13 +116,16 @@ void WGMultiEditProxy::setMergeKeys(const QList<QString>& mergeKeys)
 		const int role = RoleProvider::convertRole(it->toUtf8().constData());
 		mergeKeyRoleIds_.push_back(role);
 	}
+	if (!sourceModels_.empty())
+	{
+		resetMapping();
+	}
 	endResetModel();
 }
 
 void WGMultiEditProxy::onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight,
                                            const QVector<int>& roles)
 {
-	QModelIndex proxy_index;
 	auto model = const_cast<QAbstractItemModel*>(topLeft.model());
 	TF_ASSERT(model != nullptr);
 	auto& mappedRole = roleMappings_[model];
@@ -108,23 +147,178 @@ void WGMultiEditProxy::onSourceDataChanged(const QModelIndex& topLeft, const QMo
 		}
 	}
 
-	for (auto it = mappings_.begin(); it != mappings_.end(); ++it)
+	auto it = findSourceMapping(model, topLeft.parent());
+	if (it == mappings_.end() || !(*it)->mapped_)
 	{
-		auto findIt = (*it)->entries_.find(model);
-		if (findIt == (*it)->entries_.end())
+		return;
+	}
+
+	auto mapping = it.value();
+	auto& entry = mapping->entries_[model];
+	auto begin = entry.sourceRows_.lower_bound(topLeft.row());
+	auto end = entry.sourceRows_.upper_bound(bottomRight.row());
+	for (auto sourceRow = begin; sourceRow != end; ++sourceRow)
+	{
+		auto row = sourceRow->second;
+		auto& aggregates = mapping->aggregates_[row];
+		if (roles.empty())
 		{
-			continue;
+			aggregates.clear();
 		}
-		if (topLeft != findIt->second.sourceParent_)
+		for (auto role : proxy_roles)
 		{
-			continue;
+			aggregates.erase(role);
 		}
-		proxy_index = it.key();
+		auto proxy_index = createIndex(row, 0, mapping);
 		emit dataChanged(proxy_index, proxy_index, proxy_roles);
-		break;
 	}
 }
 
+void WGMultiEditProxy::onSourceRowsInserted(QAbstractItemModel* sourceModel, const QModelIndex& sourceParent,
+                                            int first, int last)
+{
+	auto it = findSourceMapping(sourceModel, sourceParent);
+	if (it == mappings_.end() || !(*it)->mapped_)
+	{
+		return;
+	}
+
+	auto mapping = it.value();
+	auto proxy_parent = it.key();
+	auto& entry = mapping->entries_[sourceModel];
+	shiftSourceRows(entry, first, last - first + 1);
+
+	// Merge the new rows into existing rows where possible, the rest are appended
+	Mapping added;
+	std::vector<std::pair<int, int>> addedRows;
+	std::vector<int> changedRows;
+	for (int i = first; i <= last; ++i)
+	{
+		auto key = mergeKey(sourceModel, i, entry.sourceParent_);
+		auto hash = hashMergeKey(key);
+		auto row = findMergedRow(*mapping, key, hash);
+		if (row >= 0)
+		{
+			mapSourceRow(entry, row, i);
+			mapping->aggregates_[row].clear();
+			changedRows.push_back(row);
+			continue;
+		}
+
+		row = findMergedRow(added, key, hash);
+		if (row < 0)
+		{
+			row = added.rowCount_;
+			addMergedRow(added, key, hash);
+		}
+		addedRows.emplace_back(i, row);
+	}
+
+	if (added.rowCount_ > 0)
+	{
+		const int firstRow = mapping->rowCount_;
+		beginInsertRows(proxy_parent, firstRow, firstRow + added.rowCount_ - 1);
+		for (auto& keyRow : added.keyRows_)
+		{
+			mapping->keyRows_.emplace(keyRow.first, firstRow + keyRow.second);
+		}
+		mapping->keys_.insert(mapping->keys_.end(), added.keys_.begin(), added.keys_.end());
+		mapping->aggregates_.resize(firstRow + added.rowCount_);
+		mapping->rowCount_ += added.rowCount_;
+		for (auto& addedRow : addedRows)
+		{
+			mapSourceRow(entry, firstRow + addedRow.second, addedRow.first);
+		}
+		endInsertRows();
+	}
+
+	syncChildMappings(proxy_parent);
+
+	for (auto row : changedRows)
+	{
+		auto proxy_index = createIndex(row, 0, mapping);
+		emit dataChanged(proxy_index, proxy_index);
+	}
+}
+
+void WGMultiEditProxy::onSourceRowsAboutToBeRemoved(QAbstractItemModel* sourceModel, const QModelIndex& sourceParent,
+                                                    int first, int last)
+{
+	auto it = findSourceMapping(sourceModel, sourceParent);
+	if (it == mappings_.end() || !(*it)->mapped_)
+	{
+		return;
+	}
+
+	auto mapping = it.value();
+	auto proxy_parent = it.key();
+	auto& entry = mapping->entries_[sourceModel];
+	std::vector<int> detachedRows;
+	auto begin = entry.sourceRows_.lower_bound(first);
+	auto end = entry.sourceRows_.upper_bound(last);
+	for (auto sourceRow = begin; sourceRow != end; ++sourceRow)
+	{
+		entry.rows_.erase(sourceRow->second);
+		detachedRows.push_back(sourceRow->second);
+	}
+	entry.sourceRows_.erase(begin, end);
+	std::sort(detachedRows.begin(), detachedRows.end());
+
+	// Rows which are no longer provided by any model are removed, the others just change value
+	std::vector<int> removedRows;
+	std::vector<int> changedRows;
+	for (auto row : detachedRows)
+	{
+		auto shared = std::any_of(mapping->entries_.begin(), mapping->entries_.end(),
+		                          [row](const std::pair<QAbstractItemModel* const, Entry>& other) {
+			                          return other.second.rows_.find(row) != other.second.rows_.end();
+			                      });
+		if (shared)
+		{
+			mapping->aggregates_[row].clear();
+			changedRows.push_back(row);
+		}
+		else
+		{
+			removedRows.push_back(row);
+		}
+	}
+
+	// Remove contiguous ranges from the back so earlier rows keep their position
+	auto rangeEnd = removedRows.rbegin();
+	while (rangeEnd != removedRows.rend())
+	{
+		auto rangeBegin = rangeEnd;
+		while (std::next(rangeBegin) != removedRows.rend() && *std::next(rangeBegin) == *rangeBegin - 1)
+		{
+			++rangeBegin;
+		}
+		removeMergedRows(proxy_parent, *rangeBegin, *rangeEnd);
+		rangeEnd = std::next(rangeBegin);
+	}
+
+	for (auto row : changedRows)
+	{
+		row -= static_cast<int>(std::lower_bound(removedRows.begin(), removedRows.end(), row) - removedRows.begin());
+		auto proxy_index = createIndex(row, 0, mapping);
+		emit dataChanged(proxy_index, proxy_index);
+	}
+}
+
+void WGMultiEditProxy::onSourceRowsRemoved(QAbstractItemModel* sourceModel, const QModelIndex& sourceParent,
+                                           int first, int last)
+{
+	auto it = findSourceMapping(sourceModel, sourceParent);
+	if (it == mappings_.end() || !(*it)->mapped_)
+	{
+		return;
+	}
+
+	auto proxy_parent = it.key();
+	shiftSourceRows((*it)->entries_[sourceModel], last + 1, first - last - 1);
+	syncChildMappings(proxy_parent);
+}
+
 void WGMultiEditProxy::create_role_mapping(QAbstractItemModel* sourceModel)
 {
 	auto roleNames = sourceModel->roleNames();
@@ -168,56 +362,8 @@ const QModelIndex& proxy_parent) const
 		return it;
 	}
 
-	std::vector<std::map<int, QVariant>> items;
-	for (auto& entry : (*it)->entries_)
-	{
-		auto& source_model = entry.first;
-		auto& source_parent = entry.second.sourceParent_;
-		int rowCount = source_model->rowCount(source_parent);
-		for (int i = 0; i < rowCount; ++i)
-		{
-			auto pair = std::map<int, QVariant>();
-			for (auto roleId : mergeKeyRoleIds_)
-			{
-				auto entry = source_model->data(source_model->index(i, 0, source_parent), roleId);
-				pair[roleId] = entry;
-			}
-			bool merged = false;
-			int j = 0;
-			for (; j < static_cast<int>(items.size()); ++j)
-			{
-				auto& item = items[j];
-				// doing merge
-				merged = true;
-				for (auto roleId : mergeKeyRoleIds_)
-				{
-					auto left = item[roleId];
-					auto right = pair[roleId];
-					if (left != right)
-					{
-						merged = false;
-						break;
-					}
-				}
-				if (merged)
-				{
-					break;
-				}
-			}
-			if (!merged)
-			{
-				entry.second.rows_[static_cast<int>(items.size())] = i;
-				items.push_back(pair);
-			}
-			else
-			{
-				entry.second.rows_[j] = i;
-			}
-		}
-	}
-	(*it)->rowCount_ = static_cast<int>(items.size());
+	mapRows(**it);
 	(*it)->mapIter_ = it;
-	(*it)->mapped_ = true;
 	return it;
 }
 
@@ -242,6 +388,375 @@ void WGMultiEditProxy::clearMapping()
 	roleNames_ = QAbstractItemModel::roleNames();
 }
 
+void WGMultiEditProxy::resetMapping()
+{
+	qDeleteAll(mappings_);
+	mappings_.clear();
+
+	auto mapping = new Mapping;
+	mappings_[QModelIndex()] = mapping;
+	for (auto sourceModel : sourceModels_)
+	{
+		mapping->entries_[sourceModel] = Entry();
+	}
+}
+
+void WGMultiEditProxy::connectSourceModel(QAbstractItemModel* sourceModel)
+{
+	connections_ +=
+	QObject::connect(sourceModel, &QAbstractItemModel::dataChanged, this, &WGMultiEditProxy::onSourceDataChanged);
+	connections_ += QObject::connect(sourceModel, &QAbstractItemModel::rowsInserted, this,
+	                                 [this, sourceModel](const QModelIndex& parent, int first, int last) {
+		                                 onSourceRowsInserted(sourceModel, parent, first, last);
+		                             });
+	connections_ += QObject::connect(sourceModel, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+	                                 [this, sourceModel](const QModelIndex& parent, int first, int last) {
+		                                 onSourceRowsAboutToBeRemoved(sourceModel, parent, first, last);
+		                             });
+	connections_ += QObject::connect(sourceModel, &QAbstractItemModel::rowsRemoved, this,
+	                                 [this, sourceModel](const QModelIndex& parent, int first, int last) {
+		                                 onSourceRowsRemoved(sourceModel, parent, first, last);
+		                             });
+
+	// Changes which can't be followed row by row remap everything
+	auto reset = [this]() {
+		beginResetModel();
+		resetMapping();
+		endResetModel();
+	};
+	connections_ += QObject::connect(sourceModel, &QAbstractItemModel::modelReset, this, reset);
+	connections_ += QObject::connect(sourceModel, &QAbstractItemModel::layoutChanged, this, reset);
+	connections_ += QObject::connect(sourceModel, &QAbstractItemModel::rowsMoved, this, reset);
+}
+
+WGMultiEditProxy::MergeKey WGMultiEditProxy::mergeKey(QAbstractItemModel* sourceModel, int sourceRow,
+                                                      const QModelIndex& sourceParent) const
+{
+	MergeKey key;
+	key.reserve(static_cast<int>(mergeKeyRoleIds_.size()));
+	auto source_index = sourceModel->index(sourceRow, 0, sourceParent);
+	for (auto roleId : mergeKeyRoleIds_)
+	{
+		key.append(sourceModel->data(source_index, roleId));
+	}
+	return key;
+}
+
+void WGMultiEditProxy::mapRows(Mapping& mapping) const
+{
+	mapping.rowCount_ = 0;
+	mapping.keys_.clear();
+	mapping.keyRows_.clear();
+	mapping.aggregates_.clear();
+	for (auto& entry : mapping.entries_)
+	{
+		auto& source_model = entry.first;
+		auto& source_parent = entry.second.sourceParent_;
+		entry.second.rows_.clear();
+		entry.second.sourceRows_.clear();
+		int rowCount = source_model->rowCount(source_parent);
+		for (int i = 0; i < rowCount; ++i)
+		{
+			auto key = mergeKey(source_model, i, source_parent);
+			auto hash = hashMergeKey(key);
+			auto row = findMergedRow(mapping, key, hash);
+			if (row < 0)
+			{
+				row = mapping.rowCount_;
+				addMergedRow(mapping, key, hash);
+			}
+			mapSourceRow(entry.second, row, i);
+		}
+	}
+	mapping.mapped_ = true;
+}
+
+int WGMultiEditProxy::findMergedRow(const Mapping& mapping, const MergeKey& key, uint hash) const
+{
+	int found = -1;
+	auto range = mapping.keyRows_.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if ((found < 0 || it->second < found) && mapping.keys_[it->second] == key)
+		{
+			found = it->second;
+		}
+	}
+	return found;
+}
+
+void WGMultiEditProxy::addMergedRow(Mapping& mapping, const MergeKey& key, uint hash) const
+{
+	mapping.keyRows_.emplace(hash, mapping.rowCount_);
+	mapping.keys_.push_back(key);
+	mapping.aggregates_.emplace_back();
+	++mapping.rowCount_;
+}
+
+void WGMultiEditProxy::mapSourceRow(Entry& entry, int row, int sourceRow) const
+{
+	auto findIt = entry.rows_.find(row);
+	if (findIt != entry.rows_.end())
+	{
+		// a later row with the same key replaces the earlier one
+		entry.sourceRows_.erase(findIt->second);
+		findIt->second = sourceRow;
+	}
+	else
+	{
+		entry.rows_.emplace(row, sourceRow);
+	}
+	entry.sourceRows_[sourceRow] = row;
+}
+
+void WGMultiEditProxy::shiftSourceRows(Entry& entry, int first, int count) const
+{
+	std::map<int, int> sourceRows;
+	for (auto& sourceRow : entry.sourceRows_)
+	{
+		auto source_row = sourceRow.first >= first ? sourceRow.first + count : sourceRow.first;
+		sourceRows.emplace(source_row, sourceRow.second);
+		entry.rows_[sourceRow.second] = source_row;
+	}
+	entry.sourceRows_.swap(sourceRows);
+}
+
+WGMultiEditProxy::MappingIterator WGMultiEditProxy::findSourceMapping(QAbstractItemModel* sourceModel,
+                                                                      const QModelIndex& sourceParent) const
+{
+	for (auto it = mappings_.begin(); it != mappings_.end(); ++it)
+	{
+		auto findIt = (*it)->entries_.find(sourceModel);
+		if (findIt != (*it)->entries_.end() && findIt->second.sourceParent_ == sourceParent)
+		{
+			return it;
+		}
+	}
+	return mappings_.end();
+}
+
+void WGMultiEditProxy::removeMergedRows(const QModelIndex& proxy_parent, int first, int last)
+{
+	auto mapping = mappings_.value(proxy_parent);
+	TF_ASSERT(mapping != nullptr);
+	const int count = last - first + 1;
+
+	beginRemoveRows(proxy_parent, first, last);
+	removeChildMappings(mapping, first, last);
+
+	// Re-key the child mappings of the rows which move up
+	std::vector<std::pair<QModelIndex, Mapping*>> moved;
+	for (auto it = mappings_.begin(); it != mappings_.end(); ++it)
+	{
+		const auto& key = it.key();
+		if (key.isValid() && key.internalPointer() == mapping && key.row() > last)
+		{
+			moved.emplace_back(key, it.value());
+		}
+	}
+	for (auto& child : moved)
+	{
+		mappings_.remove(child.first);
+	}
+	for (auto& child : moved)
+	{
+		child.second->mapIter_ =
+		mappings_.insert(createIndex(child.first.row() - count, child.first.column(), mapping), child.second);
+	}
+
+	for (auto& entry : mapping->entries_)
+	{
+		std::map<int, int> rows;
+		for (auto& row : entry.second.rows_)
+		{
+			if (row.first < first)
+			{
+				rows.emplace(row.first, row.second);
+			}
+			else if (row.first > last)
+			{
+				rows.emplace(row.first - count, row.second);
+			}
+		}
+		entry.second.rows_.swap(rows);
+		entry.second.sourceRows_.clear();
+		for (auto& row : entry.second.rows_)
+		{
+			entry.second.sourceRows_.emplace(row.second, row.first);
+		}
+	}
+
+	std::unordered_multimap<uint, int> keyRows;
+	for (auto& keyRow : mapping->keyRows_)
+	{
+		if (keyRow.second < first)
+		{
+			keyRows.emplace(keyRow.first, keyRow.second);
+		}
+		else if (keyRow.second > last)
+		{
+			keyRows.emplace(keyRow.first, keyRow.second - count);
+		}
+	}
+	mapping->keyRows_.swap(keyRows);
+	mapping->keys_.erase(mapping->keys_.begin() + first, mapping->keys_.begin() + last + 1);
+	mapping->aggregates_.erase(mapping->aggregates_.begin() + first, mapping->aggregates_.begin() + last + 1);
+	mapping->rowCount_ -= count;
+
+	endRemoveRows();
+}
+
+void WGMultiEditProxy::removeChildMappings(const Mapping* mapping, int first, int last)
+{
+	std::vector<std::pair<QModelIndex, Mapping*>> children;
+	for (auto it = mappings_.begin(); it != mappings_.end(); ++it)
+	{
+		const auto& key = it.key();
+		if (key.isValid() && key.internalPointer() == mapping && key.row() >= first && key.row() <= last)
+		{
+			children.emplace_back(key, it.value());
+		}
+	}
+	for (auto& child : children)
+	{
+		removeChildMappings(child.second, 0, std::numeric_limits<int>::max());
+		mappings_.remove(child.first);
+		delete child.second;
+	}
+}
+
+void WGMultiEditProxy::syncChildMappings(const QModelIndex& proxy_parent)
+{
+	auto mapping = mappings_.value(proxy_parent);
+	TF_ASSERT(mapping != nullptr);
+
+	std::vector<std::pair<QModelIndex, Mapping*>> children;
+	for (auto it = mappings_.begin(); it != mappings_.end(); ++it)
+	{
+		const auto& key = it.key();
+		if (key.isValid() && key.internalPointer() == mapping)
+		{
+			children.emplace_back(key, it.value());
+		}
+	}
+
+	for (auto& child : children)
+	{
+		const auto& childIndex = child.first;
+		auto childMapping = child.second;
+
+		std::map<QAbstractItemModel*, Entry> entries;
+		for (auto& entry : mapping->entries_)
+		{
+			auto findSourceRow = entry.second.rows_.find(childIndex.row());
+			if (findSourceRow != entry.second.rows_.end())
+			{
+				auto& source_model = entry.first;
+				entries[source_model].sourceParent_ =
+				source_model->index(findSourceRow->second, childIndex.column(), entry.second.sourceParent_);
+			}
+		}
+
+		auto sameSources = entries.size() == childMapping->entries_.size() &&
+		std::equal(entries.begin(), entries.end(), childMapping->entries_.begin(),
+		           [](const std::pair<QAbstractItemModel* const, Entry>& left,
+		              const std::pair<QAbstractItemModel* const, Entry>& right) { return left.first == right.first; });
+		if (!childMapping->mapped_)
+		{
+			childMapping->entries_.swap(entries);
+			continue;
+		}
+		if (sameSources)
+		{
+			// Only the source rows moved, the children are unchanged
+			for (auto& entry : entries)
+			{
+				childMapping->entries_[entry.first].sourceParent_ = entry.second.sourceParent_;
+			}
+			continue;
+		}
+
+		// The items sharing this row changed, so its children need merging again
+		if (childMapping->rowCount_ > 0)
+		{
+			beginRemoveRows(childIndex, 0, childMapping->rowCount_ - 1);
+			removeChildMappings(childMapping, 0, std::numeric_limits<int>::max());
+			childMapping->rowCount_ = 0;
+			childMapping->keys_.clear();
+			childMapping->keyRows_.clear();
+			childMapping->aggregates_.clear();
+			childMapping->entries_.clear();
+			endRemoveRows();
+		}
+
+		Mapping merged;
+		merged.entries_.swap(entries);
+		mapRows(merged);
+		if (merged.rowCount_ > 0)
+		{
+			beginInsertRows(childIndex, 0, merged.rowCount_ - 1);
+		}
+		childMapping->entries_.swap(merged.entries_);
+		childMapping->keys_.swap(merged.keys_);
+		childMapping->keyRows_.swap(merged.keyRows_);
+		childMapping->aggregates_.swap(merged.aggregates_);
+		childMapping->rowCount_ = merged.rowCount_;
+		if (merged.rowCount_ > 0)
+		{
+			endInsertRows();
+		}
+	}
+}
+
+WGMultiEditProxy::Aggregate WGMultiEditProxy::mergeData(const Mapping& mapping, int row, int column, int role) const
+{
+	Aggregate result;
+	int i = 0;
+	for (auto& entry : mapping.entries_)
+	{
+		auto& source_model = entry.first;
+		auto& source_parent = entry.second.sourceParent_;
+		auto findIt = entry.second.rows_.find(row);
+		auto roleMapping = roleMappings_.find(source_model);
+		TF_ASSERT(roleMapping != roleMappings_.end());
+		auto roleIt = roleMapping->second.find(role);
+		if (findIt == entry.second.rows_.end() || roleIt == roleMapping->second.end())
+		{
+			continue;
+		}
+		auto sourceRole = roleIt->second;
+		if (sourceRole == multipleValuesRole_)
+		{
+			result.value_ = false;
+			// for merged rows, set multipleValue to true
+			if (i > 0)
+			{
+				result.value_ = true;
+				break;
+			}
+		}
+		else
+		{
+			auto source_row = findIt->second;
+			auto source_index = source_model->index(source_row, column, source_parent);
+			auto sourceData = source_model->data(source_index, sourceRole);
+
+			if (i == 0)
+			{
+				result.value_ = sourceData;
+			}
+			else if (result.value_ != sourceData)
+			{
+				result.allEqual_ = false;
+				result.value_ = QVariant();
+				break;
+			}
+		}
+		i++;
+	}
+	return result;
+}
+
 QModelIndex WGMultiEditProxy::index(int row, int column, const QModelIndex& parent) const
 {
 	auto it = create_index_mapping(parent);
@@ -304,64 +819,30 @@ int WGMultiEditProxy::columnCount(const QModelIndex& parent) const
 
 QVariant WGMultiEditProxy::data(const QModelIndex& index, int role) const
 {
-	if (sourceModels_.empty())
+	if (sourceModels_.empty() || !index.isValid())
 	{
 		return QVariant();
 	}
+	auto mapping = index_to_iterator(index).value();
 	auto row = index.row();
-	auto column = index.column();
-	auto parent = this->parent(index);
-	auto it = create_index_mapping(parent);
-	QVariant retValue;
-	int i = 0;
-	bool multipleValues = false;
-	for (auto& entry : (*it)->entries_)
+	if (row < 0 || row >= mapping->rowCount_)
 	{
-		auto& source_model = entry.first;
-		auto& source_parent = entry.second.sourceParent_;
-		QVariant sourceData;
-		auto findIt = entry.second.rows_.find(row);
-		auto roleMapping = roleMappings_.find(source_model);
-		TF_ASSERT(roleMapping != roleMappings_.end());
-		auto roleIt = roleMapping->second.find(role);
-		if (findIt == entry.second.rows_.end() || roleIt == roleMapping->second.end())
-		{
-			continue;
-		}
-		auto sourceRole = roleIt->second;
-		if (sourceRole == multipleValuesRole_)
-		{
-			retValue = false;
-			// for merged rows, set multipleValue to true
-			if (i > 0)
-			{
-				retValue = true;
-				break;
-			}
-		}
-		else
-		{
-			auto source_row = findIt->second;
-			auto source_index = source_model->index(source_row, column, source_parent);
-			sourceData = source_model->data(source_index, sourceRole);
+		return QVariant();
+	}
 
-			if (i == 0)
-			{
-				retValue = sourceData;
-			}
-			else
-			{
-				if (retValue != sourceData)
-				{
-					retValue = QVariant();
-					break;
-				}
-			}
-		}
-		i++;
+	if (index.column() != 0)
+	{
+		auto result = mergeData(*mapping, row, index.column(), role);
+		return result.allEqual_ ? result.value_ : QVariant();
 	}
 
-	return retValue;
+	auto& aggregates = mapping->aggregates_[row];
+	auto findIt = aggregates.find(role);
+	if (findIt == aggregates.end())
+	{
+		findIt = aggregates.emplace(role, mergeData(*mapping, row, 0, role)).first;
+	}
+	return findIt->second.allEqual_ ? findIt->second.value_ : QVariant();
 }
 
 bool WGMultiEditProxy::setData(const QModelIndex& index, const QVariant& value, int role)
@@ -374,27 +855,57 @@ bool WGMultiEditProxy::setData(const QModelIndex& index, const QVariant& value,
 	{
 		return false;
 	}
-	auto parent = this->parent(index);
-	auto findIt = mappings_.find(parent);
-	TF_ASSERT(findIt != mappings_.end());
+	auto mapping = index_to_iterator(index).value();
 	auto row = index.row();
 	auto column = index.column();
-	bool ret = false;
-	for (auto& entry : (*findIt)->entries_)
+
+	struct Target
+	{
+		QAbstractItemModel* model_;
+		QModelIndex index_;
+		int role_;
+	};
+	std::vector<Target> targets;
+	for (auto& entry : mapping->entries_)
 	{
 		auto& source_model = entry.first;
 		auto& source_parent = entry.second.sourceParent_;
 		auto findSourceRow = entry.second.rows_.find(row);
-		auto roleIt = roleMappings_[source_model].find(role);
-		if (findSourceRow == entry.second.rows_.end() || roleIt == roleMappings_[source_model].end())
+		auto& roleMapping = roleMappings_[source_model];
+		auto roleIt = roleMapping.find(role);
+		if (findSourceRow == entry.second.rows_.end() || roleIt == roleMapping.end())
 		{
 			continue;
 		}
 		auto source_row = findSourceRow->second;
-		auto source_index = source_model->index(source_row, column, source_parent);
-		ret = source_model->setData(source_index, value, roleIt->second) || ret;
+		Target target = { source_model, source_model->index(source_row, column, source_parent), roleIt->second };
+		targets.push_back(target);
 	}
 
+	// Editing several items at once is undone as a single step
+	auto commandManager = targets.size() > 1 ? get<ICommandManager>() : nullptr;
+	if (commandManager != nullptr)
+	{
+		commandManager->beginBatchCommand();
+	}
+
+	bool ret = false;
+	for (auto& target : targets)
+	{
+		ret = target.model_->setData(target.index_, value, target.role_) || ret;
+	}
+
+	if (commandManager != nullptr)
+	{
+		if (ret)
+		{
+			commandManager->endBatchCommand();
+		}
+		else
+		{
+			commandManager->abortBatchCommand();
+		}
+	}
 	return ret;
 }
 
@@ -402,4 +913,4 @@ QHash<int, QByteArray> WGMultiEditProxy::roleNames() const
 {
 	return roleNames_;
 }
-}
\ No newline at end of file
+}
@@ -3,14 +3,17 @@
 
 #include "qt_connection_holder.hpp"
 #include "core_qt_common/qt_new_handler.hpp"
+#include "core_dependency_system/depends.hpp"
 #include <memory>
 #include <QAbstractItemModel>
+#include <QVector>
 #include <vector>
 #include <unordered_map>
 #include <map>
 
 namespace wgt
 {
+class ICommandManager;
 
 /**
 * Proxy layer which merges properties for multiple items.
@@ -29,9 +32,14 @@ namespace wgt
 *
 * The view can use this behaviour to show multiple-valued properties appropriately.
 *
-* The setData() method will forward the value to all the items which share the property.
+* The setData() method will forward the value to all the items which share the property,
+* as a single batch command when there is more than one of them.
+*
+* Merge keys are hashed, so mapping a parent is linear in its number of source rows. Source row
+* inserts and removes are remapped incrementally, and the merged value of each row and role is
+* cached until a source reports a change to it.
 */
-class WGMultiEditProxy : public QAbstractItemModel
+class WGMultiEditProxy : public QAbstractItemModel, public Depends<ICommandManager>
 {
 	Q_OBJECT
 	DECLARE_QT_MEMORY_HANDLER
@@ -58,11 +66,24 @@ public:
 	virtual QHash<int, QByteArray> roleNames() const override;
 
 private:
+	typedef QVector<QVariant> MergeKey;
 
 	struct Entry
 	{
 		QModelIndex sourceParent_;
+		// proxy row -> source row
 		std::map<int, int> rows_;
+		// source row -> proxy row
+		std::map<int, int> sourceRows_;
+	};
+
+	struct Aggregate
+	{
+		Aggregate() : allEqual_(true)
+		{
+		}
+		bool allEqual_;
+		QVariant value_;
 	};
 
 	struct Mapping
@@ -74,18 +95,43 @@ private:
 		int rowCount_;
 		QHash<QModelIndex, Mapping*>::iterator mapIter_;
 		std::map<QAbstractItemModel*, Entry> entries_;
+		// merge key values of each proxy row
+		std::vector<MergeKey> keys_;
+		// hashed merge key -> proxy row
+		std::unordered_multimap<uint, int> keyRows_;
+		// cached merged values of each proxy row, by proxy role
+		std::vector<std::unordered_map<int, Aggregate>> aggregates_;
 	};
 
+	typedef QHash<QModelIndex, Mapping*>::iterator MappingIterator;
+
 	QList<QString> getMergeKeys() const;
 	void setMergeKeys(const QList<QString>& mergeKeys);
 
 	void onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles);
+	void onSourceRowsInserted(QAbstractItemModel* sourceModel, const QModelIndex& sourceParent, int first, int last);
+	void onSourceRowsAboutToBeRemoved(QAbstractItemModel* sourceModel, const QModelIndex& sourceParent, int first,
+	                                  int last);
+	void onSourceRowsRemoved(QAbstractItemModel* sourceModel, const QModelIndex& sourceParent, int first, int last);
 
+	void create_role_mapping(QAbstractItemModel* sourceModel);
 	QHash<QModelIndex, Mapping*>::iterator create_index_mapping(const QModelIndex& proxy_parent) const;
 	QHash<QModelIndex, Mapping*>::const_iterator index_to_iterator(const QModelIndex& proxy_index) const;
 	void clearMapping();
-
-	void create_role_mapping(QAbstractItemModel* sourceModel);
+	void resetMapping();
+	void connectSourceModel(QAbstractItemModel* sourceModel);
+
+	MergeKey mergeKey(QAbstractItemModel* sourceModel, int sourceRow, const QModelIndex& sourceParent) const;
+	void mapRows(Mapping& mapping) const;
+	int findMergedRow(const Mapping& mapping, const MergeKey& key, uint hash) const;
+	void addMergedRow(Mapping& mapping, const MergeKey& key, uint hash) const;
+	void mapSourceRow(Entry& entry, int row, int sourceRow) const;
+	void shiftSourceRows(Entry& entry, int first, int count) const;
+	MappingIterator findSourceMapping(QAbstractItemModel* sourceModel, const QModelIndex& sourceParent) const;
+	void removeMergedRows(const QModelIndex& proxy_parent, int first, int last);
+	void removeChildMappings(const Mapping* mapping, int first, int last);
+	void syncChildMappings(const QModelIndex& proxy_parent);
+	Aggregate mergeData(const Mapping& mapping, int row, int column, int role) const;
 
 	QList<QString> mergeKeys_;
 	std::vector<int> mergeKeyRoleIds_;
@@ -100,4 +146,4 @@ private:
 };
 }
 
-#endif // WG_MULTI_EDIT_PROXY_HPP
\ No newline at end of file
+#endif // WG_MULTI_EDIT_PROXY_HPP
@@ -9,6 +9,10 @@ QmlComponent::QmlComponent(QQmlEngine& qmlEngine) : qmlComponent_(new QQmlCompon
 {
 }
 
+QmlComponent::QmlComponent(const std::shared_ptr<QQmlComponent>& qmlComponent) : qmlComponent_(qmlComponent)
+{
+}
+
 QmlComponent::~QmlComponent()
 {
 }
@@ -14,12 +14,13 @@ class QmlComponent : public IComponent
 {
 public:
 	QmlComponent(QQmlEngine& qmlEngine);
+	QmlComponent(const std::shared_ptr<QQmlComponent>& qmlComponent);
 	virtual ~QmlComponent();
 
 	QQmlComponent* component() const;
 
 private:
-	std::unique_ptr<QQmlComponent> qmlComponent_;
+	std::shared_ptr<QQmlComponent> qmlComponent_;
 };
 } // end namespace wgt
 #endif
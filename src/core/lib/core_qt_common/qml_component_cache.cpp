@@ -0,0 +1,168 @@
+#include "qml_component_cache.hpp"
+
+#include "core_logging/logging.hpp"
+
+#include <algorithm>
+
+#include <QQmlComponent>
+#include <QQmlEngine>
+
+namespace wgt
+{
+namespace
+{
+double elapsedMilliseconds(const std::chrono::high_resolution_clock::time_point& startTime)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+}
+}
+
+//==============================================================================
+QmlComponentCache::QmlComponentCache(QQmlEngine& qmlEngine) : qmlEngine_(qmlEngine)
+{
+}
+
+//==============================================================================
+QmlComponentCache::~QmlComponentCache()
+{
+	// Views may still hold components, so stop them calling back into the cache
+	for (auto& entry : entries_)
+	{
+		QObject::disconnect(entry->connection_);
+	}
+	for (auto& entry : staleEntries_)
+	{
+		QObject::disconnect(entry->connection_);
+	}
+}
+
+//==============================================================================
+std::shared_ptr<QQmlComponent> QmlComponentCache::load(const QUrl& url, bool async, Handler loadedHandler,
+                                                       Handler errorHandler)
+{
+	auto found = entries_.find(url);
+	if (found == entries_.end())
+	{
+		auto entry = std::make_shared<Entry>();
+		entry->url_ = url;
+		entry->component_.reset(new QQmlComponent(&qmlEngine_));
+		entry->pending_.emplace_back(loadedHandler, errorHandler);
+		std::weak_ptr<Entry> weakEntry = entry;
+		entry->connection_ = QObject::connect(entry->component_.get(), &QQmlComponent::statusChanged,
+		                                      [this, weakEntry](QQmlComponent::Status) { onStatusChanged(weakEntry); });
+		entries_.insert(url, entry);
+
+		NGT_TRACE_MSG("Queuing load of %s\n", qPrintable(url.fileName()));
+		entry->startTime_ = std::chrono::high_resolution_clock::now();
+		// A synchronous load notifies the handlers before returning
+		entry->component_->loadUrl(url, async ? QQmlComponent::Asynchronous : QQmlComponent::PreferSynchronous);
+		return entry->component_;
+	}
+
+	auto entry = found.value();
+	++statistics_[url].hits_;
+	switch (entry->component_->status())
+	{
+	case QQmlComponent::Ready:
+		if (loadedHandler)
+		{
+			loadedHandler(entry->component_);
+		}
+		break;
+
+	case QQmlComponent::Error:
+		if (errorHandler)
+		{
+			errorHandler(entry->component_);
+		}
+		break;
+
+	default:
+		entry->pending_.emplace_back(loadedHandler, errorHandler);
+		break;
+	}
+	return entry->component_;
+}
+
+//==============================================================================
+void QmlComponentCache::clear()
+{
+	for (auto& entry : entries_)
+	{
+		if (entry->component_->isLoading())
+		{
+			staleEntries_.push_back(entry);
+		}
+	}
+	entries_.clear();
+}
+
+//==============================================================================
+void QmlComponentCache::onStatusChanged(const std::weak_ptr<Entry>& weakEntry)
+{
+	auto entry = weakEntry.lock();
+	if (entry == nullptr)
+	{
+		return;
+	}
+
+	const auto status = entry->component_->status();
+	if (status != QQmlComponent::Ready && status != QQmlComponent::Error)
+	{
+		return;
+	}
+
+	const auto compileTime = elapsedMilliseconds(entry->startTime_);
+	auto& statistics = statistics_[entry->url_];
+	++statistics.compiles_;
+	statistics.compileTime_ += compileTime;
+
+	if (status == QQmlComponent::Error)
+	{
+		NGT_WARNING_MSG("Error loading control %s\n", qPrintable(entry->component_->errorString()));
+	}
+	else
+	{
+		NGT_TRACE_MSG("Loaded %s in %.3f ms.\n", qPrintable(entry->url_.fileName()), compileTime);
+	}
+
+	staleEntries_.erase(std::remove(staleEntries_.begin(), staleEntries_.end(), entry), staleEntries_.end());
+
+	auto pending = std::move(entry->pending_);
+	entry->pending_.clear();
+	for (auto& handlers : pending)
+	{
+		auto& handler = status == QQmlComponent::Ready ? handlers.first : handlers.second;
+		if (handler)
+		{
+			handler(entry->component_);
+		}
+	}
+}
+
+//==============================================================================
+void QmlComponentCache::recordInstantiation(const QUrl& url, double milliseconds)
+{
+	auto& statistics = statistics_[url];
+	++statistics.instantiations_;
+	statistics.instantiateTime_ += milliseconds;
+}
+
+//==============================================================================
+QmlComponentCache::Statistics QmlComponentCache::getStatistics(const QUrl& url) const
+{
+	return statistics_.value(url);
+}
+
+//==============================================================================
+void QmlComponentCache::dumpStatistics() const
+{
+	for (auto it = statistics_.cbegin(); it != statistics_.cend(); ++it)
+	{
+		auto& statistics = it.value();
+		NGT_TRACE_MSG("%s: compiled %d times in %.3f ms, %d cache hits, instantiated %d times in %.3f ms\n",
+		              qPrintable(it.key().toString()), statistics.compiles_, statistics.compileTime_,
+		              statistics.hits_, statistics.instantiations_, statistics.instantiateTime_);
+	}
+}
+} // end namespace wgt
@@ -0,0 +1,89 @@
+#ifndef QML_COMPONENT_CACHE_HPP
+#define QML_COMPONENT_CACHE_HPP
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QHash>
+#include <QMetaObject>
+#include <QUrl>
+
+class QQmlComponent;
+class QQmlEngine;
+
+namespace wgt
+{
+/**
+ *	Compiled QQmlComponents shared by every view which loads the same url.
+ *
+ *	The first load of a url creates its component and compiles it; later loads
+ *	reuse the component once it is ready, or queue behind it while it is still
+ *	loading. Components are reference counted, so a view keeps using the one it
+ *	was created from after the cache is cleared by a QML file change, and simply
+ *	picks up a fresh one on its next load.
+ */
+class QmlComponentCache
+{
+public:
+	typedef std::function<void(const std::shared_ptr<QQmlComponent>&)> Handler;
+
+	/** Compile and instantiate times for a url, in milliseconds. */
+	struct Statistics
+	{
+		Statistics() : compiles_(0), compileTime_(0.0), hits_(0), instantiations_(0), instantiateTime_(0.0)
+		{
+		}
+
+		int compiles_;
+		double compileTime_;
+		int hits_;
+		int instantiations_;
+		double instantiateTime_;
+	};
+
+	QmlComponentCache(QQmlEngine& qmlEngine);
+	~QmlComponentCache();
+
+	/**
+	 *	Returns the shared component for url, which may still be loading.
+	 *	Calls loadedHandler with it once it is ready, or errorHandler if it
+	 *	fails to compile. Either may be called before this returns.
+	 */
+	std::shared_ptr<QQmlComponent> load(const QUrl& url, bool async, Handler loadedHandler = Handler(),
+	                                    Handler errorHandler = Handler());
+
+	/**
+	 *	Drops every cached component. Components still loading finish and
+	 *	notify their handlers, but are not reused.
+	 */
+	void clear();
+
+	void recordInstantiation(const QUrl& url, double milliseconds);
+	Statistics getStatistics(const QUrl& url) const;
+	void dumpStatistics() const;
+
+private:
+	QmlComponentCache(const QmlComponentCache& other);
+	QmlComponentCache& operator=(const QmlComponentCache& other);
+
+	struct Entry
+	{
+		QUrl url_;
+		std::shared_ptr<QQmlComponent> component_;
+		QMetaObject::Connection connection_;
+		std::chrono::high_resolution_clock::time_point startTime_;
+		std::vector<std::pair<Handler, Handler>> pending_;
+	};
+
+	void onStatusChanged(const std::weak_ptr<Entry>& weakEntry);
+
+	QQmlEngine& qmlEngine_;
+	QHash<QUrl, std::shared_ptr<Entry>> entries_;
+	// Entries dropped by clear() while still loading
+	std::vector<std::shared_ptr<Entry>> staleEntries_;
+	QHash<QUrl, Statistics> statistics_;
+};
+} // end namespace wgt
+#endif // QML_COMPONENT_CACHE_HPP
@@ -3,16 +3,54 @@
 #include "qml_component.hpp"
 
 #include "core_ui_framework/i_component_provider.hpp"
+#include "wg_types/hash_utilities.hpp"
+
+#include <algorithm>
+#include <utility>
 
 namespace wgt
 {
+/**
+* A node in the memoized choice of component for a type. Either the providers settled on a
+* component once the roles on the path to this node had the answers they had, or the next role
+* they asked about is recorded with a branch for each answer.
+*/
+struct QmlComponentManager::Decision
+{
+	Decision() : resolved_(false), component_(nullptr), hasRole_(false)
+	{
+	}
+
+	bool resolved_;
+	IComponent* component_;
+
+	bool hasRole_;
+	ItemRole::Id role_;
+	std::unique_ptr<Decision> branches_[2];
+};
+
+size_t QmlComponentManager::DecisionKeyHash::operator()(const DecisionKey& key) const
+{
+	uint64_t seed = key.typeId_.getHashcode();
+	HashUtilities::combine(seed, key.version_);
+	return static_cast<size_t>(seed);
+}
+
+QmlComponentManager::QmlComponentManager()
+{
+}
+
+QmlComponentManager::~QmlComponentManager()
+{
+}
+
 void QmlComponentManager::registerComponent(
 	const char* id, const char* version, IComponent& component,
 	bool supportsAsync)
 {
 	auto& components = components_[id];
 
-	auto tokens = ComponentVersion::tokenise(version);
+	auto& tokens = getVersionTokens(version);
 	auto it = components.find(tokens);
 	if (it != components.end())
 	{
@@ -24,70 +62,84 @@ void QmlComponentManager::registerComponent(
 	{
 		noAsync_.insert(&component);
 	}
+	decisions_.clear();
 }
 
 void QmlComponentManager::registerComponentProvider(IComponentProvider& provider)
 {
 	componentProviders_.push_back(&provider);
+	decisions_.clear();
 }
 
 IComponent* QmlComponentManager::findComponent(const TypeId& typeId,
                                                std::function<bool(const ItemRole::Id&)>& predicate,
                                                const char* version) const
 {
-	auto tokens = ComponentVersion::tokenise(version);
-
-	for (auto componentProviderIt = componentProviders_.rbegin(); componentProviderIt != componentProviders_.rend();
-	     ++componentProviderIt)
+	DecisionKey key = { typeId, version };
+	auto& root = decisions_[key];
+	if (root == nullptr)
 	{
-		auto id = (*componentProviderIt)->componentId(typeId, predicate);
-		if (id == nullptr)
-		{
-			continue;
-		}
+		root.reset(new Decision());
+	}
 
-		auto componentsIt = components_.find(id);
-		if (componentsIt == components_.end())
+	// Follow the answers the providers needed last time
+	std::vector<std::pair<ItemRole::Id, bool>> answers;
+	auto decision = root.get();
+	while (decision->hasRole_)
+	{
+		const bool answer = predicate(decision->role_);
+		answers.emplace_back(decision->role_, answer);
+		auto& branch = decision->branches_[answer ? 1 : 0];
+		if (branch == nullptr)
 		{
-			continue;
+			branch.reset(new Decision());
 		}
+		decision = branch.get();
+	}
 
-		auto& components = componentsIt->second;
+	if (decision->resolved_)
+	{
+		return decision->component_;
+	}
 
-		if (components.empty())
+	// First item down this path, so ask the providers and remember any further
+	// roles they needed. Each role is only evaluated once.
+	const size_t knownAnswers = answers.size();
+	std::function<bool(const ItemRole::Id&)> recordingPredicate = [&answers, &predicate](const ItemRole::Id& roleId) {
+		auto found = std::find_if(answers.begin(), answers.end(),
+		                          [&roleId](const std::pair<ItemRole::Id, bool>& answer) { return answer.first == roleId; });
+		if (found != answers.end())
 		{
-			continue;
+			return found->second;
 		}
+		const bool answer = predicate(roleId);
+		answers.emplace_back(roleId, answer);
+		return answer;
+	};
+	auto component = resolveComponent(typeId, recordingPredicate, getVersionTokens(version));
 
-		auto componentIt = components.upper_bound(tokens);
-		--componentIt;
-
-		return componentIt->second;
+	for (size_t i = knownAnswers; i < answers.size(); ++i)
+	{
+		decision->hasRole_ = true;
+		decision->role_ = answers[i].first;
+		auto& branch = decision->branches_[answers[i].second ? 1 : 0];
+		branch.reset(new Decision());
+		decision = branch.get();
 	}
-	return nullptr;
+	decision->resolved_ = true;
+	decision->component_ = component;
+	return component;
 }
 
 IComponent* QmlComponentManager::findComponent(const char* componentId, const char* version) const
 {
-	auto tokens = ComponentVersion::tokenise(version);
-
 	auto componentsIt = components_.find(componentId);
 	if (componentsIt == components_.end())
 	{
 		return nullptr;
 	}
 
-	auto& components = componentsIt->second;
-
-	if (components.empty())
-	{
-		return nullptr;
-	}
-
-	auto componentIt = components.upper_bound(tokens);
-	--componentIt;
-
-	return componentIt->second;
+	return findComponent(componentsIt->second, getVersionTokens(version));
 }
 
 QQmlComponent* QmlComponentManager::toQmlComponent(IComponent& component) const
@@ -108,4 +160,60 @@ bool QmlComponentManager::supportsAsync(IComponent & component) const
 	return !noAsync;
 }
 
+const std::vector<int>& QmlComponentManager::getVersionTokens(const char* version) const
+{
+	auto found = versionTokens_.find(version);
+	if (found != versionTokens_.end())
+	{
+		return found->second;
+	}
+	return versionTokens_.emplace(version, ComponentVersion::tokenise(version)).first->second;
+}
+
+IComponent* QmlComponentManager::findComponent(const VersionedComponents& components,
+                                               const std::vector<int>& tokens) const
+{
+	if (components.empty())
+	{
+		return nullptr;
+	}
+
+	auto componentIt = components.upper_bound(tokens);
+	if (componentIt == components.begin())
+	{
+		return nullptr;
+	}
+	--componentIt;
+
+	return componentIt->second;
+}
+
+IComponent* QmlComponentManager::resolveComponent(const TypeId& typeId,
+                                                  std::function<bool(const ItemRole::Id&)>& predicate,
+                                                  const std::vector<int>& tokens) const
+{
+	for (auto componentProviderIt = componentProviders_.rbegin(); componentProviderIt != componentProviders_.rend();
+	     ++componentProviderIt)
+	{
+		auto id = (*componentProviderIt)->componentId(typeId, predicate);
+		if (id == nullptr)
+		{
+			continue;
+		}
+
+		auto componentsIt = components_.find(id);
+		if (componentsIt == components_.end())
+		{
+			continue;
+		}
+
+		auto component = findComponent(componentsIt->second, tokens);
+		if (component == nullptr)
+		{
+			continue;
+		}
+		return component;
+	}
+	return nullptr;
+}
 }
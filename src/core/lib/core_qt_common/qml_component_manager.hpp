@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core_data_model/i_item_role.hpp"
+#include "core_variant/type_id.hpp"
 
 #include "core_qt_common/private/component_version.hpp"
 
@@ -9,18 +10,31 @@
 #include <set>
 #include <memory>
 #include <functional>
+#include <string>
+#include <unordered_map>
 
 class QQmlComponent;
 
 namespace wgt
 {
-class TypeId;
 class IComponent;
 class IComponentProvider;
 
+/**
+* Registry of QML delegate components and the providers which choose them.
+*
+* Choosing a component for a type asks the providers about the item's roles through the
+* predicate. The choice is memoized per type and version as a decision tree over the roles the
+* providers asked about, so later items of the same kind only re-evaluate those roles before
+* the component is known. Registering a component or provider discards the memoized choices.
+* Lookups are expected to come from the UI thread.
+*/
 class QmlComponentManager
 {
 public:
+	QmlComponentManager();
+	~QmlComponentManager();
+
 	void registerComponent(const char* id, const char* version, IComponent& component, bool supportsAsync );
 	void registerComponentProvider(IComponentProvider& provider);
 
@@ -32,8 +46,36 @@ public:
 
 	bool supportsAsync(IComponent & component ) const;
 private:
-	std::map<std::string, std::map<std::vector<int>, IComponent*, ComponentVersion>> components_;
+	struct Decision;
+
+	struct DecisionKey
+	{
+		TypeId typeId_;
+		std::string version_;
+
+		bool operator==(const DecisionKey& other) const
+		{
+			return typeId_ == other.typeId_ && version_ == other.version_;
+		}
+	};
+
+	struct DecisionKeyHash
+	{
+		size_t operator()(const DecisionKey& key) const;
+	};
+
+	typedef std::map<std::vector<int>, IComponent*, ComponentVersion> VersionedComponents;
+
+	const std::vector<int>& getVersionTokens(const char* version) const;
+	IComponent* findComponent(const VersionedComponents& components, const std::vector<int>& tokens) const;
+	IComponent* resolveComponent(const TypeId& typeId, std::function<bool(const ItemRole::Id&)>& predicate,
+	                             const std::vector<int>& tokens) const;
+
+	std::unordered_map<std::string, VersionedComponents> components_;
 	std::vector<IComponentProvider*> componentProviders_;
 	std::set< IComponent * > noAsync_;
+
+	mutable std::unordered_map<std::string, std::vector<int>> versionTokens_;
+	mutable std::unordered_map<DecisionKey, std::unique_ptr<Decision>, DecisionKeyHash> decisions_;
 };
 }
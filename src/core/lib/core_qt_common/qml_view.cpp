@@ -5,13 +5,14 @@
 #include "i_qt_framework.hpp"
 #include "core_ui_framework/i_preferences.hpp"
 #include "core_qt_common/qt_connection_holder.hpp"
-#include "core_qt_common/helpers/qml_component_loader_helper.hpp"
+#include "core_qt_common/qml_component_cache.hpp"
 #include "core_qt_common/interfaces/i_qt_helpers.hpp"
 #include "core_qt_common/qt_component_finder.hpp"
 #include "core_qt_common/qt_script_object.hpp"
 #include "core_string_utils/string_utils.hpp"
 #include "core_string_utils/file_path.hpp"
 
+#include <chrono>
 #include <functional>
 
 #include <QQmlComponent>
@@ -23,6 +24,7 @@
 #include <QFileSystemWatcher>
 #include <QApplication>
 #include <QDir>
+#include <QPointer>
 
 namespace wgt
 {
@@ -45,9 +47,12 @@ struct QmlView::Implementation : Depends<IQtFramework>
 		qmlEngine_.collectGarbage();
 	}
 
-	void handleLoaded(QQmlComponent* qmlComponent)
+	void handleLoaded(const std::shared_ptr<QQmlComponent>& qmlComponent)
 	{
+		auto startTime = std::chrono::high_resolution_clock::now();
 		auto content = std::unique_ptr<QObject>(qmlComponent->create(qmlContext_.get()));
+		get<IQtFramework>()->qmlComponentCache()->recordInstantiation(
+			url_, std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count());
 		qmlView_.QtViewCommon::initialise(content.get());
 
 		auto property = content->property("layoutHints");
@@ -80,7 +85,9 @@ struct QmlView::Implementation : Depends<IQtFramework>
 			rootObject->deleteLater();
 		}
 
-		view->setContent(url_, qmlComponent, content.release());
+		// The component is shared with other views, so keep it alive for as long as it is set
+		view->setContent(url_, qmlComponent.get(), content.release());
+		qmlComponent_ = qmlComponent;
 		view->setResizeMode(QQuickWidget::SizeRootObjectToView);
 		view->setFocusPolicy(Qt::ClickFocus);
 
@@ -116,18 +123,26 @@ struct QmlView::Implementation : Depends<IQtFramework>
 	            std::function<void()> errorHandler = [] {}, bool async = true)
 	{
 		std::unique_lock<std::mutex> holder(loadMutex_);
-		auto qmlEngine = qmlContext_->engine();
-		auto qmlComponent = new QQmlComponent(qmlEngine, qmlView_.widget());
-
-		QmlComponentLoaderHelper helper(qmlComponent, qUrl);
-		using namespace std::placeholders;
-		helper.data_->connections_ += helper.data_->sig_Loaded_.connect(
-			std::bind(&Implementation::handleLoaded, this, _1));
-		helper.data_->connections_ +=
-		helper.data_->sig_Loaded_.connect([loadedHandler](QQmlComponent*) { loadedHandler(); });
-		helper.data_->connections_ +=
-		helper.data_->sig_Error_.connect([errorHandler](QQmlComponent*) { errorHandler(); });
-		helper.load(async);
+
+		// The shared component can finish loading after this view is gone
+		QPointer<QmlView> qmlView(&qmlView_);
+		get<IQtFramework>()->qmlComponentCache()->load(
+			qUrl, async,
+			[this, qmlView, loadedHandler](const std::shared_ptr<QQmlComponent>& qmlComponent) {
+				if (qmlView.isNull())
+				{
+					return;
+				}
+				handleLoaded(qmlComponent);
+				loadedHandler();
+			},
+			[qmlView, errorHandler](const std::shared_ptr<QQmlComponent>&) {
+				if (qmlView.isNull())
+				{
+					return;
+				}
+				errorHandler();
+			});
 		return true;
 	}
 
@@ -136,6 +151,7 @@ struct QmlView::Implementation : Depends<IQtFramework>
 	QtComponentFinder components_;
 	QUrl url_;
 	std::unique_ptr<QQmlContext> qmlContext_;
+	std::shared_ptr<QQmlComponent> qmlComponent_;
 	QQmlEngine& qmlEngine_;
 	std::mutex loadMutex_;
 	bool watched_;
@@ -35,6 +35,16 @@ public:
 
 		return false;
 	}
+
+	void getVariantTypes(std::vector<TypeId>& o_types) const override
+	{
+		o_types.push_back(TypeId::getType<QObject>());
+	}
+
+	void getQVariantTypes(std::vector<int>& o_types) const override
+	{
+		o_types.push_back(QMetaType::QObjectStar);
+	}
 };
 } // end namespace wgt
 #endif
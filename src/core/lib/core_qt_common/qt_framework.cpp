@@ -516,6 +516,11 @@ QFileSystemWatcher* QtFramework::qmlWatcher() const
 	return qmlWatcher_.get();
 }
 
+QmlComponentCache* QtFramework::qmlComponentCache() const
+{
+	return qtFrameworkBase_->qmlComponentCache();
+}
+
 void QtFramework::setIncubationTime(int msecs)
 {
 	qtFrameworkBase_->setIncubationTime(msecs);
@@ -1253,7 +1258,10 @@ void QtFramework::findReloadableFiles(const QString& path, const QStringList& fi
 
 void QtFramework::registerReloadableFiles()
 {
-	auto clearCache = [this]() { qmlEngine()->clearComponentCache(); };
+	auto clearCache = [this]() {
+		qmlEngine()->clearComponentCache();
+		qmlComponentCache()->clear();
+	};
 	QObject::connect(qmlWatcher_.get(), &QFileSystemWatcher::fileChanged, clearCache);
 
 	QStringList paths = qmlEngine()->importPathList();
@@ -61,6 +61,7 @@ public:
 	// IQtFramework
 	QQmlEngine* qmlEngine() const override;
 	QFileSystemWatcher* qmlWatcher() const override;
+	QmlComponentCache* qmlComponentCache() const override;
 	virtual void setIncubationTime(int msecs) override;
 	virtual void incubate() override;
 	QtPalette* palette() const override;
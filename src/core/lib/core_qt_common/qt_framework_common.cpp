@@ -2,6 +2,7 @@
 
 #include "qt_scripting_engine_base.hpp"
 #include "qml_component_manager.hpp"
+#include "qml_component_cache.hpp"
 
 #include "qt_int64.hpp"
 #include "int64_type_converter.hpp"
@@ -13,6 +14,7 @@
 #include "core_qt_common/i_qt_type_converter.hpp"
 #include "core_qt_common/string_qt_type_converter.hpp"
 #include "core_qt_common/vector_qt_type_converter.hpp"
+#include "core_qt_common/qt_type_converter_registry.hpp"
 #include "core_qt_common/helpers/qt_helpers.hpp"
 
 #include "core_qt_common/interfaces/i_qt_helpers.hpp"
@@ -23,7 +25,6 @@
 #include "core_qt_common/qt_global_settings.hpp"
 #include "core_qt_common/qt_global_logger.hpp"
 #include "core_qt_common/qt_file_path_helper.hpp"
-#include "core_qt_common/helpers/qml_component_loader_helper.hpp"
 #include "core_qt_common/models/extensions/model_extension_manager.hpp"
 
 #include "core_common/platform_env.hpp"
@@ -31,8 +32,6 @@
 
 #include "core_logging/logging.hpp"
 
-#include "core_script/type_converter_queue.hpp"
-
 #include "core_variant/variant.hpp"
 
 #include "private/qt_ui_worker.hpp"
@@ -90,9 +89,10 @@ struct QtFrameworkCommon::Implementation
 	std::unique_ptr<QtScriptingEngineBase> scriptingEngine_;
 
 	std::unique_ptr<QmlComponentManager> qmlComponentManager_;
+	std::unique_ptr<QmlComponentCache> qmlComponentCache_;
 	std::unique_ptr<ModelExtensionManager> modelExtensionManager_;
 
-	TypeConverterQueue<IQtTypeConverter, QVariant> typeConverters_;
+	QtTypeConverterRegistry typeConverters_;
 	std::vector<std::unique_ptr<IQtTypeConverter>> defaultTypeConverters_;
 
 	IDefinitionManager* definitionManager_;
@@ -339,6 +339,7 @@ QtFrameworkCommon::QtFrameworkCommon(std::unique_ptr<QQmlEngine> qmlEngine,
 	impl_->qmlEngine_->addImportPath("qrc:/");
 	impl_->qmlEngine_->addImportPath(":/");
 	impl_->qmlEngine_->setIncubationController(impl_->incubationController_.get());
+	impl_->qmlComponentCache_.reset(new QmlComponentCache(*impl_->qmlEngine_));
 }
 
 QtFrameworkCommon::~QtFrameworkCommon()
@@ -376,6 +377,8 @@ void QtFrameworkCommon::finalise()
 
 	impl_->scriptingEngine_->finalise();
 
+	impl_->qmlComponentCache_->dumpStatistics();
+	impl_->qmlComponentCache_ = nullptr;
 	impl_->qmlEngine_ = nullptr;
 	impl_->scriptingEngine_ = nullptr;
 
@@ -395,6 +398,11 @@ const QmlComponentManager* QtFrameworkCommon::qmlComponentManager() const
 	return impl_->qmlComponentManager_.get();
 }
 
+QmlComponentCache* QtFrameworkCommon::qmlComponentCache() const
+{
+	return impl_->qmlComponentCache_.get();
+}
+
 ModelExtensionManager* QtFrameworkCommon::modelExtensionManager()
 {
 	return impl_->modelExtensionManager_.get();
@@ -513,13 +521,11 @@ QUrl QtFrameworkCommon::resolveQmlPath(const char* relativePath) const
 
 QmlComponent* QtFrameworkCommon::createComponent(const QUrl& resource)
 {
-	auto qmlComponent = new QmlComponent(*impl_->qmlEngine_);
-	if (!resource.isEmpty())
+	if (resource.isEmpty())
 	{
-		QmlComponentLoaderHelper helper(qmlComponent->component(), resource);
-		helper.load(true);
+		return new QmlComponent(*impl_->qmlEngine_);
 	}
-	return qmlComponent;
+	return new QmlComponent(impl_->qmlComponentCache_->load(resource, true));
 }
 
 void QtFrameworkCommon::registerTypeConverter(IQtTypeConverter& converter)
@@ -535,7 +541,7 @@ void QtFrameworkCommon::deregisterTypeConverter(IQtTypeConverter& converter)
 QVariant QtFrameworkCommon::toQVariant(const Variant& variant, QObject* parent) const
 {
 	QVariant qVariant = QVariant::Invalid;
-	impl_->typeConverters_.toScriptType(variant, qVariant, parent);
+	impl_->typeConverters_.toQVariant(variant, qVariant, parent);
 	return qVariant;
 }
 
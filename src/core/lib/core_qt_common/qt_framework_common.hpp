@@ -17,6 +17,7 @@ class QtScriptingEngineBase;
 class QtDefaultSpacing;
 class QtGlobalSettings;
 class QmlComponentManager;
+class QmlComponentCache;
 class QmlComponent;
 class QtPalette;
 class IComponentProvider;
@@ -40,6 +41,8 @@ public:
 	QmlComponentManager* qmlComponentManager();
 	const QmlComponentManager* qmlComponentManager() const;
 
+	QmlComponentCache* qmlComponentCache() const;
+
 	ModelExtensionManager* modelExtensionManager();
 	const ModelExtensionManager* modelExtensionManager() const;
 
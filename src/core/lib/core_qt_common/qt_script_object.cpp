@@ -21,68 +21,91 @@
 namespace wgt
 {
 
-namespace
-{
-PropertyAccessor bindProperty(IClassDefinition* definition, ObjectHandle& rootObject, const std::string& path, int propertyIndex, IDefinitionManager& definitionManager,
-                              bool method = false)
+//------------------------------------------------------------------------------
+const PropertyAccessor& QtScriptObjectData::bindProperty(int index, bool method, PropertyAccessor& o_accessor)
 {
-	TF_ASSERT(propertyIndex >= 0);
+	TF_ASSERT(index >= 0);
 
-	auto properties = definition->allProperties();
-	auto it = properties.begin();
-	while (it->isMethod() != method && it != properties.end())
+	auto& table = getSlotTable();
+	auto& entries = method ? table.methods_ : table.properties_;
+	if (index >= static_cast<int>(entries.size()) || table.rootDefinition_ == nullptr)
 	{
-		++it;
+		return o_accessor;
 	}
-	for (; propertyIndex > 0 && it != properties.end(); ++it)
-	{
-		if (it->isMethod() == method && --propertyIndex == 0)
-		{
-			break;
-		}
-	}
-	if (it == properties.end())
+
+	auto& slot = entries[index];
+	if (!path_.empty())
 	{
-		return PropertyAccessor();
+		// The objects along the path may be replaced, so bind from the root every time
+		o_accessor = table.rootDefinition_->bindProperty(slot.path_.c_str(), rootObject_);
+		return o_accessor;
 	}
 
-	auto rootDefinition = definitionManager.getDefinition(rootObject);
-	if (rootDefinition == nullptr)
+	if (!slot.accessor_.isValid())
 	{
-		return PropertyAccessor();
+		slot.accessor_ = table.rootDefinition_->bindProperty(slot.path_.c_str(), rootObject_);
 	}
-
-	auto fullPath = path.empty() ? it->getName() : path + "." + it->getName();
-	return rootDefinition->bindProperty(fullPath.c_str(), rootObject);
+	return slot.accessor_;
 }
 
-int findPropertyId(IClassDefinition* definition, const IBasePropertyPtr& property)
+//------------------------------------------------------------------------------
+int QtScriptObjectData::findPropertyId(const IBasePropertyPtr& property)
 {
 	TF_ASSERT(property != nullptr);
 
-	if (definition == nullptr)
+	auto& table = getSlotTable();
+	auto& ids = property->isMethod() ? table.methodIds_ : table.propertyIds_;
+	auto found = ids.find(property->getNameHash());
+	return found != ids.end() ? found->second : -1;
+}
+
+//------------------------------------------------------------------------------
+void QtScriptObjectData::invalidateSlotTable()
+{
+	slotTable_.metaObject_ = nullptr;
+}
+
+//------------------------------------------------------------------------------
+QtScriptObjectData::SlotTable& QtScriptObjectData::getSlotTable()
+{
+	if (slotTable_.metaObject_ == metaObject_ && metaObject_ != nullptr)
+	{
+		return slotTable_;
+	}
+
+	SlotTable table;
+	table.metaObject_ = metaObject_;
+	table.rootDefinition_ = get<IDefinitionManager>()->getDefinition(rootObject_);
+	if (definition_ == nullptr)
 	{
-		return -1;
+		slotTable_ = std::move(table);
+		return slotTable_;
 	}
 
-	auto properties = definition->allProperties();
-	int id = 0;
+	// Accessors are not safe to copy unbound, so never let the vectors reallocate
+	size_t propertyCount = 0;
+	size_t methodCount = 0;
+	auto properties = definition_->allProperties();
+	for (auto it = properties.begin(); it != properties.end(); ++it)
+	{
+		++(it->isMethod() ? methodCount : propertyCount);
+	}
+	table.properties_.reserve(propertyCount);
+	table.methods_.reserve(methodCount);
 
-	for (auto itr = properties.begin(); itr != properties.end(); ++itr)
+	for (auto it = properties.begin(); it != properties.end(); ++it)
 	{
-		if (itr->getNameHash() == property->getNameHash())
-		{
-			return id;
-		}
+		auto& entries = it->isMethod() ? table.methods_ : table.properties_;
+		auto& ids = it->isMethod() ? table.methodIds_ : table.propertyIds_;
+		ids.emplace(it->getNameHash(), static_cast<int>(entries.size()));
 
-		if (itr->isMethod() == property->isMethod())
-		{
-			++id;
-		}
+		entries.emplace_back();
+		auto& slot = entries.back();
+		slot.path_ = path_.empty() ? it->getName() : path_ + "." + it->getName();
 	}
 
-	return -1;
-}
+	slotTable_ = std::move(table);
+	return slotTable_;
 }
 
 QtScriptObject::QtScriptObject(std::shared_ptr<QtScriptObjectData>& data, QObject* parent)
@@ -167,8 +190,9 @@ int QtScriptObject::qt_metacall(QMetaObject::Call c, int id, void** argv)
 			return id;
 		}
 
-		// The property offset is in our QtScriptObject
-		auto property = bindProperty(data_->definition_, data_->rootObject_, data_->path_, id, *data_->get<IDefinitionManager>());
+		// The property offset is in our QtScriptObject, after self
+		PropertyAccessor accessor;
+		auto& property = data_->bindProperty(id - 1, false, accessor);
 
 		if (property.isValid())
 		{
@@ -193,13 +217,15 @@ int QtScriptObject::qt_metacall(QMetaObject::Call c, int id, void** argv)
 				{
 					RefObjectId objectId;
 					Variant valueVariant = qtHelpers->toVariant(*value);
+					// Setting a value may change the definition and with it the slot table
+					PropertyAccessor target(property);
 					if (controller)
 					{
-						controller->setValue(property, valueVariant);
+						controller->setValue(target, valueVariant);
 					}
 					else
 					{
-						property.setValue(valueVariant);
+						target.setValue(valueVariant);
 					}
 				}
 			}
@@ -220,7 +246,7 @@ void QtScriptObject::firePropertySignal(const IBasePropertyPtr& property, const
 {
 	QVariant qvariant = data_->get<IQtHelpers>()->toQVariant(value, this);
 	void* parameters[] = { nullptr, &qvariant };
-	int signalId = findPropertyId(data_->definition_, property);
+	int signalId = data_->findPropertyId(property);
 	callMethod(signalId, parameters);
 }
 
@@ -229,7 +255,7 @@ void QtScriptObject::fireMethodSignal(const IBasePropertyPtr& method, bool undo)
 	TF_ASSERT(data_->metaObject_ != nullptr);
 	QVariant qvariant = undo;
 	void* parameters[] = { nullptr, &qvariant };
-	int methodId = findPropertyId(data_->definition_, method);
+	int methodId = data_->findPropertyId(method);
 	int propertyCount = data_->metaObject_->propertyCount() - data_->metaObject_->propertyOffset();
 	int firstMethodSignalId = propertyCount - 1;
 	int nonReflectedMethodSignals = 2;
@@ -333,8 +359,16 @@ void QtScriptObject::callMethod(int id, void** argv)
 	}
 	else
 	{
-		int methodId = id - 2;
-		auto pa = bindProperty(data_->definition_, data_->rootObject_, data_->path_, methodId, *data_->get<IDefinitionManager>(), true);
+		// Reflected methods follow the three above
+		PropertyAccessor accessor;
+		auto& method = data_->bindProperty(id - 3, true, accessor);
+		if (!method.isValid())
+		{
+			return;
+		}
+
+		// Methods may change the definition and with it the slot table
+		PropertyAccessor pa(method);
 		ReflectedMethodParameters parameters;
 
 		for (size_t i = 0; i < pa.getProperty()->parameterCount(); ++i)
@@ -20,6 +20,8 @@ Details: Search for NGT Reflection System on the Wargaming Confluence
 #include "core_common/signal.hpp"
 #include "core_qt_common/interfaces/i_qt_helpers.hpp"
 #include <QObject>
+#include <unordered_map>
+#include <vector>
 
 namespace wgt
 {
@@ -43,6 +45,23 @@ struct QtScriptObjectData : public Depends<IDefinitionManager, IReflectionContro
 		connectPostPropertyAdded_.disconnect();
 		connectPostPropertyRemoved_.disconnect();
 	}
+	/**
+	 *	Binds the reflected property, or method, at index in the order the
+	 *	generated meta-object numbers them.
+	 *	@param o_accessor receives the accessor when it cannot be kept bound.
+	 *	@return the bound accessor, which is not valid on failure.
+	 */
+	const PropertyAccessor& bindProperty(int index, bool method, PropertyAccessor& o_accessor);
+
+	/**
+	 *	Returns the index of a property, or method, in the order the generated
+	 *	meta-object numbers them, or -1 if the definition does not have it.
+	 */
+	int findPropertyId(const IBasePropertyPtr& property);
+
+	/** Discards the slot table, for when the definition and metaObject_ change. */
+	void invalidateSlotTable();
+
 	QtScriptingEngineBase& scriptEngine_;
 	QMetaObject* metaObject_;
 	IClassDefinition* definition_;
@@ -51,6 +70,35 @@ struct QtScriptObjectData : public Depends<IDefinitionManager, IReflectionContro
 	uint64_t hash_;
 	Connection connectPostPropertyAdded_;
 	Connection connectPostPropertyRemoved_;
+
+private:
+	// Reflected properties and methods, indexed the way metaObject_ numbers them
+	struct SlotTable
+	{
+		SlotTable() : metaObject_(nullptr), rootDefinition_(nullptr)
+		{
+		}
+
+		struct Slot
+		{
+			// path from rootObject_
+			std::string path_;
+			// kept bound when the property is on rootObject_ itself
+			PropertyAccessor accessor_;
+		};
+
+		const QMetaObject* metaObject_;
+		IClassDefinition* rootDefinition_;
+		std::vector<Slot> properties_;
+		std::vector<Slot> methods_;
+		// name hash -> index into properties_ or methods_
+		std::unordered_map<uint64_t, int> propertyIds_;
+		std::unordered_map<uint64_t, int> methodIds_;
+	};
+
+	SlotTable& getSlotTable();
+
+	SlotTable slotTable_;
 };
 
 class QtScriptObject : public QObject
@@ -215,6 +215,7 @@ QtScriptObject* QtScriptingEngine::Implementation::createScriptObject(QObject* p
         // lambda per instance.
         auto pData = data.get();
         auto postChanged = [&, pData, classDefinition](const char* name) {
+            pData->invalidateSlotTable();
             auto definitionName = classDefinition->getName();
             QMetaObject* oldMetaObject = nullptr;
             {
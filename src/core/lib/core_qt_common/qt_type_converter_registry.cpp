@@ -0,0 +1,228 @@
+#include "qt_type_converter_registry.hpp"
+
+#include "i_qt_type_converter.hpp"
+
+#include "core_common/assert.hpp"
+#include "wg_types/shared_string.hpp"
+#include "wg_types/vector2.hpp"
+#include "wg_types/vector3.hpp"
+#include "wg_types/vector4.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <QVariant>
+
+namespace wgt
+{
+namespace
+{
+//------------------------------------------------------------------------------
+bool isValueType(const TypeId& type)
+{
+	static const std::vector<TypeId> s_ValueTypes = {
+		TypeId::getType<bool>(),
+		TypeId::getType<char>(),
+		TypeId::getType<int8_t>(),
+		TypeId::getType<uint8_t>(),
+		TypeId::getType<short>(),
+		TypeId::getType<unsigned short>(),
+		TypeId::getType<int>(),
+		TypeId::getType<unsigned int>(),
+		TypeId::getType<long>(),
+		TypeId::getType<unsigned long>(),
+		TypeId::getType<long long>(),
+		TypeId::getType<unsigned long long>(),
+		TypeId::getType<float>(),
+		TypeId::getType<double>(),
+		TypeId::getType<const char*>(),
+		TypeId::getType<std::string>(),
+		TypeId::getType<const wchar_t*>(),
+		TypeId::getType<std::wstring>(),
+		TypeId::getType<SharedString>(),
+		TypeId::getType<Vector2>(),
+		TypeId::getType<Vector3>(),
+		TypeId::getType<Vector4>(),
+	};
+	return std::find(s_ValueTypes.begin(), s_ValueTypes.end(), type) != s_ValueTypes.end();
+}
+
+//------------------------------------------------------------------------------
+bool isValueType(int qType)
+{
+	static const std::vector<int> s_ValueTypes = {
+		QMetaType::Bool,     QMetaType::Char,      QMetaType::SChar,     QMetaType::UChar,    QMetaType::Short,
+		QMetaType::UShort,   QMetaType::Int,       QMetaType::UInt,      QMetaType::Long,     QMetaType::ULong,
+		QMetaType::LongLong, QMetaType::ULongLong, QMetaType::Float,     QMetaType::Double,   QMetaType::QString,
+		QMetaType::QUrl,     QMetaType::QPoint,    QMetaType::QPointF,   QMetaType::QVector2D, QMetaType::QVector3D,
+		QMetaType::QVector4D,
+	};
+	return std::find(s_ValueTypes.begin(), s_ValueTypes.end(), qType) != s_ValueTypes.end();
+}
+
+//------------------------------------------------------------------------------
+template <typename Key>
+bool acceptsType(const std::vector<Key>& types, const Key& type, bool valueType)
+{
+	if (types.empty())
+	{
+		return !valueType;
+	}
+	return std::find(types.begin(), types.end(), type) != types.end();
+}
+}
+
+//==============================================================================
+QtTypeConverterRegistry::QtTypeConverterRegistry()
+{
+}
+
+//==============================================================================
+QtTypeConverterRegistry::~QtTypeConverterRegistry()
+{
+}
+
+//==============================================================================
+void QtTypeConverterRegistry::registerTypeConverter(IQtTypeConverter& converter)
+{
+	wg_write_lock_guard guard(lock_);
+	auto foundItr = std::find_if(entries_.cbegin(), entries_.cend(),
+	                             [&converter](const Entry& entry) { return entry.converter_ == &converter; });
+	const bool found = (foundItr != entries_.cend());
+	TF_ASSERT(!found);
+	if (found)
+	{
+		return;
+	}
+
+	Entry entry;
+	entry.converter_ = &converter;
+	converter.getVariantTypes(entry.variantTypes_);
+	converter.getQVariantTypes(entry.qVariantTypes_);
+	entries_.push_back(std::move(entry));
+	clearConverters();
+}
+
+//==============================================================================
+void QtTypeConverterRegistry::deregisterTypeConverter(IQtTypeConverter& converter)
+{
+	wg_write_lock_guard guard(lock_);
+	auto foundItr = std::find_if(entries_.cbegin(), entries_.cend(),
+	                             [&converter](const Entry& entry) { return entry.converter_ == &converter; });
+	const bool found = (foundItr != entries_.cend());
+	TF_ASSERT(found);
+	if (!found)
+	{
+		return;
+	}
+	entries_.erase(foundItr);
+	clearConverters();
+}
+
+//==============================================================================
+bool QtTypeConverterRegistry::toQVariant(const Variant& variant, QVariant& o_qVariant, QObject* parent) const
+{
+	if (variant.isVoid())
+	{
+		return false;
+	}
+
+	auto converters = getConverters(variant.type()->typeId(), variant.isPointer());
+	for (auto& converter : *converters)
+	{
+		if (converter->toQVariant(variant, o_qVariant, parent))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//==============================================================================
+bool QtTypeConverterRegistry::toVariant(const QVariant& qVariant, Variant& o_variant) const
+{
+	if (!qVariant.isValid())
+	{
+		return false;
+	}
+
+	auto converters = getConverters(qVariant.userType());
+	for (auto& converter : *converters)
+	{
+		if (converter->toVariant(qVariant, o_variant))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//==============================================================================
+QtTypeConverterRegistry::ConvertersPtr QtTypeConverterRegistry::getConverters(const TypeId& type, bool pointer) const
+{
+	auto& cache = pointer ? pointerConverters_ : variantConverters_;
+	{
+		wg_read_lock_guard guard(lock_);
+		auto found = cache.find(type);
+		if (found != cache.end())
+		{
+			return found->second;
+		}
+	}
+
+	wg_write_lock_guard guard(lock_);
+	auto& converters = cache[type];
+	if (converters == nullptr)
+	{
+		const bool valueType = !pointer && isValueType(type);
+		auto candidates = std::make_shared<Converters>();
+		for (auto itr = entries_.crbegin(); itr != entries_.crend(); ++itr)
+		{
+			if (acceptsType(itr->variantTypes_, type, valueType))
+			{
+				candidates->push_back(itr->converter_);
+			}
+		}
+		converters = candidates;
+	}
+	return converters;
+}
+
+//==============================================================================
+QtTypeConverterRegistry::ConvertersPtr QtTypeConverterRegistry::getConverters(int qType) const
+{
+	{
+		wg_read_lock_guard guard(lock_);
+		auto found = qVariantConverters_.find(qType);
+		if (found != qVariantConverters_.end())
+		{
+			return found->second;
+		}
+	}
+
+	wg_write_lock_guard guard(lock_);
+	auto& converters = qVariantConverters_[qType];
+	if (converters == nullptr)
+	{
+		const bool valueType = isValueType(qType);
+		auto candidates = std::make_shared<Converters>();
+		for (auto itr = entries_.crbegin(); itr != entries_.crend(); ++itr)
+		{
+			if (acceptsType(itr->qVariantTypes_, qType, valueType))
+			{
+				candidates->push_back(itr->converter_);
+			}
+		}
+		converters = candidates;
+	}
+	return converters;
+}
+
+//==============================================================================
+void QtTypeConverterRegistry::clearConverters()
+{
+	variantConverters_.clear();
+	pointerConverters_.clear();
+	qVariantConverters_.clear();
+}
+} // end namespace wgt
@@ -0,0 +1,78 @@
+#ifndef QT_TYPE_CONVERTER_REGISTRY_HPP
+#define QT_TYPE_CONVERTER_REGISTRY_HPP
+
+#include "core_common/wg_read_write_lock.hpp"
+#include "core_variant/type_id.hpp"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class QVariant;
+class QObject;
+
+namespace wgt
+{
+class IQtTypeConverter;
+class Variant;
+
+/**
+ *	Registry of IQtTypeConverters indexed by source type.
+ *
+ *	Converters are searched from most-recently-added to first-added, as with
+ *	TypeConverterQueue. The list of candidate converters for each Variant TypeId
+ *	and QVariant::userType() is built on first use and cached until the next
+ *	registration change, so converters which declare the types they accept via
+ *	IQtTypeConverter::getVariantTypes/getQVariantTypes are only tried for those types.
+ *	Types with no candidates are rejected without calling any converter.
+ *
+ *	Plain value types (numbers, strings and vectors) are only offered to converters
+ *	which list them explicitly, never to catch-all converters. Pointers to them are
+ *	still offered to every catch-all converter.
+ */
+class QtTypeConverterRegistry
+{
+public:
+	QtTypeConverterRegistry();
+	~QtTypeConverterRegistry();
+
+	/**
+	 *	@pre converter must not already be added.
+	 */
+	void registerTypeConverter(IQtTypeConverter& converter);
+
+	/**
+	 *	@pre converter must have been added with registerTypeConverter().
+	 */
+	void deregisterTypeConverter(IQtTypeConverter& converter);
+
+	bool toQVariant(const Variant& variant, QVariant& o_qVariant, QObject* parent) const;
+	bool toVariant(const QVariant& qVariant, Variant& o_variant) const;
+
+private:
+	QtTypeConverterRegistry(const QtTypeConverterRegistry& other);
+	QtTypeConverterRegistry& operator=(const QtTypeConverterRegistry& other);
+
+	struct Entry
+	{
+		IQtTypeConverter* converter_;
+		std::vector<TypeId> variantTypes_;
+		std::vector<int> qVariantTypes_;
+	};
+
+	typedef std::vector<const IQtTypeConverter*> Converters;
+	typedef std::shared_ptr<const Converters> ConvertersPtr;
+
+	ConvertersPtr getConverters(const TypeId& type, bool pointer) const;
+	ConvertersPtr getConverters(int qType) const;
+	void clearConverters();
+
+	std::vector<Entry> entries_;
+
+	mutable wg_read_write_lock lock_;
+	mutable std::unordered_map<TypeId, ConvertersPtr> variantConverters_;
+	mutable std::unordered_map<TypeId, ConvertersPtr> pointerConverters_;
+	mutable std::unordered_map<int, ConvertersPtr> qVariantConverters_;
+};
+} // end namespace wgt
+#endif // QT_TYPE_CONVERTER_REGISTRY_HPP
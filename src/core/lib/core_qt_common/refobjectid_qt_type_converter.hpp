@@ -41,6 +41,16 @@ public:
 		}
 		return true;
 	}
+
+	void getVariantTypes(std::vector<TypeId>& o_types) const override
+	{
+		o_types.push_back(TypeId::getType<RefObjectId>());
+	}
+
+	void getQVariantTypes(std::vector<int>& o_types) const override
+	{
+		o_types.push_back(qMetaTypeId<RefObjectId>());
+	}
 };
 } // end namespace wgt
 #endif
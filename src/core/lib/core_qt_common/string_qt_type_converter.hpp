@@ -63,6 +63,21 @@ public:
 
 		return false;
 	}
+
+	void getVariantTypes(std::vector<TypeId>& o_types) const override
+	{
+		o_types.push_back(TypeId::getType<const char*>());
+		o_types.push_back(TypeId::getType<std::string>());
+		o_types.push_back(TypeId::getType<wgt::SharedString>());
+		o_types.push_back(TypeId::getType<const wchar_t*>());
+		o_types.push_back(TypeId::getType<std::wstring>());
+	}
+
+	void getQVariantTypes(std::vector<int>& o_types) const override
+	{
+		o_types.push_back(QVariant::String);
+		o_types.push_back(QVariant::Url);
+	}
 };
 } // end namespace wgt
 #endif
@@ -0,0 +1,204 @@
+#include "trigram_index.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace wgt
+{
+namespace
+{
+unsigned char foldCase(char c)
+{
+	return static_cast<unsigned char>((c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c);
+}
+
+void getTrigrams(const char* str, size_t length, std::vector<uint32_t>& o_trigrams)
+{
+	o_trigrams.clear();
+	for (size_t i = 2; i < length; ++i)
+	{
+		o_trigrams.push_back((foldCase(str[i - 2]) << 16) | (foldCase(str[i - 1]) << 8) | foldCase(str[i]));
+	}
+	std::sort(o_trigrams.begin(), o_trigrams.end());
+	o_trigrams.erase(std::unique(o_trigrams.begin(), o_trigrams.end()), o_trigrams.end());
+}
+}
+
+TrigramIndex::TrigramIndex(const std::vector<std::string>& values) : values_(values), deadIds_(0)
+{
+}
+
+void TrigramIndex::clear()
+{
+	postings_.clear();
+	rowIds_.clear();
+	idRows_.clear();
+	deadIds_ = 0;
+}
+
+void TrigramIndex::rebuild()
+{
+	clear();
+	insertRows(0, static_cast<int>(values_.size()));
+}
+
+void TrigramIndex::insertRows(int first, int count)
+{
+	std::vector<uint32_t> ids;
+	ids.reserve(count);
+	for (auto row = first; row < first + count; ++row)
+	{
+		ids.push_back(addValue(values_[row], row));
+	}
+	rowIds_.insert(rowIds_.begin() + first, ids.begin(), ids.end());
+	updateRows(first + count);
+}
+
+void TrigramIndex::removeRows(int first, int count)
+{
+	auto begin = rowIds_.begin() + first;
+	auto end = begin + count;
+	for (auto it = begin; it != end; ++it)
+	{
+		idRows_[*it] = -1;
+	}
+	deadIds_ += count;
+	rowIds_.erase(begin, end);
+	updateRows(first);
+	compact();
+}
+
+void TrigramIndex::changeRow(int row)
+{
+	idRows_[rowIds_[row]] = -1;
+	++deadIds_;
+	rowIds_[row] = addValue(values_[row], row);
+	compact();
+}
+
+bool TrigramIndex::findCandidates(const FilterExpression::TermClauses& clauses, std::vector<int>& o_rows) const
+{
+	bool constrained = false;
+	std::vector<uint32_t> ids;
+	std::vector<uint32_t> clauseIds;
+	std::vector<uint32_t> termIds;
+	std::vector<uint32_t> merged;
+	for (auto& clause : clauses)
+	{
+		if (!findClause(clause, clauseIds, termIds, merged))
+		{
+			continue;
+		}
+
+		if (!constrained)
+		{
+			ids.swap(clauseIds);
+			constrained = true;
+		}
+		else
+		{
+			merged.clear();
+			std::set_intersection(ids.begin(), ids.end(), clauseIds.begin(), clauseIds.end(), std::back_inserter(merged));
+			ids.swap(merged);
+		}
+	}
+
+	if (!constrained)
+	{
+		return false;
+	}
+
+	o_rows.clear();
+	o_rows.reserve(ids.size());
+	for (auto id : ids)
+	{
+		if (idRows_[id] != -1)
+		{
+			o_rows.push_back(idRows_[id]);
+		}
+	}
+	std::sort(o_rows.begin(), o_rows.end());
+	return true;
+}
+
+uint32_t TrigramIndex::addValue(const std::string& value, int row)
+{
+	auto id = static_cast<uint32_t>(idRows_.size());
+	idRows_.push_back(row);
+	getTrigrams(value.c_str(), value.length(), trigrams_);
+	for (auto trigram : trigrams_)
+	{
+		postings_[trigram].push_back(id);
+	}
+	return id;
+}
+
+void TrigramIndex::updateRows(int first)
+{
+	for (auto row = first; row < static_cast<int>(rowIds_.size()); ++row)
+	{
+		idRows_[rowIds_[row]] = row;
+	}
+}
+
+void TrigramIndex::compact()
+{
+	if (deadIds_ > 1024 && deadIds_ > rowIds_.size())
+	{
+		rebuild();
+	}
+}
+
+// Union of the ids containing any of the terms. Returns false if a term is too short to look up.
+bool TrigramIndex::findClause(const std::vector<std::string>& clause, std::vector<uint32_t>& o_ids,
+                              std::vector<uint32_t>& termIds, std::vector<uint32_t>& merged) const
+{
+	o_ids.clear();
+	for (auto& term : clause)
+	{
+		if (term.length() < 3)
+		{
+			return false;
+		}
+	}
+
+	std::vector<uint32_t> trigrams;
+	std::vector<const std::vector<uint32_t>*> postings;
+	for (auto& term : clause)
+	{
+		getTrigrams(term.c_str(), term.length(), trigrams);
+		postings.clear();
+		for (auto trigram : trigrams)
+		{
+			auto found = postings_.find(trigram);
+			if (found == postings_.end())
+			{
+				postings.clear();
+				break;
+			}
+			postings.push_back(&found->second);
+		}
+		if (postings.empty())
+		{
+			continue;
+		}
+
+		// Intersect the shortest posting lists first
+		std::sort(postings.begin(), postings.end(),
+		          [](const std::vector<uint32_t>* a, const std::vector<uint32_t>* b) { return a->size() < b->size(); });
+		termIds = *postings.front();
+		for (size_t i = 1; i < postings.size() && !termIds.empty(); ++i)
+		{
+			merged.clear();
+			std::set_intersection(termIds.begin(), termIds.end(), postings[i]->begin(), postings[i]->end(),
+			                      std::back_inserter(merged));
+			termIds.swap(merged);
+		}
+
+		merged.clear();
+		std::set_union(o_ids.begin(), o_ids.end(), termIds.begin(), termIds.end(), std::back_inserter(merged));
+		o_ids.swap(merged);
+	}
+	return true;
+}
+} // end namespace wgt
@@ -0,0 +1,67 @@
+#ifndef TRIGRAM_INDEX_HPP
+#define TRIGRAM_INDEX_HPP
+
+#include "filter_expression.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace wgt
+{
+/*
+	Posting lists of case folded trigrams over a list of strings, used to find the
+	candidate rows for the terms of a filter. Each row has an id, and ids are only
+	ever appended so every posting list stays sorted. Removed and changed rows
+	leave their old id dead in the posting lists until enough have accumulated to
+	rebuild the index.
+*/
+class TrigramIndex
+{
+public:
+	/*
+		Indexes the given values, which the owner keeps and updates before
+		telling the index about the rows that changed.
+	*/
+	TrigramIndex(const std::vector<std::string>& values);
+
+	void clear();
+	void rebuild();
+
+	// Indexes rows which have just been inserted into the values
+	void insertRows(int first, int count);
+
+	// Drops rows which have just been removed from the values
+	void removeRows(int first, int count);
+
+	// Reindexes a row whose value has just changed
+	void changeRow(int row);
+
+	/*
+		Collects the sorted rows which could satisfy every clause. Returns false if
+		no clause can be looked up, i.e. they all have a term shorter than a trigram.
+	*/
+	bool findCandidates(const FilterExpression::TermClauses& clauses, std::vector<int>& o_rows) const;
+
+private:
+	typedef std::unordered_map<uint32_t, std::vector<uint32_t>> Postings;
+
+	uint32_t addValue(const std::string& value, int row);
+	void updateRows(int first);
+	void compact();
+	bool findClause(const std::vector<std::string>& clause, std::vector<uint32_t>& o_ids,
+	                std::vector<uint32_t>& termIds, std::vector<uint32_t>& merged) const;
+
+	const std::vector<std::string>& values_;
+	Postings postings_;
+	std::vector<uint32_t> trigrams_;
+	// source row -> id
+	std::vector<uint32_t> rowIds_;
+	// id -> source row, or -1 once the id is dead
+	std::vector<int> idRows_;
+	size_t deadIds_;
+};
+} // end namespace wgt
+
+#endif // TRIGRAM_INDEX_HPP
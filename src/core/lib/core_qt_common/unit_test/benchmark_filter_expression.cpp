@@ -0,0 +1,75 @@
+#include "pch.hpp"
+
+#include "core_qt_common/filter_expression.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace wgt
+{
+namespace
+{
+bool containsNoCase(std::string str, const std::string& term)
+{
+	std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+	return str.find(term) != std::string::npos;
+}
+}
+
+TEST(filterExpressionBenchmark)
+{
+	const char* words[] = { "rock", "tree", "grass", "water", "house", "wall", "door", "roof",
+		                    "bush", "stone", "road", "fence", "lamp", "crate", "barrel", "sign" };
+	const size_t numWords = sizeof(words) / sizeof(words[0]);
+
+	std::vector<std::string> names;
+	names.reserve(1000000);
+	for (size_t i = 0; i < 1000000; ++i)
+	{
+		names.push_back(std::string("models/environment/") + words[i % numWords] + "_" +
+		                words[(i / numWords) % numWords] + "_" + std::to_string(i % 997) + ".model");
+	}
+
+	for (size_t numTerms = 1; numTerms <= 8; ++numTerms)
+	{
+		std::vector<std::string> terms;
+		std::string anyExpression;
+		std::string allExpression;
+		for (size_t i = 0; i < numTerms; ++i)
+		{
+			terms.push_back(words[(i * 5 + 3) % numWords]);
+			anyExpression += (i == 0 ? "" : " ") + terms.back();
+			allExpression += (i == 0 ? "" : " AND ") + terms.back();
+		}
+
+		auto anyExpr = FilterExpression(anyExpression.c_str());
+		auto allExpr = FilterExpression(allExpression.c_str());
+
+		size_t anyMatches = 0;
+		size_t allMatches = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		for (auto& name : names)
+		{
+			anyMatches += anyExpr.match(name.c_str()) ? 1 : 0;
+			allMatches += allExpr.match(name.c_str()) ? 1 : 0;
+		}
+		auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start);
+
+		// Spot check the results against a plain substring search
+		for (size_t i = 0; i < names.size(); i += 101)
+		{
+			size_t found = std::count_if(terms.begin(), terms.end(),
+			                             [&](const std::string& term) { return containsNoCase(names[i], term); });
+			CHECK_EQUAL(found != 0, anyExpr.match(names[i].c_str()));
+			CHECK_EQUAL(found == terms.size(), allExpr.match(names[i].c_str()));
+		}
+
+		printf("Matched %d names against %d term expressions in %.3fms (%d any, %d all)\n",
+		       static_cast<int>(names.size()), static_cast<int>(numTerms), elapsed.count(),
+		       static_cast<int>(anyMatches), static_cast<int>(allMatches));
+	}
+}
+} // end namespace wgt
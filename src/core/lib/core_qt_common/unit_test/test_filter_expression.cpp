@@ -5,6 +5,7 @@
 #include "core_common/platform_dll.hpp"
 #include "core_string_utils/file_path.hpp"
 #include "core_string_utils/string_utils.hpp"
+#include <algorithm>
 #include <array>
 #include <fstream>
 #include <QDir>
@@ -320,4 +321,135 @@ TEST(testFilterExpression)
 		CHECK(expr.match("test cake"));		
 	}
 }
+
+TEST(testFilterExpressionCompiled)
+{
+	{
+		// Terms are matched case insensitively
+		auto expr = FilterExpression("Rock");
+		CHECK(expr.match("models/ROCK_large.model"));
+		CHECK(expr.match("models/rock_large.model"));
+		CHECK(!expr.match("models/roc_large.model"));
+	}
+
+	{
+		// Overlapping terms are all found in a single pass
+		auto expr = FilterExpression("she AND he AND hers");
+		CHECK(expr.match("ushers"));
+		CHECK(!expr.match("ushe"));
+
+		auto subExpr = FilterExpression("abcd AND bc");
+		CHECK(!subExpr.match("xabcx"));
+		CHECK(subExpr.match("xabcdx"));
+	}
+
+	{
+		// Repeated terms share a single search
+		auto expr = FilterExpression("foo XOR FOO");
+		CHECK(!expr.match("foo"));
+		CHECK(!expr.match("bar"));
+	}
+
+	{
+		// A missing operand never matches
+		CHECK(!FilterExpression("foo AND").match("foo"));
+		CHECK(FilterExpression("foo OR").match("foo"));
+		CHECK(!FilterExpression("NOT").match("foo"));
+		CHECK(!FilterExpression("AND foo").match("foo"));
+	}
+
+	{
+		// More terms than fit in a single pass still match
+		std::string expression;
+		for (int i = 0; i < 100; ++i)
+		{
+			expression += "term" + std::to_string(i) + "x ";
+		}
+		auto expr = FilterExpression(expression.c_str());
+		CHECK(expr.match("a term57x string"));
+		CHECK(!expr.match("a term string"));
+	}
+}
+
+TEST(testFilterExpressionRequiredTerms)
+{
+	FilterExpression::TermClauses clauses;
+	bool exact = false;
+
+	CHECK(!FilterExpression("").getRequiredTerms(clauses, exact));
+	CHECK(!FilterExpression("NOT foo").getRequiredTerms(clauses, exact));
+	CHECK(!FilterExpression("foo OR NOT bar").getRequiredTerms(clauses, exact));
+
+	CHECK(FilterExpression("Foo").getRequiredTerms(clauses, exact));
+	CHECK(exact);
+	CHECK(clauses == FilterExpression::TermClauses({ { "foo" } }));
+
+	CHECK(FilterExpression("foo bar AND cake").getRequiredTerms(clauses, exact));
+	CHECK(exact);
+	CHECK(clauses == FilterExpression::TermClauses({ { "foo", "bar" }, { "cake" } }));
+
+	CHECK(FilterExpression("foo NOT bar").getRequiredTerms(clauses, exact));
+	CHECK(!exact);
+	CHECK(clauses == FilterExpression::TermClauses({ { "foo" } }));
+
+	CHECK(FilterExpression("foo OR (bar AND cake)").getRequiredTerms(clauses, exact));
+	CHECK(exact);
+	CHECK(clauses == FilterExpression::TermClauses({ { "foo", "bar" }, { "foo", "cake" } }));
+
+	CHECK(FilterExpression("foo XOR bar").getRequiredTerms(clauses, exact));
+	CHECK(!exact);
+	CHECK(clauses == FilterExpression::TermClauses({ { "foo", "bar" } }));
+
+	// A syntax error can never be satisfied
+	CHECK(FilterExpression("foo NOT NOT bar").getRequiredTerms(clauses, exact));
+	CHECK(clauses == FilterExpression::TermClauses(1));
+}
+
+namespace
+{
+bool containsNoCase(std::string str, const std::string& term)
+{
+	std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+	return str.find(term) != std::string::npos;
+}
+}
+
+TEST(testFilterExpressionManyTerms)
+{
+	const char* words[] = { "rock", "tree", "grass", "water", "house", "wall", "door", "roof",
+		                    "bush", "stone", "road", "fence", "lamp", "crate", "barrel", "sign" };
+	const size_t numWords = sizeof(words) / sizeof(words[0]);
+
+	std::vector<std::string> names;
+	for (size_t i = 0; i < numWords * numWords; ++i)
+	{
+		names.push_back(std::string("models/environment/") + words[i % numWords] + "_" +
+		                words[(i / numWords) % numWords] + "_" + std::to_string(i % 97) + ".model");
+	}
+
+	for (size_t numTerms = 1; numTerms <= 8; ++numTerms)
+	{
+		std::vector<std::string> terms;
+		std::string anyExpression;
+		std::string allExpression;
+		for (size_t i = 0; i < numTerms; ++i)
+		{
+			terms.push_back(words[(i * 5 + 3) % numWords]);
+			anyExpression += (i == 0 ? "" : " ") + terms.back();
+			allExpression += (i == 0 ? "" : " AND ") + terms.back();
+		}
+
+		auto anyExpr = FilterExpression(anyExpression.c_str());
+		auto allExpr = FilterExpression(allExpression.c_str());
+
+		// Check the results against a plain substring search
+		for (auto& name : names)
+		{
+			size_t found = std::count_if(terms.begin(), terms.end(),
+			                             [&](const std::string& term) { return containsNoCase(name, term); });
+			CHECK_EQUAL(found != 0, anyExpr.match(name.c_str()));
+			CHECK_EQUAL(found == terms.size(), allExpr.match(name.c_str()));
+		}
+	}
+}
 } // end namespace wgt
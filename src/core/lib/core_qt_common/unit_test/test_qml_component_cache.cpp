@@ -0,0 +1,164 @@
+#include "pch.hpp"
+
+#include "core_qt_common/qml_component_cache.hpp"
+
+#include <chrono>
+#include <memory>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileSystemWatcher>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QTemporaryDir>
+
+namespace wgt
+{
+namespace
+{
+/**
+ *	Provides the event loop the engine's loader and the file watcher report through.
+ */
+class ComponentCacheTestApplication
+{
+public:
+	ComponentCacheTestApplication()
+	{
+		if (QCoreApplication::instance() == nullptr)
+		{
+			static int argc = 1;
+			static char name[] = "qt_common_unit_test";
+			static char* argv[] = { name, nullptr };
+			application_.reset(new QCoreApplication(argc, argv));
+		}
+	}
+
+	/** Processes events until condition holds, for at most five seconds. */
+	template <typename Condition>
+	bool waitFor(Condition condition)
+	{
+		QElapsedTimer timer;
+		timer.start();
+		while (!condition() && timer.elapsed() < 5000)
+		{
+			QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+		}
+		return condition();
+	}
+
+private:
+	std::unique_ptr<QCoreApplication> application_;
+};
+
+bool writeComponent(const QString& path, int value)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+	{
+		return false;
+	}
+	file.write(QString("import QtQml 2.2\nQtObject { property int value: %1 }\n").arg(value).toUtf8());
+	return true;
+}
+
+int createValue(QQmlComponent& component)
+{
+	std::unique_ptr<QObject> object(component.create());
+	return object != nullptr ? object->property("value").toInt() : -1;
+}
+}
+
+TEST(QmlComponentCache_hits)
+{
+	ComponentCacheTestApplication application;
+	QTemporaryDir dir;
+	RETURN_ON_FAIL_CHECK(dir.isValid());
+	const QString path = dir.path() + "/CacheHit.qml";
+	RETURN_ON_FAIL_CHECK(writeComponent(path, 1));
+	const QUrl url = QUrl::fromLocalFile(path);
+
+	QQmlEngine engine;
+	QmlComponentCache cache(engine);
+
+	int loaded = 0;
+	int failed = 0;
+	auto onLoaded = [&loaded](const std::shared_ptr<QQmlComponent>&) { ++loaded; };
+	auto onError = [&failed](const std::shared_ptr<QQmlComponent>&) { ++failed; };
+
+	// Loads made while the component compiles queue behind it
+	auto first = cache.load(url, true, onLoaded, onError);
+	RETURN_ON_FAIL_CHECK(first != nullptr);
+	auto queued = cache.load(url, true, onLoaded, onError);
+	CHECK(queued == first);
+	CHECK(application.waitFor([&]() { return loaded + failed == 2; }));
+	CHECK_EQUAL(2, loaded);
+	CHECK_EQUAL(0, failed);
+	CHECK(first->isReady());
+
+	// Once ready the component is handed out straight away
+	auto ready = cache.load(url, false, onLoaded, onError);
+	CHECK(ready == first);
+	CHECK_EQUAL(3, loaded);
+	CHECK_EQUAL(1, createValue(*ready));
+
+	auto statistics = cache.getStatistics(url);
+	CHECK_EQUAL(1, statistics.compiles_);
+	CHECK_EQUAL(2, statistics.hits_);
+
+	// Failures are cached as well
+	const QUrl missing = QUrl::fromLocalFile(dir.path() + "/Missing.qml");
+	auto broken = cache.load(missing, false, onLoaded, onError);
+	CHECK(application.waitFor([&]() { return failed == 1; }));
+	CHECK(cache.load(missing, false, onLoaded, onError) == broken);
+	CHECK_EQUAL(2, failed);
+	CHECK_EQUAL(3, loaded);
+	CHECK_EQUAL(1, cache.getStatistics(missing).compiles_);
+}
+
+TEST(QmlComponentCache_watcherInvalidation)
+{
+	ComponentCacheTestApplication application;
+	QTemporaryDir dir;
+	RETURN_ON_FAIL_CHECK(dir.isValid());
+	const QString path = dir.path() + "/Reloaded.qml";
+	RETURN_ON_FAIL_CHECK(writeComponent(path, 1));
+	const QUrl url = QUrl::fromLocalFile(path);
+
+	QQmlEngine engine;
+	QmlComponentCache cache(engine);
+
+	// Invalidate as the framework's QML watcher does. A write may be reported
+	// more than once, so stop watching after the first change.
+	int changes = 0;
+	QFileSystemWatcher watcher;
+	RETURN_ON_FAIL_CHECK(watcher.addPath(path));
+	QObject::connect(&watcher, &QFileSystemWatcher::fileChanged, [&]() {
+		++changes;
+		watcher.removePath(path);
+		engine.clearComponentCache();
+		cache.clear();
+	});
+
+	auto original = cache.load(url, false);
+	RETURN_ON_FAIL_CHECK(original != nullptr && original->isReady());
+	CHECK_EQUAL(1, createValue(*original));
+	CHECK(cache.load(url, false) == original);
+
+	RETURN_ON_FAIL_CHECK(writeComponent(path, 2));
+	RETURN_ON_FAIL_CHECK(application.waitFor([&]() { return changes != 0; }));
+
+	// The next load compiles the changed file, views holding the old component keep it
+	auto reloaded = cache.load(url, false);
+	RETURN_ON_FAIL_CHECK(reloaded != nullptr && reloaded->isReady());
+	CHECK(reloaded != original);
+	CHECK_EQUAL(2, createValue(*reloaded));
+	CHECK(original->isReady());
+	CHECK_EQUAL(1, createValue(*original));
+	CHECK(cache.load(url, false) == reloaded);
+
+	auto statistics = cache.getStatistics(url);
+	CHECK_EQUAL(2, statistics.compiles_);
+	CHECK_EQUAL(2, statistics.hits_);
+}
+} // end namespace wgt
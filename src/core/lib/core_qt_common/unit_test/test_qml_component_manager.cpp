@@ -0,0 +1,124 @@
+#include "pch.hpp"
+
+#include "core_unit_test/unit_test.hpp"
+#include "core_qt_common/qml_component_manager.hpp"
+#include "core_ui_framework/i_component.hpp"
+#include "core_ui_framework/i_component_provider.hpp"
+
+#include <map>
+
+namespace wgt
+{
+namespace
+{
+const ItemRole::Id s_EnumRole = ItemRole::compute("isEnum");
+const ItemRole::Id s_SliderRole = ItemRole::compute("isSlider");
+
+class NumberComponentProvider : public IComponentProvider
+{
+public:
+	NumberComponentProvider() : calls_(0)
+	{
+	}
+
+	const char* componentId(const TypeId& typeId, std::function<bool(const ItemRole::Id&)>& predicate) const override
+	{
+		++calls_;
+		if (typeId != TypeId::getType<int>())
+		{
+			return nullptr;
+		}
+		if (predicate(s_EnumRole))
+		{
+			return "enum";
+		}
+		// Asking again must not evaluate the role again
+		if (predicate(s_EnumRole) || predicate(s_SliderRole))
+		{
+			return "slider";
+		}
+		return "number";
+	}
+
+	mutable int calls_;
+};
+
+class StringComponentProvider : public IComponentProvider
+{
+public:
+	const char* componentId(const TypeId& typeId, std::function<bool(const ItemRole::Id&)>& predicate) const override
+	{
+		return typeId == TypeId::getType<std::string>() ? "string" : nullptr;
+	}
+};
+
+struct TestItem
+{
+	IComponent* find(const QmlComponentManager& manager, const TypeId& typeId, const char* version)
+	{
+		std::function<bool(const ItemRole::Id&)> predicate = [this](const ItemRole::Id& roleId) {
+			++evaluations_;
+			auto found = roles_.find(roleId);
+			return found != roles_.end() && found->second;
+		};
+		return manager.findComponent(typeId, predicate, version);
+	}
+
+	std::map<ItemRole::Id, bool> roles_;
+	int evaluations_ = 0;
+};
+}
+
+TEST(QmlComponentManager_memoizedSelection)
+{
+	IComponent number10, number20, slider, enumeration;
+	NumberComponentProvider provider;
+	QmlComponentManager manager;
+	manager.registerComponent("number", "1.0", number10, true);
+	manager.registerComponent("number", "2.0", number20, true);
+	manager.registerComponent("slider", "1.0", slider, true);
+	manager.registerComponent("enum", "1.0", enumeration, true);
+	manager.registerComponentProvider(provider);
+
+	TestItem plain;
+	CHECK(plain.find(manager, TypeId::getType<int>(), "2.0") == &number20);
+	CHECK(plain.find(manager, TypeId::getType<int>(), "1.5") == &number10);
+	CHECK(plain.find(manager, TypeId::getType<int>(), "0.5") == nullptr);
+	CHECK_EQUAL(3, provider.calls_);
+	CHECK_EQUAL(6, plain.evaluations_);
+
+	// Later items of the same kind only evaluate the roles the providers asked about
+	TestItem other;
+	CHECK(other.find(manager, TypeId::getType<int>(), "2.0") == &number20);
+	CHECK_EQUAL(3, provider.calls_);
+	CHECK_EQUAL(2, other.evaluations_);
+
+	TestItem sliderItem;
+	sliderItem.roles_[s_SliderRole] = true;
+	CHECK(sliderItem.find(manager, TypeId::getType<int>(), "2.0") == &slider);
+	CHECK_EQUAL(4, provider.calls_);
+	CHECK(sliderItem.find(manager, TypeId::getType<int>(), "2.0") == &slider);
+	CHECK_EQUAL(4, provider.calls_);
+
+	TestItem enumItem;
+	enumItem.roles_[s_EnumRole] = true;
+	CHECK(enumItem.find(manager, TypeId::getType<int>(), "2.0") == &enumeration);
+	CHECK_EQUAL(5, provider.calls_);
+	CHECK(enumItem.find(manager, TypeId::getType<int>(), "2.0") == &enumeration);
+	CHECK_EQUAL(5, provider.calls_);
+	CHECK_EQUAL(2, enumItem.evaluations_);
+
+	// Registering a provider or component discards the memoized choices
+	IComponent string;
+	StringComponentProvider stringProvider;
+	manager.registerComponentProvider(stringProvider);
+	CHECK(plain.find(manager, TypeId::getType<std::string>(), "1.0") == nullptr);
+	manager.registerComponent("string", "1.0", string, true);
+	CHECK(plain.find(manager, TypeId::getType<std::string>(), "1.0") == &string);
+	CHECK(plain.find(manager, TypeId::getType<int>(), "2.0") == &number20);
+	CHECK_EQUAL(7, provider.calls_);
+
+	CHECK(manager.findComponent("slider", "3.0") == &slider);
+	CHECK(manager.findComponent("missing", "1.0") == nullptr);
+}
+} // end namespace wgt
@@ -0,0 +1,108 @@
+#include "pch.hpp"
+
+#include "core_qt_common/qt_type_converter_registry.hpp"
+#include "core_qt_common/i_qt_type_converter.hpp"
+#include "core_qt_common/string_qt_type_converter.hpp"
+
+#include <QString>
+
+namespace wgt
+{
+namespace
+{
+class CountingQtTypeConverter : public IQtTypeConverter
+{
+public:
+	CountingQtTypeConverter() : toVariantCalls_(0), toQVariantCalls_(0)
+	{
+	}
+
+	bool toVariant(const QVariant& qVariant, Variant& o_variant) const override
+	{
+		++toVariantCalls_;
+		return false;
+	}
+
+	bool toQVariant(const Variant& variant, QVariant& o_qVariant, QObject* parent = nullptr) const override
+	{
+		++toQVariantCalls_;
+		return false;
+	}
+
+	mutable int toVariantCalls_;
+	mutable int toQVariantCalls_;
+};
+
+class NegatingIntQtTypeConverter : public GenericQtTypeConverter<int>
+{
+public:
+	bool toQVariant(const Variant& variant, QVariant& o_qVariant, QObject* parent = nullptr) const override
+	{
+		int value;
+		if (!variant.typeIs<int>() || !variant.tryCast(value))
+		{
+			return false;
+		}
+		o_qVariant = -value;
+		return true;
+	}
+};
+}
+
+TEST(QtTypeConverterRegistry_valueTypes)
+{
+	QtTypeConverterRegistry registry;
+	GenericQtTypeConverter<int> intConverter;
+	StringQtTypeConverter stringConverter;
+	CountingQtTypeConverter catchAll;
+	registry.registerTypeConverter(intConverter);
+	registry.registerTypeConverter(stringConverter);
+	registry.registerTypeConverter(catchAll);
+
+	QVariant qVariant;
+	CHECK(registry.toQVariant(Variant(42), qVariant, nullptr));
+	CHECK_EQUAL(42, qVariant.toInt());
+	CHECK(registry.toQVariant(Variant(std::string("text")), qVariant, nullptr));
+	CHECK(qVariant.toString() == QString("text"));
+
+	Variant variant;
+	CHECK(registry.toVariant(QVariant(7), variant));
+	CHECK(variant.typeIs<int>());
+	CHECK_EQUAL(7, variant.cast<int>());
+
+	// Unclaimed value types and empty values are rejected without trying any converter
+	CHECK(!registry.toQVariant(Variant(1.5), qVariant, nullptr));
+	CHECK(!registry.toQVariant(Variant(), qVariant, nullptr));
+	CHECK(!registry.toVariant(QVariant(), variant));
+	CHECK_EQUAL(0, catchAll.toQVariantCalls_);
+	CHECK_EQUAL(0, catchAll.toVariantCalls_);
+
+	registry.deregisterTypeConverter(catchAll);
+	registry.deregisterTypeConverter(stringConverter);
+	registry.deregisterTypeConverter(intConverter);
+}
+
+TEST(QtTypeConverterRegistry_registrationOrder)
+{
+	QtTypeConverterRegistry registry;
+	GenericQtTypeConverter<int> intConverter;
+	NegatingIntQtTypeConverter negatingConverter;
+	registry.registerTypeConverter(intConverter);
+
+	QVariant qVariant;
+	CHECK(registry.toQVariant(Variant(3), qVariant, nullptr));
+	CHECK_EQUAL(3, qVariant.toInt());
+
+	// The most recently registered converter wins, even once the dispatch is cached
+	registry.registerTypeConverter(negatingConverter);
+	CHECK(registry.toQVariant(Variant(3), qVariant, nullptr));
+	CHECK_EQUAL(-3, qVariant.toInt());
+
+	registry.deregisterTypeConverter(negatingConverter);
+	CHECK(registry.toQVariant(Variant(3), qVariant, nullptr));
+	CHECK_EQUAL(3, qVariant.toInt());
+
+	registry.deregisterTypeConverter(intConverter);
+	CHECK(!registry.toQVariant(Variant(3), qVariant, nullptr));
+}
+} // end namespace wgt
@@ -0,0 +1,71 @@
+#include "pch.hpp"
+
+#include "core_qt_common/trigram_index.hpp"
+
+#include <string>
+#include <vector>
+
+namespace wgt
+{
+namespace
+{
+std::vector<int> trigramCandidates(const TrigramIndex& index, const FilterExpression::TermClauses& clauses)
+{
+	std::vector<int> rows;
+	if (!index.findCandidates(clauses, rows))
+	{
+		rows.push_back(-1);
+	}
+	return rows;
+}
+}
+
+TEST(trigram_index_candidates)
+{
+	std::vector<std::string> values = { "Street", "road", "Streetlight", "avenue", "side ROAD" };
+	TrigramIndex index(values);
+	index.rebuild();
+
+	// Trigrams are case folded, the terms of a clause are alternatives
+	CHECK(trigramCandidates(index, { { "street" } }) == std::vector<int>({ 0, 2 }));
+	CHECK(trigramCandidates(index, { { "road", "avenue" } }) == std::vector<int>({ 1, 3, 4 }));
+	CHECK(trigramCandidates(index, { { "street" }, { "light" } }) == std::vector<int>({ 2 }));
+	CHECK(trigramCandidates(index, { { "lane" } }).empty());
+
+	// Clauses with a term shorter than a trigram can not be looked up
+	CHECK(trigramCandidates(index, { { "st" } }) == std::vector<int>({ -1 }));
+	CHECK(trigramCandidates(index, { { "st" }, { "road" } }) == std::vector<int>({ 1, 4 }));
+}
+
+TEST(trigram_index_incremental_updates)
+{
+	std::vector<std::string> values = { "street", "road", "streetlight" };
+	TrigramIndex index(values);
+	index.rebuild();
+
+	values.insert(values.begin() + 1, "main street");
+	index.insertRows(1, 1);
+	CHECK(trigramCandidates(index, { { "street" } }) == std::vector<int>({ 0, 1, 3 }));
+	CHECK(trigramCandidates(index, { { "road" } }) == std::vector<int>({ 2 }));
+
+	values.erase(values.begin());
+	index.removeRows(0, 1);
+	CHECK(trigramCandidates(index, { { "street" } }) == std::vector<int>({ 0, 2 }));
+	CHECK(trigramCandidates(index, { { "road" } }) == std::vector<int>({ 1 }));
+
+	values[0] = "lane";
+	index.changeRow(0);
+	CHECK(trigramCandidates(index, { { "street" } }) == std::vector<int>({ 2 }));
+	CHECK(trigramCandidates(index, { { "lane" } }) == std::vector<int>({ 0 }));
+
+	// Enough dead ids rebuild the index, which still finds the current values
+	for (int i = 0; i < 3000; ++i)
+	{
+		values[1] = i % 2 == 0 ? "avenue" : "road";
+		index.changeRow(1);
+	}
+	CHECK(trigramCandidates(index, { { "road" } }) == std::vector<int>({ 1 }));
+	CHECK(trigramCandidates(index, { { "avenue" } }).empty());
+	CHECK(trigramCandidates(index, { { "street" } }) == std::vector<int>({ 2 }));
+}
+} // end namespace wgt
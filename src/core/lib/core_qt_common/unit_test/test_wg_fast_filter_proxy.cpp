@@ -0,0 +1,91 @@
+#include "pch.hpp"
+
+#include "core_qt_common/models/wg_fast_filter_proxy.hpp"
+
+#include <QStringList>
+#include <QStringListModel>
+
+namespace wgt
+{
+namespace
+{
+QStringList fastFilterRows(const WGFastFilterProxy& proxy)
+{
+	QStringList rows;
+	for (int row = 0; row < proxy.rowCount(); ++row)
+	{
+		auto proxyIndex = proxy.index(row, 0);
+		if (proxy.mapFromSource(proxy.mapToSource(proxyIndex)) != proxyIndex)
+		{
+			rows << "<unmapped>";
+			continue;
+		}
+		rows << proxy.data(proxyIndex, Qt::DisplayRole).toString();
+	}
+	return rows;
+}
+
+void setFastFilterText(WGFastFilterProxy& proxy, const char* filterText)
+{
+	proxy.setProperty("filterText", QString(filterText));
+}
+}
+
+TEST(wg_fast_filter_proxy_narrowing)
+{
+	QStringListModel model(QStringList() << "street" << "main street" << "road" << "streetlight" << "avenue");
+	WGFastFilterProxy proxy;
+	proxy.setSourceModel(&model);
+	CHECK_EQUAL(5, proxy.rowCount());
+
+	setFastFilterText(proxy, "str");
+	CHECK(fastFilterRows(proxy) == QStringList() << "street" << "main street" << "streetlight");
+
+	// Typing more characters narrows the previous result
+	setFastFilterText(proxy, "stree");
+	CHECK(fastFilterRows(proxy) == QStringList() << "street" << "main street" << "streetlight");
+	setFastFilterText(proxy, "streetl");
+	CHECK(fastFilterRows(proxy) == QStringList() << "streetlight");
+
+	// Widening the filter maps from the source again
+	setFastFilterText(proxy, "road");
+	CHECK(fastFilterRows(proxy) == QStringList() << "road");
+	setFastFilterText(proxy, "");
+	CHECK_EQUAL(5, proxy.rowCount());
+}
+
+TEST(wg_fast_filter_proxy_source_changes)
+{
+	QStringListModel model(QStringList() << "street" << "road" << "streetlight");
+	WGFastFilterProxy proxy;
+	proxy.setSourceModel(&model);
+	setFastFilterText(proxy, "street");
+	CHECK(fastFilterRows(proxy) == QStringList() << "street" << "streetlight");
+
+	// Inserted rows are matched when they arrive and again when their data is set
+	RETURN_ON_FAIL_CHECK(model.insertRows(1, 2));
+	CHECK(fastFilterRows(proxy) == QStringList() << "street" << "streetlight");
+	CHECK(model.setData(model.index(1), "side street"));
+	CHECK(model.setData(model.index(2), "lane"));
+	CHECK(fastFilterRows(proxy) == QStringList() << "street" << "side street" << "streetlight");
+
+	// Narrowing starts from the rows updated by the source changes
+	setFastFilterText(proxy, "side street");
+	CHECK(fastFilterRows(proxy) == QStringList() << "side street");
+	setFastFilterText(proxy, "street");
+	CHECK(fastFilterRows(proxy) == QStringList() << "street" << "side street" << "streetlight");
+
+	RETURN_ON_FAIL_CHECK(model.removeRows(0, 1));
+	CHECK(fastFilterRows(proxy) == QStringList() << "side street" << "streetlight");
+	setFastFilterText(proxy, "streetl");
+	CHECK(fastFilterRows(proxy) == QStringList() << "streetlight");
+
+	// Changed rows enter and leave the result
+	setFastFilterText(proxy, "street");
+	CHECK(model.setData(model.index(2), "road to the street"));
+	CHECK(model.setData(model.index(0), "side road"));
+	CHECK(fastFilterRows(proxy) == QStringList() << "road to the street" << "streetlight");
+	setFastFilterText(proxy, "road");
+	CHECK(fastFilterRows(proxy) == QStringList() << "side road" << "road to the street");
+}
+} // end namespace wgt
@@ -0,0 +1,186 @@
+#include "pch.hpp"
+
+#include "core_qt_common/controls/wg_item_view.hpp"
+#include "core_qt_common/models/extensions/qt_model_extension.hpp"
+
+#include <QAbstractListModel>
+#include <QQmlListProperty>
+#include <QStringList>
+
+namespace wgt
+{
+namespace
+{
+const char* ITEM_VIEW_STATE_ROLE = "itemViewTestState";
+
+/**
+ *	List model, every index of which shares internal id 0.
+ */
+class ItemViewTestModel : public QAbstractListModel
+{
+public:
+	ItemViewTestModel(int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			rows_ << QString("row %1").arg(i);
+		}
+	}
+
+	int rowCount(const QModelIndex& parent = QModelIndex()) const override
+	{
+		return parent.isValid() ? 0 : rows_.count();
+	}
+
+	QVariant data(const QModelIndex& index, int role) const override
+	{
+		if (!index.isValid() || index.row() >= rows_.count())
+		{
+			return QVariant();
+		}
+		return role == Qt::DisplayRole || role == keyRole() ? rows_[index.row()] : QVariant();
+	}
+
+	QHash<int, QByteArray> roleNames() const override
+	{
+		auto roleNames = QAbstractListModel::roleNames();
+		roleNames[keyRole()] = "key";
+		return roleNames;
+	}
+
+	void insert(int row, const QString& value)
+	{
+		beginInsertRows(QModelIndex(), row, row);
+		rows_.insert(row, value);
+		endInsertRows();
+	}
+
+	void remove(int row)
+	{
+		beginRemoveRows(QModelIndex(), row, row);
+		rows_.removeAt(row);
+		endRemoveRows();
+	}
+
+	static int keyRole()
+	{
+		return Qt::UserRole + 7;
+	}
+
+private:
+	QStringList rows_;
+};
+
+/**
+ *	Keeps a value per item in the view's extension data.
+ */
+class ItemViewStateExtension : public QtModelExtension
+{
+public:
+	ItemViewStateExtension()
+	{
+		roles_.push_back(ITEM_VIEW_STATE_ROLE);
+	}
+
+	QVariant data(const QModelIndex& index, ItemRole::Id roleId) const override
+	{
+		return roleId == stateRoleId() ? extensionData_->data(index, roleId) : QVariant();
+	}
+
+	bool setData(const QModelIndex& index, const QVariant& value, ItemRole::Id roleId) override
+	{
+		return roleId == stateRoleId() && extensionData_->setData(index, value, roleId);
+	}
+
+	static ItemRole::Id stateRoleId()
+	{
+		return ItemRole::compute(ITEM_VIEW_STATE_ROLE);
+	}
+};
+
+QAbstractItemModel* extendedModel(WGItemView& view)
+{
+	return view.property("extendedModel").value<QAbstractItemModel*>();
+}
+
+void addExtension(WGItemView& view, QtModelExtension& extension)
+{
+	auto extensions = view.property("extensions").value<QQmlListProperty<QtModelExtension>>();
+	extensions.append(&extensions, &extension);
+}
+}
+
+TEST(wg_item_view_role_tables)
+{
+	ItemViewTestModel model(3);
+	ItemViewStateExtension extension;
+	WGItemView view;
+	addExtension(view, extension);
+	view.setProperty("model", QVariant::fromValue<QAbstractItemModel*>(&model));
+
+	auto extended = extendedModel(view);
+	RETURN_ON_FAIL_CHECK(extended != nullptr);
+	auto roleNames = extended->roleNames();
+	auto keyRole = roleNames.key("key", -1);
+	auto stateRole = roleNames.key(ITEM_VIEW_STATE_ROLE, -1);
+	RETURN_ON_FAIL_CHECK(keyRole == ItemViewTestModel::keyRole());
+	RETURN_ON_FAIL_CHECK(stateRole != -1);
+
+	// Roles of the model are passed through, extension roles are not
+	CHECK(extended->data(extended->index(1, 0), keyRole).toString() == "row 1");
+	CHECK(extended->data(extended->index(2, 0), Qt::DisplayRole).toString() == "row 2");
+	CHECK(!extended->data(extended->index(1, 0), stateRole).isValid());
+
+	CHECK(extended->setData(extended->index(1, 0), 5, stateRole));
+	CHECK_EQUAL(5, extended->data(extended->index(1, 0), stateRole).toInt());
+	CHECK(!extended->data(extended->index(0, 0), stateRole).isValid());
+
+	// Another model rebuilds the tables
+	ItemViewTestModel other(2);
+	view.setProperty("model", QVariant::fromValue<QAbstractItemModel*>(&other));
+	CHECK(extended->roleNames().key(ITEM_VIEW_STATE_ROLE, -1) == stateRole);
+	CHECK(!extended->data(extended->index(1, 0), stateRole).isValid());
+	CHECK(extended->data(extended->index(1, 0), keyRole).toString() == "row 1");
+}
+
+TEST(wg_item_view_index_cache)
+{
+	const int count = 200;
+	ItemViewTestModel model(count);
+	ItemViewStateExtension extension;
+	WGItemView view;
+	addExtension(view, extension);
+	view.setProperty("model", QVariant::fromValue<QAbstractItemModel*>(&model));
+
+	auto extended = extendedModel(view);
+	RETURN_ON_FAIL_CHECK(extended != nullptr);
+	auto stateRole = extended->roleNames().key(ITEM_VIEW_STATE_ROLE, -1);
+	RETURN_ON_FAIL_CHECK(stateRole != -1);
+
+	// Every row shares an internal id, each still keeps its own data
+	for (int row = 0; row < count; ++row)
+	{
+		CHECK(extended->setData(extended->index(row, 0), row, stateRole));
+	}
+	for (int row = 0; row < count; ++row)
+	{
+		CHECK_EQUAL(row, extended->data(extended->index(row, 0), stateRole).toInt());
+	}
+
+	// Data follows its row as rows are inserted and removed before it
+	model.insert(0, "new row");
+	CHECK(!extended->data(extended->index(0, 0), stateRole).isValid());
+	CHECK_EQUAL(0, extended->data(extended->index(1, 0), stateRole).toInt());
+	CHECK_EQUAL(count - 1, extended->data(extended->index(count, 0), stateRole).toInt());
+
+	model.remove(1);
+	model.remove(1);
+	CHECK(!extended->data(extended->index(0, 0), stateRole).isValid());
+	CHECK_EQUAL(2, extended->data(extended->index(1, 0), stateRole).toInt());
+
+	// A row inserted where a removed one was starts without data
+	model.insert(1, "replacement");
+	CHECK(!extended->data(extended->index(1, 0), stateRole).isValid());
+	CHECK_EQUAL(2, extended->data(extended->index(2, 0), stateRole).toInt());
+}
+} // end namespace wgt
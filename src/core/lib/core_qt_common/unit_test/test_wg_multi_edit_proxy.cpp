@@ -0,0 +1,446 @@
+#include "pch.hpp"
+
+#include "core_qt_common/models/wg_multi_edit_proxy.hpp"
+#include "core_qt_common/models/role_provider.hpp"
+#include "core_command_system/i_command_manager.hpp"
+#include "core_unit_test/test_global_context.hpp"
+
+#include <QAbstractListModel>
+#include <QStringList>
+
+#include <utility>
+#include <vector>
+
+namespace wgt
+{
+namespace
+{
+const int MULTI_EDIT_VALUE_ROLE = Qt::UserRole + 1;
+
+/**
+ *	Command manager that only counts batches, registered for as long as it exists.
+ */
+class MultiEditTestCommandManager : public ICommandManager
+{
+	class SelectionContext : public ISelectionContext
+	{
+	public:
+		const ObjectHandle& getContextObject() const override
+		{
+			return contextObject_;
+		}
+
+		void setContextObject(const ObjectHandle& contextObject) override
+		{
+			contextObject_ = contextObject;
+		}
+
+	private:
+		ObjectHandle contextObject_;
+	};
+
+public:
+	MultiEditTestCommandManager() : batchDepth_(0), beginCount_(0), endCount_(0), abortCount_(0)
+	{
+		interface_ = registerInterface<ICommandManager>(this);
+	}
+
+	~MultiEditTestCommandManager()
+	{
+		deregisterInterface(interface_.get());
+	}
+
+	// clang-format off
+	void fini() override {}
+	void registerCommand(Command* command) override {}
+	void deregisterCommand(const char* commandId) override {}
+	Command* findCommand(const char* commandId) const override { return nullptr; }
+	CommandInstancePtr queueCommand(const char* commandId) override { return nullptr; }
+	CommandInstancePtr queueCommand(const char* commandId, const ObjectHandle& arguments) override { return nullptr; }
+	CommandInstancePtr queueCommand(const char* commandId, ManagedObjectPtr arguments) override { return nullptr; }
+	void waitForInstance(const CommandInstancePtr& instance) override {}
+	void registerCommandStatusListener(ICommandEventListener* listener) override {}
+	void deregisterCommandStatusListener(ICommandEventListener* listener) override {}
+	void fireCommandStatusChanged(const CommandInstance& command) const override {}
+	void fireProgressMade(const CommandInstance& command) const override {}
+	void fireCommandExecuted(const CommandInstance& command, CommandOperation operation) const override {}
+	void undo() override {}
+	void redo() override {}
+	bool canUndo() const override { return false; }
+	bool canRedo() const override { return false; }
+	void removeCommands(const TRemoveFunctor& functor) override {}
+	const Collection& getHistory() const override { return history_; }
+	const int commandIndex() const override { return -1; }
+	void moveCommandIndex(int newIndex) override {}
+	Collection& getMacros() const override { return macros_; }
+	bool createMacro(const Collection& commandInstanceList, const char* id) override { return false; }
+	bool deleteMacroByName(const char* id) override { return false; }
+	void notifyBeginMultiCommand() override {}
+	void notifyCompleteMultiCommand() override {}
+	void notifyCancelMultiCommand() override {}
+	void notifyHandleCommandQueued(const char* commandId) override {}
+	void notifyNonBlockingProcessExecution(const char* commandId) override {}
+	ISelectionContext& selectionContext() override { return selectionContext_; }
+	std::thread::id ownerThreadId() override { return std::this_thread::get_id(); }
+	bool executingCommandGroup() override { return batchDepth_ > 0; }
+	// clang-format on
+
+	void beginBatchCommand() override
+	{
+		++batchDepth_;
+		++beginCount_;
+	}
+
+	void endBatchCommand(const char* description) override
+	{
+		--batchDepth_;
+		++endCount_;
+	}
+
+	void abortBatchCommand() override
+	{
+		--batchDepth_;
+		++abortCount_;
+	}
+
+	int batchDepth_;
+	int beginCount_;
+	int endCount_;
+	int abortCount_;
+
+private:
+	InterfacePtr interface_;
+	Collection history_;
+	mutable Collection macros_;
+	SelectionContext selectionContext_;
+};
+
+/**
+ *	Property list of one item, each row a key and a value.
+ */
+class MultiEditTestModel : public QAbstractListModel
+{
+public:
+	typedef std::pair<QString, int> Row;
+
+	MultiEditTestModel(std::vector<Row> rows) : rows_(std::move(rows)), commandManager_(nullptr), lastSetBatchDepth_(0)
+	{
+	}
+
+	int rowCount(const QModelIndex& parent = QModelIndex()) const override
+	{
+		return parent.isValid() ? 0 : static_cast<int>(rows_.size());
+	}
+
+	QVariant data(const QModelIndex& index, int role) const override
+	{
+		if (!index.isValid() || index.row() >= rowCount())
+		{
+			return QVariant();
+		}
+
+		auto& row = rows_[index.row()];
+		if (role == keyRole())
+		{
+			return row.first;
+		}
+		if (role == MULTI_EDIT_VALUE_ROLE)
+		{
+			return row.second;
+		}
+		if (role == multipleValuesRole())
+		{
+			return false;
+		}
+		return QVariant();
+	}
+
+	bool setData(const QModelIndex& index, const QVariant& value, int role) override
+	{
+		if (!index.isValid() || role != MULTI_EDIT_VALUE_ROLE)
+		{
+			return false;
+		}
+
+		rows_[index.row()].second = value.toInt();
+		lastSetBatchDepth_ = commandManager_ != nullptr ? commandManager_->batchDepth_ : 0;
+		emit dataChanged(index, index, QVector<int>() << role);
+		return true;
+	}
+
+	QHash<int, QByteArray> roleNames() const override
+	{
+		auto roleNames = QAbstractListModel::roleNames();
+		roleNames[keyRole()] = "key";
+		roleNames[MULTI_EDIT_VALUE_ROLE] = "value";
+		roleNames[multipleValuesRole()] = "multipleValues";
+		return roleNames;
+	}
+
+	void insert(int row, const QString& key, int value)
+	{
+		beginInsertRows(QModelIndex(), row, row);
+		rows_.insert(rows_.begin() + row, Row(key, value));
+		endInsertRows();
+	}
+
+	void remove(int row)
+	{
+		beginRemoveRows(QModelIndex(), row, row);
+		rows_.erase(rows_.begin() + row);
+		endRemoveRows();
+	}
+
+	static int keyRole()
+	{
+		return RoleProvider::convertRole("key");
+	}
+
+	static int multipleValuesRole()
+	{
+		return RoleProvider::convertRole("multipleValues");
+	}
+
+	/** Records the batch depth of the command manager whenever a value is set.*/
+	void watchBatches(const MultiEditTestCommandManager& commandManager)
+	{
+		commandManager_ = &commandManager;
+	}
+
+	int lastSetBatchDepth() const
+	{
+		return lastSetBatchDepth_;
+	}
+
+private:
+	std::vector<Row> rows_;
+	const MultiEditTestCommandManager* commandManager_;
+	int lastSetBatchDepth_;
+};
+
+/**
+ *	Reads the merged rows of a proxy.
+ */
+class MultiEditProxyReader
+{
+public:
+	MultiEditProxyReader(QAbstractItemModel& proxy) : proxy_(proxy)
+	{
+		auto roleNames = proxy_.roleNames();
+		keyRole_ = roleNames.key("key", -1);
+		valueRole_ = roleNames.key("value", -1);
+		multipleValuesRole_ = roleNames.key("multipleValues", -1);
+	}
+
+	QStringList keys() const
+	{
+		QStringList keys;
+		for (int row = 0; row < proxy_.rowCount(); ++row)
+		{
+			keys << proxy_.data(proxy_.index(row, 0), keyRole_).toString();
+		}
+		return keys;
+	}
+
+	/**
+	 *	Keys in sorted order, the order rows are first merged in follows the source model addresses.
+	 */
+	QStringList sortedKeys() const
+	{
+		auto sorted = keys();
+		sorted.sort();
+		return sorted;
+	}
+
+	int row(const QString& key) const
+	{
+		return keys().indexOf(key);
+	}
+
+	QVariant value(const QString& key) const
+	{
+		return proxy_.data(proxy_.index(row(key), 0), valueRole_);
+	}
+
+	bool multiple(const QString& key) const
+	{
+		return proxy_.data(proxy_.index(row(key), 0), multipleValuesRole_).toBool();
+	}
+
+	bool setValue(const QString& key, int value)
+	{
+		return proxy_.setData(proxy_.index(row(key), 0), value, valueRole_);
+	}
+
+private:
+	QAbstractItemModel& proxy_;
+	int keyRole_;
+	int valueRole_;
+	int multipleValuesRole_;
+};
+}
+
+TEST(multi_edit_proxy_merge_and_aggregate)
+{
+	MultiEditTestModel first({ { "a", 1 }, { "b", 2 } });
+	MultiEditTestModel second({ { "b", 2 }, { "c", 3 } });
+	MultiEditTestModel third({ { "c", 4 }, { "b", 2 } });
+
+	WGMultiEditProxy proxy;
+	proxy.setMergeKeys(QList<QString>() << "key");
+	proxy.addModel(&first);
+	proxy.addModel(&second);
+	proxy.addModel(&third);
+
+	MultiEditProxyReader reader(proxy);
+	CHECK(reader.sortedKeys() == (QStringList() << "a"
+	                                            << "b"
+	                                            << "c"));
+	CHECK(!reader.multiple("a"));
+	CHECK(reader.multiple("b"));
+	CHECK(reader.multiple("c"));
+
+	// Equal values are shown, mixed values are not
+	CHECK_EQUAL(1, reader.value("a").toInt());
+	CHECK_EQUAL(2, reader.value("b").toInt());
+	CHECK(!reader.value("c").isValid());
+
+	// A source change invalidates the cached aggregate
+	second.setData(second.index(0), 5, MULTI_EDIT_VALUE_ROLE);
+	CHECK(!reader.value("b").isValid());
+	second.setData(second.index(0), 2, MULTI_EDIT_VALUE_ROLE);
+	CHECK_EQUAL(2, reader.value("b").toInt());
+
+	// Editing a merged row sets every item sharing it
+	CHECK(reader.setValue("c", 7));
+	CHECK_EQUAL(7, reader.value("c").toInt());
+	CHECK_EQUAL(7, second.data(second.index(1), MULTI_EDIT_VALUE_ROLE).toInt());
+	CHECK_EQUAL(7, third.data(third.index(0), MULTI_EDIT_VALUE_ROLE).toInt());
+
+	proxy.removeModel(&third);
+	MultiEditProxyReader remaining(proxy);
+	CHECK(!remaining.multiple("c"));
+	CHECK(remaining.multiple("b"));
+}
+
+TEST(multi_edit_proxy_source_row_insert)
+{
+	MultiEditTestModel first({ { "a", 1 }, { "b", 2 } });
+	MultiEditTestModel second({ { "b", 2 } });
+
+	WGMultiEditProxy proxy;
+	proxy.setMergeKeys(QList<QString>() << "key");
+	proxy.addModel(&first);
+	proxy.addModel(&second);
+
+	MultiEditProxyReader reader(proxy);
+	CHECK_EQUAL(2, proxy.rowCount());
+
+	// A new key is appended, and source rows after it keep their values
+	first.insert(0, "d", 4);
+	CHECK(reader.sortedKeys() == (QStringList() << "a"
+	                                            << "b"
+	                                            << "d"));
+	CHECK_EQUAL(1, reader.value("a").toInt());
+	CHECK_EQUAL(2, reader.value("b").toInt());
+	CHECK_EQUAL(4, reader.value("d").toInt());
+	CHECK(!reader.multiple("d"));
+
+	// A key already shown by another source merges into its row
+	second.insert(0, "d", 5);
+	CHECK_EQUAL(3, proxy.rowCount());
+	CHECK(reader.multiple("d"));
+	CHECK(!reader.value("d").isValid());
+	CHECK_EQUAL(2, reader.value("b").toInt());
+
+	second.setData(second.index(0), 4, MULTI_EDIT_VALUE_ROLE);
+	CHECK_EQUAL(4, reader.value("d").toInt());
+
+	// Several new keys in one model
+	second.insert(2, "e", 6);
+	second.insert(1, "f", 7);
+	CHECK(reader.sortedKeys() == (QStringList() << "a"
+	                                            << "b"
+	                                            << "d"
+	                                            << "e"
+	                                            << "f"));
+	CHECK_EQUAL(6, reader.value("e").toInt());
+	CHECK_EQUAL(7, reader.value("f").toInt());
+	CHECK_EQUAL(2, reader.value("b").toInt());
+}
+
+TEST(multi_edit_proxy_source_row_remove)
+{
+	MultiEditTestModel first({ { "a", 1 }, { "b", 2 }, { "c", 3 } });
+	MultiEditTestModel second({ { "b", 5 }, { "c", 3 }, { "d", 4 } });
+
+	WGMultiEditProxy proxy;
+	proxy.setMergeKeys(QList<QString>() << "key");
+	proxy.addModel(&first);
+	proxy.addModel(&second);
+
+	MultiEditProxyReader reader(proxy);
+	CHECK(reader.sortedKeys() == (QStringList() << "a"
+	                                            << "b"
+	                                            << "c"
+	                                            << "d"));
+	CHECK(!reader.value("b").isValid());
+
+	// A row still provided by another source stays, with that source's value
+	second.remove(0);
+	CHECK_EQUAL(4, proxy.rowCount());
+	CHECK(!reader.multiple("b"));
+	CHECK_EQUAL(2, reader.value("b").toInt());
+
+	// A row no source provides any more is removed, later rows move up
+	first.remove(0);
+	CHECK(reader.sortedKeys() == (QStringList() << "b"
+	                                            << "c"
+	                                            << "d"));
+	CHECK_EQUAL(3, reader.value("c").toInt());
+	CHECK_EQUAL(4, reader.value("d").toInt());
+
+	second.remove(1);
+	CHECK(reader.sortedKeys() == (QStringList() << "b"
+	                                            << "c"));
+	CHECK(reader.multiple("c"));
+
+	// Source rows after a removed one still map to the right proxy rows
+	first.remove(0);
+	CHECK(reader.sortedKeys() == (QStringList() << "c"));
+	CHECK(reader.setValue("c", 8));
+	CHECK_EQUAL(8, first.data(first.index(0), MULTI_EDIT_VALUE_ROLE).toInt());
+	CHECK_EQUAL(8, second.data(second.index(0), MULTI_EDIT_VALUE_ROLE).toInt());
+	CHECK_EQUAL(8, reader.value("c").toInt());
+}
+TEST(multi_edit_proxy_set_data_batches)
+{
+	MultiEditTestCommandManager commandManager;
+	MultiEditTestModel first({ { "a", 1 }, { "b", 2 } });
+	MultiEditTestModel second({ { "b", 3 } });
+	first.watchBatches(commandManager);
+	second.watchBatches(commandManager);
+
+	WGMultiEditProxy proxy;
+	proxy.setMergeKeys(QList<QString>() << "key");
+	proxy.addModel(&first);
+	proxy.addModel(&second);
+	MultiEditProxyReader reader(proxy);
+
+	// Editing a merged row sets every sharing item inside exactly one batch
+	CHECK(reader.setValue("b", 7));
+	CHECK_EQUAL(1, commandManager.beginCount_);
+	CHECK_EQUAL(1, commandManager.endCount_);
+	CHECK_EQUAL(0, commandManager.abortCount_);
+	CHECK_EQUAL(0, commandManager.batchDepth_);
+	CHECK_EQUAL(1, first.lastSetBatchDepth());
+	CHECK_EQUAL(1, second.lastSetBatchDepth());
+	CHECK_EQUAL(7, reader.value("b").toInt());
+
+	// A row with a single item is set directly
+	CHECK(reader.setValue("a", 4));
+	CHECK_EQUAL(1, commandManager.beginCount_);
+	CHECK_EQUAL(0, first.lastSetBatchDepth());
+	CHECK_EQUAL(4, reader.value("a").toInt());
+}
+} // end namespace wgt
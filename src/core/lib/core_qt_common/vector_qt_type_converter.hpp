@@ -95,6 +95,22 @@ public:
 
 		return false;
 	}
+
+	void getVariantTypes(std::vector<TypeId>& o_types) const override
+	{
+		o_types.push_back(TypeId::getType<Vector2>());
+		o_types.push_back(TypeId::getType<Vector3>());
+		o_types.push_back(TypeId::getType<Vector4>());
+	}
+
+	void getQVariantTypes(std::vector<int>& o_types) const override
+	{
+		o_types.push_back(QVariant::Vector2D);
+		o_types.push_back(QVariant::Vector3D);
+		o_types.push_back(QVariant::Vector4D);
+		o_types.push_back(QVariant::Point);
+		o_types.push_back(QVariant::PointF);
+	}
 };
 } // end namespace wgt
 #endif // VECTOR_QT_TYPE_CONVERTERS_HPP
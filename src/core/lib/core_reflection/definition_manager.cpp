@@ -1,18 +1,54 @@
 #include "definition_manager.hpp"
 
 #include "class_definition.hpp"
+#include "property_accessor.hpp"
 #include "property_accessor_listener.hpp"
 #include "i_object_manager.hpp"
 #include "metadata/meta_base.hpp"
+#include "metadata/meta_data_table.hpp"
 #include "interfaces/i_base_property.hpp"
 #include "interfaces/i_definition_helper.hpp"
 #include "generic/generic_definition.hpp"
 #include "generic/generic_definition_helper.hpp"
+#include "utilities/object_handle_reflection_utils.hpp"
 
 #include "core_common/assert.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace wgt
 {
+namespace
+{
+/**
+ *	Changing a property also changes its parents and children, so a subscription to
+ *	"a.b" is interested in changes to "a", "a.b" and "a.b[0].c" but not "a.bc".
+ */
+bool pathsOverlap(const std::string& subscribedPath, const char* path)
+{
+	if (subscribedPath.empty())
+	{
+		return true;
+	}
+
+	const size_t pathLength = strlen(path);
+	const size_t length = std::min(pathLength, subscribedPath.size());
+	if (strncmp(subscribedPath.c_str(), path, length) != 0)
+	{
+		return false;
+	}
+
+	if (pathLength == subscribedPath.size())
+	{
+		return true;
+	}
+
+	const char next = pathLength > subscribedPath.size() ? path[length] : subscribedPath[length];
+	return length == 0 || next == '.' || next == Collection::getIndexOpen();
+}
+}
+
 //==============================================================================
 DefinitionManager::DefinitionManager(IObjectManager& objectManager) : objectManager_(objectManager)
 {
@@ -27,6 +63,7 @@ DefinitionManager::~DefinitionManager()
 	genericDefinitionHelper_.reset();
 
 	listeners_.clear();
+	subscriptions_.clear();
 
     deregisterDefinitions();
 }
@@ -107,6 +144,8 @@ IClassDefinition* DefinitionManager::registerDefinition(std::unique_ptr<IClassDe
 	const auto result = definitions_.insert(std::make_pair(definition->getName(), definition));
 	TF_ASSERT(result.second && "Duplicate definition overwritten in map.");
 	definition->setDefinitionManager(this);
+	ObjectHandleReflectedUtils::invalidateCastCache();
+	MetaDataTable::invalidateTables();
 
 	return definition;
 }
@@ -124,6 +163,8 @@ bool DefinitionManager::deregisterDefinition(const IClassDefinition* definition)
 	}
     delete it->second;
 	definitions_.erase(it);
+	ObjectHandleReflectedUtils::invalidateCastCache();
+	MetaDataTable::invalidateTables();
 	return true;
 }
 
@@ -136,6 +177,8 @@ void DefinitionManager::deregisterDefinitions()
         delete it->second;
     }
     definitions_.clear();
+	ObjectHandleReflectedUtils::invalidateCastCache();
+	MetaDataTable::invalidateTables();
 }
 
 //==============================================================================
@@ -212,6 +255,24 @@ void DefinitionManager::registerPropertyAccessorListener(std::shared_ptr<Propert
 	listeners_.push_back(listener);
 }
 
+//==============================================================================
+void DefinitionManager::registerPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+                                                         const RefObjectId& objectId, const char* path)
+{
+	ListenerSubscription subscription = { listener, path != nullptr ? path : "" };
+	wg_write_lock_guard writeGuard(listenersLock_);
+	auto& subscriptions = subscriptions_[objectId];
+	auto found = std::find_if(subscriptions.begin(), subscriptions.end(),
+	                          [&subscription](const ListenerSubscription& existing) {
+		                          return existing.listener_ == subscription.listener_ &&
+		                          existing.path_ == subscription.path_;
+		                      });
+	if (found == subscriptions.end())
+	{
+		subscriptions.push_back(subscription);
+	}
+}
+
 //==============================================================================
 void DefinitionManager::deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener)
 {
@@ -221,6 +282,40 @@ void DefinitionManager::deregisterPropertyAccessorListener(std::shared_ptr<Prope
 	{
 		listeners_.erase(it);
 	}
+
+	for (auto subscriptionsIt = subscriptions_.begin(); subscriptionsIt != subscriptions_.end();)
+	{
+		auto& subscriptions = subscriptionsIt->second;
+		subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+		                                   [&listener](const ListenerSubscription& subscription) {
+			                                   return subscription.listener_ == listener;
+			                               }),
+		                    subscriptions.end());
+		subscriptionsIt = subscriptions.empty() ? subscriptions_.erase(subscriptionsIt) : std::next(subscriptionsIt);
+	}
+}
+
+//==============================================================================
+void DefinitionManager::deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+                                                           const RefObjectId& objectId)
+{
+	wg_write_lock_guard writeGuard(listenersLock_);
+	auto found = subscriptions_.find(objectId);
+	if (found == subscriptions_.end())
+	{
+		return;
+	}
+
+	auto& subscriptions = found->second;
+	subscriptions.erase(std::remove_if(subscriptions.begin(), subscriptions.end(),
+	                                   [&listener](const ListenerSubscription& subscription) {
+		                                   return subscription.listener_ == listener;
+		                               }),
+	                    subscriptions.end());
+	if (subscriptions.empty())
+	{
+		subscriptions_.erase(found);
+	}
 }
 
 //==============================================================================
@@ -229,6 +324,60 @@ const IDefinitionManager::PropertyAccessorListeners& DefinitionManager::getPrope
 	return listeners_;
 }
 
+//==============================================================================
+void DefinitionManager::getPropertyAccessorListeners(const PropertyAccessor& accessor,
+                                                     PropertyAccessorListeners& o_Listeners) const
+{
+	wg_read_lock_guard readGuard(listenersLock_);
+	o_Listeners.insert(o_Listeners.end(), listeners_.begin(), listeners_.end());
+	if (subscriptions_.empty() || !accessor.isValid())
+	{
+		return;
+	}
+
+	// A listener subscribed to both the object and its root is only notified once
+	const size_t firstSubscribed = o_Listeners.size();
+	const char* fullPath = nullptr;
+	const RefObjectId objectId = accessor.getObject().id();
+	getSubscribedListeners(objectId, accessor, fullPath, firstSubscribed, o_Listeners);
+
+	const RefObjectId rootId = accessor.getRootObject().id();
+	if (rootId != objectId)
+	{
+		getSubscribedListeners(rootId, accessor, fullPath, firstSubscribed, o_Listeners);
+	}
+}
+
+//==============================================================================
+void DefinitionManager::getSubscribedListeners(const RefObjectId& objectId, const PropertyAccessor& accessor,
+                                               const char*& fullPath, size_t firstSubscribed,
+                                               PropertyAccessorListeners& o_Listeners) const
+{
+	auto found = subscriptions_.find(objectId);
+	if (found == subscriptions_.end())
+	{
+		return;
+	}
+
+	for (const auto& subscription : found->second)
+	{
+		if (!subscription.path_.empty())
+		{
+			fullPath = fullPath != nullptr ? fullPath : accessor.getFullPath();
+			if (!pathsOverlap(subscription.path_, fullPath))
+			{
+				continue;
+			}
+		}
+
+		auto begin = o_Listeners.begin() + firstSubscribed;
+		if (std::find(begin, o_Listeners.end(), subscription.listener_) == o_Listeners.end())
+		{
+			o_Listeners.push_back(subscription.listener_);
+		}
+	}
+}
+
 //==============================================================================
 IObjectManager* DefinitionManager::getObjectManager() const
 {
@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "i_definition_manager.hpp"
+#include "ref_object_id.hpp"
 #include "core_common/wg_read_write_lock.hpp"
 #include "core_dependency_system/i_interface.hpp"
 #include "wg_types/hashed_string_ref.hpp"
@@ -35,8 +36,14 @@ public:
 	void deregisterDefinitionHelper(const IDefinitionHelper& helper) override;
 
 	void registerPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener) override;
+	void registerPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+	                                      const RefObjectId& objectId, const char* path = nullptr) override;
 	void deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener) override;
+	void deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+	                                        const RefObjectId& objectId) override;
 	const PropertyAccessorListeners& getPropertyAccessorListeners() const override;
+	void getPropertyAccessorListeners(const PropertyAccessor& accessor,
+	                                  PropertyAccessorListeners& o_Listeners) const override;
 
 	virtual IObjectManager* getObjectManager() const override;
 
@@ -64,6 +71,16 @@ private:
 
 	mutable wg_read_write_lock listenersLock_;
 	PropertyAccessorListeners listeners_;
+
+	struct ListenerSubscription
+	{
+		std::shared_ptr<PropertyAccessorListener> listener_;
+		std::string path_;
+	};
+	typedef std::vector<ListenerSubscription> ListenerSubscriptions;
+	void getSubscribedListeners(const RefObjectId& objectId, const PropertyAccessor& accessor, const char*& fullPath,
+	                            size_t firstSubscribed, PropertyAccessorListeners& o_Listeners) const;
+	std::unordered_map<RefObjectId, ListenerSubscriptions, std::hash<const RefObjectId>> subscriptions_;
 	IObjectManager& objectManager_;
 };
 
@@ -76,10 +76,10 @@ Variant BaseGenericObject::getProperty(const char* name) const
 
 bool BaseGenericObject::addProperty(const char* name, const Variant& value, MetaData metadata, bool enableNotification)
 {
-	const IClassDefinition& definition = *this->getDefinition();
+	IClassDefinition* definition = this->getDefinition();
 	ObjectHandle provider = this->getDerivedType();
 
-	auto definitionModifier = definition.getDetails().getDefinitionModifier();
+	auto definitionModifier = definition->getDetails().getDefinitionModifier();
 	if (definitionModifier == nullptr)
 	{
 		return false;
@@ -87,13 +87,33 @@ bool BaseGenericObject::addProperty(const char* name, const Variant& value, Meta
 
 	Collection testCollection;
 	bool isCollection = value.tryCast<Collection>(testCollection);
+	const TypeId& typeId = value.type()->typeId();
 
-	if (!definitionModifier->addProperty(name, value.type()->typeId(), std::move(metadata), isCollection))
+	// Objects sharing a shape move to the next shape rather than adding the
+	// property to every object. Metadata is not shared between objects.
+	auto genericDefinition = dynamic_cast<GenericDefinition*>(definitionModifier);
+	if (genericDefinition != nullptr && genericDefinition->isShape())
+	{
+		if (metadata == nullptr)
+		{
+			definition = genericDefinition->getTransition(*definition, name, typeId, isCollection);
+			definitionModifier = nullptr;
+		}
+		else
+		{
+			definition = genericDefinition->detach(*definition);
+			definitionModifier = definition->getDetails().getDefinitionModifier();
+		}
+		setDefinition(definition);
+	}
+
+	if (definitionModifier != nullptr &&
+	    !definitionModifier->addProperty(name, typeId, std::move(metadata), isCollection))
 	{
 		return false;
 	}
 
-	PropertyAccessor accessor = definition.bindProperty(name, provider);
+	PropertyAccessor accessor = definition->bindProperty(name, provider);
 	if (enableNotification)
 	{
 		return accessor.setValue(value);
@@ -140,6 +160,13 @@ bool BaseGenericObject::setProperty(const char* name, const Variant& value, bool
 
 	if (accessor.isValid() && value.isVoid())
 	{
+		auto genericDefinition = dynamic_cast<GenericDefinition*>(definitionModifier);
+		if (genericDefinition != nullptr && genericDefinition->isShape())
+		{
+			auto detached = genericDefinition->detach(definition);
+			setDefinition(detached);
+			definitionModifier = detached->getDetails().getDefinitionModifier();
+		}
 		definitionModifier->removeProperty(name);
 		return false;
 	}
@@ -11,15 +11,71 @@
 
 namespace wgt
 {
+namespace
+{
+std::mutex s_rootShapesLock;
+// Names rather than definitions, so a definition manager destroyed and another
+// created at the same address is not handed a deleted root shape
+std::unordered_map<const IDefinitionManager*, std::string> s_rootShapes;
+}
+
 const char* GenericDefinition::getName() const
 {
 	return name_.c_str();
 }
 
 //------------------------------------------------------------------------------
-GenericDefinition::GenericDefinition(const char* name)
-    : name_(name == nullptr ? RefObjectId::generate().toString() : name)
+GenericDefinition::GenericDefinition(const char* name, bool isShape)
+    : name_(name == nullptr ? RefObjectId::generate().toString() : name), slotCount_(0), isShape_(isShape)
+{
+}
+
+//------------------------------------------------------------------------------
+GenericDefinition::GenericDefinition(const GenericDefinition& parent, bool isShape)
+    : name_(RefObjectId::generate().toString()), properties_(parent.properties_), slotCount_(parent.slotCount_),
+      isShape_(isShape)
+{
+}
+
+//------------------------------------------------------------------------------
+IClassDefinition* GenericDefinition::getRootShape(IDefinitionManager& definitionManager)
+{
+	std::lock_guard<std::mutex> guard(s_rootShapesLock);
+	auto& name = s_rootShapes[&definitionManager];
+	IClassDefinition* definition = name.empty() ? nullptr : definitionManager.getDefinition(name.c_str());
+	if (definition == nullptr)
+	{
+		std::unique_ptr<GenericDefinition> details(new GenericDefinition(nullptr, true));
+		name = details->getName();
+		definition = definitionManager.registerDefinition(std::move(details));
+	}
+	return definition;
+}
+
+//------------------------------------------------------------------------------
+IClassDefinition* GenericDefinition::getTransition(const IClassDefinition& definition, const char* name,
+                                                   const TypeId& typeId, bool isCollection)
+{
+	TF_ASSERT(isShape_);
+	std::string key(name);
+	key.append(1, '\0').append(typeId.getName()).append(1, isCollection ? '1' : '0');
+
+	std::lock_guard<std::mutex> guard(transitionsLock_);
+	auto& transition = transitions_[key];
+	if (transition == nullptr)
+	{
+		std::unique_ptr<GenericDefinition> details(new GenericDefinition(*this, true));
+		details->addProperty(name, typeId, nullptr, isCollection);
+		transition = definition.getDefinitionManager()->registerDefinition(std::move(details));
+	}
+	return transition;
+}
+
+//------------------------------------------------------------------------------
+IClassDefinition* GenericDefinition::detach(const IClassDefinition& definition) const
 {
+	std::unique_ptr<GenericDefinition> details(new GenericDefinition(*this, false));
+	return definition.getDefinitionManager()->registerDefinition(std::move(details));
 }
 
 //------------------------------------------------------------------------------
@@ -49,7 +105,7 @@ PropertyIteratorImplPtr GenericDefinition::getPropertyIterator() const
 IBasePropertyPtr GenericDefinition::addProperty(const char* name, const TypeId& typeId, MetaData metaData,
                                                 bool isCollection)
 {
-	IBasePropertyPtr property = std::make_shared<GenericProperty>(name, typeId, isCollection);
+	IBasePropertyPtr property = std::make_shared<GenericProperty>(name, typeId, isCollection, slotCount_++);
 	if (metaData != nullptr)
 	{
         property = std::make_shared<BasePropertyWithMetaData>(property, std::move(metaData));
@@ -57,6 +113,7 @@ IBasePropertyPtr GenericDefinition::addProperty(const char* name, const TypeId&
 	prePropertyAdded(name);
 	properties_.addProperty(property);
 	postPropertyAdded(name);
+	clearTransitions();
 	return property;
 }
 
@@ -66,5 +123,14 @@ void GenericDefinition::removeProperty(const char* name)
 	prePropertyRemoved(name);
 	properties_.removeProperty(name);
 	postPropertyRemoved(name);
+	clearTransitions();
+}
+
+//------------------------------------------------------------------------------
+void GenericDefinition::clearTransitions()
+{
+	// shapes that followed this one no longer have all of its properties
+	std::lock_guard<std::mutex> guard(transitionsLock_);
+	transitions_.clear();
 }
 } // end namespace wgt
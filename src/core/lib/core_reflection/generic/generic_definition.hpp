@@ -5,7 +5,10 @@
 #include "core_reflection/interfaces/i_class_definition_modifier.hpp"
 #include "core_reflection/metadata/meta_base.hpp"
 #include "core_reflection/property_storage.hpp"
+#include "core_reflection/reflection_dll.hpp"
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace wgt
 {
@@ -13,14 +16,46 @@ class IDefinitionManager;
 
 /**
  *	GenericDefinition
+ *
+ *	A definition is either private to the objects it was created for, or a
+ *	shape. Shapes are shared by every object with the same properties, so
+ *	objects add properties by moving on to another shape rather than by
+ *	changing theirs. Properties keep their slot in the shapes that follow.
  */
 class GenericDefinition : public IClassDefinitionDetails, public IClassDefinitionModifier
 {
 private:
 	friend class DefinitionManager;
-	GenericDefinition(const char* name);
+	GenericDefinition(const char* name, bool isShape = false);
+	GenericDefinition(const GenericDefinition& parent, bool isShape);
 
 public:
+	/**
+	 *	Get the shape with no properties, registering it with definitionManager
+	 *	the first time.
+	 */
+	REFLECTION_DLL static IClassDefinition* getRootShape(IDefinitionManager& definitionManager);
+
+	bool isShape() const
+	{
+		return isShape_;
+	}
+
+	/**
+	 *	Get the shape objects of this shape move to when they add a property.
+	 *	@param definition the definition this is the details of.
+	 */
+	IClassDefinition* getTransition(const IClassDefinition& definition, const char* name, const TypeId& typeId,
+	                                bool isCollection);
+
+	/**
+	 *	Register a private definition with the same properties, for an object
+	 *	to change without changing the other objects of this definition.
+	 *	@param definition the definition this is the details of.
+	 */
+	IClassDefinition* detach(const IClassDefinition& definition) const;
+
+
 	ObjectHandleStoragePtr createObjectStorage(const IClassDefinition& definition) const override;
 	ManagedObjectPtr createManaged(const IClassDefinition& definition, RefObjectId id = RefObjectId::zero()) const override;
 
@@ -61,8 +96,15 @@ public:
 	void removeProperty(const char* name) override;
 
 private:
+	void clearTransitions();
+
 	const std::string name_;
 	PropertyStorage properties_;
+	size_t slotCount_;
+	const bool isShape_;
+
+	std::mutex transitionsLock_;
+	std::unordered_map<std::string, IClassDefinition*> transitions_;
 };
 } // end namespace wgt
 #endif // GENERIC_DEFINITION_HPP
@@ -2,6 +2,7 @@
 #define GENERIC_OBJECT_HPP
 
 #include "base_generic_object.hpp"
+#include "generic_definition.hpp"
 
 #include "core_common/assert.hpp"
 #include "core_reflection/reflection_dll.hpp"
@@ -14,7 +15,7 @@
 #include "core_object/i_object_manager.hpp"
 #include "core_object/object_handle_provider.hpp"
 #include "core_dependency_system/depends.hpp"
-#include <unordered_map>
+#include <vector>
 
 namespace wgt
 {
@@ -26,6 +27,7 @@ class TypeId;
 /**
  *	GenericObject is an object that has a "generic type".
  *	And it has storage for any properties that are added/removed.
+ *	Values are kept in slots, indexed by the slot of their GenericProperty.
  */
 class GenericObject : public BaseGenericObject
                     , public ObjectHandleProvider<GenericObject>
@@ -41,11 +43,27 @@ public:
 		return ManagedObject<GenericObject>(definition->createObjectStorage(), id);
 	}
 
+	/**
+	 *	Create an object that shares its definition with every other shaped
+	 *	object that had the same properties added to it in the same order.
+	 *	Adding a property moves the object on to the next shape, removing one
+	 *	or adding one with metadata gives the object a definition of its own.
+	 *	Use this for the many small objects, like command descriptions,
+	 *	that would otherwise register a definition each.
+	 */
+	static ManagedObject<GenericObject> createShaped(const RefObjectId& id = RefObjectId::zero())
+	{
+		auto defManager = DependsLocal<IDefinitionManager>().get<IDefinitionManager>();
+		TF_ASSERT(defManager);
+		auto definition = GenericDefinition::getRootShape(*defManager);
+		return ManagedObject<GenericObject>(definition->createObjectStorage(), id);
+	}
+
     void operator=(const GenericObjectPtr& otherHandle)
 	{
         if (handle() != otherHandle)
         {
-            properties_.clear();
+            slots_.clear();
             auto definition = otherHandle->getDefinition();
             TF_ASSERT(definition);
             for (auto property : definition->allProperties())
@@ -74,7 +92,7 @@ private:
 		return handle();
 	}
 
-	mutable std::unordered_map<const GenericProperty*, Variant> properties_;
+	std::vector<Variant> slots_;
 };
 } // end namespace wgt
 #endif // GENERIC_OBJECT_HPP
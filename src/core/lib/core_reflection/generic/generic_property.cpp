@@ -9,11 +9,12 @@ namespace wgt
 
 //==============================================================================
 GenericProperty::GenericProperty(
-	const char* name, const TypeId& typeName, bool isCollection)
+	const char* name, const TypeId& typeName, bool isCollection, size_t slot)
 	: BaseProperty(name, typeName)
 	, propertyName_(name)
 	, typeName_(typeName.getName())
 	, isCollection_(isCollection)
+	, slot_(slot)
 {
 	setType(typeName_.c_str());
 	setName(propertyName_.c_str());
@@ -35,7 +36,12 @@ bool GenericProperty::set(const ObjectHandle& pBase, const Variant& value,
 	auto pObject = 
 		reflectedCast<GenericObject>(
 			pBase.data(), pBase.type(), definitionManager);
-	pObject->properties_[this] = value;
+	auto& slots = pObject->slots_;
+	if (slot_ >= slots.size())
+	{
+		slots.resize(slot_ + 1);
+	}
+	slots[slot_] = value;
 	return true;
 }
 
@@ -46,7 +52,8 @@ Variant GenericProperty::get(
 {
 	TF_ASSERT(this->isValue());
 	auto pObject = reflectedCast<GenericObject>(pBase.data(), pBase.type(), definitionManager);
-	return pObject->properties_[this];
+	const auto& slots = pObject->slots_;
+	return slot_ < slots.size() ? slots[slot_] : Variant();
 }
 
 
@@ -63,4 +70,11 @@ bool GenericProperty::isByReference() const
 	return getType().isPointer();
 }
 
+
+//------------------------------------------------------------------------------
+size_t GenericProperty::slot() const
+{
+	return slot_;
+}
+
 } // end namespace wgt
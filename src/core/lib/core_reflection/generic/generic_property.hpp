@@ -10,7 +10,10 @@ class GenericObject;
 class GenericProperty : public BaseProperty
 {
 public:
-	GenericProperty(const char* name, const TypeId& typeName, bool isCollection);
+	/**
+	 *	@param slot index of the value in the slots of the objects using this property.
+	 */
+	GenericProperty(const char* name, const TypeId& typeName, bool isCollection, size_t slot);
 
 	bool isValue() const override;
 	Variant get(const ObjectHandle& pBase, const IDefinitionManager& definitionManager) const override;
@@ -19,6 +22,9 @@ public:
 
 	bool isCollection() const override;
 	bool isByReference() const override;
+
+	size_t slot() const;
+
 protected:
 	friend class GenericObject;
 
@@ -26,6 +32,7 @@ private:
 	const std::string propertyName_;
 	const std::string typeName_;
 	bool isCollection_;
+	const size_t slot_;
 };
 } // end namespace wgt
 #endif // GENERIC_PROPERTY_HPP
@@ -16,6 +16,8 @@ class IClassDefinitionDetails;
 class IDefinitionHelper;
 class IObjectManager;
 class PropertyAccessorListener;
+class PropertyAccessor;
+class RefObjectId;
 class GenericObjectListener;
 class ISerializer;
 class GenericObjectListener;
@@ -79,9 +81,32 @@ public:
 	virtual void deregisterDefinitionHelper(const IDefinitionHelper& helper) = 0;
 
 	virtual void registerPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener) = 0;
+	/**
+	 *	Register a listener that is only notified of changes to the object with the given id.
+	 *	If a path is given, only changes to that property, its parents or its children are notified.
+	 *	Changes are matched against both the object that owns the property and the root object it was bound through.
+	 */
+	virtual void registerPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+	                                              const RefObjectId& objectId, const char* path = nullptr) = 0;
 	virtual void deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener) = 0;
+	/**
+	 *	Remove the subscriptions of a listener to the object with the given id, keeping its other registrations.
+	 */
+	virtual void deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+	                                                const RefObjectId& objectId) = 0;
+
+	/**
+	 *	Get the listeners registered for every object.
+	 */
 	virtual const PropertyAccessorListeners& getPropertyAccessorListeners() const = 0;
 
+	/**
+	 *	Get the listeners registered for every object along with the listeners subscribed to
+	 *	the object and property of the accessor.
+	 */
+	virtual void getPropertyAccessorListeners(const PropertyAccessor& accessor,
+	                                          PropertyAccessorListeners& o_Listeners) const = 0;
+
 	virtual bool serializeDefinitions(ISerializer& serializer) = 0;
 	virtual bool deserializeDefinitions(ISerializer& serializer) = 0;
 
@@ -1,6 +1,7 @@
 #ifndef I_META_UTILITIES_HPP
 #define I_META_UTILITIES_HPP
 
+#include <cstddef>
 #include <functional>
 
 namespace wgt
@@ -37,6 +38,19 @@ public:
 	virtual ObjectHandle findFirstMetaData(
 		const TypeId& , const IClassDefinition&, const IDefinitionManager &) = 0;
 
+	/**
+	* Returns the slot used to cache lookups of the meta type.
+	* Callers should query it once per type and pass it to the slot based lookups.
+	*/
+	virtual size_t getMetaDataSlot(const TypeId&) = 0;
+
+	/** Finds the first meta object of the type, already cast to the type. */
+	virtual ObjectHandle findFirstMetaDataCast(
+		const TypeId& , size_t slot, const MetaData &, const IDefinitionManager & ) = 0;
+
+	virtual bool hasMetaData(
+		const TypeId& , size_t slot, const MetaData &, const IDefinitionManager & ) = 0;
+
 	virtual void forEachMetaData(
 		const IClassDefinition&, const MetaData &, const IDefinitionManager &, MetaDataCallback callback) = 0;
 
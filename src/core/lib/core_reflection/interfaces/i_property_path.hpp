@@ -36,6 +36,8 @@ public:
 	virtual const SharedString & getRecursivePath() const = 0;
 	virtual bool operator==(const char * name) const = 0;
 	virtual bool operator==(const std::string & name) const = 0;
+	/** Compares with an interned recursive path, without comparing strings. */
+	virtual bool operator==(const SharedString & name) const = 0;
 };
 
 
@@ -1,7 +1,12 @@
 #include "meta_base.hpp"
 
+#include "meta_data_table.hpp"
 #include "meta_utilities_impl.hpp"
 #include "core_common/assert.hpp"
+#include "core_common/wg_read_write_lock.hpp"
+
+#include <algorithm>
+#include <vector>
 
 namespace wgt
 {
@@ -12,6 +17,10 @@ struct MetaDataStorage
 	ManagedObjectPtr object_;
 	ObjectHandle handle_;
 	mutable MetaData next_ = nullptr;
+
+	mutable wg_read_write_lock tableLock_;
+	// one table per definition manager the chain is queried with
+	mutable std::vector<std::shared_ptr<const MetaDataTable>> tables_;
 };
 
 //==============================================================================
@@ -100,6 +109,50 @@ void MetaData::setNext(MetaData next) const
 }
 
 
+//------------------------------------------------------------------------------
+std::shared_ptr<const MetaDataTable> MetaData::getTable(const IDefinitionManager& definitionManager) const
+{
+	if (storage_ == nullptr)
+	{
+		return nullptr;
+	}
+
+	{
+		wg_read_lock_guard guard(storage_->tableLock_);
+		for (auto& table : storage_->tables_)
+		{
+			if (table->isValidFor(definitionManager))
+			{
+				return table;
+			}
+		}
+	}
+
+	auto table = std::make_shared<const MetaDataTable>(*this, definitionManager);
+	wg_write_lock_guard guard(storage_->tableLock_);
+	auto& tables = storage_->tables_;
+	tables.erase(std::remove_if(tables.begin(), tables.end(),
+	                            [&definitionManager](const std::shared_ptr<const MetaDataTable>& existing) {
+		                            return existing->getDefinitionManager() == &definitionManager || existing->isStale();
+		                        }),
+	             tables.end());
+	tables.push_back(table);
+	return table;
+}
+
+
+//------------------------------------------------------------------------------
+void MetaData::invalidateTable() const
+{
+	if (storage_ == nullptr)
+	{
+		return;
+	}
+	wg_write_lock_guard guard(storage_->tableLock_);
+	storage_->tables_.clear();
+}
+
+
 //------------------------------------------------------------------------------
 IMetaUtilities & MetaData::getMetaUtils()
 {
@@ -29,6 +29,7 @@ enum MetaParamType
 }
 
 struct MetaDataStorage;
+class MetaDataTable;
 
 //==============================================================================
 /**
@@ -62,11 +63,17 @@ private:
 
 	const MetaData & next() const;
 	void setNext(MetaData next) const;
+
+	/** The flattened table for the chain starting at this meta data, built on first use. */
+	std::shared_ptr<const MetaDataTable> getTable(const IDefinitionManager& definitionManager) const;
+	void invalidateTable() const;
+
     MetaData(const MetaData& rhs) = delete;
     MetaData& operator=(const MetaData& rhs) = delete;
 
 	std::unique_ptr< MetaDataStorage > storage_;
 	friend class MetaUtilities;
+	friend class MetaDataTable;
 };
 
 //==============================================================================
@@ -77,40 +84,73 @@ ObjectHandleT<T> CastMetaData(const ObjectHandle & metaData, const IDefinitionMa
 	return reflectedCast<T>(root, definitionManager);
 }
 
+namespace MetaDataDetails
+{
+template <class T>
+size_t getSlot()
+{
+	static const size_t s_Slot = MetaData::getMetaUtils().getMetaDataSlot(TypeId::getType<T>());
+	return s_Slot;
+}
+}
+
 //==============================================================================
 template <class T>
 ObjectHandleT<T> findFirstMetaData(const MetaData & metaData, const IDefinitionManager& definitionManager)
 {
-	auto meta =
-		MetaData::getMetaUtils().findFirstMetaData(TypeId::getType<T>(), metaData, definitionManager);
-	return CastMetaData<T>(meta, definitionManager);
+	auto meta = MetaData::getMetaUtils().findFirstMetaDataCast(
+		TypeId::getType<T>(), MetaDataDetails::getSlot<T>(), metaData, definitionManager);
+	return reinterpretCast<T>(meta);
 }
 
 //==============================================================================
 template <class T>
 ObjectHandleT<T> findFirstMetaData(const PropertyAccessor& accessor, const IDefinitionManager& definitionManager)
 {
-	auto meta =
-		MetaData::getMetaUtils().findFirstMetaData(TypeId::getType<T>(), accessor, definitionManager );
-	return CastMetaData<T>(meta, definitionManager);
+	return findFirstMetaData<T>(accessor.getMetaData(), definitionManager);
 }
 
 //==============================================================================
 template <class T>
 ObjectHandleT<T> findFirstMetaData(const IBaseProperty& pProperty, const IDefinitionManager& definitionManager)
 {
-	auto meta =
-		MetaData::getMetaUtils().findFirstMetaData(TypeId::getType<T>(), pProperty, definitionManager);
-	return CastMetaData<T>(meta, definitionManager);
+	return findFirstMetaData<T>(pProperty.getMetaData(), definitionManager);
 }
 
 //==============================================================================
 template <class T>
 ObjectHandleT<T> findFirstMetaData(const IClassDefinition& definition, const IDefinitionManager& definitionManager)
 {
-	auto meta =
-		MetaData::getMetaUtils().findFirstMetaData(TypeId::getType<T>(), definition, definitionManager);
-	return CastMetaData<T>(meta, definitionManager);
+	return findFirstMetaData<T>(definition.getMetaData(), definitionManager);
+}
+
+//==============================================================================
+template <class T>
+bool hasMetaData(const MetaData & metaData, const IDefinitionManager& definitionManager)
+{
+	return MetaData::getMetaUtils().hasMetaData(
+		TypeId::getType<T>(), MetaDataDetails::getSlot<T>(), metaData, definitionManager);
+}
+
+//==============================================================================
+template <class T>
+bool hasMetaData(const PropertyAccessor& accessor, const IDefinitionManager& definitionManager)
+{
+	return hasMetaData<T>(accessor.getMetaData(), definitionManager);
+}
+
+//==============================================================================
+template <class T>
+bool hasMetaData(const IBaseProperty& pProperty, const IDefinitionManager& definitionManager)
+{
+	return hasMetaData<T>(pProperty.getMetaData(), definitionManager);
+}
+
+//==============================================================================
+template <class T>
+bool hasMetaData(const IClassDefinition& definition, const IDefinitionManager& definitionManager)
+{
+	return hasMetaData<T>(definition.getMetaData(), definitionManager);
 }
 
 //==============================================================================
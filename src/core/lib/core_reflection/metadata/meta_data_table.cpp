@@ -0,0 +1,212 @@
+#include "meta_data_table.hpp"
+
+#include "meta_base.hpp"
+#include "core_reflection/i_definition_manager.hpp"
+#include "core_reflection/interfaces/i_class_definition.hpp"
+#include "core_variant/type_id.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace wgt
+{
+namespace
+{
+const size_t MAX_SLOTS = 64;
+
+// Bumped whenever definitions are registered or deregistered, which makes every table stale
+std::atomic<uint64_t> s_tableGeneration(0);
+
+uint64_t slotBit(size_t slot)
+{
+	return slot < MAX_SLOTS ? (uint64_t(1) << slot) : 0;
+}
+}
+
+//==============================================================================
+MetaDataTable::MetaDataTable(const MetaData& metaData, const IDefinitionManager& definitionManager)
+    : definitionManager_(&definitionManager), generation_(s_tableGeneration.load(std::memory_order_acquire)),
+      complete_(true), resolvedMask_(0), presentMask_(0)
+{
+	auto meta = &metaData;
+	while (*meta != nullptr)
+	{
+		auto root = reflectedRoot(meta->getHandle(), definitionManager);
+		auto rootDefinition = definitionManager.getDefinition(root.type().getName());
+		if (rootDefinition == nullptr)
+		{
+			complete_ = false;
+		}
+		else
+		{
+			Entry entry = { meta->getHandle(), root, rootDefinition };
+			entries_.push_back(entry);
+		}
+		meta = &meta->next();
+	}
+}
+
+//==============================================================================
+bool MetaDataTable::isValidFor(const IDefinitionManager& definitionManager) const
+{
+	return complete_ && definitionManager_ == &definitionManager && !isStale();
+}
+
+//==============================================================================
+bool MetaDataTable::isStale() const
+{
+	return generation_ != s_tableGeneration.load(std::memory_order_acquire);
+}
+
+//==============================================================================
+const IDefinitionManager* MetaDataTable::getDefinitionManager() const
+{
+	return definitionManager_;
+}
+
+//==============================================================================
+void MetaDataTable::invalidateTables()
+{
+	s_tableGeneration.fetch_add(1, std::memory_order_release);
+}
+
+//==============================================================================
+ObjectHandle MetaDataTable::find(const TypeId& typeId, size_t slot,
+                                 const IDefinitionManager& definitionManager) const
+{
+	bool found = false;
+	return resolve(typeId, slot, definitionManager, found);
+}
+
+//==============================================================================
+ObjectHandle MetaDataTable::find(const IClassDefinition& targetDefinition) const
+{
+	for (const auto& entry : entries_)
+	{
+		if (entry.definition_->canBeCastTo(targetDefinition))
+		{
+			return entry.meta_;
+		}
+	}
+	return nullptr;
+}
+
+//==============================================================================
+void MetaDataTable::forEach(const IClassDefinition& targetDefinition,
+                            const std::function<void(const ObjectHandle&)>& callback) const
+{
+	for (const auto& entry : entries_)
+	{
+		if (entry.definition_->canBeCastTo(targetDefinition))
+		{
+			callback(entry.meta_);
+		}
+	}
+}
+
+//==============================================================================
+bool MetaDataTable::contains(const TypeId& typeId, size_t slot,
+                             const IDefinitionManager& definitionManager) const
+{
+	bool found = false;
+	resolve(typeId, slot, definitionManager, found);
+	return found;
+}
+
+//==============================================================================
+ObjectHandle MetaDataTable::resolve(const TypeId& typeId, size_t slot, const IDefinitionManager& definitionManager,
+                                    bool& o_Found) const
+{
+	const auto typeHash = typeId.getHashcode();
+	const auto bit = slotBit(slot);
+	auto findResolved = [this, typeHash]() {
+		return std::find_if(resolved_.begin(), resolved_.end(),
+		                    [typeHash](const Resolved& resolved) { return resolved.typeHash_ == typeHash; });
+	};
+
+	{
+		wg_read_lock_guard guard(lock_);
+		if (bit != 0 && (resolvedMask_ & bit) != 0)
+		{
+			o_Found = (presentMask_ & bit) != 0;
+			return o_Found ? findResolved()->meta_ : nullptr;
+		}
+		if (bit == 0)
+		{
+			auto resolved = findResolved();
+			if (resolved != resolved_.end())
+			{
+				o_Found = true;
+				return resolved->meta_;
+			}
+			if (std::find(missing_.begin(), missing_.end(), typeHash) != missing_.end())
+			{
+				o_Found = false;
+				return nullptr;
+			}
+		}
+	}
+
+	// The target definition may not have been registered yet, so only cache once it has
+	auto targetDefinition = definitionManager.getDefinition(typeId.getName());
+	if (targetDefinition == nullptr)
+	{
+		o_Found = false;
+		return nullptr;
+	}
+
+	const Entry* match = nullptr;
+	for (const auto& entry : entries_)
+	{
+		if (entry.definition_->canBeCastTo(*targetDefinition))
+		{
+			match = &entry;
+			break;
+		}
+	}
+
+	ObjectHandle cast = match != nullptr ? reflectedCast(match->root_, typeId, definitionManager) : nullptr;
+
+	wg_write_lock_guard guard(lock_);
+	o_Found = match != nullptr;
+	if (o_Found && findResolved() == resolved_.end())
+	{
+		Resolved entry = { typeHash, cast };
+		resolved_.push_back(entry);
+	}
+	else if (!o_Found && bit == 0)
+	{
+		missing_.push_back(typeHash);
+	}
+
+	resolvedMask_ |= bit;
+	if (o_Found)
+	{
+		presentMask_ |= bit;
+	}
+	return cast;
+}
+
+//==============================================================================
+size_t MetaDataTable::getSlot(const TypeId& typeId)
+{
+	static std::mutex s_Mutex;
+	static std::unordered_map<uint64_t, size_t> s_Slots;
+
+	std::lock_guard<std::mutex> guard(s_Mutex);
+	auto found = s_Slots.find(typeId.getHashcode());
+	if (found != s_Slots.end())
+	{
+		return found->second;
+	}
+	if (s_Slots.size() >= MAX_SLOTS)
+	{
+		return INVALID_SLOT;
+	}
+	auto slot = s_Slots.size();
+	s_Slots[typeId.getHashcode()] = slot;
+	return slot;
+}
+} // end namespace wgt
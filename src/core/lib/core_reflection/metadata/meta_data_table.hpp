@@ -0,0 +1,100 @@
+#ifndef META_DATA_TABLE_HPP
+#define META_DATA_TABLE_HPP
+
+#include "core_object/object_handle.hpp"
+#include "core_common/wg_read_write_lock.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace wgt
+{
+class IClassDefinition;
+class IDefinitionManager;
+class MetaData;
+class TypeId;
+
+//==============================================================================
+/**
+* Flattened view of a MetaData chain.
+* Each meta object's reflected root and class definition are resolved once when
+* the table is built, and the result of every query for a meta type is cached
+* already cast to the queried type. Meta types are given a slot the first time
+* they are queried; the first 64 slots are tracked in a presence bitmask so that
+* repeated queries for the common meta types are a couple of bit tests.
+* A table holds the definitions of the manager it was built with, so it is only
+* valid for that manager and until definitions are registered or deregistered.
+*/
+class MetaDataTable
+{
+public:
+	static const size_t INVALID_SLOT = static_cast<size_t>(-1);
+
+	MetaDataTable(const MetaData& metaData, const IDefinitionManager& definitionManager);
+
+	/**
+	* Whether the table can answer queries made with the definition manager.
+	* Tables built with another manager, built before definitions last changed, or
+	* missing the definition of a meta object in the chain are rebuilt on the next query.
+	*/
+	bool isValidFor(const IDefinitionManager& definitionManager) const;
+
+	/** Whether definitions were registered or deregistered since the table was built. */
+	bool isStale() const;
+
+	const IDefinitionManager* getDefinitionManager() const;
+
+	/**
+	* Tables hold class definitions, so this must be called whenever definitions
+	* are registered or deregistered.
+	*/
+	static void invalidateTables();
+
+	/**
+	* Finds the first meta object which can be cast to the type.
+	* @return the meta object already cast to the type, or nullptr.
+	*/
+	ObjectHandle find(const TypeId& typeId, size_t slot, const IDefinitionManager& definitionManager) const;
+
+	/** Finds the first meta object which can be cast to the definition, returning its uncast handle. */
+	ObjectHandle find(const IClassDefinition& targetDefinition) const;
+
+	bool contains(const TypeId& typeId, size_t slot, const IDefinitionManager& definitionManager) const;
+
+	void forEach(const IClassDefinition& targetDefinition,
+	             const std::function<void(const ObjectHandle&)>& callback) const;
+
+	/** Assigns a process wide slot to the type, or INVALID_SLOT once the slots run out. */
+	static size_t getSlot(const TypeId& typeId);
+
+private:
+	struct Entry
+	{
+		ObjectHandle meta_;
+		ObjectHandle root_;
+		const IClassDefinition* definition_;
+	};
+
+	struct Resolved
+	{
+		uint64_t typeHash_;
+		ObjectHandle meta_;
+	};
+
+	ObjectHandle resolve(const TypeId& typeId, size_t slot, const IDefinitionManager& definitionManager,
+	                     bool& o_Found) const;
+
+	const IDefinitionManager* definitionManager_;
+	uint64_t generation_;
+	std::vector<Entry> entries_;
+	bool complete_;
+
+	mutable wg_read_write_lock lock_;
+	mutable uint64_t resolvedMask_;
+	mutable uint64_t presentMask_;
+	mutable std::vector<Resolved> resolved_;
+	mutable std::vector<uint64_t> missing_;
+};
+} // end namespace wgt
+#endif // META_DATA_TABLE_HPP
@@ -485,7 +485,8 @@ void MetaActionObj::execute(const ObjectHandle& handle, const std::string& path)
 		TF_ASSERT(definition != nullptr);
 		auto propertyAccessor = definition->bindProperty(path.c_str(), handle);
 
-		auto listeners = definitionManager_->getPropertyAccessorListeners();
+		IDefinitionManager::PropertyAccessorListeners listeners;
+		definitionManager_->getPropertyAccessorListeners(propertyAccessor, listeners);
 		auto itBegin = listeners.cbegin();
 		auto itEnd = listeners.cend();
 		for (auto it = itBegin; it != itEnd; ++it)
@@ -571,14 +572,14 @@ MetaUrlObj::MetaUrlObj(bool native, const std::string& title, const std::string&
     : native_(native), title_(title), folder_(folder), nameFilters_(nameFilters),
       selectedNameFilter_(selectedNameFilter)
 {
-	if (nameFilters_.empty())
+	if (nameFilters_->empty())
 	{
 		nameFilters_ = "All Files (*)";
 	}
 
-	if (selectedNameFilter_.empty())
+	if (selectedNameFilter_->empty())
 	{
-		selectedNameFilter_ = nameFilters_.substr(0, nameFilters_.find('|'));
+		selectedNameFilter_ = nameFilters_->substr(0, nameFilters_->find('|'));
 	}
 }
 
@@ -589,22 +590,22 @@ bool MetaUrlObj::native() const
 
 const std::string& MetaUrlObj::title() const
 {
-	return title_;
+	return title_.str();
 }
 
 const std::string& MetaUrlObj::folder() const
 {
-	return folder_;
+	return folder_.str();
 }
 
 const std::string& MetaUrlObj::nameFilters() const
 {
-	return nameFilters_;
+	return nameFilters_.str();
 }
 
 const std::string& MetaUrlObj::selectedNameFilter() const
 {
-	return selectedNameFilter_;
+	return selectedNameFilter_.str();
 }
 
 bool MetaUrlObj::isAssetBrowserDialog() const
@@ -12,6 +12,7 @@
 #include "static_string_database/i_static_string_database.hpp"
 #include "core_common/signal.hpp"
 #include "core_variant/collection.hpp"
+#include "wg_types/shared_string.hpp"
 #include "core_reflection/interfaces/i_direct_base_helper.hpp"
 
 namespace wgt
@@ -821,11 +822,10 @@ public:
 
 private:
 	bool native_;
-	std::string title_;
-	std::string folder_;
-	std::string nameFilters_;
-	std::string selectedNameFilter_;
-	std::string rootDirectory_;
+	SharedString title_;
+	SharedString folder_;
+	SharedString nameFilters_;
+	SharedString selectedNameFilter_;
 };
 
 //==============================================================================
@@ -7,6 +7,7 @@
 #include "core_reflection/i_definition_manager.hpp"
 #include "core_dependency_system/i_interface.hpp"
 #include "core_reflection/property_accessor.hpp"
+#include "core_reflection/metadata/meta_data_table.hpp"
 
 namespace wgt
 {
@@ -29,19 +30,32 @@ public:
 		const IClassDefinition& targetDefinition, const MetaData & metaData,
 		const IDefinitionManager & definitionManager) override
 	{
-		auto meta = &metaData;
-		while (*meta != nullptr)
-		{
-			auto root = reflectedRoot(meta->getHandle(), definitionManager);
-			auto rootDefinition = definitionManager.getDefinition(root.type().getName());
-			TF_ASSERT(rootDefinition != nullptr);
-			if (rootDefinition->canBeCastTo(targetDefinition))
-			{
-				return meta->getHandle();
-			}
-			meta = &meta->next();
-		}
-		return nullptr;
+		auto table = metaData.getTable(definitionManager);
+		return table ? table->find(targetDefinition) : nullptr;
+	}
+
+	//--------------------------------------------------------------------------
+	size_t getMetaDataSlot(const TypeId& typeId) override
+	{
+		return MetaDataTable::getSlot(typeId);
+	}
+
+	//--------------------------------------------------------------------------
+	ObjectHandle findFirstMetaDataCast(
+		const TypeId& typeId, size_t slot, const MetaData & metaData,
+		const IDefinitionManager & definitionManager) override
+	{
+		auto table = metaData.getTable(definitionManager);
+		return table ? table->find(typeId, slot, definitionManager) : nullptr;
+	}
+
+	//--------------------------------------------------------------------------
+	bool hasMetaData(
+		const TypeId& typeId, size_t slot, const MetaData & metaData,
+		const IDefinitionManager & definitionManager) override
+	{
+		auto table = metaData.getTable(definitionManager);
+		return table ? table->contains(typeId, slot, definitionManager) : false;
 	}
 
 	//--------------------------------------------------------------------------
@@ -96,17 +110,10 @@ public:
 		const IClassDefinition & targetDefinition, const MetaData & metaData,
 		const IDefinitionManager & definitionManager, MetaDataCallback callback) override
 	{
-		auto meta = &metaData;
-		while (*meta != nullptr)
+		auto table = metaData.getTable(definitionManager);
+		if (table != nullptr)
 		{
-			auto root = reflectedRoot(meta->getHandle(), definitionManager);
-			auto rootDefinition = definitionManager.getDefinition(root.type().getName());
-			TF_ASSERT(rootDefinition != nullptr);
-			if (rootDefinition->canBeCastTo(targetDefinition))
-			{
-				callback(meta->getHandle());
-			}
-			meta = &meta->next();
+			table->forEach(targetDefinition, callback);
 		}
 	}
 
@@ -137,11 +144,13 @@ public:
 	//--------------------------------------------------------------------------
 	void setNextMetaData(MetaData& left, MetaData&& right)
 	{
-		// traverse to the end of the linked list
+		// traverse to the end of the linked list, dropping the tables of every chain being extended
+		left.invalidateTable();
 		auto && next = &left.next();
 		const MetaData * last = &left;
 		while (*next != nullptr)
 		{
+			next->invalidateTable();
 			last = next;
 			next = &next->next();
 		};
@@ -11,8 +11,7 @@ BasePropertyPath::BasePropertyPath(
 	, path_( path ? path : "" )
 	, hash_( 0 )
 	, recursiveHash_( parent ? parent->getRecursiveHash() : 0 )
-	//Do deep copy
-	, recursivePath_( parent ? parent->getRecursivePath().str() : "" )
+	, recursivePath_( parent ? parent->getRecursivePath() : SharedString() )
 {
 }
 
@@ -67,6 +66,11 @@ bool BasePropertyPath::operator==(const std::string & name) const
 	return recursivePath_.str() == name;
 }
 
+bool BasePropertyPath::operator==(const SharedString & name) const
+{
+	return recursivePath_ == name;
+}
+
 PropertyPath::PropertyPath(
 	IPropertyPath::ConstPtr & parent, const char * path)
 	: BasePropertyPath(parent, path )
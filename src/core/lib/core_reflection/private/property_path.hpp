@@ -21,6 +21,7 @@ protected:
 public:
 	bool operator==(const char * name) const override;
 	bool operator==(const std::string & name) const override;
+	bool operator==(const SharedString & name) const override;
 
 	IPropertyPath::ConstPtr & getParent() const override;
 
@@ -8,7 +8,7 @@ namespace ReflectionPrivate
 {
 	uint64_t computePropertyId(const char * path)
 	{
-		return HashUtilities::compute(path);
+		return HashUtilities::computeFast(path);
 	}
 
 	std::unique_ptr< ReflectionCache > s_Cache;
@@ -118,7 +118,8 @@ bool PropertyAccessor::canSetValue() const
 void PropertyAccessor::notify() const
 {
 	// Intentionally copy cause set of listeners can change between preSet and postSet
-	auto listeners = data_->get< IDefinitionManager >()->getPropertyAccessorListeners();
+	IDefinitionManager::PropertyAccessorListeners listeners;
+	data_->get< IDefinitionManager >()->getPropertyAccessorListeners(*this, listeners);
 	auto itBegin = listeners.cbegin();
 	auto itEnd = listeners.cend();
 	Variant value = getValue();
@@ -146,7 +147,8 @@ bool PropertyAccessor::setValue(const Variant& value) const
 	}
 
 	// Intentionally copy cause set of listeners can change between preSet and postSet
-	auto listeners = data_->get< IDefinitionManager >()->getPropertyAccessorListeners();
+	IDefinitionManager::PropertyAccessorListeners listeners;
+	data_->get< IDefinitionManager >()->getPropertyAccessorListeners(*this, listeners);
 	auto itBegin = listeners.cbegin();
 	auto itEnd = listeners.cend();
 	for (auto it = itBegin; it != itEnd; ++it)
@@ -212,7 +214,8 @@ Variant PropertyAccessor::invoke(const ReflectedMethodParameters& parameters) co
 		return result;
 	}
 
-	auto listeners = data_->get< IDefinitionManager >()->getPropertyAccessorListeners();
+	IDefinitionManager::PropertyAccessorListeners listeners;
+	data_->get< IDefinitionManager >()->getPropertyAccessorListeners(*this, listeners);
 
 	for (auto it = listeners.cbegin(); it != listeners.cend(); ++it)
 	{
@@ -259,7 +262,8 @@ void PropertyAccessor::invokeUndoRedo(const ReflectedMethodParameters& parameter
 		return;
 	}
 
-	auto listeners = data_->get<IDefinitionManager >()->getPropertyAccessorListeners();
+	IDefinitionManager::PropertyAccessorListeners listeners;
+	data_->get< IDefinitionManager >()->getPropertyAccessorListeners(*this, listeners);
 	for (auto it = listeners.cbegin(); it != listeners.cend(); ++it)
 	{
 		auto listener = *it;
@@ -318,7 +322,8 @@ bool PropertyAccessor::insert(const Variant& key, const Variant& value) const
 		return false;
 	}
 
-	auto listeners = data_->get< IDefinitionManager >()->getPropertyAccessorListeners();
+	IDefinitionManager::PropertyAccessorListeners listeners;
+	data_->get< IDefinitionManager >()->getPropertyAccessorListeners(*this, listeners);
 	auto itBegin = listeners.cbegin();
 	auto itEnd = listeners.cend();
 
@@ -379,7 +384,8 @@ bool PropertyAccessor::erase(const Variant& key) const
 		return false;
 	}
 
-	auto listeners = data_->get< IDefinitionManager >()->getPropertyAccessorListeners();
+	IDefinitionManager::PropertyAccessorListeners listeners;
+	data_->get< IDefinitionManager >()->getPropertyAccessorListeners(*this, listeners);
 	auto itBegin = listeners.cbegin();
 	auto itEnd = listeners.cend();
 
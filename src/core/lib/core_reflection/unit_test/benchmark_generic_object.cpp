@@ -0,0 +1,56 @@
+#include "pch.hpp"
+
+#include "core_reflection/generic/generic_object.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "test_objects.hpp"
+
+namespace wgt
+{
+TEST_F(TestDefinitionFixture, genericObjectShapeBenchmark)
+{
+	const size_t count = 1000000;
+	const char* names[] = { "Name", "Type", "Index", "Weight" };
+
+	auto start = std::chrono::high_resolution_clock::now();
+	std::vector<ManagedObject<GenericObject>> objects;
+	objects.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		objects.emplace_back(GenericObject::createShaped());
+		auto& object = objects.back();
+		object->set(names[0], std::string("object"));
+		object->set(names[1], std::string("benchmark"));
+		object->set(names[2], static_cast<int>(i));
+		object->set(names[3], 0.5);
+	}
+	auto created = std::chrono::high_resolution_clock::now();
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		objects[i]->set(names[2], static_cast<int>(count - i));
+	}
+	auto written = std::chrono::high_resolution_clock::now();
+
+	bool matches = true;
+	int64_t checksum = 0;
+	for (size_t i = 0; i < count; ++i)
+	{
+		int index = 0;
+		matches = matches && objects[i]->get(names[2], index) && index == static_cast<int>(count - i);
+		checksum += index;
+	}
+	auto read = std::chrono::high_resolution_clock::now();
+
+	CHECK(matches);
+	CHECK(objects.front()->getDefinition() == objects.back()->getDefinition());
+
+	typedef std::chrono::duration<double, std::milli> Milliseconds;
+	printf("Generic objects x %d: create %.3fms, write %.3fms, read %.3fms (checksum %lld)\n",
+	       static_cast<int>(count), Milliseconds(created - start).count(), Milliseconds(written - created).count(),
+	       Milliseconds(read - written).count(), static_cast<long long>(checksum));
+}
+} // end namespace wgt
@@ -7,6 +7,8 @@
 #include "core_reflection/metadata/meta_types.hpp"
 #include "core_reflection/utilities/reflection_function_utilities.hpp"
 #include "core_reflection/definition_manager.hpp"
+#include "core_reflection/property_accessor_listener.hpp"
+#include "core_reflection/ref_object_id.hpp"
 #include "core_object/managed_object.hpp"
 #include "core_unit_test/test_framework.hpp"
 
@@ -771,6 +773,78 @@ TEST_F(TestDefinitionFixture, property_accessor_int)
 	}
 }
 
+namespace
+{
+class CountingPropertyListener : public PropertyAccessorListener
+{
+public:
+	CountingPropertyListener() : count_(0)
+	{
+	}
+
+	void postSetValue(const PropertyAccessor& accessor, const Variant& value) override
+	{
+		++count_;
+	}
+
+	int count_;
+};
+}
+
+TEST_F(TestDefinitionFixture, property_accessor_listener_subscriptions)
+{
+	TestDefinitionObject data1;
+	TestDefinitionObject data2;
+	ManagedObject<TestDefinitionObject> object1(data1, RefObjectId::generate());
+	ManagedObject<TestDefinitionObject> object2(data2, RefObjectId::generate());
+	ObjectHandle handle1 = object1.getHandle();
+	ObjectHandle handle2 = object2.getHandle();
+
+	auto objectListener = std::make_shared<CountingPropertyListener>();
+	auto pathListener = std::make_shared<CountingPropertyListener>();
+	auto globalListener = std::make_shared<CountingPropertyListener>();
+	std::shared_ptr<PropertyAccessorListener> objectListenerPtr = objectListener;
+	std::shared_ptr<PropertyAccessorListener> pathListenerPtr = pathListener;
+	std::shared_ptr<PropertyAccessorListener> globalListenerPtr = globalListener;
+
+	auto& definitionManager = getDefinitionManager();
+	definitionManager.registerPropertyAccessorListener(objectListenerPtr, handle1.id());
+	definitionManager.registerPropertyAccessorListener(pathListenerPtr, handle1.id(), "vector3");
+	definitionManager.registerPropertyAccessorListener(globalListenerPtr);
+
+	CHECK(klass_->bindProperty("counter", handle1).setValue(1));
+	CHECK(klass_->bindProperty("vector3", handle1).setValue(Vector3(1.0f, 2.0f, 3.0f)));
+	CHECK(klass_->bindProperty("counter", handle2).setValue(2));
+
+	CHECK_EQUAL(2, objectListener->count_);
+	CHECK_EQUAL(1, pathListener->count_);
+	CHECK_EQUAL(3, globalListener->count_);
+
+	definitionManager.deregisterPropertyAccessorListener(objectListenerPtr);
+	definitionManager.deregisterPropertyAccessorListener(pathListenerPtr);
+	definitionManager.deregisterPropertyAccessorListener(globalListenerPtr);
+
+	CHECK(klass_->bindProperty("vector3", handle1).setValue(Vector3(3.0f, 2.0f, 1.0f)));
+	CHECK_EQUAL(2, objectListener->count_);
+	CHECK_EQUAL(1, pathListener->count_);
+	CHECK_EQUAL(3, globalListener->count_);
+
+	// Subscribing twice notifies once, and a subscription can be removed from a single object
+	definitionManager.registerPropertyAccessorListener(objectListenerPtr, handle1.id());
+	definitionManager.registerPropertyAccessorListener(objectListenerPtr, handle1.id());
+	definitionManager.registerPropertyAccessorListener(objectListenerPtr, handle2.id());
+	CHECK(klass_->bindProperty("counter", handle1).setValue(3));
+	CHECK(klass_->bindProperty("counter", handle2).setValue(4));
+	CHECK_EQUAL(4, objectListener->count_);
+
+	definitionManager.deregisterPropertyAccessorListener(objectListenerPtr, handle1.id());
+	CHECK(klass_->bindProperty("counter", handle1).setValue(5));
+	CHECK(klass_->bindProperty("counter", handle2).setValue(6));
+	CHECK_EQUAL(5, objectListener->count_);
+
+	definitionManager.deregisterPropertyAccessorListener(objectListenerPtr);
+}
+
 TEST_F(TestDefinitionFixture, property_accessor_vector3)
 {
 	TestDefinitionObject data;
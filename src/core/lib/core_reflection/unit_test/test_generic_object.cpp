@@ -4,6 +4,7 @@
 #include "wg_types/vector4.hpp"
 #include "core_reflection/ref_object_id.hpp"
 #include "core_reflection/generic/generic_object.hpp"
+#include "core_reflection/metadata/meta_types.hpp"
 #include "core_variant/variant.hpp"
 
 #include "test_helpers.hpp"
@@ -235,4 +236,59 @@ TEST_F(TestDefinitionFixture, createMultipleGenericObjects)
 		CHECK(!newGenericObj->get("testStructure", value));
 	}
 }
+
+TEST_F(TestDefinitionFixture, genericObjectShapes)
+{
+	auto object1 = GenericObject::createShaped();
+	auto object2 = GenericObject::createShaped();
+	auto object3 = GenericObject::createShaped();
+	CHECK(object1->getDefinition() == object2->getDefinition());
+
+	object1->set("intValue", 1);
+	object1->set("stringValue", std::string("one"));
+	object2->set("intValue", 2);
+	object2->set("stringValue", std::string("two"));
+	object3->set("stringValue", std::string("three"));
+	object3->set("intValue", 3);
+
+	// objects with the same properties share a definition, but not their values
+	CHECK(object1->getDefinition() == object2->getDefinition());
+	CHECK(object1->getDefinition() != object3->getDefinition());
+	CHECK(object1->getDefinition() == getDefinitionManager().getDefinition(object1.getHandle()));
+	{
+		int value1, value2, value3;
+		CHECK(object1->get("intValue", value1));
+		CHECK(object2->get("intValue", value2));
+		CHECK(object3->get("intValue", value3));
+		CHECK_EQUAL(1, value1);
+		CHECK_EQUAL(2, value2);
+		CHECK_EQUAL(3, value3);
+	}
+
+	// removing a property gives the object a definition of its own
+	auto sharedDefinition = object1->getDefinition();
+	object2->set("intValue", Variant());
+	CHECK(object2->getDefinition() != sharedDefinition);
+	CHECK(object1->getDefinition() == sharedDefinition);
+	{
+		int value;
+		CHECK(!object2->findProperty("intValue").isValid());
+		CHECK(object1->get("intValue", value));
+		CHECK_EQUAL(1, value);
+
+		std::string stringValue;
+		CHECK(object2->get("stringValue", stringValue));
+		CHECK_EQUAL(std::string("two"), stringValue);
+	}
+
+	// so does adding one with metadata
+	CHECK(object3->add("hidden", true, MetaHidden()));
+	CHECK(object3->getDefinition() != object1->getDefinition());
+	CHECK(!object1->findProperty("hidden").isValid());
+	{
+		bool value = false;
+		CHECK(object3->get("hidden", value));
+		CHECK(value);
+	}
+}
 } // end namespace wgt
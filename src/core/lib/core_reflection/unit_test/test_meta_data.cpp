@@ -1,5 +1,6 @@
 #include "pch.hpp"
 
+#include "core_reflection/definition_manager.hpp"
 #include "core_reflection/metadata/meta_types.hpp"
 #include "core_reflection/metadata/meta_base.hpp"
 #include "core_reflection/metadata/meta_impl.hpp"
@@ -22,6 +23,50 @@ TEST_F(TestDefinitionFixture, test_add_meta_data)
     CHECK(findFirstMetaData<MetaHiddenObj>(meta, manager) != nullptr);
 }
 
+TEST_F(TestDefinitionFixture, test_meta_data_table)
+{
+	auto& manager = getDefinitionManager();
+	auto meta = MetaData(nullptr);
+	meta += MetaReadOnly();
+
+	CHECK(hasMetaData<MetaReadOnlyObj>(meta, manager));
+	CHECK(!hasMetaData<MetaHiddenObj>(meta, manager));
+
+	// Repeated queries return the cached handle
+	auto readOnly = findFirstMetaData<MetaReadOnlyObj>(meta, manager);
+	CHECK(readOnly != nullptr);
+	CHECK(readOnly.get() == findFirstMetaData<MetaReadOnlyObj>(meta, manager).get());
+
+	// Extending the chain invalidates the cached lookups
+	meta += MetaHidden();
+	CHECK(hasMetaData<MetaHiddenObj>(meta, manager));
+	CHECK(findFirstMetaData<MetaHiddenObj>(meta, manager) != nullptr);
+	CHECK(readOnly.get() == findFirstMetaData<MetaReadOnlyObj>(meta, manager).get());
+}
+
+TEST_F(TestDefinitionFixture, test_meta_data_table_per_definition_manager)
+{
+	auto& manager = getDefinitionManager();
+	auto meta = MetaData(nullptr);
+	meta += MetaReadOnly();
+	CHECK(hasMetaData<MetaReadOnlyObj>(meta, manager));
+
+	// A table is only used with the manager it was built with, which here knows no meta types
+	{
+		DefinitionManager other(getObjectManager());
+		CHECK(!hasMetaData<MetaReadOnlyObj>(meta, other));
+		CHECK(findFirstMetaData<MetaReadOnlyObj>(meta, other) == nullptr);
+		CHECK(hasMetaData<MetaReadOnlyObj>(meta, manager));
+
+		// Registering a definition rebuilds the tables on the next query
+		CHECK(other.registerDefinition(other.createGenericDefinition("TestMetaDataTableGeneric")) != nullptr);
+		CHECK(hasMetaData<MetaReadOnlyObj>(meta, manager));
+		CHECK(!hasMetaData<MetaReadOnlyObj>(meta, other));
+	}
+
+	CHECK(findFirstMetaData<MetaReadOnlyObj>(meta, manager) != nullptr);
+}
+
 TEST_F(TestDefinitionFixture, test_definition_meta_data)
 {
     auto object = ManagedObject<TestMetaDataObject>::make();
@@ -159,6 +159,10 @@ TEST_F(TestObjectHandleFixture, test_object_handle_cast)
 	CHECK(reflectCastedBasePtr == handle.data());
 	CHECK(reflectCastedBasePtr == handleT.get());
 
+	// Repeated casts are served from the cast cache
+	CHECK(reflectedCast<ITestCast>(handle.data(), handle.type(), definitionManager) == reflectCastedBasePtr);
+	CHECK(reflectedCast<Test1>(handle.data(), handle.type(), definitionManager) == nullptr);
+
 	// Test unsupported handle casting
 	ObjectHandleT<ITestCast> downcastedBase = nullptr;
 	downcast(&downcastedBase, handle);
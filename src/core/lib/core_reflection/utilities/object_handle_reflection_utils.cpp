@@ -3,9 +3,135 @@
 #include "core_common/assert.hpp"
 #include "core_object/object_handle_cast_utils.hpp"
 #include "core_reflection/i_definition_manager.hpp"
+#include "core_reflection/interfaces/i_direct_base_helper.hpp"
+#include "core_reflection/metadata/meta_base.hpp"
+#include "core_reflection/metadata/meta_impl.hpp"
+#include "wg_types/hash_utilities.hpp"
+
+#include <atomic>
+#include <unordered_map>
+#include <vector>
 
 namespace wgt
 {
+namespace
+{
+// Bumped whenever definitions are registered or deregistered, which drops every thread's cast cache
+std::atomic<uint64_t> s_castCacheGeneration(0);
+
+struct CastKey
+{
+	const IDefinitionManager* definitionManager_;
+	uint64_t source_;
+	uint64_t dest_;
+
+	bool operator==(const CastKey& other) const
+	{
+		return definitionManager_ == other.definitionManager_ && source_ == other.source_ && dest_ == other.dest_;
+	}
+};
+
+struct CastKeyHash
+{
+	size_t operator()(const CastKey& key) const
+	{
+		uint64_t hash = key.source_;
+		HashUtilities::combine(hash, key.dest_);
+		HashUtilities::combine(hash, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key.definitionManager_)));
+		return static_cast<size_t>(hash);
+	}
+};
+
+/**
+ *	How to get from a source type to a destination type: the base casters to
+ *	apply in turn, or not at all if the types are not related.
+ */
+struct CastPath
+{
+	bool convertible_;
+	std::vector<const IDirectBaseHelper::CasterSig*> casters_;
+};
+
+struct CastCache
+{
+	uint64_t generation_ = 0;
+	std::unordered_map<CastKey, CastPath, CastKeyHash> paths_;
+};
+
+//------------------------------------------------------------------------------
+bool findCasters(const IClassDefinition& source, const IClassDefinition& dest,
+                 const IDefinitionManager& definitionManager, std::vector<const IDirectBaseHelper::CasterSig*>& o_casters)
+{
+	// Assuming definitions are shared we only need to check the pointer
+	if (&source == &dest)
+	{
+		return true;
+	}
+
+	auto metaBasesHolder = findFirstMetaData<MetaBasesHolderObj>(source, definitionManager);
+	if (metaBasesHolder == nullptr)
+	{
+		return false;
+	}
+
+	const auto& parents = metaBasesHolder->getParents();
+	const auto& casters = metaBasesHolder->getCasters();
+	TF_ASSERT(parents.size() == casters.size());
+	for (size_t i = 0; i < parents.size(); ++i)
+	{
+		auto baseDefinition = definitionManager.getDefinition(parents[i].c_str());
+		if (baseDefinition == nullptr)
+		{
+			continue;
+		}
+
+		o_casters.push_back(&casters[i]);
+		if (findCasters(*baseDefinition, dest, definitionManager, o_casters))
+		{
+			return true;
+		}
+		o_casters.pop_back();
+	}
+	return false;
+}
+
+//------------------------------------------------------------------------------
+/**
+ *	Finds the cast path between two types, walking the definitions only the first
+ *	time a thread casts between them. Every thread keeps its own cache so that
+ *	lookups never wait on a lock.
+ */
+const CastPath& findCastPath(const TypeId& typeIdSource, const TypeId& typeIdDest,
+                             const IDefinitionManager& definitionManager)
+{
+	thread_local CastCache s_cache;
+
+	const auto generation = s_castCacheGeneration.load(std::memory_order_acquire);
+	if (s_cache.generation_ != generation)
+	{
+		s_cache.paths_.clear();
+		s_cache.generation_ = generation;
+	}
+
+	const CastKey key = { &definitionManager, typeIdSource.getHashcode(), typeIdDest.getHashcode() };
+	auto found = s_cache.paths_.find(key);
+	if (found != s_cache.paths_.end())
+	{
+		return found->second;
+	}
+
+	CastPath path;
+	path.convertible_ = false;
+	auto srcDefinition = definitionManager.getDefinition(typeIdSource.getName());
+	if (srcDefinition != nullptr)
+	{
+		auto dstDefinition = definitionManager.getDefinition(typeIdDest.getName());
+		path.convertible_ =
+		dstDefinition != nullptr && findCasters(*srcDefinition, *dstDefinition, definitionManager, path.casters_);
+	}
+	return s_cache.paths_.emplace(key, std::move(path)).first->second;
+}
+}
 
 //------------------------------------------------------------------------------
 void* ObjectHandleReflectedUtils::cast(
@@ -23,14 +149,18 @@ void* ObjectHandleReflectedUtils::cast(
 		return pRaw;
 	}
 
-	auto srcDefinition = definitionManager.getDefinition(typeIdSource.getName());
-	if (srcDefinition != nullptr)
+	auto& path = findCastPath(typeIdSource, typeIdDest, definitionManager);
+	if (!path.convertible_)
 	{
-		auto dstDefinition = definitionManager.getDefinition(typeIdDest.getName());
-		return dstDefinition != nullptr ? srcDefinition->castTo(*dstDefinition, pRaw) : nullptr;
+		return nullptr;
 	}
 
-	return nullptr;
+	void* object = pRaw;
+	for (auto caster : path.casters_)
+	{
+		object = (*caster)(object);
+	}
+	return object;
 }
 
 //------------------------------------------------------------------------------
@@ -49,25 +179,27 @@ ObjectHandle ObjectHandleReflectedUtils::cast(
         return source;
     }
 
-    auto srcDefinition = definitionManager.getDefinition(typeIdSource.getName());
-    if (srcDefinition != nullptr)
+    if (findCastPath(typeIdSource, typeIdDest, definitionManager).convertible_)
     {
-        auto dstDefinition = definitionManager.getDefinition(typeIdDest.getName());
-        if (dstDefinition != nullptr && srcDefinition->canBeCastTo(*dstDefinition))
-        {
-			CastType castType;
-			castType.type = typeIdDest;
-			castType.cast = [&definitionManager, typeIdDest](void* data, const TypeId& dataType) -> void*
-			{
-				return ObjectHandleReflectedUtils::cast(data, dataType, typeIdDest, definitionManager);
-			};
-			return ObjectHandle(source.storage(), castType);
-        }
+		CastType castType;
+		castType.type = typeIdDest;
+		castType.cast = [&definitionManager, typeIdDest](void* data, const TypeId& dataType) -> void*
+		{
+			return ObjectHandleReflectedUtils::cast(data, dataType, typeIdDest, definitionManager);
+		};
+		return ObjectHandle(source.storage(), castType);
     }
     return nullptr;
 }
 
 
+//------------------------------------------------------------------------------
+void ObjectHandleReflectedUtils::invalidateCastCache()
+{
+	s_castCacheGeneration.fetch_add(1, std::memory_order_release);
+}
+
+
 //------------------------------------------------------------------------------
 ObjectHandle ObjectHandleReflectedUtils::root(
 	const ObjectHandle& source, const IDefinitionManager& definitionManager)
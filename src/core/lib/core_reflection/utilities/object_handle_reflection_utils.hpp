@@ -23,6 +23,12 @@ public:
 	REFLECTION_DLL static ObjectHandle root(
 		const ObjectHandle& source, 
 		const IDefinitionManager& definitionManager);
+
+	/**
+	* Casts between types are cached, so this must be called whenever definitions
+	* are registered or deregistered.
+	*/
+	REFLECTION_DLL static void invalidateCastCache();
 };
 
 /**
@@ -70,7 +70,7 @@ bool CustomCommand::redo(const ObjectHandle& arguments) const
 CommandDescription CustomCommand::getCommandDescription(const ObjectHandle& arguments) const
 {
 	auto commandParameters = arguments.getBase<CustomCommandParameters>();
-	auto object = GenericObject::create();
+	auto object = GenericObject::createShaped();
     object->set("Name", commandParameters->description_);
     object->set("Type", "Custom");
     return std::move(object);
@@ -230,7 +230,7 @@ CommandDescription InvokeReflectedMethodCommand::getCommandDescription(const Obj
 
 		if (description != nullptr && description->getDescription() != nullptr)
 		{
-            auto object = GenericObject::create();
+            auto object = GenericObject::createShaped();
             object->set("Name", std::wstring(description->getDescription()));
             object->set("Type", "Unknown");
             return std::move(object);
@@ -111,7 +111,7 @@ bool ReflectedCollectionEraseCommand::redo(const ObjectHandle& arguments) const
 
 CommandDescription ReflectedCollectionEraseCommand::getCommandDescription(const ObjectHandle&) const
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
     object->set("Name", "Erase");
     object->set("Type", "Unknown");
     return std::move(object);
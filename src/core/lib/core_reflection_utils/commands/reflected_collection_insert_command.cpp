@@ -96,7 +96,7 @@ bool ReflectedCollectionInsertCommand::redo(const ObjectHandle& arguments) const
 
 CommandDescription ReflectedCollectionInsertCommand::getCommandDescription(const ObjectHandle&) const
 {
-    auto object = GenericObject::create();
+    auto object = GenericObject::createShaped();
     object->set("Name", "Insert");
     object->set("Type", "Unknown");
     return std::move(object);
@@ -6,18 +6,39 @@
 #include "core_reflection/property_accessor.hpp"
 #include "core_reflection/property_iterator.hpp"
 #include "core_reflection/interfaces/i_base_property.hpp"
+#include "core_reflection/interfaces/i_class_definition_details.hpp"
 #include "core_command_system/i_command_manager.hpp"
 #include "core_reflection/metadata/meta_utilities.hpp"
 #include "core_reflection/metadata/meta_impl.hpp"
 #include "core_reflection/i_definition_manager.hpp"
 #include "core_serialization/serializer/i_serialization_manager.hpp"
+#include "core_reflection/utilities/reflection_utilities.hpp"
 
 namespace wgt
 {
+namespace
+{
+bool isStruct(const IBaseProperty& property, const Variant& value, const IDefinitionManager& definitionManager)
+{
+	if (property.getType().isPointer())
+	{
+		return false;
+	}
+
+	ObjectHandle handle;
+	if (!value.tryCast(handle))
+	{
+		return false;
+	}
+
+	return definitionManager.getDefinition(handle) != nullptr;
+}
+}
+
 ReflectionSerializer::ReflectionSerializer(ISerializationManager& serializationManager, IObjectManager& objManager,
                                            IDefinitionManager& defManager)
     : serializationManager_(serializationManager), objManager_(objManager), defManager_(defManager),
-      curDataStream_(nullptr)
+      curDataStream_(nullptr), nextPlanVersion_(0), depth_(0), writeStream_(nullptr), readStream_(nullptr)
 {
 	typeList.push_back(TypeId::getType<ObjectHandle>());
 }
@@ -33,15 +54,105 @@ std::vector<TypeId> ReflectionSerializer::getSupportedType()
 	return typeList;
 }
 
+void ReflectionSerializer::beginWrite(IDataStream& dataStream)
+{
+	// Continue the schemas of the stream being written, unless it starts over
+	if (&dataStream == writeStream_ && dataStream.seek(0, std::ios_base::cur) != 0)
+	{
+		return;
+	}
+
+	writeStream_ = &dataStream;
+	writtenSchemas_.clear();
+	writtenTypes_.clear();
+}
+
+void ReflectionSerializer::beginRead(IDataStream& dataStream)
+{
+	if (&dataStream == readStream_ && dataStream.seek(0, std::ios_base::cur) != 0)
+	{
+		return;
+	}
+
+	readStream_ = &dataStream;
+	readSchemas_.clear();
+	readTypes_.clear();
+}
+
+const ReflectionSerializer::SerializationPlan& ReflectionSerializer::getPlan(const IClassDefinition& classDef)
+{
+	auto& plan = plans_[&classDef];
+	if (plan != nullptr && isCurrent(classDef, *plan))
+	{
+		return *plan;
+	}
+
+	plan.reset(new SerializationPlan());
+	plan->version_ = nextPlanVersion_++;
+	const bool modifiable = classDef.getDetails().getDefinitionModifier() != nullptr;
+	const PropertyIteratorRange& props = classDef.allProperties();
+	for (PropertyIterator pi = props.begin(), end = props.end(); pi != end; ++pi)
+	{
+		auto property = pi.get();
+		if (modifiable)
+		{
+			plan->definitionProperties_.push_back(property);
+		}
+		if (property->isMethod())
+		{
+			continue;
+		}
+		auto metaData = findFirstMetaData<MetaNoSerializationObj>(*property, defManager_);
+		if (metaData != nullptr)
+		{
+			continue;
+		}
+		plan->properties_.push_back(property);
+	}
+	return *plan;
+}
+
+bool ReflectionSerializer::isCurrent(const IClassDefinition& classDef, const SerializationPlan& plan) const
+{
+	if (classDef.getDetails().getDefinitionModifier() == nullptr)
+	{
+		return true;
+	}
+
+	// Properties added to or removed from the definition since the plan was built
+	auto planIt = plan.definitionProperties_.begin();
+	auto planEnd = plan.definitionProperties_.end();
+	const PropertyIteratorRange& props = classDef.allProperties();
+	for (PropertyIterator pi = props.begin(), end = props.end(); pi != end; ++pi, ++planIt)
+	{
+		if (planIt == planEnd || *planIt != pi.get())
+		{
+			return false;
+		}
+	}
+	return planIt == planEnd;
+}
+
 bool ReflectionSerializer::write(IDataStream* dataStream, const Variant& variant)
 {
-	TypeId type(variant.type()->name());
 	curDataStream_ = dataStream;
 	if (!curDataStream_)
 	{
 		return false;
 	}
 
+	if (depth_ == 0)
+	{
+		beginWrite(*curDataStream_);
+	}
+	++depth_;
+	bool result = writeObject(variant);
+	--depth_;
+	return result;
+}
+
+bool ReflectionSerializer::writeObject(const Variant& variant)
+{
 	if (variant.canCast<ObjectHandle>())
 	{
 		ObjectHandle provider;
@@ -58,9 +169,8 @@ bool ReflectionSerializer::write(IDataStream* dataStream, const Variant& variant
 			}
 			curDataStream_->write(classDef->getName());
 			std::string stringId = "";
-			RefObjectId id;
-			isOk = provider.getId(id);
-			if (isOk)
+			RefObjectId id = provider.id();
+			if (id != RefObjectId::zero())
 			{
 				stringId = id.toString();
 			}
@@ -86,43 +196,61 @@ void ReflectionSerializer::writeProperties(const ObjectHandle& provider)
 {
 	const auto classDef = defManager_.getDefinition(provider);
 	assert(classDef);
-	const PropertyIteratorRange& props = classDef->allProperties();
-	std::vector<PropertyAccessor> pas;
-	for (PropertyIterator pi = props.begin(), end = props.end(); pi != end; ++pi)
+	const auto& plan = getPlan(*classDef);
+	writeSchema(*classDef, plan);
+
+	for (auto& property : plan.properties_)
 	{
-		if (pi->isMethod())
-		{
-			continue;
-		}
-		PropertyAccessor pa = classDef->bindProperty(pi->getName(), provider);
-		assert(pa.isValid());
-		auto metaData = findFirstMetaData<MetaNoSerializationObj>(pa, defManager_);
-		if (metaData != nullptr)
+		Variant value = property->get(provider, defManager_);
+		writeValueType(value);
+		if (!value.isVoid())
 		{
-			continue;
+			writePropertyValue(value);
 		}
-		pas.push_back(pa);
 	}
-	size_t count = pas.size();
+}
+
+void ReflectionSerializer::writeSchema(const IClassDefinition& classDef, const SerializationPlan& plan)
+{
+	// Each class writes its property names once, later objects only write the schema index.
+	// A plan rebuilt after its definition changed writes a new schema.
+	auto found = writtenSchemas_.find(&classDef);
+	if (found != writtenSchemas_.end() && found->second.second == plan.version_)
+	{
+		curDataStream_->write(found->second.first);
+		curDataStream_->write(false);
+		return;
+	}
+
+	size_t index = found != writtenSchemas_.end() ? found->second.first : writtenSchemas_.size();
+	writtenSchemas_[&classDef] = std::make_pair(index, plan.version_);
+	curDataStream_->write(index);
+	curDataStream_->write(true);
+
+	size_t count = plan.properties_.size();
 	curDataStream_->write(count);
-	for (auto& pa : pas)
+	for (auto& property : plan.properties_)
 	{
-		writeProperty(pa);
+		curDataStream_->write(std::string(property->getName()));
 	}
 }
 
-void ReflectionSerializer::writeProperty(const PropertyAccessor& property)
+void ReflectionSerializer::writeValueType(const Variant& value)
 {
-	assert(property.isValid());
-	const auto& propPath = property.getFullPath();
-	curDataStream_->write(propPath);
-
-	Variant value = property.getValue();
-	curDataStream_->write(value.type()->name());
-	if (!value.isVoid())
+	auto metaType = value.type();
+	auto found = writtenTypes_.find(metaType);
+	if (found != writtenTypes_.end())
 	{
-		writePropertyValue(value);
+		curDataStream_->write(found->second);
+		curDataStream_->write(false);
+		return;
 	}
+
+	size_t index = writtenTypes_.size();
+	writtenTypes_[metaType] = index;
+	curDataStream_->write(index);
+	curDataStream_->write(true);
+	curDataStream_->write(metaType->name());
 }
 
 void ReflectionSerializer::writeCollection(const Collection& collection)
@@ -140,7 +268,7 @@ void ReflectionSerializer::writeCollection(const Collection& collection)
 
 		Collection subCollection;
 		auto value = it.value();
-		curDataStream_->write(value.type()->name());
+		writeValueType(value);
 		writePropertyValue(value);
 	}
 }
@@ -164,16 +292,13 @@ void ReflectionSerializer::writePropertyValue(const Variant& value)
 			assert(isOk);
 			if (provider.isValid())
 			{
-				RefObjectId id;
-				hasId = provider.getId(id);
+				// Objects of their own are linked by id, objects within another are written in full
+				RefObjectId id = provider.id();
+				hasId = id != RefObjectId::zero() && provider.path().empty();
 				if (hasId)
 				{
 					curDataStream_->write(id.toString());
 				}
-				else
-				{
-					hasId = false;
-				}
 			}
 			else
 			{
@@ -196,6 +321,18 @@ bool ReflectionSerializer::read(IDataStream* dataStream, Variant& variant)
 		return false;
 	}
 
+	if (depth_ == 0)
+	{
+		beginRead(*curDataStream_);
+	}
+	++depth_;
+	bool result = readObject(variant);
+	--depth_;
+	return result;
+}
+
+bool ReflectionSerializer::readObject(Variant& variant)
+{
 	ObjectHandle provider;
 	if (!variant.tryCast(provider))
 	{
@@ -204,62 +341,178 @@ bool ReflectionSerializer::read(IDataStream* dataStream, Variant& variant)
 	}
 	std::string classDefName;
 	curDataStream_->read(classDefName);
-	if (!classDefName.empty())
+	if (classDefName.empty())
 	{
-		std::string id;
-		curDataStream_->read(id);
-		if (id.empty())
+		return true;
+	}
+
+	std::string id;
+	curDataStream_->read(id);
+	if (provider.isValid())
+	{
+		readProperties(provider);
+		return true;
+	}
+
+	auto definition = defManager_.getDefinition(classDefName.c_str());
+	if (definition == nullptr)
+	{
+		// Step over the properties of an object that can not be created
+		skipProperties();
+		return false;
+	}
+
+	auto object = definition->createShared(id.empty() ? RefObjectId::zero() : RefObjectId(id));
+	readProperties(object);
+	variant = object;
+	return true;
+}
+
+void ReflectionSerializer::readProperties(const ObjectHandle& provider)
+{
+	assert(provider.isValid());
+	const auto classDef = defManager_.getDefinition(provider);
+	assert(classDef);
+	auto schema = readSchema(classDef);
+	if (schema == nullptr)
+	{
+		assert(false);
+		return;
+	}
+
+	for (auto& property : schema->properties_)
+	{
+		auto metaType = readValueType();
+		if (metaType == nullptr)
 		{
-			if (provider.isValid())
-			{
-				readProperties(provider);
-			}
-			else
+			assert(false);
+			return;
+		}
+		if (property == nullptr)
+		{
+			// The property no longer exists, its value is still in the stream
+			if (!skipValue(metaType))
 			{
-				auto polyStruct = objManager_.createObject(classDefName);
-				readProperties(polyStruct);
-				variant = polyStruct;
+				assert(false);
+				return;
 			}
+			continue;
 		}
-		else
+		readProperty(provider, *classDef, property, metaType);
+	}
+}
+
+const ReflectionSerializer::ReadSchema* ReflectionSerializer::readSchema(const IClassDefinition* classDef)
+{
+	size_t index = 0;
+	bool defined = false;
+	curDataStream_->read(index);
+	curDataStream_->read(defined);
+	if (defined)
+	{
+		// First object of this class, or of a new version of it, read the property names
+		if (index >= readSchemas_.size())
+		{
+			readSchemas_.resize(index + 1);
+		}
+		auto& schema = readSchemas_[index];
+		schema.definition_ = nullptr;
+		schema.names_.clear();
+		size_t count = 0;
+		curDataStream_->read(count);
+		std::string propName;
+		for (size_t i = 0; i < count; ++i)
 		{
-			auto object = objManager_.createObject(RefObjectId(id.c_str()), classDefName.c_str());
-			readProperties(object);
-			variant = object;
+			propName.clear();
+			curDataStream_->read(propName);
+			schema.names_.push_back(propName);
 		}
 	}
-	return true;
+	else if (index >= readSchemas_.size())
+	{
+		return nullptr;
+	}
+
+	// Bind the property names to the reading definition once, names it does not have stay unbound
+	auto schema = &readSchemas_[index];
+	if (classDef != nullptr && schema->definition_ != classDef)
+	{
+		schema->definition_ = classDef;
+		schema->properties_.clear();
+		for (auto& name : schema->names_)
+		{
+			schema->properties_.push_back(classDef->findProperty(name.c_str()));
+		}
+	}
+	return schema;
 }
 
-void ReflectionSerializer::readProperties(const ObjectHandle& provider)
+const MetaType* ReflectionSerializer::readValueType()
 {
-	assert(provider.isValid());
-	size_t count = 0;
-	curDataStream_->read(count);
-	for (size_t i = 0; i < count; i++)
+	size_t index = 0;
+	bool defined = false;
+	curDataStream_->read(index);
+	curDataStream_->read(defined);
+	if (!defined)
 	{
-		readProperty(provider);
+		return index < readTypes_.size() ? readTypes_[index] : nullptr;
 	}
+
+	std::string valueType;
+	curDataStream_->read(valueType);
+	if (index >= readTypes_.size())
+	{
+		readTypes_.resize(index + 1, nullptr);
+	}
+	readTypes_[index] = MetaType::find(valueType.c_str());
+	return readTypes_[index];
 }
 
-void ReflectionSerializer::readProperty(const ObjectHandle& provider)
+void ReflectionSerializer::readProperty(const ObjectHandle& provider, const IClassDefinition& classDef,
+                                        const IBasePropertyPtr& property, const MetaType* metaType)
 {
 	assert(provider.isValid());
-	std::string propName;
-	curDataStream_->read(propName);
-
-	PropertyAccessor prop = defManager_.getDefinition(provider)->bindProperty(propName.c_str(), provider);
-	assert(prop.isValid());
+	if (Variant(metaType).isVoid())
+	{
+		return;
+	}
 
-	std::string valueType;
-	curDataStream_->read(valueType);
-	const MetaType* metaType = MetaType::find(valueType.c_str());
-	if (metaType == nullptr)
+	Variant value = property->get(provider, defManager_);
+	if (value.typeIs<Collection>())
 	{
-		assert(false);
+		PropertyAccessor prop = classDef.bindProperty(property->getName(), provider);
+		assert(prop.isValid());
+		readCollection(prop);
 		return;
 	}
-	readPropertyValue(valueType.c_str(), prop);
+
+	std::string id;
+	curDataStream_->read(id);
+	if (!id.empty())
+	{
+		auto obj = objManager_.getObject(RefObjectId(id));
+		if (obj == nullptr)
+		{
+			objManager_.addObjectLinks(id, property, provider);
+		}
+		else if (!property->readOnly(provider))
+		{
+			property->set(provider, obj, defManager_);
+		}
+	}
+	else if (isStruct(*property, value, defManager_))
+	{
+		read(curDataStream_, value);
+	}
+	else
+	{
+		Variant variant(metaType);
+		serializationManager_.deserialize(*curDataStream_, variant);
+		if (!property->readOnly(provider))
+		{
+			property->set(provider, variant, defManager_);
+		}
+	}
 }
 
 void ReflectionSerializer::readCollection(const PropertyAccessor& prop)
@@ -279,7 +532,6 @@ void ReflectionSerializer::readCollection(const PropertyAccessor& prop)
 
 	std::string strIndex;
 	std::string propName;
-	std::string valueType;
 	for (size_t i = 0; i < count; i++)
 	{
 		strIndex.clear();
@@ -295,26 +547,18 @@ void ReflectionSerializer::readCollection(const PropertyAccessor& prop)
 		// TODO: Allow iteration to next element in collection.
 		PropertyAccessor pa = defManager_.getDefinition(baseProvider)->bindProperty(propName.c_str(), baseProvider);
 		assert(pa.isValid());
-		valueType.clear();
-		curDataStream_->read(valueType);
-		const MetaType* metaType = MetaType::find(valueType.c_str());
+		const MetaType* metaType = readValueType();
 		if (metaType == nullptr)
 		{
 			assert(false);
 			return;
 		}
-		readPropertyValue(valueType.c_str(), pa);
+		readPropertyValue(metaType, pa);
 	}
 }
 
-void ReflectionSerializer::readPropertyValue(const char* valueType, PropertyAccessor& pa)
+void ReflectionSerializer::readPropertyValue(const MetaType* metaType, PropertyAccessor& pa)
 {
-	const MetaType* metaType = MetaType::find(valueType);
-	if (metaType == nullptr)
-	{
-		assert(false);
-		return;
-	}
 	Variant value = pa.getValue();
 
 	if (value.typeIs<Collection>())
@@ -324,33 +568,104 @@ void ReflectionSerializer::readPropertyValue(const char* valueType, PropertyAcce
 	}
 	std::string id;
 	curDataStream_->read(id);
-	if (ReflectionUtilities::isStruct(pa))
+	if (!id.empty())
+	{
+		auto obj = objManager_.getObject(RefObjectId(id));
+		if (obj == nullptr)
+		{
+			objManager_.addObjectLinks(id, pa.getProperty(), pa.getRootObject());
+		}
+		else
+		{
+			pa.setValueWithoutNotification(obj);
+		}
+	}
+	else if (ReflectionUtilities::isStruct(pa))
 	{
 		read(curDataStream_, value);
 	}
 	else
 	{
-		if (!id.empty())
+		Variant variant(metaType);
+		if (!variant.isVoid())
 		{
-			auto obj = objManager_.getObject(id);
-			if (obj == nullptr)
-			{
-				objManager_.addObjectLinks(id, pa.getProperty(), pa.getRootObject());
-			}
-			else
-			{
-				pa.setValueWithoutNotification(obj);
-			}
+			serializationManager_.deserialize(*curDataStream_, variant);
+			pa.setValueWithoutNotification(variant);
 		}
-		else
+	}
+}
+
+bool ReflectionSerializer::skipValue(const MetaType* metaType)
+{
+	if (metaType == nullptr)
+	{
+		return false;
+	}
+
+	Variant value(metaType);
+	if (value.isVoid())
+	{
+		return true;
+	}
+
+	if (value.typeIs<Collection>())
+	{
+		size_t count = 0;
+		curDataStream_->read(count);
+		std::string strIndex;
+		for (size_t i = 0; i < count; ++i)
 		{
-			Variant variant(metaType);
-			if (!variant.isVoid())
+			strIndex.clear();
+			curDataStream_->read(strIndex);
+			if (!skipValue(readValueType()))
 			{
-				serializationManager_.deserialize(*curDataStream_, variant);
-				pa.setValueWithoutNotification(variant);
+				return false;
 			}
 		}
+		return true;
+	}
+
+	std::string id;
+	curDataStream_->read(id);
+	if (!id.empty())
+	{
+		return true;
+	}
+	if (value.typeIs<ObjectHandle>())
+	{
+		return skipObject();
+	}
+	return serializationManager_.deserialize(*curDataStream_, value);
+}
+
+bool ReflectionSerializer::skipObject()
+{
+	std::string classDefName;
+	curDataStream_->read(classDefName);
+	if (classDefName.empty())
+	{
+		return true;
 	}
+
+	std::string id;
+	curDataStream_->read(id);
+	return skipProperties();
+}
+
+bool ReflectionSerializer::skipProperties()
+{
+	auto schema = readSchema(nullptr);
+	if (schema == nullptr)
+	{
+		return false;
+	}
+	for (size_t i = 0; i < schema->names_.size(); ++i)
+	{
+		if (!skipValue(readValueType()))
+		{
+			return false;
+		}
+	}
+	return true;
 }
 } // end namespace wgt
@@ -6,6 +6,11 @@
 #include "core_reflection/property_accessor.hpp"
 #include "core_serialization/serializer/i_serializer.hpp"
 
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 namespace wgt
 {
 class ObjectHandle;
@@ -13,6 +18,8 @@ class IObjectManager;
 
 /**
  * reflected object Serializer
+ * Class schemas and value type names are written once per stream, writing
+ * at the start of a stream or to another stream begins a new set.
  */
 class ReflectionSerializer : public ISerializer
 {
@@ -24,18 +31,54 @@ public:
 	std::vector<TypeId> getSupportedType();
 
 private:
+	/**
+	* The serializable properties of a class, built once per definition.
+	* Properties are written in plan order, with the property names written
+	* once per class in a schema and referenced by index afterwards.
+	* Definitions that can be modified keep the properties the plan was built
+	* from, the plan is rebuilt when they no longer match.
+	*/
+	struct SerializationPlan
+	{
+		size_t version_;
+		std::vector<IBasePropertyPtr> properties_;
+		std::vector<IBasePropertyPtr> definitionProperties_;
+	};
+
+	/** A class schema read from the stream, bound to the reading definition. */
+	struct ReadSchema
+	{
+		const IClassDefinition* definition_;
+		std::vector<std::string> names_;
+		std::vector<IBasePropertyPtr> properties_;
+	};
+
 	bool write(IDataStream* dataStream, const Variant& variant) override;
 	bool read(IDataStream* dataStream, Variant& variant) override;
+	bool writeObject(const Variant& variant);
+	bool readObject(Variant& variant);
+
+	const SerializationPlan& getPlan(const IClassDefinition& classDef);
+	bool isCurrent(const IClassDefinition& classDef, const SerializationPlan& plan) const;
+	void beginWrite(IDataStream& dataStream);
+	void beginRead(IDataStream& dataStream);
 
 	void writeProperties(const ObjectHandle& provider);
-	void writeProperty(const PropertyAccessor& property);
+	void writeSchema(const IClassDefinition& classDef, const SerializationPlan& plan);
+	void writeValueType(const Variant& value);
 	void writePropertyValue(const Variant& value);
 	void writeCollection(const Collection& collection);
 
 	void readProperties(const ObjectHandle& provider);
-	void readProperty(const ObjectHandle& provider);
-	void readPropertyValue(const char* valueType, PropertyAccessor& pa);
+	const ReadSchema* readSchema(const IClassDefinition* classDef);
+	const MetaType* readValueType();
+	void readProperty(const ObjectHandle& provider, const IClassDefinition& classDef, const IBasePropertyPtr& property,
+	                  const MetaType* metaType);
+	void readPropertyValue(const MetaType* metaType, PropertyAccessor& pa);
 	void readCollection(const PropertyAccessor& prop);
+	bool skipValue(const MetaType* metaType);
+	bool skipObject();
+	bool skipProperties();
 
 	ISerializationManager& serializationManager_;
 	IObjectManager& objManager_;
@@ -44,6 +87,20 @@ private:
 	typedef std::vector<std::pair<PropertyAccessor, RefObjectId>> ObjLinks;
 	std::vector<TypeId> typeList;
 	ObjLinks objLinks_;
+
+	std::unordered_map<const IClassDefinition*, std::unique_ptr<SerializationPlan>> plans_;
+	size_t nextPlanVersion_;
+
+	// Schemas and value type names written to or read from the current streams,
+	// each is written in full on first use and referred to by index afterwards.
+	// Written schemas keep the index and the version of the plan they were written from.
+	int depth_;
+	IDataStream* writeStream_;
+	IDataStream* readStream_;
+	std::unordered_map<const IClassDefinition*, std::pair<size_t, size_t>> writtenSchemas_;
+	std::unordered_map<const MetaType*, size_t> writtenTypes_;
+	std::deque<ReadSchema> readSchemas_;
+	std::vector<const MetaType*> readTypes_;
 };
 } // end namespace wgt
 #endif // REFLECTION_SERIALIZER_HPP
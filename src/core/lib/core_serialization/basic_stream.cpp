@@ -12,7 +12,8 @@ namespace wgt
 BasicStream::BasicStream(IDataStream& dataStream)
     : dataStream_(dataStream), state_(std::ios_base::goodbit),
       // readBuffer_(),
-      readPos_(readBuffer_), readEnd_(readBuffer_), ungetBufferSize_(1)
+      ownBuffer_(), buffer_(readBuffer_), bufferSize_(sizeof(readBuffer_)), readPos_(readBuffer_),
+      readEnd_(readBuffer_), writePos_(readBuffer_), writeEnd_(readBuffer_), ungetBufferSize_(1)
 {
 }
 
@@ -33,6 +34,11 @@ void BasicStream::resetState(std::ios_base::iostate state)
 
 std::streamoff BasicStream::seek(std::streamoff offset, std::ios_base::seekdir dir)
 {
+	if (!flush())
+	{
+		return -1;
+	}
+
 	std::streamoff o = offset;
 	if (dir == std::ios_base::cur)
 	{
@@ -43,9 +49,11 @@ std::streamoff BasicStream::seek(std::streamoff offset, std::ios_base::seekdir d
 	auto r = dataStream_.seek(o, dir);
 	if (r >= 0)
 	{
-		// reset read buffer
-		readPos_ = readBuffer_;
-		readEnd_ = readBuffer_;
+		// reset read and write buffers
+		readPos_ = buffer_;
+		readEnd_ = buffer_;
+		writePos_ = buffer_;
+		writeEnd_ = buffer_;
 	}
 
 	return r;
@@ -53,13 +61,64 @@ std::streamoff BasicStream::seek(std::streamoff offset, std::ios_base::seekdir d
 
 bool BasicStream::sync()
 {
+	bool flushed = flush();
 	resetReadBuffer();
-	return dataStream_.sync();
+	return dataStream_.sync() && flushed;
+}
+
+std::streamsize BasicStream::setBufferSize(std::streamsize v)
+{
+	flush();
+	resetReadBuffer();
+
+	if (v > static_cast<std::streamsize>(sizeof(readBuffer_)))
+	{
+		if (v != bufferSize_)
+		{
+			ownBuffer_.reset(new char[static_cast<size_t>(v)]);
+		}
+		buffer_ = ownBuffer_.get();
+		bufferSize_ = v;
+	}
+	else
+	{
+		ownBuffer_.reset();
+		buffer_ = readBuffer_;
+		bufferSize_ = sizeof(readBuffer_);
+	}
+
+	readPos_ = buffer_;
+	readEnd_ = buffer_;
+	writePos_ = buffer_;
+	writeEnd_ = buffer_;
+	ungetBufferSize_ = std::min(ungetBufferSize_, bufferSize_);
+	return bufferSize_;
+}
+
+bool BasicStream::flush()
+{
+	const char* pos = buffer_;
+	while (pos < writePos_)
+	{
+		auto r = dataStream_.write(pos, writePos_ - pos);
+		if (r <= 0)
+		{
+			// drop what could not be written
+			setState(std::ios_base::badbit);
+			writePos_ = buffer_;
+			return false;
+		}
+
+		pos += r;
+	}
+
+	writePos_ = buffer_;
+	return true;
 }
 
 std::streamsize BasicStream::setUngetBufferSize(std::streamsize v)
 {
-	ungetBufferSize_ = std::min<std::streamsize>(std::max<std::streamsize>(v, 0), sizeof(readBuffer_));
+	ungetBufferSize_ = std::min<std::streamsize>(std::max<std::streamsize>(v, 0), bufferSize_);
 	return ungetBufferSize_;
 }
 
@@ -82,7 +141,7 @@ int BasicStream::get()
 
 bool BasicStream::unget(std::streamsize size, const void* source)
 {
-	if (size < 0 || size > readPos_ - readBuffer_)
+	if (size < 0 || size > readPos_ - buffer_)
 	{
 		// unget area doesn't contain requested amount of data
 		setState(std::ios_base::badbit);
@@ -120,13 +179,23 @@ int BasicStream::peek()
 	return r;
 }
 
-std::streamsize BasicStream::read(void* destination, std::streamsize size)
+std::streamsize BasicStream::readFromStream(void* destination, std::streamsize size)
 {
 	if (size <= 0)
 	{
 		return 0;
 	}
 
+	if (writePos_ != buffer_ || writeEnd_ != buffer_)
+	{
+		// switch the buffer from writing to reading
+		if (!flush())
+		{
+			return 0;
+		}
+		writeEnd_ = buffer_;
+	}
+
 	// try read from buffer
 	auto copyFromBuffer = std::min<std::streamsize>(size, readEnd_ - readPos_);
 	if (copyFromBuffer > 0)
@@ -140,15 +209,15 @@ std::streamsize BasicStream::read(void* destination, std::streamsize size)
 	TF_ASSERT(readPos_ == readEnd_);
 
 	// is unget area larger than needed?
-	if (readPos_ - readBuffer_ > ungetBufferSize_)
+	if (readPos_ - buffer_ > ungetBufferSize_)
 	{
 		// free some buffer space for reading
-		std::memmove(readBuffer_, readPos_ - ungetBufferSize_, static_cast<size_t>(ungetBufferSize_));
-		readPos_ = readBuffer_ + ungetBufferSize_;
+		std::memmove(buffer_, readPos_ - ungetBufferSize_, static_cast<size_t>(ungetBufferSize_));
+		readPos_ = buffer_ + ungetBufferSize_;
 		readEnd_ = readPos_;
 	}
 
-	const std::streamsize freeBufferSize = readBuffer_ + sizeof(readBuffer_) - readEnd_;
+	const std::streamsize freeBufferSize = buffer_ + bufferSize_ - readEnd_;
 	if (freeBufferSize > size)
 	{
 		// free buffer is larger that requested size, so read to buffer
@@ -178,19 +247,19 @@ std::streamsize BasicStream::read(void* destination, std::streamsize size)
 		}
 
 		// copy read data tail to read buffer
-		const auto toBuffer = std::min<std::streamsize>(r, sizeof(readBuffer_));
+		const auto toBuffer = std::min<std::streamsize>(r, bufferSize_);
 		char* buf = readEnd_;
 
 		if (toBuffer > freeBufferSize)
 		{
 			// replace (partially or completely) current unget area
-			std::streamsize ungetBytesToKeep = sizeof(readBuffer_) - toBuffer;
+			std::streamsize ungetBytesToKeep = bufferSize_ - toBuffer;
 			if (ungetBytesToKeep > 0)
 			{
 				// shift current unget area
-				std::memmove(readBuffer_, readEnd_ - ungetBytesToKeep, static_cast<size_t>(ungetBytesToKeep));
+				std::memmove(buffer_, readEnd_ - ungetBytesToKeep, static_cast<size_t>(ungetBytesToKeep));
 			}
-			buf = readBuffer_ + ungetBytesToKeep;
+			buf = buffer_ + ungetBytesToKeep;
 		}
 
 		std::memcpy(buf, static_cast<char*>(destination) + r - toBuffer, static_cast<size_t>(toBuffer));
@@ -208,11 +277,26 @@ bool BasicStream::put(char c)
 	return r > 0;
 }
 
-std::streamsize BasicStream::write(const void* source, std::streamsize size)
+std::streamsize BasicStream::writeToStream(const void* source, std::streamsize size)
 {
 	resetReadBuffer();
 
-	// TODO: buffered write
+	if (ownBuffer_ != nullptr)
+	{
+		// the buffer is full, or holds read data which was just dropped
+		if (!flush())
+		{
+			return 0;
+		}
+
+		writeEnd_ = buffer_ + bufferSize_;
+		if (size > 0 && size < bufferSize_)
+		{
+			std::memcpy(writePos_, source, static_cast<size_t>(size));
+			writePos_ += size;
+			return size;
+		}
+	}
 
 	std::streamsize r = dataStream_.write(source, size);
 	if (r <= 0)
@@ -223,7 +307,7 @@ std::streamsize BasicStream::write(const void* source, std::streamsize size)
 	return r;
 }
 
-std::streamsize BasicStream::readHard(void* destination, std::streamsize size)
+std::streamsize BasicStream::readHardFromStream(void* destination, std::streamsize size)
 {
 	std::streamsize total = 0;
 
@@ -241,7 +325,7 @@ std::streamsize BasicStream::readHard(void* destination, std::streamsize size)
 	return total;
 }
 
-std::streamsize BasicStream::writeHard(const void* source, std::streamsize size)
+std::streamsize BasicStream::writeHardToStream(const void* source, std::streamsize size)
 {
 	std::streamsize total = 0;
 
@@ -1,7 +1,9 @@
 #ifndef BASIC_STREAM_HPP_INCLUDED
 #define BASIC_STREAM_HPP_INCLUDED
 
+#include <cstring>
 #include <ios>
+#include <memory>
 
 //#include "i_datastream.hpp" // break cyclic include: i_datastream.hpp -> variant.hpp -> text_stream.hpp ->
 // basic_stream.hpp -> i_datastream.hpp
@@ -13,6 +15,11 @@ class IDataStream;
 
 /**
 Basic IDataStream wrapper for more convenient IO.
+
+Reads go through a small read-ahead buffer. Writes go straight to the data
+stream unless a larger buffer is set with setBufferSize(), in which case both
+reads and writes that fit in the buffer are plain memory copies, and the data
+stream only sees writes when the buffer fills up, on seek() and on sync().
 */
 class SERIALIZATION_DLL BasicStream
 {
@@ -29,6 +36,8 @@ public:
 
 	/**
 	Get underlying data stream used for actual IO.
+
+	If writes are buffered, sync() before using the data stream directly.
 	*/
 	IDataStream& dataStream() const
 	{
@@ -98,6 +107,30 @@ public:
 	*/
 	bool sync();
 
+	/**
+	Current buffer size.
+	*/
+	std::streamsize bufferSize() const
+	{
+		return bufferSize_;
+	}
+
+	/**
+	Set buffer size.
+
+	Sizes larger than the default read-ahead buffer also enable buffered
+	writes. Smaller sizes restore the default buffer and unbuffered writes.
+	Buffered data is flushed or discarded as by sync() first.
+
+	@return actual value to be used.
+	*/
+	std::streamsize setBufferSize(std::streamsize v);
+
+	/**
+	Write buffered data to the data stream.
+	*/
+	bool flush();
+
 	/**
 	Current unget buffer size.
 	*/
@@ -156,7 +189,17 @@ public:
 	/**
 	Wrapper for IDataStream::read().
 	*/
-	std::streamsize read(void* destination, std::streamsize size);
+	std::streamsize read(void* destination, std::streamsize size)
+	{
+		if (size > 0 && size <= readEnd_ - readPos_)
+		{
+			std::memcpy(destination, readPos_, static_cast<size_t>(size));
+			readPos_ += size;
+			return size;
+		}
+
+		return readFromStream(destination, size);
+	}
 
 	/**
 	Write single character.
@@ -166,7 +209,17 @@ public:
 	/**
 	Wrapper for IDataStream::write().
 	*/
-	std::streamsize write(const void* source, std::streamsize size);
+	std::streamsize write(const void* source, std::streamsize size)
+	{
+		if (size > 0 && size <= writeEnd_ - writePos_)
+		{
+			std::memcpy(writePos_, source, static_cast<size_t>(size));
+			writePos_ += size;
+			return size;
+		}
+
+		return writeToStream(source, size);
+	}
 
 	/**
 	Read stream until destination buffer is filled or error occurred.
@@ -177,7 +230,17 @@ public:
 	Regular read() function may read less than requested, so use this function
 	if you want to read as much as possible.
 	*/
-	std::streamsize readHard(void* destination, std::streamsize size);
+	std::streamsize readHard(void* destination, std::streamsize size)
+	{
+		if (size > 0 && size <= readEnd_ - readPos_)
+		{
+			std::memcpy(destination, readPos_, static_cast<size_t>(size));
+			readPos_ += size;
+			return size;
+		}
+
+		return readHardFromStream(destination, size);
+	}
 
 	/**
 	Write stream until source buffer is sent or error occurred.
@@ -188,7 +251,17 @@ public:
 	Regular write() function may write less than requested, so use this function
 	if you want to write as much as possible.
 	*/
-	std::streamsize writeHard(const void* source, std::streamsize size);
+	std::streamsize writeHard(const void* source, std::streamsize size)
+	{
+		if (size > 0 && size <= writeEnd_ - writePos_)
+		{
+			std::memcpy(writePos_, source, static_cast<size_t>(size));
+			writePos_ += size;
+			return size;
+		}
+
+		return writeHardToStream(source, size);
+	}
 
 	/**
 	Copy data from @a source stream to this one.
@@ -226,11 +299,24 @@ private:
 	std::ios_base::iostate state_;
 
 	char readBuffer_[16];
-	char* readPos_; // is allowed to get below (readBuffer_ + ungetBufferSize_) only in unget()
+	std::unique_ptr<char[]> ownBuffer_;
+	char* buffer_; // either readBuffer_ or ownBuffer_
+	std::streamsize bufferSize_;
+
+	// Reading and writing never use the buffer at the same time, so at least
+	// one of these ranges is always empty. Buffered writes are [buffer_, writePos_).
+	char* readPos_; // is allowed to get below (buffer_ + ungetBufferSize_) only in unget()
 	char* readEnd_;
+	char* writePos_;
+	char* writeEnd_;
 	std::streamsize ungetBufferSize_;
 
 	bool resetReadBuffer();
+
+	std::streamsize readFromStream(void* destination, std::streamsize size);
+	std::streamsize writeToStream(const void* source, std::streamsize size);
+	std::streamsize readHardFromStream(void* destination, std::streamsize size);
+	std::streamsize writeHardToStream(const void* source, std::streamsize size);
 };
 } // end namespace wgt
 #endif // BASIC_STREAM_HPP_INCLUDED
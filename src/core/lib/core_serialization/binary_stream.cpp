@@ -23,16 +23,79 @@ void BinaryStream::serializeBuffer(const void* buffer, std::streamsize size)
 		return;
 	}
 
-	(*this) << s;
+	if (compact_)
+	{
+		serializeVarint(s);
+	}
+	else
+	{
+		(*this) << s;
+	}
 
 	FixedMemoryStream src(buffer, size);
 	copyFrom(src);
 }
 
+void BinaryStream::serializeVarint(uint64_t value)
+{
+	char buffer[10];
+	std::streamsize size = 0;
+	while (value >= 0x80)
+	{
+		buffer[size++] = static_cast<char>(value | 0x80);
+		value >>= 7;
+	}
+	buffer[size++] = static_cast<char>(value);
+
+	if (writeHard(buffer, size) != size)
+	{
+		setState(std::ios_base::failbit);
+	}
+}
+
+void BinaryStream::deserializeVarint(uint64_t& value)
+{
+	uint64_t result = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7)
+	{
+		char c;
+		if (read(&c, 1) != 1)
+		{
+			setState(std::ios_base::failbit);
+			return;
+		}
+
+		auto byte = static_cast<uint64_t>(static_cast<unsigned char>(c));
+		if (shift == 63 && byte > 1)
+		{
+			// overflow
+			setState(std::ios_base::failbit);
+			return;
+		}
+
+		result |= (byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			value = result;
+			return;
+		}
+	}
+
+	setState(std::ios_base::failbit);
+}
+
 void BinaryStream::deserializeBuffer(IDataStream& destination, std::streamsize maximumSize)
 {
 	size_type size = 0;
-	(*this) >> size;
+	if (compact_)
+	{
+		deserializeVarint(size);
+	}
+	else
+	{
+		(*this) >> size;
+	}
+
 	if (fail())
 	{
 		return;
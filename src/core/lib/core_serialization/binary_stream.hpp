@@ -17,10 +17,42 @@ public:
 	// common platform-independent types
 	typedef uint64_t size_type;
 
-	explicit BinaryStream(IDataStream& stream) : base(stream)
+	explicit BinaryStream(IDataStream& stream) : base(stream), compact_(false)
 	{
 	}
 
+	bool compact() const
+	{
+		return compact_;
+	}
+
+	/**
+	Enable compact encoding.
+
+	Compact streams write buffer and string sizes as varints (see
+	serializeVarint()) rather than 64-bit integers. Streams must be read with
+	the same setting they were written with.
+	*/
+	void setCompact(bool compact)
+	{
+		compact_ = compact;
+	}
+
+	/**
+	Serialize unsigned integer as LEB128 varint.
+
+	Values are written 7 bits per byte, lowest bits first, so values below 128
+	take a single byte. Use it for ids, counts and sizes which are usually small.
+	*/
+	void serializeVarint(uint64_t value);
+
+	/**
+	Deserialize LEB128 varint.
+
+	Sets failbit if the stream ends inside the varint or it doesn't fit 64 bits.
+	*/
+	void deserializeVarint(uint64_t& value);
+
 	/**
 	Serialize given buffer.
 
@@ -42,6 +74,9 @@ public:
 	size) only on trusted data sources.
 	*/
 	void deserializeBuffer(IDataStream& destination, std::streamsize maximumSize = -1);
+
+private:
+	bool compact_;
 };
 
 // generic simple types serialization
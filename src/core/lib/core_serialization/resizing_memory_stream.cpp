@@ -98,14 +98,24 @@ std::streamsize ResizingMemoryStream::read(void* destination, std::streamsize si
 
 std::streamsize ResizingMemoryStream::write(const void* source, std::streamsize size)
 {
+	if (size <= 0)
+	{
+		return 0;
+	}
+
 	std::streamsize newPos = pos_ + size;
 	if (newPos > static_cast<std::streamoff>(buffer_.size()))
 	{
-		buffer_.resize(static_cast<size_t>(newPos));
+		// grow geometrically, so that many small writes copy the buffer only a few times
+		const auto newSize = static_cast<size_t>(newPos);
+		if (newSize > buffer_.capacity())
+		{
+			buffer_.reserve(std::max(newSize, buffer_.capacity() * 2));
+		}
+		buffer_.resize(newSize);
 	}
 
-	auto src = static_cast<const char*>(source);
-	std::copy(src, src + size, buffer_.begin() + static_cast<size_t>(pos_));
+	std::memcpy(&buffer_[static_cast<size_t>(pos_)], source, static_cast<size_t>(size));
 	pos_ = newPos;
 
 	return size;
@@ -36,4 +36,19 @@ bool ISerializer::deserialize(IManagedObject& object)
 {
 	return false;
 }
+
+bool ISerializer::deserialize(std::vector<Variant>& o_values, size_t count)
+{
+	o_values.reserve(o_values.size() + count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		o_values.emplace_back();
+		if (!deserialize(o_values.back()))
+		{
+			o_values.pop_back();
+			return false;
+		}
+	}
+	return true;
+}
 } // end namespace wgt
@@ -6,6 +6,7 @@
 #include "core_serialization/serialization_dll.hpp"
 #include "core_object/managed_object.hpp"
 #include <utility>
+#include <vector>
 
 namespace wgt
 {
@@ -27,6 +28,13 @@ public:
 	virtual bool serialize(const IManagedObject& object);
 	virtual bool deserialize(IManagedObject& object);
 
+	/**
+	 *	Deserializes the next count values, appending them to o_values.
+	 *	Serializers may parse the values concurrently, references between
+	 *	them are only guaranteed to be resolved once this returns.
+	 */
+	virtual bool deserialize(std::vector<Variant>& o_values, size_t count);
+
 	template<class T>
 	bool serialize(const ManagedObject<T>& object)
 	{
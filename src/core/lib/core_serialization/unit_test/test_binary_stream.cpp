@@ -0,0 +1,103 @@
+#include "pch.hpp"
+
+#include "CppUnitLite2/src/CppUnitLite2.h"
+#include "core_serialization/binary_stream.hpp"
+#include "core_serialization/fixed_memory_stream.hpp"
+#include "core_serialization/resizing_memory_stream.hpp"
+#include <cstdint>
+#include <string>
+
+namespace wgt
+{
+TEST(binary_stream_buffered)
+{
+	ResizingMemoryStream dataStream;
+	BinaryStream stream(dataStream);
+	CHECK_EQUAL(256, stream.setBufferSize(256));
+
+	for (int32_t i = 0; i < 1000; ++i)
+	{
+		stream << i;
+	}
+
+	// buffered writes only reach the data stream when the buffer fills up
+	CHECK(dataStream.buffer().size() < 1000 * sizeof(int32_t));
+	CHECK(stream.sync());
+	CHECK_EQUAL(1000 * sizeof(int32_t), dataStream.buffer().size());
+
+	CHECK_EQUAL(0, stream.seek(0));
+	int32_t value = -1;
+	stream >> value;
+	CHECK_EQUAL(0, value);
+
+	// writing after reading continues from the read position
+	stream << int32_t(-1);
+	CHECK_EQUAL(2 * sizeof(int32_t), stream.seek(0, std::ios_base::cur));
+	stream >> value;
+	CHECK_EQUAL(2, value);
+
+	CHECK_EQUAL(0, stream.seek(0));
+	bool matches = true;
+	for (int32_t i = 0; i < 1000; ++i)
+	{
+		stream >> value;
+		matches = matches && value == (i == 1 ? -1 : i);
+	}
+	CHECK(matches);
+	CHECK(stream.good());
+
+	stream >> value;
+	CHECK(stream.fail());
+}
+
+TEST(binary_stream_varint)
+{
+	const uint64_t values[] = { 0, 1, 127, 128, 300, 16383, 16384, 0xffffffff, 0xffffffffffffffffull };
+	const size_t sizes[] = { 1, 1, 1, 2, 2, 2, 3, 5, 10 };
+
+	for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+	{
+		ResizingMemoryStream dataStream;
+		{
+			BinaryStream stream(dataStream);
+			stream.serializeVarint(values[i]);
+		}
+		CHECK_EQUAL(sizes[i], dataStream.buffer().size());
+		CHECK_EQUAL(0, dataStream.seek(0));
+
+		BinaryStream stream(dataStream);
+		uint64_t value = 0;
+		stream.deserializeVarint(value);
+		CHECK(stream.good());
+		CHECK(value == values[i]);
+	}
+
+	// truncated varint
+	FixedMemoryStream dataStream("\x80\x80", 2);
+	BinaryStream stream(dataStream);
+	uint64_t value = 0;
+	stream.deserializeVarint(value);
+	CHECK(stream.fail());
+}
+
+TEST(binary_stream_compact_strings)
+{
+	ResizingMemoryStream dataStream;
+	{
+		BinaryStream stream(dataStream);
+		stream.setCompact(true);
+		stream << std::string("hello") << std::string();
+	}
+	CHECK_EQUAL(7, dataStream.buffer().size());
+	CHECK_EQUAL(0, dataStream.seek(0));
+
+	BinaryStream stream(dataStream);
+	stream.setCompact(true);
+	std::string hello;
+	std::string empty = "not empty";
+	stream >> hello >> empty;
+	CHECK(stream.good());
+	CHECK_EQUAL(std::string("hello"), hello);
+	CHECK(empty.empty());
+}
+} // end namespace wgt
@@ -0,0 +1,153 @@
+#include "pch.hpp"
+
+#include "CppUnitLite2/src/CppUnitLite2.h"
+#include "core_serialization/resizing_memory_stream.hpp"
+#include "core_serialization/serializer/serialization_manager.hpp"
+#include "core_reflection_utils/serializer/reflection_serializer.hpp"
+#include "core_reflection/i_definition_manager.hpp"
+#include "core_reflection/interfaces/i_class_definition.hpp"
+#include "core_reflection/generic/generic_object.hpp"
+#include "core_object/managed_object.hpp"
+#include <string>
+
+namespace wgt
+{
+IDefinitionManager& definitionManager();
+
+namespace
+{
+/**
+ *	Writes and reads objects through a ReflectionSerializer registered for object handles.
+ */
+class ReflectionSerializerStream
+{
+public:
+	ReflectionSerializerStream()
+	    : serializer_(serializationManager_, *definitionManager().getObjectManager(), definitionManager())
+	{
+		serializationManager_.registerSerializer(MetaType::get<ObjectHandle>()->name(), &serializer_);
+	}
+
+	bool write(const ObjectHandle& object)
+	{
+		return serializationManager_.serialize(stream_, object);
+	}
+
+	bool read(const ObjectHandle& object)
+	{
+		Variant value = object;
+		return serializationManager_.deserialize(stream_, value);
+	}
+
+	std::streamoff pos()
+	{
+		return stream_.seek(0, std::ios_base::cur);
+	}
+
+	std::streamoff rewind()
+	{
+		return stream_.seek(0);
+	}
+
+private:
+	SerializationManager serializationManager_;
+	ReflectionSerializer serializer_;
+	ResizingMemoryStream stream_;
+};
+
+IClassDefinition* reflectionSerializerDefinition(const char* name)
+{
+	return definitionManager().registerDefinition(definitionManager().createGenericDefinition(name));
+}
+
+std::string getString(const ManagedObject<GenericObject>& object, const char* name)
+{
+	std::string value;
+	object->get(name, value);
+	return value;
+}
+
+int getInt(const ManagedObject<GenericObject>& object, const char* name)
+{
+	int value = 0;
+	object->get(name, value);
+	return value;
+}
+}
+
+TEST(ReflectionSerializer_unknown_properties)
+{
+	auto writtenDefinition = reflectionSerializerDefinition("ReflectionSerializerWritten");
+	auto readDefinition = reflectionSerializerDefinition("ReflectionSerializerRead");
+	auto linkedDefinition = reflectionSerializerDefinition("ReflectionSerializerLinked");
+
+	ManagedObject<GenericObject> linked(linkedDefinition->createObjectStorage());
+	ManagedObject<GenericObject> first(writtenDefinition->createObjectStorage());
+	first->set("name", std::string("first"));
+	first->set("note", std::string("only written"));
+	first->set("link", linked.getHandle());
+	first->set("count", 1);
+	ManagedObject<GenericObject> second(writtenDefinition->createObjectStorage());
+	second->set("name", std::string("second"));
+	second->set("note", std::string("also only written"));
+	second->set("link", linked.getHandle());
+	second->set("count", 2);
+
+	ReflectionSerializerStream stream;
+	CHECK(stream.write(first.getHandle()));
+	auto firstSize = stream.pos();
+	CHECK(stream.write(second.getHandle()));
+	auto end = stream.pos();
+
+	// The second object refers to the schema and value types written with the first
+	CHECK(end - firstSize < firstSize);
+	CHECK_EQUAL(0, stream.rewind());
+
+	// Values of properties the reading definition does not have are stepped over
+	ManagedObject<GenericObject> firstRead(readDefinition->createObjectStorage());
+	firstRead->set("name", std::string());
+	firstRead->set("count", 0);
+	ManagedObject<GenericObject> secondRead(readDefinition->createObjectStorage());
+	secondRead->set("name", std::string());
+	secondRead->set("count", 0);
+
+	CHECK(stream.read(firstRead.getHandle()));
+	CHECK(stream.read(secondRead.getHandle()));
+	CHECK_EQUAL(end, stream.pos());
+	CHECK(getString(firstRead, "name") == "first");
+	CHECK_EQUAL(1, getInt(firstRead, "count"));
+	CHECK(getString(secondRead, "name") == "second");
+	CHECK_EQUAL(2, getInt(secondRead, "count"));
+	CHECK(readDefinition->findProperty("note") == nullptr);
+}
+
+TEST(ReflectionSerializer_definition_changes)
+{
+	auto definition = reflectionSerializerDefinition("ReflectionSerializerChanging");
+	ManagedObject<GenericObject> object(definition->createObjectStorage());
+	object->set("name", std::string("before"));
+
+	ReflectionSerializerStream stream;
+	CHECK(stream.write(object.getHandle()));
+
+	// Adding a property to the definition writes a new schema
+	object->set("name", std::string("after"));
+	object->set("extra", 5);
+	CHECK(stream.write(object.getHandle()));
+	auto end = stream.pos();
+	CHECK_EQUAL(0, stream.rewind());
+
+	ManagedObject<GenericObject> before(definition->createObjectStorage());
+	before->set("name", std::string());
+	ManagedObject<GenericObject> after(definition->createObjectStorage());
+	after->set("name", std::string());
+	after->set("extra", 0);
+
+	CHECK(stream.read(before.getHandle()));
+	CHECK(stream.read(after.getHandle()));
+	CHECK_EQUAL(end, stream.pos());
+	CHECK(getString(before, "name") == "before");
+	CHECK(getString(after, "name") == "after");
+	CHECK_EQUAL(5, getInt(after, "extra"));
+}
+} // end namespace wgt
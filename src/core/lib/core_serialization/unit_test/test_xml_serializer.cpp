@@ -15,6 +15,7 @@
 #include "core_reflection/utilities/reflection_function_utilities.hpp"
 #include "core_unit_test/test_framework.hpp"
 #include "core_object/managed_object.hpp"
+#include "core_reflection/generic/generic_object.hpp"
 #include <string>
 #include <vector>
 #include <map>
@@ -258,6 +259,146 @@ TEST(XMLSerializer_simple)
 	CHECK(s == "hello");
 }
 
+TEST(XMLSerializer_batch)
+{
+	ResizingMemoryStream dataStream;
+	XMLSerializer serializer(dataStream, definitionManager());
+
+	const int count = 64;
+	for (int i = 0; i < count; ++i)
+	{
+		CHECK(serializer.serialize(i));
+	}
+	CHECK(serializer.serialize("tail"));
+
+	CHECK(serializer.sync());
+	CHECK_EQUAL(0, dataStream.seek(0));
+
+	std::vector<Variant> values;
+	CHECK(serializer.deserialize(values, count));
+	RETURN_ON_FAIL_CHECK(values.size() == count);
+	for (int i = 0; i < count; ++i)
+	{
+		CHECK(values[i] == i);
+	}
+
+	// the stream is left after the values read
+	std::string s;
+	CHECK(serializer.deserialize(s));
+	CHECK(s == "tail");
+
+	CHECK(!serializer.deserialize(values, 1));
+	CHECK_EQUAL(count, values.size());
+}
+
+TEST(XMLSerializer_batch_stream_position)
+{
+	ResizingMemoryStream dataStream;
+	XMLSerializer serializer(dataStream, definitionManager());
+
+	const int count = 3;
+	for (int i = 0; i < count; ++i)
+	{
+		CHECK(serializer.serialize(i));
+	}
+	CHECK(serializer.sync());
+
+	// more data follows the values, larger than the batch reader reads at once
+	const std::string trailer = "trailer" + std::string(100 * 1024, '.');
+	CHECK_EQUAL(static_cast<std::streamsize>(trailer.size()), dataStream.write(trailer.data(), trailer.size()));
+
+	// reading the values one at a time leaves the stream right after the last one
+	CHECK_EQUAL(0, dataStream.seek(0));
+	for (int i = 0; i < count; ++i)
+	{
+		Variant value;
+		CHECK(serializer.deserialize(value));
+		CHECK(value == i);
+	}
+	CHECK(serializer.sync());
+	const auto expected = dataStream.seek(0, std::ios_base::cur);
+	CHECK(expected > 0);
+
+	// reading them in a batch must leave it in the same place
+	CHECK_EQUAL(0, dataStream.seek(0));
+	std::vector<Variant> values;
+	CHECK(serializer.deserialize(values, count));
+	CHECK_EQUAL(count, values.size());
+	CHECK(serializer.sync());
+	CHECK_EQUAL(expected, dataStream.seek(0, std::ios_base::cur));
+
+	std::string rest;
+	char buffer[4096];
+	for (auto bytesRead = dataStream.read(buffer, sizeof(buffer)); bytesRead > 0;
+	     bytesRead = dataStream.read(buffer, sizeof(buffer)))
+	{
+		rest.append(buffer, static_cast<size_t>(bytesRead));
+	}
+	auto begin = rest.find_first_not_of(" \t\r\n");
+	RETURN_ON_FAIL_CHECK(begin != std::string::npos);
+	CHECK(rest.compare(begin, std::string::npos, trailer) == 0);
+}
+
+TEST(XMLSerializer_batch_objects)
+{
+	ResizingMemoryStream dataStream;
+	XMLSerializer serializer(dataStream, definitionManager());
+	classDefinition<SimpleTestObject>();
+	classDefinition<ComplexTestObject>();
+
+	auto simpleObject = createObject<SimpleTestObject>(SimpleTestObject("linked", 7));
+	auto complexObject = createObject<ComplexTestObject>();
+	complexObject.getHandleT()->init(simpleObject);
+	auto complexData = *complexObject.getHandleT().get();
+
+	auto genericDefinition =
+	    definitionManager().registerDefinition(definitionManager().createGenericDefinition("XMLSerializerBatchObject"));
+	ManagedObject<GenericObject> genericObject(genericDefinition->createObjectStorage());
+	genericObject->set("count", 3);
+	genericObject->set("link", simpleObject.getHandle());
+
+	// objects refer to one written after them
+	CHECK(serializer.serialize(complexObject.getHandleT()));
+	CHECK(serializer.serialize(genericObject.getHandleT()));
+	CHECK(serializer.serialize(simpleObject.getHandleT()));
+	CHECK(serializer.sync());
+	CHECK_EQUAL(0, dataStream.seek(0));
+
+	complexObject = nullptr;
+	genericObject = nullptr;
+	simpleObject = nullptr;
+
+	std::vector<Variant> values;
+	CHECK(serializer.deserialize(values, 3));
+	RETURN_ON_FAIL_CHECK(values.size() == 3);
+
+	ObjectHandle complexHandle;
+	ObjectHandle genericHandle;
+	ObjectHandle simpleHandle;
+	RETURN_ON_FAIL_CHECK(values[0].tryCast(complexHandle));
+	RETURN_ON_FAIL_CHECK(values[1].tryCast(genericHandle));
+	RETURN_ON_FAIL_CHECK(values[2].tryCast(simpleHandle));
+
+	auto simple = simpleHandle.getBase<SimpleTestObject>();
+	RETURN_ON_FAIL_CHECK(simple != nullptr);
+	CHECK(*simple == SimpleTestObject("linked", 7));
+
+	auto complex = complexHandle.getBase<ComplexTestObject>();
+	RETURN_ON_FAIL_CHECK(complex != nullptr);
+	CHECK(complex->linkedObject_.getBase<SimpleTestObject>() == simple);
+	complexData.linkedObject_ = simpleHandle;
+	CHECK(*complex == complexData);
+
+	auto generic = genericHandle.getBase<GenericObject>();
+	RETURN_ON_FAIL_CHECK(generic != nullptr);
+	int count = 0;
+	CHECK(generic->get("count", count));
+	CHECK_EQUAL(3, count);
+	ObjectHandle link;
+	CHECK(generic->get("link", link));
+	CHECK(link.getBase<SimpleTestObject>() == simple);
+}
+
 TEST(XMLSerializer_void)
 {
 	ResizingMemoryStream dataStream;
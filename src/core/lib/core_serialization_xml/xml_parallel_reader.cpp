@@ -0,0 +1,316 @@
+#include "xml_parallel_reader.hpp"
+
+#include "core_serialization_xml/simple_api_for_xml.hpp"
+#include "core_serialization_xml/xml_reader.hpp"
+#include "core_serialization/fixed_memory_stream.hpp"
+#include "core_serialization/text_stream.hpp"
+#include "core_reflection/i_definition_manager.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+namespace wgt
+{
+namespace XMLParallelReaderDetail
+{
+//==========================================================================
+class Recorder : private SimpleApiForXml
+{
+	typedef SimpleApiForXml base;
+
+public:
+	Recorder(TextStream& stream, XMLReader::Recording& recording) : base(stream), recording_(recording)
+	{
+	}
+
+	bool record()
+	{
+		return parse();
+	}
+
+private:
+	void elementStart(const char* name, const char* const* attributes) override
+	{
+		XMLReader::Recording::Event event = { XMLReader::Recording::ELEMENT_START, recording_.strings.size(), 0 };
+		addString(name);
+		for (auto attribute = attributes; *attribute; ++attribute)
+		{
+			addString(*attribute);
+		}
+		event.count = recording_.strings.size() - event.first;
+		recording_.events.push_back(event);
+	}
+
+	void elementEnd(const char* name) override
+	{
+		XMLReader::Recording::Event event = { XMLReader::Recording::ELEMENT_END, recording_.strings.size(), 1 };
+		addString(name);
+		recording_.events.push_back(event);
+	}
+
+	void characterData(const char* data, size_t length) override
+	{
+		// expat may hand over one run of text in several pieces
+		auto& events = recording_.events;
+		if (events.empty() || events.back().type != XMLReader::Recording::CHARACTER_DATA)
+		{
+			XMLReader::Recording::Event event = { XMLReader::Recording::CHARACTER_DATA, recording_.text.size(), 0 };
+			events.push_back(event);
+		}
+		recording_.text.append(data, length);
+		events.back().count += length;
+	}
+
+	void addString(const char* value)
+	{
+		recording_.strings.push_back(recording_.text.size());
+		recording_.text.append(value);
+		recording_.text.push_back('\0');
+	}
+
+	XMLReader::Recording& recording_;
+};
+
+//==========================================================================
+/**
+ *	Runs function for every index below count, spread over the hardware threads.
+ */
+template <typename Function>
+void parallelFor(size_t count, Function function)
+{
+	size_t threadCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), count);
+	if (threadCount <= 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			function(i);
+		}
+		return;
+	}
+
+	std::atomic<size_t> next(0);
+	auto worker = [&]() {
+		for (size_t i = next++; i < count; i = next++)
+		{
+			function(i);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	for (size_t i = 1; i < threadCount; ++i)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+//==========================================================================
+/**
+ *	Finds where the next root element after pos ends, skipping the prolog,
+ *	comments and character data sections around and inside it.
+ *	@return false if buffer ends before the root does.
+ */
+bool findRoot(const std::string& buffer, size_t& pos, size_t& o_begin)
+{
+	size_t depth = 0;
+	while (pos < buffer.size())
+	{
+		if (depth == 0 && isspace(static_cast<unsigned char>(buffer[pos])))
+		{
+			++pos;
+			continue;
+		}
+
+		if (buffer[pos] != '<')
+		{
+			if (depth == 0)
+			{
+				// text outside of a root element
+				return false;
+			}
+			pos = buffer.find('<', pos);
+			continue;
+		}
+
+		const char* skipEnd = nullptr;
+		if (buffer.compare(pos, 4, "<!--") == 0)
+		{
+			skipEnd = "-->";
+		}
+		else if (buffer.compare(pos, 9, "<![CDATA[") == 0)
+		{
+			skipEnd = "]]>";
+		}
+		else if (buffer.compare(pos, 2, "<?") == 0)
+		{
+			skipEnd = "?>";
+		}
+		else if (buffer.compare(pos, 2, "<!") == 0)
+		{
+			skipEnd = ">";
+		}
+
+		if (skipEnd != nullptr)
+		{
+			pos = buffer.find(skipEnd, pos);
+			if (pos == std::string::npos)
+			{
+				return false;
+			}
+			pos += strlen(skipEnd);
+			continue;
+		}
+
+		if (depth == 0)
+		{
+			o_begin = pos;
+		}
+
+		bool endTag = buffer.compare(pos, 2, "</") == 0;
+		char quote = 0;
+		for (++pos; pos < buffer.size(); ++pos)
+		{
+			char c = buffer[pos];
+			if (quote != 0)
+			{
+				quote = c == quote ? 0 : quote;
+			}
+			else if (c == '"' || c == '\'')
+			{
+				quote = c;
+			}
+			else if (c == '>')
+			{
+				break;
+			}
+		}
+		if (pos >= buffer.size())
+		{
+			return false;
+		}
+
+		if (endTag)
+		{
+			if (depth == 0)
+			{
+				return false;
+			}
+			--depth;
+		}
+		else if (buffer[pos - 1] != '/')
+		{
+			++depth;
+		}
+		++pos;
+
+		if (depth == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+}
+
+//==============================================================================
+XMLParallelReader::XMLParallelReader(TextStream& stream, IDefinitionManager& definitionManager,
+                                     const XMLSerializer::Format& format)
+    : stream_(stream), definitionManager_(definitionManager), format_(format)
+{
+}
+
+//==============================================================================
+bool XMLParallelReader::read(std::vector<Variant>& o_values, size_t count)
+{
+	using namespace XMLParallelReaderDetail;
+
+	if (count == 0)
+	{
+		return true;
+	}
+
+	std::string buffer;
+	const std::streamsize BUFFER_SIZE = 64 * 1024;
+	while (true)
+	{
+		auto size = buffer.size();
+		buffer.resize(size + BUFFER_SIZE);
+		auto bytesRead = stream_.read(&buffer[size], BUFFER_SIZE);
+		buffer.resize(size + static_cast<size_t>(std::max<std::streamsize>(bytesRead, 0)));
+		if (bytesRead <= 0)
+		{
+			break;
+		}
+	}
+
+	std::vector<std::pair<size_t, size_t>> roots(count);
+	size_t pos = 0;
+	bool found = true;
+	for (auto& root : roots)
+	{
+		found = findRoot(buffer, pos, root.first);
+		if (!found)
+		{
+			break;
+		}
+		root.second = pos;
+	}
+
+	// leave the stream after the last root read, or where it was if there are too few
+	std::streamoff off = static_cast<std::streamoff>(found ? pos : 0) - static_cast<std::streamoff>(buffer.size());
+	if (off != 0)
+	{
+		stream_.seek(off, std::ios_base::cur);
+		stream_.resetState(std::ios_base::eofbit);
+	}
+	if (!found)
+	{
+		return false;
+	}
+
+	std::vector<XMLReader::Recording> recordings(count);
+	std::atomic<bool> succeeded(true);
+	parallelFor(count, [&](size_t i) {
+		FixedMemoryStream dataStream(buffer.data() + roots[i].first, roots[i].second - roots[i].first);
+		TextStream stream(dataStream);
+		Recorder recorder(stream, recordings[i]);
+		if (!recorder.record())
+		{
+			succeeded = false;
+		}
+	});
+	if (!succeeded)
+	{
+		return false;
+	}
+
+	// Creating objects and setting their properties runs constructors, setters
+	// and collection inserts that are not safe to call concurrently, so values
+	// are read on the calling thread.
+	FixedMemoryStream dataStream("");
+	TextStream stream(dataStream);
+	XMLReader reader(stream, definitionManager_, format_);
+	std::vector<XMLReader::Link> links;
+	for (auto& recording : recordings)
+	{
+		Variant value;
+		if (!reader.read(value, recording, links))
+		{
+			succeeded = false;
+			break;
+		}
+		o_values.push_back(std::move(value));
+	}
+
+	XMLReader::link(links, definitionManager_);
+	return succeeded;
+}
+} // end namespace wgt
@@ -0,0 +1,45 @@
+#ifndef XML_PARALLEL_READER_HPP_INCLUDED
+#define XML_PARALLEL_READER_HPP_INCLUDED
+
+#include "core_serialization_xml/xml_serializer.hpp"
+#include "core_variant/variant.hpp"
+
+#include <vector>
+
+namespace wgt
+{
+class IDefinitionManager;
+class TextStream;
+
+/**
+ *	Reads a run of root elements, such as the objects saved by an object
+ *	manager, parsing them on every core.
+ *
+ *	The roots are parsed into recordings in parallel first. The recordings are
+ *	then turned into values by XMLReader on the calling thread, as creating
+ *	objects and setting their properties is not thread safe. References between
+ *	objects are set once every object exists, so the order roots are read in
+ *	does not matter.
+ */
+class XMLParallelReader
+{
+public:
+	XMLParallelReader(TextStream& stream, IDefinitionManager& definitionManager, const XMLSerializer::Format& format);
+
+	/**
+	 *	Reads count values, appending them to o_values and leaving the stream
+	 *	after the last one.
+	 *	@return false, with the stream where it was, if there are fewer roots.
+	 */
+	bool read(std::vector<Variant>& o_values, size_t count);
+
+private:
+	XMLParallelReader(const XMLParallelReader&);
+	XMLParallelReader& operator=(const XMLParallelReader&);
+
+	TextStream& stream_;
+	IDefinitionManager& definitionManager_;
+	const XMLSerializer::Format& format_;
+};
+} // end namespace wgt
+#endif
@@ -91,13 +91,13 @@ private:
 
 XMLReader::StackItem::StackItem(Variant&& value)
     : value(std::move(value)), reference(nullptr), property(nullptr), pos(), characterData(),
-      hasChildren(false), assumedKey(0)
+      hasChildren(false), assumedKey(0), link(nullptr)
 {
 }
 
 XMLReader::XMLReader(TextStream& stream, IDefinitionManager& definitionManager, const XMLSerializer::Format& format)
     : base(stream), definitionManager_(definitionManager), format_(format), stack_(), pushed_(false), done_(false),
-      ignore_(0)
+      ignore_(0), links_(nullptr)
 {
 }
 
@@ -137,6 +137,63 @@ bool XMLReader::read(IManagedObject& object)
 	return reference && object.set(std::move(reference), std::move(objectStorage_));
 }
 
+bool XMLReader::read(Variant& value, const Recording& recording, std::vector<Link>& o_links)
+{
+	objectType_ = TypeId();
+	stack_.emplace_back(std::move(value));
+	pushed_ = true;
+	done_ = false;
+	links_ = &o_links;
+
+	std::vector<const char*> strings;
+	for (auto& event : recording.events)
+	{
+		if (aborted())
+		{
+			break;
+		}
+
+		switch (event.type)
+		{
+		case Recording::ELEMENT_START:
+			strings.clear();
+			for (size_t i = 0; i < event.count; ++i)
+			{
+				strings.push_back(recording.text.c_str() + recording.strings[event.first + i]);
+			}
+			strings.push_back(nullptr);
+			elementStart(strings[0], strings.data() + 1);
+			break;
+
+		case Recording::ELEMENT_END:
+			elementEnd(recording.text.c_str() + recording.strings[event.first]);
+			break;
+
+		case Recording::CHARACTER_DATA:
+			characterData(recording.text.c_str() + event.first, event.count);
+			break;
+		}
+	}
+	links_ = nullptr;
+
+	if (!done_)
+	{
+		return false;
+	}
+
+	value = std::move(stack_.back().value);
+	stack_.pop_back();
+	return true;
+}
+
+void XMLReader::link(const std::vector<Link>& links, IDefinitionManager& definitionManager)
+{
+	for (auto& link : links)
+	{
+		link.property->set(link.object, ObjectReference::asHandle(link.reference), definitionManager);
+	}
+}
+
 void XMLReader::elementStart(const char* elementName, const char* const* attributes)
 {
 	if (ignore_)
@@ -357,6 +414,17 @@ void XMLReader::elementStart(const char* elementName, const char* const* attribu
 		std::string path = objectPath ? objectPath : "";
 		auto reference = objectManager->getObject(RefObjectId(objectId), path);
 		current.value = ObjectReference::asHandle(reference);
+
+		// The object may not be created yet, so setting a pointer to it is left
+		// until every object is. Only objects and collections outlive the read.
+		if (links_ != nullptr && stack_.size() > 1)
+		{
+			auto& parent = *std::next(stack_.rbegin());
+			if (parent.reference != nullptr || parent.value.value<Collection*>() != nullptr)
+			{
+				current.link = std::move(reference);
+			}
+		}
 		return;
 	}
 
@@ -490,7 +558,15 @@ void XMLReader::elementEnd(const char* elementName)
 	TF_ASSERT(handle.isValid());
 
 	TF_ASSERT(current.property);
-	current.property->set(handle, std::move(current.value), definitionManager_);
+	if (current.link != nullptr)
+	{
+		Link link = { handle, current.property, std::move(current.link) };
+		links_->push_back(std::move(link));
+	}
+	else
+	{
+		current.property->set(handle, std::move(current.value), definitionManager_);
+	}
 	stack_.pop_back();
 }
 
@@ -10,6 +10,7 @@
 #include <list>
 #include <string>
 #include <utility>
+#include <vector>
 #include <cstdint>
 
 namespace wgt
@@ -25,11 +26,57 @@ class XMLReader : private SimpleApiForXml
 	typedef SimpleApiForXml base;
 
 public:
+	/**
+	 *	Parse events of one root element, recorded so that they can be parsed
+	 *	on one thread and turned into a value on another.
+	 */
+	struct Recording
+	{
+		enum EventType
+		{
+			ELEMENT_START,
+			ELEMENT_END,
+			CHARACTER_DATA
+		};
+
+		// Element events refer to count strings from strings[first], the element
+		// name followed by attribute name and value pairs. Character data events
+		// refer to count characters from text[first].
+		struct Event
+		{
+			EventType type;
+			size_t first;
+			size_t count;
+		};
+
+		std::vector<Event> events;
+		std::vector<size_t> strings;
+		std::string text;
+	};
+
+	/** An object reference left to be set once every object has been created. */
+	struct Link
+	{
+		ObjectHandle object;
+		IBasePropertyPtr property;
+		std::shared_ptr<ObjectReference> reference;
+	};
+
 	XMLReader(TextStream& stream, IDefinitionManager& definitionManager, const XMLSerializer::Format& format);
 
 	bool read(Variant& value);
 	bool read(IManagedObject& object);
 
+	/**
+	 *	Reads a value from recorded events rather than the stream.
+	 *	References to other objects are not set, but added to o_links instead,
+	 *	so that objects can refer to ones read after them.
+	 */
+	bool read(Variant& value, const Recording& recording, std::vector<Link>& o_links);
+
+	/** Sets the object references left by reading recordings. */
+	static void link(const std::vector<Link>& links, IDefinitionManager& definitionManager);
+
 private:
 	struct StackItem
 	{
@@ -44,6 +91,7 @@ private:
 		std::string characterData;
 		bool hasChildren;
 		intmax_t assumedKey;
+		std::shared_ptr<ObjectReference> link;
 	};
 
 	IDefinitionManager& definitionManager_;
@@ -54,6 +102,7 @@ private:
 	unsigned ignore_;
 	TypeId objectType_;
 	std::shared_ptr<ObjectStorage> objectStorage_;
+	std::vector<Link>* links_;
 
 	void elementStart(const char* elementName, const char* const* attributes) override;
 	void elementEnd(const char* elementName) override;
@@ -1,6 +1,7 @@
 #include "xml_serializer.hpp"
 #include "core_serialization_xml/xml_writer.hpp"
 #include "core_serialization_xml/xml_reader.hpp"
+#include "core_serialization_xml/xml_parallel_reader.hpp"
 #include "core_reflection/i_definition_manager.hpp"
 
 namespace wgt
@@ -64,6 +65,12 @@ bool XMLSerializer::deserialize(IManagedObject& object)
 	return reader.read(object);
 }
 
+bool XMLSerializer::deserialize(std::vector<Variant>& o_values, size_t count)
+{
+	XMLParallelReader reader(stream_, definitionManager_, format_);
+	return reader.read(o_values, count);
+}
+
 void XMLSerializer::setFormat(const Format& format)
 {
 	format_ = format;
@@ -96,6 +96,11 @@ public:
 	bool serialize(const IManagedObject& object) override;
 	bool deserialize(IManagedObject& object) override;
 
+	/**
+	Reads count root values, parsing and creating them on every core.
+	*/
+	bool deserialize(std::vector<Variant>& o_values, size_t count) override;
+
 	const Format& format() const
 	{
 		return format_;
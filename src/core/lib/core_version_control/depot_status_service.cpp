@@ -0,0 +1,334 @@
+#include "depot_status_service.hpp"
+
+#include "core_serialization/i_file_system.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace wgt
+{
+namespace
+{
+std::string normalisePath(const char* path)
+{
+	std::string result(path);
+	std::replace(result.begin(), result.end(), '\\', '/');
+	return result;
+}
+
+const char* const s_PathAttributes[] = { "clientFile", "depotFile", "path" };
+}
+
+//==============================================================================
+struct DepotStatusService::Implementation
+{
+	Implementation(IDepotView& depotView)
+	    : depotView_(depotView), coalesceDelay_(10), maxBatchSize_(500), batchCount_(0), flushing_(0),
+	      exiting_(false)
+	{
+	}
+
+	bool queue(const std::string& path)
+	{
+		if (pending_.find(path) != pending_.end())
+		{
+			return false;
+		}
+
+		auto inFlight = inFlight_.find(path);
+		if (inFlight != inFlight_.end())
+		{
+			// Already being fetched, but the answer may predate the latest change
+			inFlight->second = true;
+			return false;
+		}
+
+		pending_.insert(path);
+		pendingOrder_.push_back(path);
+		return true;
+	}
+
+	void run();
+	void processBatch(std::unique_lock<std::mutex>& lock);
+
+	IDepotView& depotView_;
+	std::chrono::milliseconds coalesceDelay_;
+	size_t maxBatchSize_;
+	size_t batchCount_;
+	int flushing_;
+	bool exiting_;
+
+	mutable std::mutex mutex_;
+	std::condition_variable wakeUp_;
+	std::condition_variable idle_;
+
+	std::unordered_map<std::string, Attributes> cache_;
+	std::unordered_set<std::string> pending_;
+	std::deque<std::string> pendingOrder_;
+	// Paths being fetched, flagged when they were invalidated while in flight
+	std::unordered_map<std::string, bool> inFlight_;
+
+	Signal<StatusChangedSignature> statusChanged_;
+	IFileSystem::PathChangedCallback pathChangedCallback_;
+	Connection pathChangedConnection_;
+	std::thread worker_;
+};
+
+//------------------------------------------------------------------------------
+void DepotStatusService::Implementation::run()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+	for (;;)
+	{
+		wakeUp_.wait(lock, [this]() { return exiting_ || !pendingOrder_.empty(); });
+		if (exiting_)
+		{
+			break;
+		}
+
+		// Give other views a moment to queue their requests so they share the round trip
+		wakeUp_.wait_for(lock, coalesceDelay_, [this]() {
+			return exiting_ || flushing_ > 0 || pendingOrder_.size() >= maxBatchSize_;
+		});
+		if (exiting_)
+		{
+			break;
+		}
+
+		processBatch(lock);
+		idle_.notify_all();
+	}
+	idle_.notify_all();
+}
+
+//------------------------------------------------------------------------------
+void DepotStatusService::Implementation::processBatch(std::unique_lock<std::mutex>& lock)
+{
+	IDepotView::PathList batch;
+	while (!pendingOrder_.empty() && batch.size() < maxBatchSize_)
+	{
+		auto& path = pendingOrder_.front();
+		pending_.erase(path);
+		inFlight_[path] = false;
+		batch.push_back(std::move(path));
+		pendingOrder_.pop_front();
+	}
+	if (batch.empty())
+	{
+		return;
+	}
+
+	lock.unlock();
+	auto result = depotView_.status(batch);
+
+	std::unordered_map<std::string, Attributes> updates;
+	updates.reserve(batch.size());
+	for (auto& path : batch)
+	{
+		updates[path];
+	}
+	if (result != nullptr)
+	{
+		for (auto& row : result->results())
+		{
+			for (auto attribute : s_PathAttributes)
+			{
+				auto found = row.find(attribute);
+				if (found == row.end())
+				{
+					continue;
+				}
+				auto update = updates.find(normalisePath(found->second.c_str()));
+				if (update != updates.end())
+				{
+					update->second = row;
+					break;
+				}
+			}
+		}
+	}
+	lock.lock();
+
+	++batchCount_;
+	std::vector<std::pair<std::string, Attributes>> changed;
+	for (auto& update : updates)
+	{
+		auto inFlight = inFlight_.find(update.first);
+		if (inFlight == inFlight_.end())
+		{
+			continue;
+		}
+		const bool stale = inFlight->second;
+		inFlight_.erase(inFlight);
+		if (stale)
+		{
+			queue(update.first);
+			continue;
+		}
+
+		auto& cached = cache_[update.first];
+		cached = std::move(update.second);
+		changed.emplace_back(update.first, cached);
+	}
+
+	lock.unlock();
+	for (auto& entry : changed)
+	{
+		statusChanged_(entry.first.c_str(), entry.second);
+	}
+	lock.lock();
+}
+
+//==============================================================================
+DepotStatusService::DepotStatusService(IDepotView& depotView, IFileSystem* fileSystem)
+    : impl_(new Implementation(depotView))
+{
+	if (fileSystem != nullptr)
+	{
+		impl_->pathChangedCallback_ = [this](const char* path, const IFileInfoPtr) { invalidate(path); };
+		impl_->pathChangedConnection_ = fileSystem->listenForChanges(impl_->pathChangedCallback_);
+	}
+	impl_->worker_ = std::thread(&Implementation::run, impl_.get());
+}
+
+//------------------------------------------------------------------------------
+DepotStatusService::~DepotStatusService()
+{
+	impl_->pathChangedConnection_.disconnect();
+	{
+		std::lock_guard<std::mutex> guard(impl_->mutex_);
+		impl_->exiting_ = true;
+	}
+	impl_->wakeUp_.notify_all();
+	impl_->worker_.join();
+}
+
+//------------------------------------------------------------------------------
+bool DepotStatusService::getStatus(const char* path, Attributes& o_Status)
+{
+	const auto normalised = normalisePath(path);
+	{
+		std::lock_guard<std::mutex> guard(impl_->mutex_);
+		auto found = impl_->cache_.find(normalised);
+		if (found != impl_->cache_.end())
+		{
+			o_Status = found->second;
+			return true;
+		}
+		if (!impl_->queue(normalised))
+		{
+			return false;
+		}
+	}
+	impl_->wakeUp_.notify_one();
+	return false;
+}
+
+//------------------------------------------------------------------------------
+void DepotStatusService::requestStatus(const char* path)
+{
+	Attributes status;
+	getStatus(path, status);
+}
+
+//------------------------------------------------------------------------------
+void DepotStatusService::requestStatus(const IDepotView::PathList& paths)
+{
+	bool queued = false;
+	{
+		std::lock_guard<std::mutex> guard(impl_->mutex_);
+		for (auto& path : paths)
+		{
+			auto normalised = normalisePath(path.c_str());
+			if (impl_->cache_.find(normalised) == impl_->cache_.end())
+			{
+				queued |= impl_->queue(normalised);
+			}
+		}
+	}
+	if (queued)
+	{
+		impl_->wakeUp_.notify_one();
+	}
+}
+
+//------------------------------------------------------------------------------
+void DepotStatusService::invalidate(const char* path)
+{
+	const auto normalised = normalisePath(path);
+	bool queued = false;
+	{
+		std::lock_guard<std::mutex> guard(impl_->mutex_);
+		auto found = impl_->cache_.find(normalised);
+		auto inFlight = impl_->inFlight_.find(normalised);
+		if (found != impl_->cache_.end())
+		{
+			impl_->cache_.erase(found);
+			queued = impl_->queue(normalised);
+		}
+		else if (inFlight != impl_->inFlight_.end())
+		{
+			inFlight->second = true;
+		}
+	}
+	if (queued)
+	{
+		impl_->wakeUp_.notify_one();
+	}
+}
+
+//------------------------------------------------------------------------------
+void DepotStatusService::invalidateAll()
+{
+	std::lock_guard<std::mutex> guard(impl_->mutex_);
+	impl_->cache_.clear();
+	for (auto& inFlight : impl_->inFlight_)
+	{
+		inFlight.second = true;
+	}
+}
+
+//------------------------------------------------------------------------------
+void DepotStatusService::flush()
+{
+	std::unique_lock<std::mutex> lock(impl_->mutex_);
+	++impl_->flushing_;
+	impl_->wakeUp_.notify_all();
+	impl_->idle_.wait(lock, [this]() {
+		return impl_->exiting_ || (impl_->pendingOrder_.empty() && impl_->inFlight_.empty());
+	});
+	--impl_->flushing_;
+}
+
+//------------------------------------------------------------------------------
+Connection DepotStatusService::connectStatusChanged(StatusChangedCallback callback)
+{
+	return impl_->statusChanged_.connect(callback);
+}
+
+//------------------------------------------------------------------------------
+void DepotStatusService::setCoalesceDelay(std::chrono::milliseconds delay)
+{
+	std::lock_guard<std::mutex> guard(impl_->mutex_);
+	impl_->coalesceDelay_ = delay;
+}
+
+//------------------------------------------------------------------------------
+void DepotStatusService::setMaxBatchSize(size_t maxBatchSize)
+{
+	std::lock_guard<std::mutex> guard(impl_->mutex_);
+	impl_->maxBatchSize_ = std::max<size_t>(maxBatchSize, 1);
+}
+
+//------------------------------------------------------------------------------
+size_t DepotStatusService::getBatchCount() const
+{
+	std::lock_guard<std::mutex> guard(impl_->mutex_);
+	return impl_->batchCount_;
+}
+} // end namespace wgt
@@ -0,0 +1,78 @@
+#ifndef DEPOT_STATUS_SERVICE_HPP
+#define DEPOT_STATUS_SERVICE_HPP
+
+#include "version_control/i_depot_view.hpp"
+#include "core_common/signal.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+namespace wgt
+{
+class IFileSystem;
+
+/**
+* Caches the depot status of files and coalesces status requests made from
+* anywhere in the UI into batched IDepotView::status calls.
+*
+* Requests are answered by a worker thread, so views never block on the
+* depot. Views query getStatus when they need to display a file. If the
+* status is not cached yet, it is queued and the statusChanged signal fires
+* once it arrives. Cached entries are dropped and refreshed when the file
+* system reports a change to the file.
+*
+* This is only the library half. Nothing in the tree creates a service yet,
+* and IFileStatusManager, which tracks edit state rather than depot state, has
+* no implementation here to feed it. Whoever owns an IDepotView creates a
+* service for it and routes its status queries through that service.
+*/
+class DepotStatusService
+{
+public:
+	typedef void StatusChangedSignature(const char* path, const Attributes& status);
+	typedef std::function<StatusChangedSignature> StatusChangedCallback;
+
+	/**
+	* @param depotView the view status requests are made against, must outlive the service.
+	* @param fileSystem optional file system whose change notifications invalidate the cache.
+	*/
+	DepotStatusService(IDepotView& depotView, IFileSystem* fileSystem = nullptr);
+	~DepotStatusService();
+
+	/**
+	* Gets the cached status of a file.
+	* If the status is not cached it is requested and false is returned.
+	* Files which are not in the depot have an empty status.
+	*/
+	bool getStatus(const char* path, Attributes& o_Status);
+
+	void requestStatus(const char* path);
+	void requestStatus(const IDepotView::PathList& paths);
+
+	/** Drops the cached status of a file, refreshing it if it was cached. */
+	void invalidate(const char* path);
+	void invalidateAll();
+
+	/** Blocks until every queued request has been answered. */
+	void flush();
+
+	/**
+	* Connects to status updates.
+	* The callback is invoked on the worker thread, UI code must marshal it to the UI thread.
+	*/
+	Connection connectStatusChanged(StatusChangedCallback callback);
+
+	/** The longest the worker waits for more requests before sending a batch. */
+	void setCoalesceDelay(std::chrono::milliseconds delay);
+	void setMaxBatchSize(size_t maxBatchSize);
+
+	/** Number of IDepotView::status calls made so far. */
+	size_t getBatchCount() const;
+
+private:
+	struct Implementation;
+	std::unique_ptr<Implementation> impl_;
+};
+} // end namespace wgt
+#endif // DEPOT_STATUS_SERVICE_HPP
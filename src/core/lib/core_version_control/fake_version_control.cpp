@@ -0,0 +1,519 @@
+#include "fake_version_control.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace wgt
+{
+namespace
+{
+class FakeResult : public IResult
+{
+public:
+	virtual const char* errors() const override
+	{
+		return errors_.c_str();
+	}
+
+	virtual const char* output() const override
+	{
+		return output_.c_str();
+	}
+
+	virtual const AttributeResults& results() const override
+	{
+		return results_;
+	}
+
+	void addError(const std::string& path, const char* message)
+	{
+		errors_ += path + " - " + message + "\n";
+	}
+
+	std::string errors_;
+	std::string output_;
+	AttributeResults results_;
+};
+
+std::string normalisePath(const std::string& path)
+{
+	std::string result(path);
+	std::replace(result.begin(), result.end(), '\\', '/');
+	return result;
+}
+}
+
+//==============================================================================
+FakeDepot::FakeDepot() : nextChangeList_(1), latency_(0), statusCalls_(0)
+{
+}
+
+//------------------------------------------------------------------------------
+void FakeDepot::addFile(const char* path, int headRev)
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto& file = files_[normalisePath(path)];
+	file.headRev_ = headRev;
+	file.haveRev_ = headRev;
+	file.action_.clear();
+}
+
+//------------------------------------------------------------------------------
+bool FakeDepot::findFile(const char* path, File& o_File) const
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+	auto found = files_.find(normalisePath(path));
+	if (found == files_.end())
+	{
+		return false;
+	}
+	o_File = found->second;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+void FakeDepot::setLatency(std::chrono::microseconds latency)
+{
+	std::lock_guard<std::mutex> guard(mutex_);
+	latency_ = latency;
+}
+
+//------------------------------------------------------------------------------
+size_t FakeDepot::getStatusCallCount() const
+{
+	return statusCalls_;
+}
+
+//------------------------------------------------------------------------------
+void FakeDepot::simulateLatency() const
+{
+	std::chrono::microseconds latency;
+	{
+		std::lock_guard<std::mutex> guard(mutex_);
+		latency = latency_;
+	}
+	if (latency.count() > 0)
+	{
+		std::this_thread::sleep_for(latency);
+	}
+}
+
+//==============================================================================
+FakeDepotView::FakeDepotView(FakeDepotPtr depot, const char* depotPath, const char* clientPath)
+    : depot_(depot), depotPath_(depotPath ? depotPath : ""), clientPath_(clientPath ? clientPath : "")
+{
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::add(const PathList& filePaths, ChangeListId changeListId)
+{
+	depot_->simulateLatency();
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	for (auto& path : filePaths)
+	{
+		auto& file = depot_->files_[normalisePath(path)];
+		if (file.headRev_ != 0 || !file.action_.empty())
+		{
+			result->addError(path, "can't add existing file");
+			continue;
+		}
+		file.action_ = "add";
+		file.change_ = changeListId;
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::remove(const PathList& filePaths, ChangeListId changeListId)
+{
+	depot_->simulateLatency();
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	for (auto& path : filePaths)
+	{
+		auto found = depot_->files_.find(normalisePath(path));
+		if (found == depot_->files_.end() || found->second.headRev_ == 0)
+		{
+			result->addError(path, "file(s) not on client.");
+			continue;
+		}
+		found->second.action_ = "delete";
+		found->second.change_ = changeListId;
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::checkout(const PathList& filePaths, ChangeListId changeListId)
+{
+	depot_->simulateLatency();
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	for (auto& path : filePaths)
+	{
+		auto found = depot_->files_.find(normalisePath(path));
+		if (found == depot_->files_.end() || found->second.headRev_ == 0)
+		{
+			result->addError(path, "file(s) not on client.");
+			continue;
+		}
+		if (found->second.action_.empty())
+		{
+			found->second.action_ = "edit";
+			found->second.change_ = changeListId;
+		}
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::rename(const FilePairs& filePairs, ChangeListId changeListId)
+{
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	for (auto& filePair : filePairs)
+	{
+		auto moved = move(filePair.first.c_str(), filePair.second.c_str(), changeListId);
+		result->errors_ += moved->errors();
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::move(const char* srcFile, const char* dstFile, ChangeListId changeListId)
+{
+	depot_->simulateLatency();
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	auto found = depot_->files_.find(normalisePath(srcFile));
+	if (found == depot_->files_.end())
+	{
+		result->addError(srcFile, "file(s) not on client.");
+		return std::move(result);
+	}
+
+	auto& dst = depot_->files_[normalisePath(dstFile)];
+	dst.action_ = "move/add";
+	dst.change_ = changeListId;
+	found->second.action_ = "move/delete";
+	found->second.change_ = changeListId;
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::revert(const PathList& filePaths)
+{
+	depot_->simulateLatency();
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	for (auto& path : filePaths)
+	{
+		auto found = depot_->files_.find(normalisePath(path));
+		if (found == depot_->files_.end() || found->second.action_.empty())
+		{
+			result->addError(path, "file(s) not opened on this client.");
+			continue;
+		}
+		if (found->second.headRev_ == 0)
+		{
+			depot_->files_.erase(found);
+			continue;
+		}
+		found->second.action_.clear();
+		found->second.change_ = kDefaultChangelist;
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::revertUnchanged(const PathList& filePaths)
+{
+	// Files have no content, so every opened file is unchanged
+	return revert(filePaths);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::get(const PathList& filePaths, Revision revision)
+{
+	depot_->simulateLatency();
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	for (auto& path : filePaths)
+	{
+		auto found = depot_->files_.find(normalisePath(path));
+		if (found == depot_->files_.end() || found->second.headRev_ == 0)
+		{
+			result->addError(path, "no such file(s).");
+			continue;
+		}
+		auto& file = found->second;
+		file.haveRev_ = revision == kHeadRevion ? file.headRev_ : std::min(revision, file.headRev_);
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::getRevisionBetween(const PathList& filePaths, int fromChangelist, int toChangelist)
+{
+	return get(filePaths, toChangelist);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::getLatest(const PathList& filePaths)
+{
+	return get(filePaths, kHeadRevion);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::status(const PathList& filePaths)
+{
+	++depot_->statusCalls_;
+	depot_->simulateLatency();
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	result->results_.reserve(filePaths.size());
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	for (auto& path : filePaths)
+	{
+		const auto clientFile = normalisePath(path);
+		auto found = depot_->files_.find(clientFile);
+		if (found == depot_->files_.end())
+		{
+			result->addError(path, "no such file(s).");
+			continue;
+		}
+
+		auto& file = found->second;
+		Attributes row;
+		row["clientFile"] = clientFile;
+		row["depotFile"] = depotPath_ + clientFile;
+		if (file.headRev_ != 0)
+		{
+			row["headRev"] = std::to_string(file.headRev_);
+			row["haveRev"] = std::to_string(file.haveRev_);
+		}
+		if (!file.action_.empty())
+		{
+			row["action"] = file.action_;
+			row["change"] = file.change_ == kDefaultChangelist ? "default" : std::to_string(file.change_);
+		}
+		result->results_.push_back(std::move(row));
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::submit(const PathList& filePaths, const char* description, bool bKeepCheckedOut)
+{
+	return submitFiles(filePaths, bKeepCheckedOut);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::submit(int changelistId, bool bKeepCheckedOut)
+{
+	PathList filePaths;
+	{
+		std::lock_guard<std::mutex> guard(depot_->mutex_);
+		for (auto& file : depot_->files_)
+		{
+			if (!file.second.action_.empty() && file.second.change_ == changelistId)
+			{
+				filePaths.push_back(file.first);
+			}
+		}
+		depot_->changeLists_.erase(changelistId);
+	}
+	return submitFiles(filePaths, bKeepCheckedOut);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::submitFiles(const PathList& filePaths, bool bKeepCheckedOut)
+{
+	depot_->simulateLatency();
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	for (auto& path : filePaths)
+	{
+		auto found = depot_->files_.find(normalisePath(path));
+		if (found == depot_->files_.end() || found->second.action_.empty())
+		{
+			result->addError(path, "file(s) not opened on this client.");
+			continue;
+		}
+
+		auto& file = found->second;
+		if (file.action_ == "delete" || file.action_ == "move/delete")
+		{
+			depot_->files_.erase(found);
+			continue;
+		}
+
+		file.haveRev_ = ++file.headRev_;
+		if (bKeepCheckedOut)
+		{
+			file.action_ = "edit";
+		}
+		else
+		{
+			file.action_.clear();
+			file.change_ = kDefaultChangelist;
+		}
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::reopen(const PathList& filePaths, ChangeListId changeListId)
+{
+	depot_->simulateLatency();
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	for (auto& path : filePaths)
+	{
+		auto found = depot_->files_.find(normalisePath(path));
+		if (found == depot_->files_.end() || found->second.action_.empty())
+		{
+			result->addError(path, "file(s) not opened on this client.");
+			continue;
+		}
+		found->second.change_ = changeListId;
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::createChangeList(const char* description, ChangeListId& rChangeListId)
+{
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	rChangeListId = depot_->nextChangeList_++;
+	depot_->changeLists_[rChangeListId] = description ? description : "";
+	result->output_ = "Change " + std::to_string(rChangeListId) + " created.";
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::deleteEmptyChangeList(ChangeListId changeListId)
+{
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	for (auto& file : depot_->files_)
+	{
+		if (!file.second.action_.empty() && file.second.change_ == changeListId)
+		{
+			result->addError(std::to_string(changeListId), "change has files open.");
+			return std::move(result);
+		}
+	}
+	depot_->changeLists_.erase(changeListId);
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::querySubDirs(const char* parentDir)
+{
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	std::string parent = normalisePath(parentDir ? parentDir : "");
+	if (!parent.empty() && parent.back() != '/')
+	{
+		parent += '/';
+	}
+
+	std::lock_guard<std::mutex> guard(depot_->mutex_);
+	std::string last;
+	for (auto it = depot_->files_.lower_bound(parent); it != depot_->files_.end(); ++it)
+	{
+		if (it->first.compare(0, parent.size(), parent) != 0)
+		{
+			break;
+		}
+		auto slash = it->first.find('/', parent.size());
+		if (slash == std::string::npos)
+		{
+			continue;
+		}
+		auto dir = it->first.substr(0, slash);
+		if (dir != last)
+		{
+			Attributes row;
+			row["dir"] = depotPath_ + dir;
+			result->results_.push_back(std::move(row));
+			last = dir;
+		}
+	}
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeDepotView::getTicket()
+{
+	std::unique_ptr<FakeResult> result(new FakeResult);
+	result->output_ = "FAKE_TICKET";
+	return std::move(result);
+}
+
+//------------------------------------------------------------------------------
+const char* FakeDepotView::getClient() const
+{
+	return "fake_client";
+}
+
+//------------------------------------------------------------------------------
+const char* FakeDepotView::getDepot() const
+{
+	return depotPath_.c_str();
+}
+
+//------------------------------------------------------------------------------
+const char* FakeDepotView::getPassword() const
+{
+	return "";
+}
+
+//------------------------------------------------------------------------------
+const char* FakeDepotView::getUser() const
+{
+	return "fake_user";
+}
+
+//------------------------------------------------------------------------------
+std::string FakeDepotView::getClientRoot()
+{
+	return clientPath_;
+}
+
+//------------------------------------------------------------------------------
+std::string FakeDepotView::getDepotRoot()
+{
+	return depotPath_;
+}
+
+//------------------------------------------------------------------------------
+std::vector<std::string> FakeDepotView::getClientNames()
+{
+	return std::vector<std::string>(1, getClient());
+}
+
+//==============================================================================
+FakeVersionControl::FakeVersionControl() : depot_(std::make_shared<FakeDepot>())
+{
+}
+
+//------------------------------------------------------------------------------
+IResultPtr FakeVersionControl::initialize(const char* depot, const char* port, const char* user, const char* client,
+                                          const char* password)
+{
+	return IResultPtr(new FakeResult);
+}
+
+//------------------------------------------------------------------------------
+std::unique_ptr<IDepotView> FakeVersionControl::createDepotView(const char* depotPath, const char* clientPath)
+{
+	return std::unique_ptr<IDepotView>(new FakeDepotView(depot_, depotPath, clientPath));
+}
+
+//------------------------------------------------------------------------------
+const FakeDepotPtr& FakeVersionControl::getDepot() const
+{
+	return depot_;
+}
+} // end namespace wgt
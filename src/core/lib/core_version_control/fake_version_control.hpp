@@ -0,0 +1,125 @@
+#ifndef FAKE_VERSION_CONTROL_HPP
+#define FAKE_VERSION_CONTROL_HPP
+
+#include "version_control/i_version_control.hpp"
+#include "version_control/i_depot_view.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace wgt
+{
+//==============================================================================
+/**
+* In-memory depot used to exercise version control clients without a server.
+* File paths are used as both client and depot paths, status rows mirror the
+* fstat keys the Perforce plugin returns (clientFile, depotFile, headRev,
+* haveRev, action).
+*/
+class FakeDepot
+{
+public:
+	struct File
+	{
+		File() : headRev_(0), haveRev_(0), change_(IDepotView::kDefaultChangelist)
+		{
+		}
+
+		int headRev_;
+		int haveRev_;
+		std::string action_;
+		IDepotView::ChangeListId change_;
+	};
+
+	FakeDepot();
+
+	/** Adds a file as if it had been submitted by someone else. */
+	void addFile(const char* path, int headRev = 1);
+
+	bool findFile(const char* path, File& o_File) const;
+
+	/** Simulated server round trip, applied to every command. */
+	void setLatency(std::chrono::microseconds latency);
+
+	size_t getStatusCallCount() const;
+
+private:
+	friend class FakeDepotView;
+
+	typedef std::map<std::string, File> Files;
+
+	void simulateLatency() const;
+
+	mutable std::mutex mutex_;
+	Files files_;
+	std::map<IDepotView::ChangeListId, std::string> changeLists_;
+	IDepotView::ChangeListId nextChangeList_;
+	std::chrono::microseconds latency_;
+	mutable std::atomic<size_t> statusCalls_;
+};
+
+typedef std::shared_ptr<FakeDepot> FakeDepotPtr;
+
+//==============================================================================
+class FakeDepotView : public IDepotView
+{
+public:
+	FakeDepotView(FakeDepotPtr depot, const char* depotPath, const char* clientPath);
+
+	virtual IResultPtr add(const PathList& filePaths, ChangeListId changeListId = kDefaultChangelist) override;
+	virtual IResultPtr remove(const PathList& filePaths, ChangeListId changeListId = kDefaultChangelist) override;
+	virtual IResultPtr checkout(const PathList& filePaths, ChangeListId changeListId = kDefaultChangelist) override;
+	virtual IResultPtr rename(const FilePairs& filePairs, ChangeListId changeListId = kDefaultChangelist) override;
+	virtual IResultPtr move(const char* srcFile, const char* dstFile,
+	                        ChangeListId changeListId = kDefaultChangelist) override;
+	virtual IResultPtr revert(const PathList& filePaths) override;
+	virtual IResultPtr revertUnchanged(const PathList& filePaths) override;
+	virtual IResultPtr get(const PathList& filePaths, Revision revision = kHeadRevion) override;
+	virtual IResultPtr getRevisionBetween(const PathList& filePaths, int fromChangelist, int toChangelist) override;
+	virtual IResultPtr getLatest(const PathList& filePaths) override;
+	virtual IResultPtr status(const PathList& filePaths) override;
+	virtual IResultPtr submit(const PathList& filePaths, const char* description = "",
+	                          bool bKeepCheckedOut = false) override;
+	virtual IResultPtr submit(int changelistId, bool bKeepCheckedOut = false) override;
+	virtual IResultPtr reopen(const PathList& filePaths, ChangeListId changeListId = kDefaultChangelist) override;
+	virtual IResultPtr createChangeList(const char* description, ChangeListId& rChangeListId) override;
+	virtual IResultPtr deleteEmptyChangeList(ChangeListId changeListId) override;
+	virtual IResultPtr querySubDirs(const char* parentDir = "") override;
+	virtual IResultPtr getTicket() override;
+
+	virtual const char* getClient() const override;
+	virtual const char* getDepot() const override;
+	virtual const char* getPassword() const override;
+	virtual const char* getUser() const override;
+	virtual std::string getClientRoot() override;
+	virtual std::string getDepotRoot() override;
+
+	virtual std::vector<std::string> getClientNames() override;
+
+private:
+	IResultPtr submitFiles(const PathList& filePaths, bool bKeepCheckedOut);
+
+	FakeDepotPtr depot_;
+	std::string depotPath_;
+	std::string clientPath_;
+};
+
+//==============================================================================
+class FakeVersionControl : public IVersionControl
+{
+public:
+	FakeVersionControl();
+
+	virtual IResultPtr initialize(const char* depot, const char* port, const char* user, const char* client,
+	                              const char* password) override;
+	virtual std::unique_ptr<IDepotView> createDepotView(const char* depotPath, const char* clientPath) override;
+
+	const FakeDepotPtr& getDepot() const;
+
+private:
+	FakeDepotPtr depot_;
+};
+} // end namespace wgt
+#endif // FAKE_VERSION_CONTROL_HPP
@@ -0,0 +1,169 @@
+#include "pch.hpp"
+
+#include "core_version_control/depot_status_service.hpp"
+#include "core_version_control/fake_version_control.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace wgt
+{
+namespace
+{
+IDepotView::PathList makePaths(size_t count)
+{
+	IDepotView::PathList paths;
+	paths.reserve(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		paths.push_back("assets/models/model_" + std::to_string(i) + ".model");
+	}
+	return paths;
+}
+
+std::string getAttribute(const Attributes& attributes, const char* name)
+{
+	auto found = attributes.find(name);
+	return found != attributes.end() ? found->second : std::string();
+}
+}
+
+//------------------------------------------------------------------------------
+TEST(fake_depot_tracks_file_actions)
+{
+	FakeVersionControl versionControl;
+	auto depotView = versionControl.createDepotView("//depot/", "c:/depot/");
+	versionControl.getDepot()->addFile("assets/tree.model", 3);
+
+	IDepotView::PathList edited(1, "assets/tree.model");
+	IDepotView::PathList added(1, "assets/rock.model");
+	CHECK(!depotView->checkout(edited)->hasErrors());
+	CHECK(!depotView->add(added)->hasErrors());
+	CHECK(depotView->add(edited)->hasErrors());
+
+	IDepotView::PathList both = { "assets/tree.model", "assets/rock.model", "assets/missing.model" };
+	auto status = depotView->status(both);
+	CHECK(status->hasErrors());
+	CHECK_EQUAL(2, status->results().size());
+	CHECK_EQUAL("edit", getAttribute(status->results()[0], "action"));
+	CHECK_EQUAL("3", getAttribute(status->results()[0], "headRev"));
+	CHECK_EQUAL("//depot/assets/tree.model", getAttribute(status->results()[0], "depotFile"));
+	CHECK_EQUAL("add", getAttribute(status->results()[1], "action"));
+
+	IDepotView::PathList opened = { "assets/tree.model", "assets/rock.model" };
+	CHECK(!depotView->submit(opened, "test")->hasErrors());
+	FakeDepot::File file;
+	CHECK(versionControl.getDepot()->findFile("assets/tree.model", file));
+	CHECK_EQUAL(4, file.headRev_);
+	CHECK(file.action_.empty());
+	CHECK(versionControl.getDepot()->findFile("assets/rock.model", file));
+	CHECK_EQUAL(1, file.headRev_);
+}
+
+//------------------------------------------------------------------------------
+TEST(depot_status_service_batches_requests)
+{
+	FakeVersionControl versionControl;
+	auto depotView = versionControl.createDepotView("//depot/", "");
+	auto paths = makePaths(1000);
+	for (auto& path : paths)
+	{
+		versionControl.getDepot()->addFile(path.c_str());
+	}
+
+	DepotStatusService service(*depotView);
+	service.setCoalesceDelay(std::chrono::milliseconds(200));
+	service.setMaxBatchSize(250);
+
+	std::atomic<int> notified(0);
+	auto connection = service.connectStatusChanged([&](const char*, const Attributes&) { ++notified; });
+
+	Attributes status;
+	for (auto& path : paths)
+	{
+		CHECK(!service.getStatus(path.c_str(), status));
+	}
+	service.flush();
+
+	CHECK_EQUAL(1000, notified.load());
+	CHECK_EQUAL(4, service.getBatchCount());
+	CHECK_EQUAL(4, versionControl.getDepot()->getStatusCallCount());
+
+	// Answered from the cache without another round trip
+	CHECK(service.getStatus("assets\\models\\model_10.model", status));
+	CHECK_EQUAL("1", getAttribute(status, "haveRev"));
+	service.requestStatus(paths);
+	service.flush();
+	CHECK_EQUAL(4, service.getBatchCount());
+	connection.disconnect();
+}
+
+//------------------------------------------------------------------------------
+TEST(depot_status_service_refreshes_invalidated_files)
+{
+	FakeVersionControl versionControl;
+	auto depotView = versionControl.createDepotView("//depot/", "");
+	versionControl.getDepot()->addFile("assets/tree.model", 2);
+
+	DepotStatusService service(*depotView);
+	service.setCoalesceDelay(std::chrono::milliseconds(0));
+
+	Attributes status;
+	service.requestStatus("assets/tree.model");
+	service.requestStatus("assets/new.model");
+	service.flush();
+	CHECK(service.getStatus("assets/tree.model", status));
+	CHECK(getAttribute(status, "action").empty());
+	CHECK(service.getStatus("assets/new.model", status));
+	CHECK(status.empty());
+
+	IDepotView::PathList tree(1, "assets/tree.model");
+	IDepotView::PathList added(1, "assets/new.model");
+	depotView->checkout(tree);
+	depotView->add(added);
+
+	// Still served from the cache until invalidated
+	CHECK(service.getStatus("assets/tree.model", status));
+	CHECK(getAttribute(status, "action").empty());
+
+	service.invalidate("assets/tree.model");
+	service.invalidate("assets/new.model");
+	service.flush();
+	CHECK(service.getStatus("assets/tree.model", status));
+	CHECK_EQUAL("edit", getAttribute(status, "action"));
+	CHECK(service.getStatus("assets/new.model", status));
+	CHECK_EQUAL("add", getAttribute(status, "action"));
+
+	service.invalidateAll();
+	CHECK(!service.getStatus("assets/tree.model", status));
+	service.flush();
+	CHECK(service.getStatus("assets/tree.model", status));
+}
+
+//------------------------------------------------------------------------------
+TEST(depot_status_service_splits_large_requests)
+{
+	FakeVersionControl versionControl;
+	auto depotView = versionControl.createDepotView("//depot/", "");
+	auto paths = makePaths(5000);
+	for (auto& path : paths)
+	{
+		versionControl.getDepot()->addFile(path.c_str());
+	}
+
+	// Every file is answered by a few full batches rather than a call each
+	DepotStatusService service(*depotView);
+	service.setMaxBatchSize(500);
+	service.requestStatus(paths);
+	service.flush();
+	CHECK_EQUAL(10, service.getBatchCount());
+	CHECK_EQUAL(10, versionControl.getDepot()->getStatusCallCount());
+
+	Attributes status;
+	for (auto& path : paths)
+	{
+		CHECK(service.getStatus(path.c_str(), status));
+	}
+	CHECK_EQUAL(10, versionControl.getDepot()->getStatusCallCount());
+}
+} // end namespace wgt
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cstdlib>
 #include <memory.h>
 #include <memory>
@@ -23,6 +24,7 @@ static bool ALLOCATOR_LOGGING = true;
 static bool ALLOCATOR_DEBUG_OUTPUT = false;
 static bool ALLOCATOR_STACK_TRACES = false;
 static bool ALLOCATOR_LEAK_DETECTION = false;
+static std::atomic<size_t> ALLOCATOR_SAMPLE_RATE(512 * 1024);
 
 #ifdef HAVE_CUSTOM_ALLOCATOR
 static NGTAllocator::allocateFn ALLOCATOR_FN = nullptr;
@@ -127,6 +129,8 @@ BOOL __stdcall SymGetLineFromAddr64(HANDLE hProcess, DWORD64 qwAddr, PDWORD pdwD
 
 namespace NGTAllocator
 {
+bool shouldSampleAllocation(size_t size, size_t sampleRate);
+
 class MemoryContext
 {
 	static const size_t numFramesToCapture_ = 25;
@@ -193,7 +197,39 @@ private:
 	typedef std::basic_string<char, std::char_traits<char>, UntrackedAllocator<char>> UntrackedString;
 
 public:
-	MemoryContext() : parentContext_(nullptr), allocId_(0)
+	// Guarded by allocationLock_
+	struct Counters
+	{
+		size_t liveBytes_;
+		size_t peakBytes_;
+		size_t liveAllocations_;
+		size_t totalAllocations_;
+		size_t totalBytes_;
+		size_t bySizeClass_[SIZE_CLASS_COUNT];
+	};
+
+	// Copies taken while collecting a snapshot, where the tracked heap may not be used
+	struct RawStats
+	{
+		uint64_t id_;
+		wchar_t name_[255];
+		size_t depth_;
+		Counters counters_;
+	};
+
+	struct RawSample
+	{
+		size_t context_;
+		size_t size_;
+		size_t weight_;
+		size_t frames_;
+		void* addrs_[numFramesToCapture_];
+	};
+
+	typedef std::vector<RawStats, UntrackedAllocator<RawStats>> RawStatsList;
+	typedef std::vector<RawSample, UntrackedAllocator<RawSample>> RawSampleList;
+
+	MemoryContext() : parentContext_(nullptr), counters_(), allocId_(0)
 	{
 		wcscpy(name_, L"root");
 #ifdef _WIN32
@@ -206,7 +242,8 @@ public:
 #endif
 	}
 
-	MemoryContext(const wchar_t* name, MemoryContext* parentContext) : parentContext_(parentContext), allocId_(0)
+	MemoryContext(const wchar_t* name, MemoryContext* parentContext)
+	    : parentContext_(parentContext), counters_(), allocId_(0)
     {
 		TF_ASSERT(parentContext_ != nullptr);
 		wcscpy(name_, name);
@@ -230,6 +267,11 @@ public:
 		}
 	}
 
+	MemoryContext* parentContext() const
+	{
+		return parentContext_;
+	}
+
 	void* allocate(size_t size)
 	{
 		AllocationPtr allocation = AllocationPtr();
@@ -249,9 +291,23 @@ public:
 		}
 
 		allocation->frames_ = 0;
+		allocation->size_ = size;
+		allocation->weight_ = 0;
 		if (ALLOCATOR_STACK_TRACES)
 		{
 			allocation->frames_ = RtlCaptureStackBackTraceFunc(3, numFramesToCapture_, allocation->addrs_, NULL);
+			allocation->weight_ = size;
+		}
+		else
+		{
+			// Each sample stands for the sample rate's worth of bytes allocated on this thread
+			const size_t sampleRate = ALLOCATOR_SAMPLE_RATE.load(std::memory_order_relaxed);
+			if (sampleRate != 0 && RtlCaptureStackBackTraceFunc != nullptr &&
+			    shouldSampleAllocation(size, sampleRate))
+			{
+				allocation->frames_ = RtlCaptureStackBackTraceFunc(3, numFramesToCapture_, allocation->addrs_, NULL);
+				allocation->weight_ = std::max(size, sampleRate);
+			}
 		}
 
 		auto ptr = wgt::internal::malloc(size);
@@ -260,6 +316,13 @@ public:
 			std::lock_guard<std::mutex> allocationGuard(allocationLock_);
 			allocation->allocId_ = allocId_++;
 			liveAllocations_.insert(std::make_pair(ptr, std::move(allocation)));
+
+			counters_.liveBytes_ += size;
+			counters_.peakBytes_ = std::max(counters_.peakBytes_, counters_.liveBytes_);
+			++counters_.liveAllocations_;
+			++counters_.totalAllocations_;
+			counters_.totalBytes_ += size;
+			++counters_.bySizeClass_[getSizeClass(size)];
 		}
 
 		if (ALLOCATOR_DEBUG_OUTPUT && ALLOCATOR_LOGGING)
@@ -607,6 +670,8 @@ public:
 				liveAllocation.second.reset();
 			}
 			liveAllocations_.clear();
+			counters_.liveBytes_ = 0;
+			counters_.liveAllocations_ = 0;
 		}
 
 		{
@@ -621,12 +686,74 @@ public:
 		return !hasLeaks;
 	}
 
+	/**
+	Copies the statistics of this context and its children, in depth first order.
+	*/
+	void collect(RawStatsList& o_Stats, RawSampleList& o_Samples, size_t depth)
+	{
+		RawStats stats;
+		stats.id_ = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this));
+		wcscpy(stats.name_, name_);
+		stats.depth_ = depth;
+
+		const auto contextIndex = o_Stats.size();
+		{
+			std::lock_guard<std::mutex> allocationGuard(allocationLock_);
+			stats.counters_ = counters_;
+			for (auto& liveAllocation : liveAllocations_)
+			{
+				const auto& allocation = *liveAllocation.second;
+				if (allocation.weight_ == 0)
+				{
+					continue;
+				}
+
+				RawSample sample;
+				sample.context_ = contextIndex;
+				sample.size_ = allocation.size_;
+				sample.weight_ = allocation.weight_;
+				sample.frames_ = allocation.frames_;
+				std::copy(allocation.addrs_, allocation.addrs_ + allocation.frames_, sample.addrs_);
+				o_Samples.push_back(sample);
+			}
+		}
+		o_Stats.push_back(stats);
+
+		std::lock_guard<std::mutex> childContextsGuard(childContextsLock_);
+		for (auto context : childContexts_)
+		{
+			context->collect(o_Stats, o_Samples, depth + 1);
+		}
+	}
+
+	/**
+	Resolves a frame without the trailing newline used by the leak output.
+	*/
+	std::string resolveFrame(void* ptr)
+	{
+		std::lock_guard<std::mutex> symbolGuard(symbolLock_);
+		if (!symbolsInitialized_)
+		{
+			initSymbols();
+			symbolsInitialized_ = true;
+		}
+		auto symbol = resolveSymbol(::GetCurrentProcess(), ptr);
+		while (!symbol.empty() && (symbol.back() == '\n' || symbol.back() == '\r'))
+		{
+			symbol.pop_back();
+		}
+		return std::string(symbol.c_str(), symbol.size());
+	}
+
 private:
 	struct Allocation
 	{
 		void* addrs_[numFramesToCapture_];
 		size_t frames_;
 		size_t allocId_;
+		size_t size_;
+		// Bytes this allocation stands for in sampled statistics, 0 if its stack was not captured
+		size_t weight_;
 
 		static void* operator new(size_t sz)
 		{
@@ -651,6 +778,7 @@ private:
 	std::vector<MemoryContext*, UntrackedAllocator<MemoryContext*>> childContexts_;
 
 	std::mutex allocationLock_;
+	Counters counters_;
 	size_t allocId_;
 	std::unordered_map<void*, AllocationPtr, std::hash<void*>, std::equal_to<void*>,
 	                   UntrackedAllocator<std::pair<void* const, AllocationPtr>>>
@@ -662,6 +790,9 @@ private:
 
 	StackCache stackCache_;
 
+	std::mutex symbolLock_;
+	bool symbolsInitialized_ = false;
+
 	/**
 	Deallocate using this context or its children recursively.
 	*/
@@ -685,6 +816,10 @@ private:
 						(size_t)ptr, name_, (size_t)this, h(std::this_thread::get_id()));
 				}
 
+				const auto size = findIt->second->size_;
+				counters_.liveBytes_ -= size;
+				--counters_.liveAllocations_;
+
 				{
 					std::lock_guard<std::mutex> allocationPoolGuard(allocationPoolLock_);
 					allocationPool_.push_back(std::move(findIt->second));
@@ -739,6 +874,24 @@ THREAD_LOCAL(int)
 s_MemoryStackPos(0);
 THREAD_LOCAL(MemoryContext*)
 s_MemoryContext[20];
+THREAD_LOCAL(size_t)
+s_BytesUntilSample(0);
+
+//------------------------------------------------------------------------------
+bool shouldSampleAllocation(size_t size, size_t sampleRate)
+{
+	const size_t bytesUntilSample = THREAD_LOCAL_GET(s_BytesUntilSample);
+	if (size < bytesUntilSample)
+	{
+		THREAD_LOCAL_SET(s_BytesUntilSample, bytesUntilSample - size);
+		return false;
+	}
+
+	// Carry the overshoot so large allocations do not skew the next interval
+	const size_t overshoot = (size - bytesUntilSample) % sampleRate;
+	THREAD_LOCAL_SET(s_BytesUntilSample, sampleRate - overshoot);
+	return true;
+}
 
 //------------------------------------------------------------------------------
 MemoryContext* getMemoryContext()
@@ -861,6 +1014,120 @@ void enableLeakDetection(bool enable)
 	ALLOCATOR_LEAK_DETECTION = enable;
 }
 
+//------------------------------------------------------------------------------
+void setStackSampleRate(size_t sampleRate)
+{
+	ALLOCATOR_SAMPLE_RATE = sampleRate;
+}
+
+//------------------------------------------------------------------------------
+size_t getSizeClass(size_t size)
+{
+	size_t sizeClass = 0;
+	size_t limit = 16;
+	while (size > limit && sizeClass + 1 < SIZE_CLASS_COUNT)
+	{
+		limit <<= 2;
+		++sizeClass;
+	}
+	return sizeClass;
+}
+
+//------------------------------------------------------------------------------
+size_t getSizeClassLimit(size_t sizeClass)
+{
+	return sizeClass + 1 < SIZE_CLASS_COUNT ? size_t(16) << (2 * sizeClass) : 0;
+}
+
+//------------------------------------------------------------------------------
+void snapshotMemoryContexts(MemorySnapshot& o_Snapshot)
+{
+	auto rootContext = getMemoryContext();
+	while (rootContext->parentContext())
+	{
+		rootContext = rootContext->parentContext();
+	}
+
+	// Collect with the context locks held into untracked storage, then build the
+	// snapshot once they are released as it allocates through the tracked heap.
+	MemoryContext::RawStatsList rawStats;
+	MemoryContext::RawSampleList rawSamples;
+	rootContext->collect(rawStats, rawSamples, 0);
+
+	o_Snapshot.time_ = std::chrono::steady_clock::now();
+	o_Snapshot.sampleRate_ = ALLOCATOR_STACK_TRACES ? 1 : ALLOCATOR_SAMPLE_RATE.load();
+	o_Snapshot.root_ = MemoryContextStats();
+
+	std::vector<MemoryContextStats*> path;
+	for (auto& raw : rawStats)
+	{
+		path.resize(raw.depth_);
+		MemoryContextStats* stats = &o_Snapshot.root_;
+		if (!path.empty())
+		{
+			path.back()->children_.emplace_back();
+			stats = &path.back()->children_.back();
+		}
+		path.push_back(stats);
+
+		stats->id_ = raw.id_;
+		stats->name_ = raw.name_;
+		stats->liveBytes_ = raw.counters_.liveBytes_;
+		stats->peakBytes_ = raw.counters_.peakBytes_;
+		stats->liveAllocations_ = raw.counters_.liveAllocations_;
+		stats->totalAllocations_ = raw.counters_.totalAllocations_;
+		stats->totalBytes_ = raw.counters_.totalBytes_;
+		std::copy(raw.counters_.bySizeClass_, raw.counters_.bySizeClass_ + SIZE_CLASS_COUNT,
+		          stats->allocationsBySizeClass_);
+	}
+
+	// The tree is complete, so pointers into it stay valid while grouping the samples.
+	// Flattening visits contexts in the same depth first order they were collected in.
+	std::vector<MemoryContextStats*> contexts;
+	std::function<void(MemoryContextStats&)> flatten = [&](MemoryContextStats& stats) {
+		contexts.push_back(&stats);
+		for (auto& child : stats.children_)
+		{
+			flatten(child);
+		}
+	};
+	flatten(o_Snapshot.root_);
+
+	std::vector<std::unordered_map<uint64_t, size_t>> siteIndices(contexts.size());
+	for (auto& sample : rawSamples)
+	{
+		uint64_t hash = 0;
+		for (size_t i = 0; i < sample.frames_; ++i)
+		{
+			HashUtilities::directCombine(hash, (uint64_t)sample.addrs_[i]);
+		}
+
+		auto& stats = *contexts[sample.context_];
+		auto inserted = siteIndices[sample.context_].insert(std::make_pair(hash, stats.sites_.size()));
+		if (inserted.second)
+		{
+			AllocationSite site = {};
+			for (size_t i = 0; i < sample.frames_; ++i)
+			{
+				site.frames_.push_back(rootContext->resolveFrame(sample.addrs_[i]));
+			}
+			stats.sites_.push_back(std::move(site));
+		}
+
+		auto& site = stats.sites_[inserted.first->second];
+		++site.sampledAllocations_;
+		site.sampledBytes_ += sample.size_;
+		site.estimatedBytes_ += sample.weight_;
+	}
+
+	for (auto stats : contexts)
+	{
+		std::sort(stats->sites_.begin(), stats->sites_.end(), [](const AllocationSite& a, const AllocationSite& b) {
+			return a.estimatedBytes_ > b.estimatedBytes_;
+		});
+	}
+}
+
 //------------------------------------------------------------------------------
 void printCallstack(size_t framesToSkip, PrintFn fn)
 {
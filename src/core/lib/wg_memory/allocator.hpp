@@ -2,6 +2,7 @@
 #define NGT_ALLOCATOR_HPP
 
 #include "wg_memory_dll.hpp"
+#include "memory_stats.hpp"
 #include <cstddef>
 #include <functional>
 
@@ -25,6 +26,19 @@ WG_MEMORY_DLL void enableStackTraces(bool enable);
 WG_MEMORY_DLL void enableLeakDetection(bool enable);
 WG_MEMORY_DLL void enableLogging(bool enable);
 
+/**
+* Captures the call stack of roughly one in every sampleRate allocated bytes,
+* without the cost of enableStackTraces. 0 disables sampling.
+*/
+WG_MEMORY_DLL void setStackSampleRate(size_t sampleRate);
+
+/**
+* Snapshots the statistics of every memory context.
+* Per context counters are always maintained, call stacks are only available
+* for sampled allocations, or for every allocation with stack traces enabled.
+*/
+WG_MEMORY_DLL void snapshotMemoryContexts(MemorySnapshot& o_Snapshot);
+
 typedef std::function<void(const char*)> PrintFn;
 WG_MEMORY_DLL void printCallstack(size_t framesToSkip, PrintFn fn);
 
@@ -0,0 +1,276 @@
+#include "memory_stats.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <unordered_map>
+
+namespace wgt
+{
+namespace NGTAllocator
+{
+namespace
+{
+typedef std::unordered_map<uint64_t, const MemoryContextStats*> ContextIndex;
+
+void indexContexts(const MemoryContextStats& stats, ContextIndex& o_Index)
+{
+	o_Index[stats.id_] = &stats;
+	for (auto& child : stats.children_)
+	{
+		indexContexts(child, o_Index);
+	}
+}
+
+struct Rates
+{
+	Rates(const MemorySnapshot& snapshot, const MemorySnapshot* previous) : seconds_(0.0)
+	{
+		if (previous != nullptr)
+		{
+			seconds_ = std::chrono::duration<double>(snapshot.time_ - previous->time_).count();
+			indexContexts(previous->root_, previous_);
+		}
+	}
+
+	/** Allocations per second in the size class since the previous snapshot, or a negative value. */
+	double get(const MemoryContextStats& stats, size_t sizeClass) const
+	{
+		auto found = previous_.find(stats.id_);
+		if (seconds_ <= 0.0 || found == previous_.end())
+		{
+			return -1.0;
+		}
+		const auto before = found->second->allocationsBySizeClass_[sizeClass];
+		const auto now = stats.allocationsBySizeClass_[sizeClass];
+		return now >= before ? (now - before) / seconds_ : -1.0;
+	}
+
+	double seconds_;
+	ContextIndex previous_;
+};
+
+std::string toUtf8(const std::wstring& str)
+{
+	std::string result;
+	result.reserve(str.size());
+	for (auto ch : str)
+	{
+		const auto code = static_cast<uint32_t>(ch);
+		if (code < 0x80)
+		{
+			result += static_cast<char>(code);
+		}
+		else if (code < 0x800)
+		{
+			result += static_cast<char>(0xC0 | (code >> 6));
+			result += static_cast<char>(0x80 | (code & 0x3F));
+		}
+		else
+		{
+			result += static_cast<char>(0xE0 | ((code >> 12) & 0x0F));
+			result += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			result += static_cast<char>(0x80 | (code & 0x3F));
+		}
+	}
+	return result;
+}
+
+void appendFormat(std::string& o_Out, const char* format, ...)
+{
+	char buffer[512];
+	va_list args;
+	va_start(args, format);
+	const auto length = vsnprintf(buffer, sizeof(buffer), format, args);
+	va_end(args);
+	if (length > 0)
+	{
+		o_Out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+	}
+}
+
+void appendSize(std::string& o_Out, size_t bytes)
+{
+	if (bytes >= 1024 * 1024)
+	{
+		appendFormat(o_Out, "%.2f MB", bytes / (1024.0 * 1024.0));
+	}
+	else if (bytes >= 1024)
+	{
+		appendFormat(o_Out, "%.2f KB", bytes / 1024.0);
+	}
+	else
+	{
+		appendFormat(o_Out, "%zu B", bytes);
+	}
+}
+
+void appendJsonString(std::string& o_Out, const std::string& str)
+{
+	o_Out += '"';
+	for (auto ch : str)
+	{
+		switch (ch)
+		{
+		case '"':
+			o_Out += "\\\"";
+			break;
+		case '\\':
+			o_Out += "\\\\";
+			break;
+		case '\n':
+			o_Out += "\\n";
+			break;
+		case '\r':
+			o_Out += "\\r";
+			break;
+		case '\t':
+			o_Out += "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(ch) < 0x20)
+			{
+				appendFormat(o_Out, "\\u%04x", static_cast<unsigned>(ch));
+			}
+			else
+			{
+				o_Out += ch;
+			}
+			break;
+		}
+	}
+	o_Out += '"';
+}
+
+void writeText(std::string& o_Out, const MemoryContextStats& stats, const Rates& rates, size_t depth)
+{
+	const std::string indent(depth * 2, ' ');
+	o_Out += indent + toUtf8(stats.name_) + ": ";
+	appendSize(o_Out, stats.liveBytes_);
+	o_Out += " live (peak ";
+	appendSize(o_Out, stats.peakBytes_);
+	appendFormat(o_Out, ") in %zu allocations, %zu allocations totalling ", stats.liveAllocations_,
+	             stats.totalAllocations_);
+	appendSize(o_Out, stats.totalBytes_);
+	o_Out += "\n";
+
+	for (size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass)
+	{
+		const auto count = stats.allocationsBySizeClass_[sizeClass];
+		if (count == 0)
+		{
+			continue;
+		}
+
+		const auto limit = getSizeClassLimit(sizeClass);
+		o_Out += indent + (limit != 0 ? "    <= " : "    >  ");
+		appendSize(o_Out, limit != 0 ? limit : getSizeClassLimit(sizeClass - 1));
+		appendFormat(o_Out, ": %zu", count);
+		const auto rate = rates.get(stats, sizeClass);
+		if (rate >= 0.0)
+		{
+			appendFormat(o_Out, " (%.1f/s)", rate);
+		}
+		o_Out += "\n";
+	}
+
+	for (auto& site : stats.sites_)
+	{
+		o_Out += indent + "    ~";
+		appendSize(o_Out, site.estimatedBytes_);
+		appendFormat(o_Out, " from %zu sampled allocations at\n", site.sampledAllocations_);
+		for (auto& frame : site.frames_)
+		{
+			o_Out += indent + "        " + frame + "\n";
+		}
+	}
+
+	for (auto& child : stats.children_)
+	{
+		writeText(o_Out, child, rates, depth + 1);
+	}
+}
+
+void writeJson(std::string& o_Out, const MemoryContextStats& stats, const Rates& rates)
+{
+	o_Out += "{\"name\":";
+	appendJsonString(o_Out, toUtf8(stats.name_));
+	appendFormat(o_Out, ",\"liveBytes\":%zu,\"peakBytes\":%zu,\"liveAllocations\":%zu", stats.liveBytes_,
+	             stats.peakBytes_, stats.liveAllocations_);
+	appendFormat(o_Out, ",\"totalAllocations\":%zu,\"totalBytes\":%zu", stats.totalAllocations_, stats.totalBytes_);
+
+	o_Out += ",\"sizeClasses\":[";
+	for (size_t sizeClass = 0; sizeClass < SIZE_CLASS_COUNT; ++sizeClass)
+	{
+		appendFormat(o_Out, "%s{\"limit\":%zu,\"allocations\":%zu", sizeClass != 0 ? "," : "",
+		             getSizeClassLimit(sizeClass), stats.allocationsBySizeClass_[sizeClass]);
+		const auto rate = rates.get(stats, sizeClass);
+		if (rate >= 0.0)
+		{
+			appendFormat(o_Out, ",\"perSecond\":%.3f", rate);
+		}
+		o_Out += "}";
+	}
+
+	o_Out += "],\"sites\":[";
+	for (size_t i = 0; i < stats.sites_.size(); ++i)
+	{
+		auto& site = stats.sites_[i];
+		appendFormat(o_Out, "%s{\"estimatedBytes\":%zu,\"sampledBytes\":%zu,\"sampledAllocations\":%zu,\"frames\":[",
+		             i != 0 ? "," : "", site.estimatedBytes_, site.sampledBytes_, site.sampledAllocations_);
+		for (size_t frame = 0; frame < site.frames_.size(); ++frame)
+		{
+			if (frame != 0)
+			{
+				o_Out += ",";
+			}
+			appendJsonString(o_Out, site.frames_[frame]);
+		}
+		o_Out += "]}";
+	}
+
+	o_Out += "],\"children\":[";
+	for (size_t i = 0; i < stats.children_.size(); ++i)
+	{
+		if (i != 0)
+		{
+			o_Out += ",";
+		}
+		writeJson(o_Out, stats.children_[i], rates);
+	}
+	o_Out += "]}";
+}
+}
+
+//------------------------------------------------------------------------------
+std::string memorySnapshotToText(const MemorySnapshot& snapshot, const MemorySnapshot* previous)
+{
+	Rates rates(snapshot, previous);
+	std::string text;
+	if (snapshot.sampleRate_ != 0)
+	{
+		text += "Stack sample rate: one per ";
+		appendSize(text, snapshot.sampleRate_);
+		text += "\n";
+	}
+	writeText(text, snapshot.root_, rates, 0);
+	return text;
+}
+
+//------------------------------------------------------------------------------
+std::string memorySnapshotToJson(const MemorySnapshot& snapshot, const MemorySnapshot* previous)
+{
+	Rates rates(snapshot, previous);
+	std::string json;
+	appendFormat(json, "{\"sampleRate\":%zu", snapshot.sampleRate_);
+	if (rates.seconds_ > 0.0)
+	{
+		appendFormat(json, ",\"intervalSeconds\":%.3f", rates.seconds_);
+	}
+	json += ",\"root\":";
+	writeJson(json, snapshot.root_, rates);
+	json += "}";
+	return json;
+}
+}
+} // end namespace wgt
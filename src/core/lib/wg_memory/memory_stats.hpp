@@ -0,0 +1,68 @@
+#ifndef NGT_MEMORY_STATS_HPP
+#define NGT_MEMORY_STATS_HPP
+
+#include "wg_memory_dll.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wgt
+{
+namespace NGTAllocator
+{
+/** Allocation sizes are bucketed by powers of four, from <= 16 bytes up to > 64KB. */
+static const size_t SIZE_CLASS_COUNT = 8;
+
+WG_MEMORY_DLL size_t getSizeClass(size_t size);
+/** Largest size in the class, or 0 for the last, unbounded class. */
+WG_MEMORY_DLL size_t getSizeClassLimit(size_t sizeClass);
+
+/** Live allocations sharing a sampled call stack. */
+struct AllocationSite
+{
+	std::vector<std::string> frames_;
+	size_t sampledAllocations_;
+	size_t sampledBytes_;
+	/** Live bytes the samples stand for, each sample represents about one sample interval of bytes. */
+	size_t estimatedBytes_;
+};
+
+struct MemoryContextStats
+{
+	/** Stable for the life of the context, used to match contexts between snapshots. */
+	uint64_t id_;
+	std::wstring name_;
+
+	size_t liveBytes_;
+	size_t peakBytes_;
+	size_t liveAllocations_;
+	size_t totalAllocations_;
+	size_t totalBytes_;
+	size_t allocationsBySizeClass_[SIZE_CLASS_COUNT];
+
+	/** Sampled allocation sites, largest estimated bytes first. */
+	std::vector<AllocationSite> sites_;
+	std::vector<MemoryContextStats> children_;
+};
+
+struct MemorySnapshot
+{
+	std::chrono::steady_clock::time_point time_;
+	size_t sampleRate_;
+	MemoryContextStats root_;
+};
+
+/**
+* Writes the context tree as indented text.
+* If a previous snapshot is given, allocation rates per size class are included.
+*/
+WG_MEMORY_DLL std::string memorySnapshotToText(const MemorySnapshot& snapshot,
+                                               const MemorySnapshot* previous = nullptr);
+WG_MEMORY_DLL std::string memorySnapshotToJson(const MemorySnapshot& snapshot,
+                                               const MemorySnapshot* previous = nullptr);
+}
+} // end namespace wgt
+#endif // NGT_MEMORY_STATS_HPP
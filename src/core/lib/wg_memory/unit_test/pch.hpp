@@ -0,0 +1,16 @@
+// stdafx.h : include file for standard system include files,
+// or project specific include files that are used frequently, but
+// are changed infrequently
+//
+
+#ifdef _WIN32
+#pragma once
+
+#include <stdio.h>
+#include <tchar.h>
+#endif
+
+// TODO: reference additional headers your program requires here
+#include "third_party/CppUnitLite2/src/CppUnitLite2.h"
+
+#include "core_unit_test/unit_test.hpp"
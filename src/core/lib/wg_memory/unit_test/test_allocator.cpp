@@ -0,0 +1,122 @@
+#include "pch.hpp"
+#include "wg_memory/allocator.hpp"
+
+#include <cwchar>
+#include <thread>
+
+namespace wgt
+{
+namespace NGTAllocator
+{
+namespace
+{
+const wchar_t* s_ContextName = L"test_allocator_samples";
+
+const MemoryContextStats* findContext(const MemoryContextStats& stats, const wchar_t* name)
+{
+	if (stats.name_ == name)
+	{
+		return &stats;
+	}
+	for (auto& child : stats.children_)
+	{
+		if (auto found = findContext(child, name))
+		{
+			return found;
+		}
+	}
+	return nullptr;
+}
+}
+
+//------------------------------------------------------------------------------
+TEST(allocator_size_classes)
+{
+	CHECK_EQUAL(0u, getSizeClass(0));
+	CHECK_EQUAL(0u, getSizeClass(16));
+	CHECK_EQUAL(1u, getSizeClass(17));
+	CHECK_EQUAL(1u, getSizeClass(64));
+	CHECK_EQUAL(2u, getSizeClass(65));
+	CHECK_EQUAL(2u, getSizeClass(256));
+	CHECK_EQUAL(6u, getSizeClass(65536));
+	CHECK_EQUAL(SIZE_CLASS_COUNT - 1, getSizeClass(65537));
+	CHECK_EQUAL(SIZE_CLASS_COUNT - 1, getSizeClass(size_t(1) << 40));
+
+	for (size_t sizeClass = 0; sizeClass + 1 < SIZE_CLASS_COUNT; ++sizeClass)
+	{
+		const auto limit = getSizeClassLimit(sizeClass);
+		CHECK_EQUAL(sizeClass, getSizeClass(limit));
+		CHECK_EQUAL(sizeClass + 1, getSizeClass(limit + 1));
+	}
+	CHECK_EQUAL(0u, getSizeClassLimit(SIZE_CLASS_COUNT - 1));
+}
+
+//------------------------------------------------------------------------------
+TEST(allocator_context_samples)
+{
+	const size_t sampleRate = 1024;
+	const size_t smallSize = 256;
+	const size_t smallCount = 100;
+	const size_t largeSize = 100000;
+
+	// A new thread starts counting down to its first sample from zero, so the
+	// first allocation is sampled and every sampleRate bytes after it.
+	MemorySnapshot snapshot;
+	std::thread worker([&]() {
+		auto context = createMemoryContext(s_ContextName);
+		pushMemoryContext(context);
+		setStackSampleRate(sampleRate);
+
+		void* small[smallCount];
+		for (size_t i = 0; i < smallCount; ++i)
+		{
+			small[i] = allocate(smallSize);
+		}
+		void* large = allocate(largeSize);
+
+		snapshotMemoryContexts(snapshot);
+
+		for (size_t i = 0; i < smallCount; ++i)
+		{
+			deallocate(small[i]);
+		}
+		deallocate(large);
+
+		setStackSampleRate(512 * 1024);
+		popMemoryContext();
+		destroyMemoryContext(context);
+	});
+	worker.join();
+
+	CHECK_EQUAL(sampleRate, snapshot.sampleRate_);
+	auto stats = findContext(snapshot.root_, s_ContextName);
+	RETURN_ON_FAIL_CHECK(stats != nullptr);
+
+	const size_t totalBytes = smallSize * smallCount + largeSize;
+	CHECK_EQUAL(smallCount + 1, stats->liveAllocations_);
+	CHECK_EQUAL(smallCount + 1, stats->totalAllocations_);
+	CHECK_EQUAL(totalBytes, stats->liveBytes_);
+	CHECK_EQUAL(totalBytes, stats->peakBytes_);
+	CHECK_EQUAL(totalBytes, stats->totalBytes_);
+	CHECK_EQUAL(smallCount, stats->allocationsBySizeClass_[getSizeClass(smallSize)]);
+	CHECK_EQUAL(1u, stats->allocationsBySizeClass_[SIZE_CLASS_COUNT - 1]);
+
+	size_t sampledAllocations = 0;
+	size_t sampledBytes = 0;
+	size_t estimatedBytes = 0;
+	for (auto& site : stats->sites_)
+	{
+		sampledAllocations += site.sampledAllocations_;
+		sampledBytes += site.sampledBytes_;
+		estimatedBytes += site.estimatedBytes_;
+	}
+
+	// The first small allocation, then one per interval of small allocations, and the large one which is
+	// larger than the interval. A small sample stands for a whole interval, a large one for its own size.
+	const size_t smallSamples = 1 + smallCount * smallSize / sampleRate;
+	CHECK_EQUAL(smallSamples + 1, sampledAllocations);
+	CHECK_EQUAL(smallSamples * smallSize + largeSize, sampledBytes);
+	CHECK_EQUAL(smallSamples * sampleRate + largeSize, estimatedBytes);
+}
+}
+} // end namespace wgt
@@ -0,0 +1,110 @@
+#include "pch.hpp"
+#include "wg_memory/memory_stats.hpp"
+
+#include <chrono>
+#include <string>
+
+namespace wgt
+{
+namespace NGTAllocator
+{
+namespace
+{
+// A root context with one child, two seconds after the previous snapshot
+void makeSnapshots(MemorySnapshot& o_Snapshot, MemorySnapshot& o_Previous)
+{
+	o_Previous = MemorySnapshot();
+	o_Previous.time_ = std::chrono::steady_clock::time_point(std::chrono::seconds(8));
+	o_Previous.sampleRate_ = 1024;
+	o_Previous.root_.id_ = 1;
+	o_Previous.root_.allocationsBySizeClass_[0] = 2;
+	o_Previous.root_.allocationsBySizeClass_[2] = 4;
+
+	o_Snapshot = MemorySnapshot();
+	o_Snapshot.time_ = std::chrono::steady_clock::time_point(std::chrono::seconds(10));
+	o_Snapshot.sampleRate_ = 1024;
+
+	auto& root = o_Snapshot.root_;
+	root.id_ = 1;
+	root.name_ = L"root";
+	root.liveBytes_ = 2048;
+	root.peakBytes_ = 4096;
+	root.liveAllocations_ = 3;
+	root.totalAllocations_ = 11;
+	root.totalBytes_ = 105000;
+	root.allocationsBySizeClass_[0] = 6;
+	root.allocationsBySizeClass_[2] = 4;
+	root.allocationsBySizeClass_[SIZE_CLASS_COUNT - 1] = 1;
+
+	MemoryContextStats child = {};
+	child.id_ = 2;
+	child.name_ = L"child \"a\"";
+	child.liveBytes_ = 100;
+	child.peakBytes_ = 100;
+	child.liveAllocations_ = 1;
+	child.totalAllocations_ = 1;
+	child.totalBytes_ = 100;
+	child.allocationsBySizeClass_[2] = 1;
+
+	AllocationSite site = {};
+	site.frames_.push_back("main.cpp(10) : main");
+	site.sampledAllocations_ = 1;
+	site.sampledBytes_ = 100;
+	site.estimatedBytes_ = 1024;
+	child.sites_.push_back(site);
+	root.children_.push_back(child);
+}
+}
+
+//------------------------------------------------------------------------------
+TEST(memory_snapshot_to_text)
+{
+	MemorySnapshot snapshot;
+	MemorySnapshot previous;
+	makeSnapshots(snapshot, previous);
+
+	const std::string expected = "Stack sample rate: one per 1.00 KB\n"
+	                             "root: 2.00 KB live (peak 4.00 KB) in 3 allocations, 11 allocations totalling 102.54 KB\n"
+	                             "    <= 16 B: 6\n"
+	                             "    <= 256 B: 4\n"
+	                             "    >  64.00 KB: 1\n"
+	                             "  child \"a\": 100 B live (peak 100 B) in 1 allocations, 1 allocations totalling 100 B\n"
+	                             "      <= 256 B: 1\n"
+	                             "      ~1.00 KB from 1 sampled allocations at\n"
+	                             "          main.cpp(10) : main\n";
+	CHECK_EQUAL(expected, memorySnapshotToText(snapshot));
+
+	// Rates are only reported for contexts which were in the previous snapshot
+	const std::string expectedRates = "Stack sample rate: one per 1.00 KB\n"
+	                                  "root: 2.00 KB live (peak 4.00 KB) in 3 allocations, 11 allocations totalling 102.54 KB\n"
+	                                  "    <= 16 B: 6 (2.0/s)\n"
+	                                  "    <= 256 B: 4 (0.0/s)\n"
+	                                  "    >  64.00 KB: 1 (0.5/s)\n"
+	                                  "  child \"a\": 100 B live (peak 100 B) in 1 allocations, 1 allocations totalling 100 B\n"
+	                                  "      <= 256 B: 1\n"
+	                                  "      ~1.00 KB from 1 sampled allocations at\n"
+	                                  "          main.cpp(10) : main\n";
+	CHECK_EQUAL(expectedRates, memorySnapshotToText(snapshot, &previous));
+}
+
+//------------------------------------------------------------------------------
+TEST(memory_snapshot_to_json)
+{
+	MemorySnapshot snapshot;
+	MemorySnapshot previous;
+	makeSnapshots(snapshot, previous);
+
+	const std::string expected = "{\"sampleRate\":1024,\"intervalSeconds\":2.000,\"root\":"
+	                             "{\"name\":\"root\",\"liveBytes\":2048,\"peakBytes\":4096,\"liveAllocations\":3,\"totalAllocations\":11,\"totalBytes\":105000"
+	                             ",\"sizeClasses\":[{\"limit\":16,\"allocations\":6,\"perSecond\":2.000},{\"limit\":64,\"allocations\":0,\"perSecond\":0.000},{\"limit\":256,\"allocations\":4,\"perSecond\":0.000},{\"limit\":1024,\"allocations\":0,\"perSecond\":0.000}"
+	                             ",{\"limit\":4096,\"allocations\":0,\"perSecond\":0.000},{\"limit\":16384,\"allocations\":0,\"perSecond\":0.000},{\"limit\":65536,\"allocations\":0,\"perSecond\":0.000},{\"limit\":0,\"allocations\":1,\"perSecond\":0.500}]"
+	                             ",\"sites\":[]"
+	                             ",\"children\":[{\"name\":\"child \\\"a\\\"\",\"liveBytes\":100,\"peakBytes\":100,\"liveAllocations\":1,\"totalAllocations\":1,\"totalBytes\":100"
+	                             ",\"sizeClasses\":[{\"limit\":16,\"allocations\":0},{\"limit\":64,\"allocations\":0},{\"limit\":256,\"allocations\":1},{\"limit\":1024,\"allocations\":0}"
+	                             ",{\"limit\":4096,\"allocations\":0},{\"limit\":16384,\"allocations\":0},{\"limit\":65536,\"allocations\":0},{\"limit\":0,\"allocations\":0}]"
+	                             ",\"sites\":[{\"estimatedBytes\":1024,\"sampledBytes\":100,\"sampledAllocations\":1,\"frames\":[\"main.cpp(10) : main\"]}]"
+	                             ",\"children\":[]}]}}";
+	CHECK_EQUAL(expected, memorySnapshotToJson(snapshot, &previous));
+}
+}
+} // end namespace wgt
@@ -1,13 +1,14 @@
 #include "hash_utilities.hpp"
 // TODO: Create multi-platform generic types header
 #include "core_common/ngt_windows.hpp"
+#include <cstring>
 
 namespace wgt
 {
 namespace HashUtilities
 {
-static const uint64_t FNV_prime = 1099511628211UL;
-static const uint64_t FNV_offset_basis = 14695981039346656037UL;
+using Detail::FNV_prime;
+using Detail::FNV_offset_basis;
 
 //------------------------------------------------------------------------------
 uint64_t compute(const void* data, size_t length)
@@ -91,6 +92,37 @@ uint64_t compute(uint64_t value)
 	return compute((const void*)&value, sizeof(uint64_t));
 }
 
+//------------------------------------------------------------------------------
+uint64_t computeFast(const void* data, size_t length)
+{
+	const char* input = static_cast<const char*>(data);
+	uint64_t result = Detail::FAST_seed ^ (length * Detail::FAST_k2);
+	for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t), input += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, input, sizeof(uint64_t));
+		result = Detail::mixWord(result, word);
+	}
+	if (length != 0)
+	{
+		result = Detail::mixWord(result, Detail::loadWord(input, length));
+	}
+	return Detail::finalize(result);
+}
+
+//------------------------------------------------------------------------------
+uint64_t computeFast(const char* value)
+{
+	return computeFast(value, strlen(value));
+}
+
+//------------------------------------------------------------------------------
+uint64_t computeFast(const std::string& value)
+{
+	return computeFast(value.c_str(), value.length());
+}
+
+//------------------------------------------------------------------------------
 void directCombine(uint64_t& seed, uint64_t value)
 {
 	seed ^= value +
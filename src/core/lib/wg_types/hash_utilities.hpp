@@ -8,6 +8,60 @@ namespace wgt
 {
 namespace HashUtilities
 {
+namespace Detail
+{
+const uint64_t FNV_prime = 1099511628211ULL;
+const uint64_t FNV_offset_basis = 14695981039346656037ULL;
+
+const uint64_t FAST_seed = 0x9E3779B97F4A7C15ULL;
+const uint64_t FAST_k1 = 0x87C37B91114253D5ULL;
+const uint64_t FAST_k2 = 0x4CF5AD432745937FULL;
+
+constexpr uint64_t fnv1a(const char* value, size_t length, uint64_t result)
+{
+	return length == 0 ? result : fnv1a(value + 1, length - 1, (result ^ value[0]) * FNV_prime);
+}
+
+constexpr uint64_t rotl(uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+// Little endian load of up to 8 bytes, matching a memcpy on the supported platforms
+constexpr uint64_t loadWord(const char* value, size_t length, size_t index = 0)
+{
+	return index == length ?
+	0 :
+	(static_cast<uint64_t>(static_cast<unsigned char>(value[index])) << (index * 8)) |
+	loadWord(value, length, index + 1);
+}
+
+constexpr uint64_t mixWord(uint64_t result, uint64_t word)
+{
+	return rotl(result ^ (rotl(word * FAST_k1, 31) * FAST_k2), 27) * 5 + 0x52DCE729;
+}
+
+constexpr uint64_t avalanche(uint64_t result)
+{
+	return result ^ (result >> 33);
+}
+
+constexpr uint64_t finalize(uint64_t result)
+{
+	return avalanche(avalanche(avalanche(result) * 0xFF51AFD7ED558CCDULL) * 0xC4CEB9FE1A85EC53ULL);
+}
+
+constexpr uint64_t fastHash(const char* value, size_t length, uint64_t result)
+{
+	return length >= 8 ? fastHash(value + 8, length - 8, mixWord(result, loadWord(value, 8))) :
+	                     finalize(length == 0 ? result : mixWord(result, loadWord(value, length)));
+}
+}
+
+/**
+* Stable FNV-1a hashes.
+* These values may be persisted (type ids, role ids, object ids) and must never change.
+*/
 uint64_t compute(const void* data, size_t length);
 uint64_t compute(const char* value);
 uint64_t compute(const std::string& value);
@@ -21,6 +75,37 @@ uint64_t compute(uint64_t value);
 //Case insensitive hash
 uint64_t computei(const char* value);
 
+/**
+* Compile time equivalent of compute(const char*) for string literals.
+*/
+template <size_t N>
+constexpr uint64_t computeConstant(const char (&value)[N])
+{
+	return Detail::fnv1a(value, N - 1, Detail::FNV_offset_basis);
+}
+
+/**
+* Word at a time hash, several times faster than compute for longer strings.
+* The values are only stable within a single build and must not be persisted.
+*/
+uint64_t computeFast(const void* data, size_t length);
+uint64_t computeFast(const char* value);
+uint64_t computeFast(const std::string& value);
+
+/**
+* Compile time equivalent of computeFast(const char*).
+*/
+constexpr uint64_t computeFastConstant(const char* value, size_t length)
+{
+	return Detail::fastHash(value, length, Detail::FAST_seed ^ (length * Detail::FAST_k2));
+}
+
+template <size_t N>
+constexpr uint64_t computeFastConstant(const char (&value)[N])
+{
+	return computeFastConstant(value, N - 1);
+}
+
 template <typename T>
 void combine(uint64_t& seed, const T& value)
 {
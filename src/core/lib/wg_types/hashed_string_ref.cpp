@@ -6,7 +6,14 @@ namespace wgt
 {
 //------------------------------------------------------------------------------
 HashedStringRef::HashedStringRef(const char* str)
-    : hash_(static_cast<size_t>(HashUtilities::compute(str))), pStart_(str), length_(strlen(pStart_))
+    : pStart_(str), length_(strlen(str))
+{
+	hash_ = static_cast<size_t>(HashUtilities::computeFast(pStart_, length_));
+}
+
+//------------------------------------------------------------------------------
+HashedStringRef::HashedStringRef(const char* str, size_t length)
+    : hash_(static_cast<size_t>(HashUtilities::computeFast(str, length))), pStart_(str), length_(length)
 {
 }
 
@@ -33,6 +40,6 @@ bool HashedStringRef::operator==(const HashedStringRef& other) const
 	{
 		return false;
 	}
-	return strcmp(pStart_, other.pStart_) == 0;
+	return memcmp(pStart_, other.pStart_, length_) == 0;
 }
 } // end namespace wgt
@@ -1,6 +1,8 @@
 #ifndef HASHED_STRING_REF_HPP
 #define HASHED_STRING_REF_HPP
 
+#include "hash_utilities.hpp"
+
 #include <functional>
 
 namespace wgt
@@ -9,6 +11,7 @@ class HashedStringRef
 {
 public:
 	HashedStringRef(const char* str);
+	HashedStringRef(const char* str, size_t length);
 
 	// Getters
 	size_t hash() const;
@@ -1,43 +1,76 @@
 #ifndef SHARED_STRING_HPP
 #define SHARED_STRING_HPP
 
+#include "string_pool.hpp"
+
 #include <string>
 #include <memory>
+#include <functional>
 
 namespace wgt
 {
 
+/**
+* Immutable string interned in the StringPool.
+* Copies share the pooled string, and comparisons and hashing are O(1).
+* The pooled string is freed with the last SharedString referring to it.
+*/
 class SharedString
 {
 public:
 	SharedString()
-		: storage_(std::make_shared< std::string >())
+		: entry_(StringPool::empty())
 	{
 	}
 
 	SharedString(const char * str)
-		: storage_( std::make_shared< std::string >( str ) )
+		: entry_(StringPool::intern(str))
 	{
 	}
 
 	SharedString(const std::string & str)
-		: storage_(std::make_shared< std::string >(str))
+		: entry_(StringPool::intern(str))
+	{
+	}
+
+	/** Takes over a reference to a pool entry, which must not be null. */
+	explicit SharedString(const StringPool::Entry * entry)
+		: entry_(entry)
+	{
+	}
+
+	SharedString(const SharedString & other)
+		: entry_(other.entry_)
 	{
+		StringPool::addRef(entry_);
 	}
 
-	SharedString( std::string && str)
-		: storage_(std::make_shared< std::string >( std::move( str ) ))
+	~SharedString()
 	{
+		StringPool::release(entry_);
+	}
+
+	SharedString & operator=(const SharedString & other)
+	{
+		StringPool::addRef(other.entry_);
+		StringPool::release(entry_);
+		entry_ = other.entry_;
+		return *this;
 	}
 
 	const std::string & str() const
 	{
-		return *storage_.get();
+		return entry_->str_;
 	}
 
 	const std::string * operator->() const
 	{
-		return storage_.get();
+		return &entry_->str_;
+	}
+
+	uint64_t hash() const
+	{
+		return entry_->hash_;
 	}
 
 	//operator std::string() const
@@ -50,23 +83,51 @@ public:
 	//	return storage_->c_str();
 	//}
 
+	/** Storage which keeps the pooled string alive. */
 	std::shared_ptr< const std::string > getStorage() const
 	{
-		return storage_;
+		const StringPool::Entry * entry = entry_;
+		StringPool::addRef(entry);
+		return std::shared_ptr< const std::string >(
+			&entry->str_, [entry](const std::string *) { StringPool::release(entry); });
 	}
 
 	SharedString & operator+= (const std::string & other)
 	{
-		*storage_ += other;
+		auto entry = StringPool::intern(entry_->str_ + other);
+		StringPool::release(entry_);
+		entry_ = entry;
 		return *this;
 	}
 
+	bool operator==(const SharedString & other) const
+	{
+		return entry_ == other.entry_;
+	}
+
+	bool operator!=(const SharedString & other) const
+	{
+		return entry_ != other.entry_;
+	}
+
 private:
-	std::shared_ptr< std::string > storage_;
+	const StringPool::Entry * entry_;
 };
 
 bool downcast(wgt::SharedString * v, const wgt::SharedString & storage);
 
 }
 
-#endif //SHARED_STRING_HPP
\ No newline at end of file
+namespace std
+{
+template <>
+struct hash<wgt::SharedString>
+{
+	size_t operator()(const wgt::SharedString& s) const
+	{
+		return static_cast<size_t>(s.hash());
+	}
+};
+}
+
+#endif //SHARED_STRING_HPP
@@ -0,0 +1,160 @@
+#include "string_pool.hpp"
+#include "hash_utilities.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace wgt
+{
+namespace StringPool
+{
+namespace
+{
+const size_t SHARD_COUNT = 32;
+
+struct Shard
+{
+	std::mutex mutex_;
+	std::unordered_multimap<uint64_t, Entry*> lookup_;
+};
+
+struct Pool
+{
+	Shard shards_[SHARD_COUNT];
+};
+
+Pool& getPool()
+{
+	// Intentionally never destroyed so that static SharedStrings can be released during shutdown
+	static Pool* s_Pool = new Pool();
+	return *s_Pool;
+}
+
+Shard& getShard(uint64_t hash)
+{
+	return getPool().shards_[hash % SHARD_COUNT];
+}
+
+Entry* findLocked(const Shard& shard, const char* str, size_t length, uint64_t hash)
+{
+	auto range = shard.lookup_.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		const auto& existing = it->second->str_;
+		if (existing.size() == length && memcmp(existing.data(), str, length) == 0)
+		{
+			// Entries are removed under the lock as their count drops to zero, so a found entry is alive
+			addRef(it->second);
+			return it->second;
+		}
+	}
+	return nullptr;
+}
+}
+
+//------------------------------------------------------------------------------
+const Entry* intern(const char* str, size_t length)
+{
+	const auto hash = HashUtilities::computeFast(str, length);
+	auto& shard = getShard(hash);
+
+	std::lock_guard<std::mutex> guard(shard.mutex_);
+	auto found = findLocked(shard, str, length, hash);
+	if (found != nullptr)
+	{
+		return found;
+	}
+
+	auto entry = new Entry();
+	entry->str_.assign(str, length);
+	entry->hash_ = hash;
+	entry->refs_.store(1, std::memory_order_relaxed);
+	shard.lookup_.insert(std::make_pair(hash, entry));
+	return entry;
+}
+
+//------------------------------------------------------------------------------
+const Entry* intern(const char* str)
+{
+	return intern(str, strlen(str));
+}
+
+//------------------------------------------------------------------------------
+const Entry* intern(const std::string& str)
+{
+	return intern(str.c_str(), str.length());
+}
+
+//------------------------------------------------------------------------------
+const Entry* find(const char* str, size_t length)
+{
+	const auto hash = HashUtilities::computeFast(str, length);
+	auto& shard = getShard(hash);
+
+	std::lock_guard<std::mutex> guard(shard.mutex_);
+	return findLocked(shard, str, length, hash);
+}
+
+//------------------------------------------------------------------------------
+const Entry* find(const std::string& str)
+{
+	return find(str.c_str(), str.length());
+}
+
+//------------------------------------------------------------------------------
+const Entry* empty()
+{
+	// Holds a reference of its own, so the most common string is never freed
+	static const Entry* s_Empty = intern("", 0);
+	addRef(s_Empty);
+	return s_Empty;
+}
+
+//------------------------------------------------------------------------------
+void release(const Entry* entry)
+{
+	auto refs = entry->refs_.load(std::memory_order_relaxed);
+	while (refs > 1)
+	{
+		if (entry->refs_.compare_exchange_weak(refs, refs - 1, std::memory_order_release,
+		                                       std::memory_order_relaxed))
+		{
+			return;
+		}
+	}
+
+	// This may be the last reference. Other holders can only release theirs, and intern
+	// can only hand out a new one under the shard lock, so decide there.
+	auto& shard = getShard(entry->hash_);
+	std::lock_guard<std::mutex> guard(shard.mutex_);
+	if (entry->refs_.fetch_sub(1, std::memory_order_acq_rel) != 1)
+	{
+		return;
+	}
+
+	auto range = shard.lookup_.equal_range(entry->hash_);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second == entry)
+		{
+			shard.lookup_.erase(it);
+			break;
+		}
+	}
+	delete entry;
+}
+
+//------------------------------------------------------------------------------
+size_t size()
+{
+	size_t count = 0;
+	for (auto& shard : getPool().shards_)
+	{
+		std::lock_guard<std::mutex> guard(shard.mutex_);
+		count += shard.lookup_.size();
+	}
+	return count;
+}
+}
+} // end namespace wgt
@@ -0,0 +1,55 @@
+#ifndef STRING_POOL_HPP
+#define STRING_POOL_HPP
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+namespace wgt
+{
+/**
+* Process wide pool of immutable, interned strings.
+* Two live interned strings are equal if and only if they share the same
+* entry. Entries carry their hash so interned strings can be used as map keys
+* without rehashing. Entries are reference counted and freed with their last
+* reference, so the pool only holds strings still in use.
+* The pool is thread safe and sharded to keep lock contention low. Only
+* interning a string and releasing its last reference take a lock.
+*/
+namespace StringPool
+{
+struct Entry
+{
+	std::string str_;
+	uint64_t hash_;
+	mutable std::atomic<size_t> refs_;
+};
+
+/** Returns the entry for a string, adding it if needed. The caller owns a reference to it. */
+const Entry* intern(const char* str, size_t length);
+const Entry* intern(const char* str);
+const Entry* intern(const std::string& str);
+
+/**
+* Looks up an existing entry without interning.
+* @return nullptr if the string is not in the pool, otherwise an entry the caller owns a reference to.
+*/
+const Entry* find(const char* str, size_t length);
+const Entry* find(const std::string& str);
+
+/** The entry for the empty string, which the caller owns a reference to. */
+const Entry* empty();
+
+inline void addRef(const Entry* entry)
+{
+	entry->refs_.fetch_add(1, std::memory_order_relaxed);
+}
+
+/** Releases a reference to an entry, freeing it with its last reference. */
+void release(const Entry* entry);
+
+/** Number of distinct strings in the pool. */
+size_t size();
+}
+} // end namespace wgt
+#endif // STRING_POOL_HPP
@@ -0,0 +1,63 @@
+#include "pch.hpp"
+#include "wg_types/hash_utilities.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace wgt
+{
+namespace
+{
+// Property paths in the shape produced by the reflection system
+std::vector<std::string> makePropertyPaths()
+{
+	const char* objects[] = { "transform", "material", "lights", "children", "components", "physics" };
+	const char* members[] = { "position", "rotation", "scale", "diffuseColour", "specularPower",
+		                      "name", "visible", "boundingBox", "userData", "textureCoordinates" };
+
+	std::vector<std::string> paths;
+	for (auto object : objects)
+	{
+		for (int index = 0; index < 20; ++index)
+		{
+			for (auto member : members)
+			{
+				paths.push_back(std::string(object) + "[" + std::to_string(index) + "]." + member);
+				paths.push_back(std::string(object) + "[" + std::to_string(index) + "]." + member + ".x");
+			}
+		}
+	}
+	return paths;
+}
+
+template <typename Hash>
+double timeHash(const std::vector<std::string>& paths, Hash hash, uint64_t& o_Checksum)
+{
+	const int iterations = 50;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iterations; ++i)
+	{
+		for (const auto& path : paths)
+		{
+			o_Checksum += hash(path.c_str());
+		}
+	}
+	auto elapsed = std::chrono::high_resolution_clock::now() - start;
+	return std::chrono::duration<double, std::milli>(elapsed).count();
+}
+}
+
+//------------------------------------------------------------------------------
+TEST(hash_property_path_benchmark)
+{
+	auto paths = makePropertyPaths();
+
+	uint64_t checksum = 0;
+	auto stableTime = timeHash(paths, [](const char* path) { return HashUtilities::compute(path); }, checksum);
+	auto fastTime = timeHash(paths, [](const char* path) { return HashUtilities::computeFast(path); }, checksum);
+	printf("Hashed %d property paths x 50: stable %.3fms, fast %.3fms (checksum %llx)\n",
+	       static_cast<int>(paths.size()), stableTime, fastTime, static_cast<unsigned long long>(checksum));
+}
+} // end namespace wgt
@@ -0,0 +1,72 @@
+#include "pch.hpp"
+#include "wg_types/hash_utilities.hpp"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace wgt
+{
+namespace
+{
+// Property paths in the shape produced by the reflection system
+std::vector<std::string> makePropertyPaths()
+{
+	const char* objects[] = { "transform", "material", "lights", "children", "components", "physics" };
+	const char* members[] = { "position", "rotation", "scale", "diffuseColour", "specularPower",
+		                      "name", "visible", "boundingBox", "userData", "textureCoordinates" };
+
+	std::vector<std::string> paths;
+	for (auto object : objects)
+	{
+		for (int index = 0; index < 20; ++index)
+		{
+			for (auto member : members)
+			{
+				paths.push_back(std::string(object) + "[" + std::to_string(index) + "]." + member);
+				paths.push_back(std::string(object) + "[" + std::to_string(index) + "]." + member + ".x");
+			}
+		}
+	}
+	return paths;
+}
+}
+
+//------------------------------------------------------------------------------
+TEST(hash_constant_matches_runtime)
+{
+	static_assert(HashUtilities::computeConstant("") == 14695981039346656037ULL, "FNV-1a offset basis");
+	static_assert(HashUtilities::computeFastConstant("position") != HashUtilities::computeFastConstant("rotation"),
+	              "compile time hashes differ");
+
+	CHECK_EQUAL(HashUtilities::compute("diffuseColour"), HashUtilities::computeConstant("diffuseColour"));
+	CHECK_EQUAL(HashUtilities::computeFast("diffuseColour"), HashUtilities::computeFastConstant("diffuseColour"));
+	CHECK_EQUAL(HashUtilities::computeFast("a"), HashUtilities::computeFastConstant("a"));
+	CHECK_EQUAL(HashUtilities::computeFast(""), HashUtilities::computeFastConstant(""));
+
+	const char* longPath = "components[12].textureCoordinates.x";
+	CHECK_EQUAL(HashUtilities::computeFast(longPath),
+	            HashUtilities::computeFastConstant("components[12].textureCoordinates.x"));
+
+	// Trailing zero bytes must still change the hash
+	const char padded[] = { 'a', '\0', '\0' };
+	CHECK(HashUtilities::computeFast(padded, 1) != HashUtilities::computeFast(padded, 2));
+}
+
+//------------------------------------------------------------------------------
+TEST(hash_property_paths_are_distinct)
+{
+	auto paths = makePropertyPaths();
+
+	std::unordered_set<uint64_t> stableHashes;
+	std::unordered_set<uint64_t> fastHashes;
+	for (const auto& path : paths)
+	{
+		stableHashes.insert(HashUtilities::compute(path));
+		fastHashes.insert(HashUtilities::computeFast(path));
+		CHECK_EQUAL(HashUtilities::computeFast(path), HashUtilities::computeFast(path.c_str(), path.size()));
+	}
+	CHECK_EQUAL(paths.size(), stableHashes.size());
+	CHECK_EQUAL(paths.size(), fastHashes.size());
+}
+} // end namespace wgt
@@ -0,0 +1,94 @@
+#include "pch.hpp"
+#include "wg_types/shared_string.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace wgt
+{
+//------------------------------------------------------------------------------
+TEST(shared_string_interns_equal_strings)
+{
+	SharedString position("position");
+	SharedString other(std::string("posi") + "tion");
+	CHECK(position == other);
+	CHECK(&position.str() == &other.str());
+	CHECK_EQUAL(position.hash(), other.hash());
+	CHECK(position != SharedString("rotation"));
+
+	CHECK(SharedString() == SharedString(""));
+	CHECK(SharedString(StringPool::find("position")) == position);
+	CHECK(StringPool::find("shared_string_never_interned") == nullptr);
+}
+
+//------------------------------------------------------------------------------
+TEST(shared_string_append_does_not_modify_copies)
+{
+	SharedString path("transform");
+	SharedString copy = path;
+	path += ".position";
+	CHECK(copy.str() == "transform");
+	CHECK(path.str() == "transform.position");
+	CHECK(path == SharedString("transform.position"));
+}
+
+//------------------------------------------------------------------------------
+TEST(string_pool_is_thread_safe)
+{
+	const int threadCount = 4;
+	std::vector<std::vector<const StringPool::Entry*>> results(threadCount);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < threadCount; ++i)
+	{
+		threads.emplace_back([&results, i]() {
+			for (int name = 0; name < 1000; ++name)
+			{
+				results[i].push_back(StringPool::intern("children[" + std::to_string(name) + "]"));
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (int i = 1; i < threadCount; ++i)
+	{
+		CHECK(results[i] == results[0]);
+	}
+
+	for (auto& result : results)
+	{
+		for (auto entry : result)
+		{
+			StringPool::release(entry);
+		}
+	}
+	CHECK(StringPool::find("children[0]") == nullptr);
+}
+
+//------------------------------------------------------------------------------
+TEST(string_pool_frees_unused_strings)
+{
+	const auto size = StringPool::size();
+	{
+		SharedString value("shared_string_temporary");
+		SharedString copy = value;
+		CHECK_EQUAL(size + 1, StringPool::size());
+
+		auto storage = value.getStorage();
+		value = SharedString();
+		copy += "_appended";
+		CHECK(*storage == "shared_string_temporary");
+		CHECK_EQUAL(size + 2, StringPool::size());
+	}
+	CHECK_EQUAL(size, StringPool::size());
+	CHECK(StringPool::find("shared_string_temporary") == nullptr);
+
+	// Interning again after the entry was freed creates a new one
+	SharedString value("shared_string_temporary");
+	CHECK(value.str() == "shared_string_temporary");
+	CHECK(value == SharedString(std::string("shared_string_temporary")));
+}
+} // end namespace wgt
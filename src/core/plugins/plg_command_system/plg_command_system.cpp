@@ -1,5 +1,6 @@
 #include "core_generic_plugin/generic_plugin.hpp"
 #include "core_generic_plugin/interfaces/i_application.hpp"
+#include "core_generic_plugin/interfaces/i_command_line_parser.hpp"
 #include "core_generic_plugin/interfaces/ui_connection.hpp"
 #include "core_reflection/i_definition_manager.hpp"
 #include "core_reflection/metadata/meta_types.hpp"
@@ -7,6 +8,7 @@
 #include "core_reflection/interfaces/i_reflection_controller.hpp"
 
 #include "core_common/assert.hpp"
+#include "core_logging/logging.hpp"
 #include "core_command_system/command.hpp"
 #include "core_command_system/command_manager.hpp"
 #include "core_environment_system/i_env_system.hpp"
@@ -34,6 +36,8 @@ namespace wgt
 * same thread.
 *       All data changes should be wrapped in a command and executed via the command manager to guarantee there are no
 * data races.
+*       Passing --historyJournal <path> on the command line keeps the command history in a journal at path, restoring
+* it on the next run.
 *       Requires Plugins:
 *       - @ref coreplugins
 */
@@ -41,6 +45,7 @@ class CommandSystemPlugin : public PluginMain
 {
 private:
 	CommandManager * commandManager_;
+	Connection openJournalConnection_;
 public:
 	CommandSystemPlugin(IComponentContext& contextManager)
 	{
@@ -64,6 +69,24 @@ public:
 		{
 			TF_ASSERT( &commandManager == commandManager_ );
 			dynamic_cast< CommandManager &>( commandManager ).init(application, defManager );
+
+			auto commandLine = contextManager.queryInterface<ICommandLineParser>();
+			auto journalPath = commandLine != nullptr ? commandLine->getParamStr("--historyJournal") : std::string();
+			if (!journalPath.empty())
+			{
+				// Restored entries need their commands, which other plugins register before the first update
+				openJournalConnection_ = application.signalUpdate.connect([this, journalPath]()
+				{
+					openJournalConnection_.disconnect();
+					if (!commandManager_->openHistoryJournal(journalPath.c_str()))
+					{
+						NGT_ERROR_MSG("Failed to open command history journal %s\n", journalPath.c_str());
+					}
+				});
+			}
+		}, [this](ICommandManager & commandManager, IApplication & application, IDefinitionManager & defManager)
+		{
+			openJournalConnection_.disconnect();
 		});
 	}
 };
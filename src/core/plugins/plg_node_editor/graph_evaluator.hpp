@@ -0,0 +1,676 @@
+#ifndef __GRAPH_EVALUATOR_H__
+#define __GRAPH_EVALUATOR_H__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace wgt
+{
+/*!
+* \class WorkStealingPool
+*
+* \brief Runs tasks on a fixed set of threads, each with its own queue.
+* A worker takes the newest task from its own queue and steals the oldest task
+* of another queue when its own is empty. Tasks pushed from a task go to the queue
+* of the worker running it, tasks pushed from other threads go to a shared queue.
+*/
+class WorkStealingPool
+{
+public:
+	typedef std::function<void()> Task;
+
+	explicit WorkStealingPool(size_t threadCount) : queued_(0), pending_(0), stop_(false)
+	{
+		threadCount = std::max<size_t>(threadCount, 1);
+		for (size_t i = 0; i <= threadCount; ++i)
+		{
+			queues_.emplace_back(new Queue);
+		}
+
+		threads_.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; ++i)
+		{
+			threads_.emplace_back(&WorkStealingPool::Run, this, i);
+		}
+	}
+
+	~WorkStealingPool()
+	{
+		{
+			std::lock_guard<std::mutex> guard(lock_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+
+		for (auto& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+
+	/*! Returns the number of worker threads
+	@return worker thread count
+	*/
+	size_t ThreadCount() const
+	{
+		return threads_.size();
+	}
+
+	/*! Queues a task to be run by a worker
+	@param task The task to run
+	*/
+	void Push(Task task)
+	{
+		auto index = QueueIndex();
+		++pending_;
+		{
+			std::lock_guard<std::mutex> guard(queues_[index]->lock);
+			queues_[index]->tasks.push_back(std::move(task));
+			++queued_;
+		}
+
+		// Lock so that a worker about to sleep cannot miss the new task
+		{
+			std::lock_guard<std::mutex> guard(lock_);
+		}
+		wake_.notify_one();
+	}
+
+	/*! Runs queued tasks on the calling thread until every task pushed so far, and every task
+	those push, has finished. Must not be called from a task.
+	*/
+	void Wait()
+	{
+		auto index = QueueIndex();
+		Task task;
+		while (pending_ > 0)
+		{
+			if (Take(index, task))
+			{
+				Execute(task);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> guard(lock_);
+			done_.wait(guard, [this]() { return pending_ == 0; });
+		}
+	}
+
+private:
+	WorkStealingPool(const WorkStealingPool&);
+	WorkStealingPool& operator=(const WorkStealingPool&);
+
+	struct Queue
+	{
+		std::mutex lock;
+		std::deque<Task> tasks;
+	};
+
+	static std::pair<const WorkStealingPool*, size_t>& CurrentWorker()
+	{
+		static thread_local std::pair<const WorkStealingPool*, size_t> s_worker(nullptr, 0);
+		return s_worker;
+	}
+
+	size_t QueueIndex() const
+	{
+		auto& worker = CurrentWorker();
+		return worker.first == this ? worker.second : queues_.size() - 1;
+	}
+
+	bool Take(size_t index, Task& task)
+	{
+		{
+			auto& queue = *queues_[index];
+			std::lock_guard<std::mutex> guard(queue.lock);
+			if (!queue.tasks.empty())
+			{
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+				--queued_;
+				return true;
+			}
+		}
+
+		for (size_t i = 1; i < queues_.size(); ++i)
+		{
+			auto& queue = *queues_[(index + i) % queues_.size()];
+			std::lock_guard<std::mutex> guard(queue.lock);
+			if (!queue.tasks.empty())
+			{
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				--queued_;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void Execute(Task& task)
+	{
+		task();
+		task = nullptr;
+		if (--pending_ == 0)
+		{
+			{
+				std::lock_guard<std::mutex> guard(lock_);
+			}
+			done_.notify_all();
+		}
+	}
+
+	void Run(size_t index)
+	{
+		CurrentWorker() = std::make_pair(this, index);
+
+		Task task;
+		while (true)
+		{
+			if (Take(index, task))
+			{
+				Execute(task);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> guard(lock_);
+			wake_.wait(guard, [this]() { return stop_ || queued_ > 0; });
+			if (stop_)
+			{
+				return;
+			}
+		}
+	}
+
+	std::vector<std::unique_ptr<Queue>> queues_;
+	std::vector<std::thread> threads_;
+	std::atomic<size_t> queued_;
+	std::atomic<size_t> pending_;
+	std::mutex lock_;
+	std::condition_variable wake_;
+	std::condition_variable done_;
+	bool stop_;
+};
+
+/*!
+* \class GraphEvaluator
+*
+* \brief Dataflow evaluation of a node graph.
+* Keeps nodes, slots and connections indexed by id along with the upstream and downstream
+* nodes of every node. Evaluation only runs nodes marked dirty and the nodes downstream of
+* them, in topological order. Nodes whose inputs are ready run in parallel on a work
+* stealing pool, so node functions must be safe to call from any thread. The graph must
+* not be changed while it is evaluated.
+*/
+class GraphEvaluator
+{
+public:
+	/*! Evaluates a node
+	@param &errorMessage The reference where will be written the error message if evaluation fails
+	@return true if the node is evaluated, false otherwise
+	*/
+	typedef std::function<bool(std::string& errorMessage)> NodeFunction;
+
+	explicit GraphEvaluator(size_t threadCount = std::thread::hardware_concurrency()) : threadCount_(threadCount)
+	{
+	}
+
+	/*! Adds a node, marking it dirty
+	@param nodeId The id of the new node
+	@param function The function evaluating the node
+	@return true if the node is added, false if a node with this id already exists
+	*/
+	bool AddNode(size_t nodeId, NodeFunction function)
+	{
+		auto result = nodes_.emplace(nodeId, Node());
+		if (!result.second)
+		{
+			return false;
+		}
+
+		result.first->second.function = std::move(function);
+		dirty_.insert(nodeId);
+		return true;
+	}
+
+	/*! Adds a slot to a node
+	@param nodeId The id of the node containing the slot
+	@param slotId The id of the new slot
+	@param isInput Whether the slot is an input of the node
+	@return true if the slot is added, false if there is no such node or the slot already exists
+	*/
+	bool AddSlot(size_t nodeId, size_t slotId, bool isInput)
+	{
+		auto nodeIt = nodes_.find(nodeId);
+		if (nodeIt == nodes_.end())
+		{
+			return false;
+		}
+
+		Slot slot = { nodeId, isInput };
+		if (!slots_.emplace(slotId, slot).second)
+		{
+			return false;
+		}
+
+		nodeIt->second.slots.push_back(slotId);
+		return true;
+	}
+
+	/*! Adds a connection between an output slot and an input slot, marking the node of the
+	input slot dirty. The slots may be given in either order.
+	@param connectionId The id of the new connection
+	@param slotIdFrom The slot id from which connection starts
+	@param slotIdTo The slot id where connection ends
+	@return true if the connection is added, false otherwise
+	*/
+	bool AddConnection(size_t connectionId, size_t slotIdFrom, size_t slotIdTo)
+	{
+		auto fromIt = slots_.find(slotIdFrom);
+		auto toIt = slots_.find(slotIdTo);
+		if (fromIt == slots_.end() || toIt == slots_.end() || fromIt->second.isInput == toIt->second.isInput ||
+		    connections_.find(connectionId) != connections_.end())
+		{
+			return false;
+		}
+
+		if (fromIt->second.isInput)
+		{
+			std::swap(fromIt, toIt);
+		}
+
+		Connection connection = { fromIt->first, toIt->first };
+		connections_.emplace(connectionId, connection);
+		fromIt->second.connections.push_back(connectionId);
+		toIt->second.connections.push_back(connectionId);
+
+		auto source = fromIt->second.node;
+		auto target = toIt->second.node;
+		nodes_[source].downstream.push_back(target);
+		nodes_[target].upstream.push_back(source);
+		dirty_.insert(target);
+		return true;
+	}
+
+	/*! Removes a connection, marking the node of its input slot dirty
+	@param connectionId The id of the connection
+	*/
+	void RemoveConnection(size_t connectionId)
+	{
+		auto it = connections_.find(connectionId);
+		if (it == connections_.end())
+		{
+			return;
+		}
+
+		auto& from = slots_[it->second.from];
+		auto& to = slots_[it->second.to];
+		EraseOne(from.connections, connectionId);
+		EraseOne(to.connections, connectionId);
+		EraseOne(nodes_[from.node].downstream, to.node);
+		EraseOne(nodes_[to.node].upstream, from.node);
+		dirty_.insert(to.node);
+		connections_.erase(it);
+	}
+
+	/*! Removes a node with its slots and connections
+	@param nodeId The id of the node
+	*/
+	void RemoveNode(size_t nodeId)
+	{
+		auto it = nodes_.find(nodeId);
+		if (it == nodes_.end())
+		{
+			return;
+		}
+
+		for (auto slotId : it->second.slots)
+		{
+			auto connections = slots_[slotId].connections;
+			for (auto connectionId : connections)
+			{
+				RemoveConnection(connectionId);
+			}
+			slots_.erase(slotId);
+		}
+
+		nodes_.erase(it);
+		dirty_.erase(nodeId);
+	}
+
+	/*! Returns whether the graph contains a node
+	@param nodeId The id of the node
+	@return true if the node exists, false otherwise
+	*/
+	bool HasNode(size_t nodeId) const
+	{
+		return nodes_.find(nodeId) != nodes_.end();
+	}
+
+	/*! Returns whether a node will be run by the next evaluation
+	@param nodeId The id of the node
+	@return true if the node or a node upstream of it is dirty, false otherwise
+	*/
+	bool IsDirty(size_t nodeId) const
+	{
+		std::vector<size_t> affected;
+		CollectAffected(affected);
+		return std::find(affected.begin(), affected.end(), nodeId) != affected.end();
+	}
+
+	/*! Marks a node dirty, so that the next evaluation runs it and the nodes downstream of it
+	@param nodeId The id of the node
+	*/
+	void MarkDirty(size_t nodeId)
+	{
+		if (HasNode(nodeId))
+		{
+			dirty_.insert(nodeId);
+		}
+	}
+
+	/*! Marks the value of a slot as changed. The node of an input slot is marked dirty, for an
+	output slot the nodes it is connected to are.
+	@param slotId The id of the slot
+	*/
+	void SlotChanged(size_t slotId)
+	{
+		auto it = slots_.find(slotId);
+		if (it == slots_.end())
+		{
+			return;
+		}
+
+		if (it->second.isInput)
+		{
+			dirty_.insert(it->second.node);
+			return;
+		}
+
+		for (auto connectionId : it->second.connections)
+		{
+			dirty_.insert(slots_[connections_[connectionId].to].node);
+		}
+	}
+
+	/*! Checks that the graph has no cycles
+	@param &errorMessage The reference where will be written the error message if the graph is not valid
+	@return true if the graph is valid, false otherwise
+	*/
+	bool Validate(std::string& errorMessage) const
+	{
+		std::vector<size_t> nodes;
+		nodes.reserve(nodes_.size());
+		for (auto& node : nodes_)
+		{
+			nodes.push_back(node.first);
+		}
+
+		std::vector<size_t> order;
+		return Sort(nodes, order, errorMessage);
+	}
+
+	/*! Runs the dirty nodes and every node downstream of them. A node is not run if a node
+	upstream of it fails, and nodes not run stay dirty.
+	@param &errorMessage The reference where will be written the error messages of failed nodes
+	@return true if every node is evaluated, false otherwise
+	*/
+	bool Evaluate(std::string& errorMessage)
+	{
+		std::vector<size_t> affected;
+		CollectAffected(affected);
+
+		std::vector<size_t> order;
+		if (!Sort(affected, order, errorMessage))
+		{
+			return false;
+		}
+
+		std::unordered_map<size_t, size_t> positions(order.size());
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			positions.emplace(order[i], i);
+		}
+
+		std::unique_ptr<Task[]> tasks(new Task[order.size()]);
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			auto& node = nodes_[order[i]];
+			auto& task = tasks[i];
+			task.function = &node.function;
+			for (auto upstream : node.upstream)
+			{
+				task.waiting += positions.count(upstream);
+			}
+			for (auto downstream : node.downstream)
+			{
+				auto it = positions.find(downstream);
+				if (it != positions.end())
+				{
+					task.next.push_back(it->second);
+				}
+			}
+		}
+
+		bool parallel = threadCount_ > 1 && order.size() > 1;
+		if (parallel && pool_ == nullptr)
+		{
+			pool_.reset(new WorkStealingPool(threadCount_));
+		}
+
+		std::function<void(size_t)> run = [&](size_t index) {
+			auto& task = tasks[index];
+			if (!task.blocked)
+			{
+				task.succeeded = !*task.function || (*task.function)(task.errorMessage);
+			}
+
+			for (auto next : task.next)
+			{
+				if (!task.succeeded)
+				{
+					tasks[next].blocked = true;
+				}
+
+				if (--tasks[next].waiting == 0 && parallel)
+				{
+					pool_->Push([&run, next]() { run(next); });
+				}
+			}
+		};
+
+		if (parallel)
+		{
+			// Find the roots before pushing any, as running ones releases others
+			std::vector<size_t> roots;
+			for (size_t i = 0; i < order.size() && tasks[i].waiting == 0; ++i)
+			{
+				roots.push_back(i);
+			}
+			for (auto root : roots)
+			{
+				pool_->Push([&run, root]() { run(root); });
+			}
+			pool_->Wait();
+		}
+		else
+		{
+			for (size_t i = 0; i < order.size(); ++i)
+			{
+				run(i);
+			}
+		}
+
+		bool result = true;
+		dirty_.clear();
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			auto& task = tasks[i];
+			if (task.succeeded)
+			{
+				continue;
+			}
+
+			dirty_.insert(order[i]);
+			if (!task.blocked)
+			{
+				errorMessage += "Node " + std::to_string(order[i]) + " failed to evaluate: " + task.errorMessage + "\n";
+				result = false;
+			}
+		}
+		return result;
+	}
+
+private:
+	GraphEvaluator(const GraphEvaluator&);
+	GraphEvaluator& operator=(const GraphEvaluator&);
+
+	struct Node
+	{
+		NodeFunction function;
+		std::vector<size_t> slots;
+		std::vector<size_t> upstream;
+		std::vector<size_t> downstream;
+	};
+
+	struct Slot
+	{
+		size_t node;
+		bool isInput;
+		std::vector<size_t> connections;
+	};
+
+	struct Connection
+	{
+		size_t from;
+		size_t to;
+	};
+
+	struct Task
+	{
+		Task() : function(nullptr), waiting(0), blocked(false), succeeded(false)
+		{
+		}
+
+		const NodeFunction* function;
+		std::vector<size_t> next;
+		std::atomic<size_t> waiting;
+		std::atomic<bool> blocked;
+		bool succeeded;
+		std::string errorMessage;
+	};
+
+	static void EraseOne(std::vector<size_t>& values, size_t value)
+	{
+		auto it = std::find(values.begin(), values.end(), value);
+		if (it != values.end())
+		{
+			*it = values.back();
+			values.pop_back();
+		}
+	}
+
+	/*! Collects the dirty nodes and the nodes downstream of them
+	*/
+	void CollectAffected(std::vector<size_t>& affected) const
+	{
+		std::unordered_set<size_t> visited(dirty_.begin(), dirty_.end());
+		affected.assign(dirty_.begin(), dirty_.end());
+		for (size_t i = 0; i < affected.size(); ++i)
+		{
+			for (auto downstream : nodes_.at(affected[i]).downstream)
+			{
+				if (visited.insert(downstream).second)
+				{
+					affected.push_back(downstream);
+				}
+			}
+		}
+	}
+
+	/*! Orders nodes so that every node comes after the nodes upstream of it, ignoring
+	connections from nodes outside of the given ones
+	@return false if the nodes form a cycle
+	*/
+	bool Sort(const std::vector<size_t>& nodes, std::vector<size_t>& order, std::string& errorMessage) const
+	{
+		std::unordered_map<size_t, size_t> waiting(nodes.size());
+		for (auto nodeId : nodes)
+		{
+			waiting.emplace(nodeId, 0);
+		}
+		for (auto nodeId : nodes)
+		{
+			for (auto downstream : nodes_.at(nodeId).downstream)
+			{
+				auto it = waiting.find(downstream);
+				if (it != waiting.end())
+				{
+					++it->second;
+				}
+			}
+		}
+
+		order.clear();
+		order.reserve(nodes.size());
+		for (auto nodeId : nodes)
+		{
+			if (waiting[nodeId] == 0)
+			{
+				order.push_back(nodeId);
+			}
+		}
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			for (auto downstream : nodes_.at(order[i]).downstream)
+			{
+				auto it = waiting.find(downstream);
+				if (it != waiting.end() && --it->second == 0)
+				{
+					order.push_back(downstream);
+				}
+			}
+		}
+
+		if (order.size() == nodes.size())
+		{
+			return true;
+		}
+
+		// Every node left waits on another node left, so walking upstream ends up on the cycle
+		auto nodeId = std::find_if(nodes.begin(), nodes.end(), [&](size_t id) { return waiting[id] != 0; });
+		size_t cycleNode = *nodeId;
+		std::unordered_set<size_t> visited;
+		while (visited.insert(cycleNode).second)
+		{
+			auto& upstream = nodes_.at(cycleNode).upstream;
+			cycleNode = *std::find_if(upstream.begin(), upstream.end(), [&](size_t id) {
+				auto it = waiting.find(id);
+				return it != waiting.end() && it->second != 0;
+			});
+		}
+
+		errorMessage += "Graph contains a cycle through node " + std::to_string(cycleNode) + "\n";
+		return false;
+	}
+
+	size_t threadCount_;
+	std::unique_ptr<WorkStealingPool> pool_;
+	std::unordered_map<size_t, Node> nodes_;
+	std::unordered_map<size_t, Slot> slots_;
+	std::unordered_map<size_t, Connection> connections_;
+	std::unordered_set<size_t> dirty_;
+};
+} // end namespace wgt
+#endif // __GRAPH_EVALUATOR_H__
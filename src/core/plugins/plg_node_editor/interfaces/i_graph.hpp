@@ -66,6 +66,17 @@ public:
 	*/
 	virtual bool Validate(std::string& errorMessage) = 0;
 
+	/*! Evaluates the nodes changed since the last evaluation and the nodes downstream of them
+	@param &errorMessage The reference where will be written the error message if evaluation fails
+	@return true if every evaluated node succeeded, false otherwise
+	*/
+	virtual bool Evaluate(std::string& errorMessage) = 0;
+
+	/*! Marks the value of a slot as changed, so that the next evaluation updates the nodes it affects
+	@param slotId The id of the slot whose value changed
+	*/
+	virtual void InvalidateSlot(size_t slotId) = 0;
+
 	/*! Saves graph
 	@param fileName The file name where graph will be saved
 	*/
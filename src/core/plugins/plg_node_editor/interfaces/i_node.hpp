@@ -122,6 +122,13 @@ public:
 	*/
 	virtual bool Validate(std::string& errorMessage) = 0;
 
+	/*! Evaluates node from the values of its input slots. May be called from any thread,
+	but never while a node upstream of it is evaluated.
+	@param &errorMessage The reference where will be written the error message if evaluation fails
+	@return true if the node is evaluated, false otherwise
+	*/
+	virtual bool Evaluate(std::string& errorMessage) = 0;
+
 	/*! Callback which should be called by slot when connection is created
 	@param mySlot The slot child of current node which is connected
 	@param otherSlot The slot child of other node which is connected
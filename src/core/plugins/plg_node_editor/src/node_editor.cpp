@@ -30,21 +30,34 @@ void NodeEditor::onCreateNode(int x, int y, std::string nodeClass)
 {
 	// TODO: Unify the x, y type between CreateNode() and onCreateNode()
 	auto node = graph_->CreateNode(nodeClass, static_cast<float>(x), static_cast<float>(y));
+	EvaluateGraph();
 }
 
 void NodeEditor::onDeleteNode(size_t nodeID)
 {
 	graph_->DeleteNode(nodeID);
+	EvaluateGraph();
 }
 
 void NodeEditor::onCreateConnection(size_t nodeIdFrom, size_t slotIdFrom, size_t nodeIdTo, size_t slotIdTo)
 {
 	graph_->CreateConnection(nodeIdFrom, slotIdFrom, nodeIdTo, slotIdTo);
+	EvaluateGraph();
 }
 
 void NodeEditor::onDeleteConnection(size_t connectionId)
 {
 	graph_->DeleteConnection(connectionId);
+	EvaluateGraph();
+}
+
+void NodeEditor::EvaluateGraph()
+{
+	std::string errorMessage;
+	if (!graph_->Evaluate(errorMessage))
+	{
+		NGT_WARNING_MSG("%s", errorMessage.c_str());
+	}
 }
 
 void NodeEditor::CreateGroup(Collection& collection, const Vector4& rectangle, const std::string& name,
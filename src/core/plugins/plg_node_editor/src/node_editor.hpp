@@ -41,6 +41,10 @@ private:
 	void onCreateConnection(size_t nodeIdFrom, size_t slotIdFrom, size_t nodeIdTo, size_t slotIdTo) override;
 	void onDeleteConnection(size_t connectionId) override;
 
+	/*! Evaluates the nodes affected by an edit of the graph, logging the nodes that fail
+	*/
+	void EvaluateGraph();
+
 	ObjectHandleT<IGraph> GetGraph() const override
 	{
 		return graph_.getHandleT();
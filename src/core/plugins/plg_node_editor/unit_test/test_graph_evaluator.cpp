@@ -0,0 +1,354 @@
+#include "CppUnitLite2/src/CppUnitLite2.h"
+#include "core_unit_test/unit_test.hpp"
+
+#include "graph_evaluator.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace wgt
+{
+namespace
+{
+/*
+	Nodes with an input and an output slot each. A node adds the values of the nodes
+	upstream of it to its own input and records when it ran.
+*/
+class TestEvaluatorGraph
+{
+public:
+	explicit TestEvaluatorGraph(size_t threadCount) : evaluator_(threadCount), nextConnectionId_(1)
+	{
+	}
+
+	static size_t inputSlot(size_t nodeId)
+	{
+		return nodeId * 10;
+	}
+
+	static size_t outputSlot(size_t nodeId)
+	{
+		return nodeId * 10 + 1;
+	}
+
+	void addNode(size_t nodeId, int input)
+	{
+		inputs_[nodeId] = input;
+		values_[nodeId] = 0;
+		upstream_[nodeId];
+		evaluator_.AddNode(nodeId, [this, nodeId](std::string& errorMessage) { return run(nodeId, errorMessage); });
+		evaluator_.AddSlot(nodeId, inputSlot(nodeId), true);
+		evaluator_.AddSlot(nodeId, outputSlot(nodeId), false);
+	}
+
+	size_t connect(size_t fromNodeId, size_t toNodeId)
+	{
+		auto connectionId = nextConnectionId_++;
+		if (!evaluator_.AddConnection(connectionId, outputSlot(fromNodeId), inputSlot(toNodeId)))
+		{
+			return 0;
+		}
+		upstream_[toNodeId].push_back(fromNodeId);
+		return connectionId;
+	}
+
+	void disconnect(size_t connectionId, size_t fromNodeId, size_t toNodeId)
+	{
+		evaluator_.RemoveConnection(connectionId);
+		auto& upstream = upstream_[toNodeId];
+		upstream.erase(std::find(upstream.begin(), upstream.end(), fromNodeId));
+	}
+
+	void setInput(size_t nodeId, int input)
+	{
+		inputs_[nodeId] = input;
+		evaluator_.SlotChanged(inputSlot(nodeId));
+	}
+
+	void setFailing(size_t nodeId, bool failing)
+	{
+		if (failing)
+		{
+			failing_.insert(nodeId);
+		}
+		else
+		{
+			failing_.erase(nodeId);
+		}
+	}
+
+	bool evaluate(std::string& errorMessage)
+	{
+		runs_.clear();
+		return evaluator_.Evaluate(errorMessage);
+	}
+
+	int value(size_t nodeId) const
+	{
+		return values_.at(nodeId);
+	}
+
+	// Nodes run by the last evaluation, in the order they finished
+	const std::vector<size_t>& runs() const
+	{
+		return runs_;
+	}
+
+	bool ran(size_t nodeId) const
+	{
+		return std::find(runs_.begin(), runs_.end(), nodeId) != runs_.end();
+	}
+
+	// Whether every node ran after the nodes upstream of it that also ran
+	bool ranInOrder() const
+	{
+		std::unordered_map<size_t, size_t> positions;
+		for (size_t i = 0; i < runs_.size(); ++i)
+		{
+			if (!positions.emplace(runs_[i], i).second)
+			{
+				return false;
+			}
+		}
+
+		for (auto& position : positions)
+		{
+			for (auto upstream : upstream_.at(position.first))
+			{
+				auto it = positions.find(upstream);
+				if (it != positions.end() && it->second > position.second)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	GraphEvaluator& evaluator()
+	{
+		return evaluator_;
+	}
+
+private:
+	bool run(size_t nodeId, std::string& errorMessage)
+	{
+		if (failing_.count(nodeId) != 0)
+		{
+			errorMessage = "test failure";
+			return false;
+		}
+
+		auto value = inputs_.at(nodeId);
+		for (auto upstream : upstream_.at(nodeId))
+		{
+			value += values_.at(upstream);
+		}
+		values_.at(nodeId) = value;
+
+		std::lock_guard<std::mutex> guard(runsLock_);
+		runs_.push_back(nodeId);
+		return true;
+	}
+
+	GraphEvaluator evaluator_;
+	size_t nextConnectionId_;
+	std::unordered_map<size_t, int> inputs_;
+	std::unordered_map<size_t, int> values_;
+	std::unordered_map<size_t, std::vector<size_t>> upstream_;
+	std::unordered_set<size_t> failing_;
+	std::mutex runsLock_;
+	std::vector<size_t> runs_;
+};
+}
+
+TEST(graphEvaluatorDiamondAndChain)
+{
+	TestEvaluatorGraph graph(1);
+
+	// 1 feeds 2 and 3 which both feed 4, 5 -> 6 -> 7 is a separate chain
+	for (size_t nodeId = 1; nodeId <= 7; ++nodeId)
+	{
+		graph.addNode(nodeId, static_cast<int>(nodeId));
+	}
+	CHECK(graph.connect(1, 2) != 0);
+	CHECK(graph.connect(1, 3) != 0);
+	CHECK(graph.connect(2, 4) != 0);
+	CHECK(graph.connect(3, 4) != 0);
+	CHECK(graph.connect(5, 6) != 0);
+	CHECK(graph.connect(6, 7) != 0);
+
+	// Slots of the same direction can not be connected
+	CHECK(!graph.evaluator().AddConnection(100, TestEvaluatorGraph::inputSlot(1), TestEvaluatorGraph::inputSlot(2)));
+
+	std::string errorMessage;
+	CHECK(graph.evaluator().Validate(errorMessage));
+	CHECK(graph.evaluate(errorMessage));
+	CHECK(errorMessage.empty());
+
+	CHECK_EQUAL(7u, graph.runs().size());
+	CHECK(graph.ranInOrder());
+	CHECK_EQUAL(1, graph.value(1));
+	CHECK_EQUAL(3, graph.value(2));
+	CHECK_EQUAL(4, graph.value(3));
+	CHECK_EQUAL(11, graph.value(4));
+	CHECK_EQUAL(11, graph.value(6));
+	CHECK_EQUAL(18, graph.value(7));
+
+	// Nothing changed, so nothing runs
+	CHECK(!graph.evaluator().IsDirty(4));
+	CHECK(graph.evaluate(errorMessage));
+	CHECK(graph.runs().empty());
+}
+
+TEST(graphEvaluatorCycle)
+{
+	TestEvaluatorGraph graph(1);
+
+	// 4 feeds the cycle 1 -> 2 -> 3 -> 1, which feeds 5
+	for (size_t nodeId = 1; nodeId <= 5; ++nodeId)
+	{
+		graph.addNode(nodeId, 1);
+	}
+	graph.connect(4, 1);
+	graph.connect(1, 2);
+	graph.connect(2, 3);
+	auto closing = graph.connect(3, 1);
+	graph.connect(3, 5);
+
+	std::string errorMessage;
+	CHECK(!graph.evaluator().Validate(errorMessage));
+	auto onCycle = errorMessage == "Graph contains a cycle through node 1\n" ||
+	               errorMessage == "Graph contains a cycle through node 2\n" ||
+	               errorMessage == "Graph contains a cycle through node 3\n";
+	CHECK(onCycle);
+
+	errorMessage.clear();
+	CHECK(!graph.evaluate(errorMessage));
+	CHECK(!errorMessage.empty());
+	CHECK(graph.runs().empty());
+
+	// Breaking the cycle lets every node run
+	graph.disconnect(closing, 3, 1);
+	errorMessage.clear();
+	CHECK(graph.evaluator().Validate(errorMessage));
+	CHECK(graph.evaluate(errorMessage));
+	CHECK_EQUAL(5u, graph.runs().size());
+	CHECK(graph.ranInOrder());
+	CHECK_EQUAL(5, graph.value(5));
+}
+
+TEST(graphEvaluatorFailureBlocksDownstream)
+{
+	TestEvaluatorGraph graph(1);
+
+	// 1 -> 2 -> 3, and 1 -> 4
+	for (size_t nodeId = 1; nodeId <= 4; ++nodeId)
+	{
+		graph.addNode(nodeId, 1);
+	}
+	graph.connect(1, 2);
+	graph.connect(2, 3);
+	graph.connect(1, 4);
+
+	graph.setFailing(2, true);
+	std::string errorMessage;
+	CHECK(!graph.evaluate(errorMessage));
+	CHECK(errorMessage == "Node 2 failed to evaluate: test failure\n");
+	CHECK(graph.ran(1));
+	CHECK(!graph.ran(2));
+	CHECK(!graph.ran(3));
+	CHECK(graph.ran(4));
+
+	// The failed node and the node it blocked stay dirty
+	CHECK(!graph.evaluator().IsDirty(1));
+	CHECK(graph.evaluator().IsDirty(2));
+	CHECK(graph.evaluator().IsDirty(3));
+	CHECK(!graph.evaluator().IsDirty(4));
+
+	graph.setFailing(2, false);
+	errorMessage.clear();
+	CHECK(graph.evaluate(errorMessage));
+	CHECK(graph.runs() == std::vector<size_t>({ 2, 3 }));
+	CHECK_EQUAL(3, graph.value(3));
+}
+
+TEST(graphEvaluatorSlotChanged)
+{
+	TestEvaluatorGraph graph(1);
+
+	// 1 -> 2 -> 3, and 4 -> 5
+	for (size_t nodeId = 1; nodeId <= 5; ++nodeId)
+	{
+		graph.addNode(nodeId, 1);
+	}
+	graph.connect(1, 2);
+	graph.connect(2, 3);
+	graph.connect(4, 5);
+
+	std::string errorMessage;
+	CHECK(graph.evaluate(errorMessage));
+	CHECK_EQUAL(5u, graph.runs().size());
+
+	// Changing an input reruns its node and the nodes downstream of it
+	graph.setInput(2, 10);
+	CHECK(!graph.evaluator().IsDirty(1));
+	CHECK(graph.evaluator().IsDirty(3));
+	CHECK(graph.evaluate(errorMessage));
+	CHECK(graph.runs() == std::vector<size_t>({ 2, 3 }));
+	CHECK_EQUAL(12, graph.value(3));
+
+	// Changing an output reruns the nodes it is connected to
+	graph.evaluator().SlotChanged(TestEvaluatorGraph::outputSlot(4));
+	CHECK(graph.evaluate(errorMessage));
+	CHECK(graph.runs() == std::vector<size_t>({ 5 }));
+
+	// So does connecting a node
+	graph.connect(5, 3);
+	CHECK(graph.evaluate(errorMessage));
+	CHECK(graph.runs() == std::vector<size_t>({ 3 }));
+	CHECK_EQUAL(14, graph.value(3));
+	CHECK(errorMessage.empty());
+}
+
+TEST(graphEvaluatorParallel)
+{
+	TestEvaluatorGraph graph(4);
+
+	// Layers of nodes, each fed by two nodes of the layer before
+	const size_t layers = 8;
+	const size_t width = 64;
+	auto nodeIdOf = [width](size_t layer, size_t i) { return layer * width + i + 1; };
+	for (size_t layer = 0; layer < layers; ++layer)
+	{
+		for (size_t i = 0; i < width; ++i)
+		{
+			graph.addNode(nodeIdOf(layer, i), 1);
+			if (layer > 0)
+			{
+				graph.connect(nodeIdOf(layer - 1, i), nodeIdOf(layer, i));
+				graph.connect(nodeIdOf(layer - 1, (i + 1) % width), nodeIdOf(layer, i));
+			}
+		}
+	}
+
+	std::string errorMessage;
+	CHECK(graph.evaluate(errorMessage));
+	CHECK_EQUAL(layers * width, graph.runs().size());
+	CHECK(graph.ranInOrder());
+	// Every node of a layer doubles the sum of the one before, plus one
+	CHECK_EQUAL(255, graph.value(nodeIdOf(layers - 1, 0)));
+
+	// Changing a single node of the first layer reaches a widening cone of nodes
+	graph.setInput(nodeIdOf(0, 0), 2);
+	CHECK(graph.evaluate(errorMessage));
+	CHECK_EQUAL(1u + 2 + 3 + 4 + 5 + 6 + 7 + 8, graph.runs().size());
+	CHECK(graph.ranInOrder());
+	CHECK_EQUAL(256, graph.value(nodeIdOf(layers - 1, 0)));
+	CHECK(errorMessage.empty());
+}
+} // end namespace wgt
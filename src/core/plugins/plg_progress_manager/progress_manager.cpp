@@ -10,7 +10,8 @@
 
 namespace wgt
 {
-ProgressManager::ProgressManager() : progressValue_(0), isMultiCommandProgress_(false), isViewVisible_(false)
+ProgressManager::ProgressManager()
+    : progressValue_(0), isMultiCommandProgress_(false), isViewVisible_(false), labelSequence_(0), remainingSeconds_(-1)
 {
 }
 
@@ -83,7 +84,7 @@ void ProgressManager::progressMade(const CommandInstance& commandInstance) const
 	{
 	case Running:
 	{
-		perform();
+		perform(commandInstance);
 		break;
 	}
 
@@ -172,6 +173,10 @@ void ProgressManager::onNonBlockingProcessExecution(const char* commandId) const
 void ProgressManager::createProgressDialog(const char* commandId) const
 {
 	progressValue_ = 0;
+	estimator_.reset();
+	labelSequence_ = 0;
+	label_.clear();
+	remainingSeconds_ = -1;
 
 	curCommandId_ = std::find(commandIdList_.begin(), commandIdList_.end(), commandId);
 	// We only care the commandIds in our list, see if this is in our list commandId
@@ -221,18 +226,58 @@ void ProgressManager::progressCompleted(const char* commandId) const
 	removeCommand(commandId);
 }
 
-/// Increment the progress dialog value when the command made a progress
-void ProgressManager::perform() const
+/// Update the progress dialog from the progress the command published
+void ProgressManager::perform(const CommandInstance& commandInstance) const
 {
-	if (isViewVisible_)
+	if (!isViewVisible_)
 	{
+		return;
+	}
+
+	auto sample = commandInstance.getProgress().sample();
+	if (!sample.started_)
+	{
+		// The command does not publish progress, keep the dialog moving
 		progressValue_++;
 		if (progressValue_ == dlg_->maximum())
 		{
 			return;
 		}
 		setProgressValueProperty();
+		return;
+	}
+
+	if (estimator_.update(sample))
+	{
+		auto minimum = dlg_->minimum();
+		auto value = minimum + static_cast<int>(estimator_.getFraction() * (dlg_->maximum() - minimum));
+		if (value != progressValue_)
+		{
+			progressValue_ = value;
+			setProgressValueProperty();
+		}
+	}
+	updateLabel(commandInstance);
+}
+
+/// Show the command's label and the estimated time remaining
+void ProgressManager::updateLabel(const CommandInstance& commandInstance) const
+{
+	auto labelChanged = commandInstance.getProgress().getLabel(labelSequence_, label_);
+	auto remaining = estimator_.getRemainingSeconds();
+	auto remainingSeconds = remaining < 0.0 ? -1 : static_cast<int>(remaining + 0.5);
+	if (!labelChanged && remainingSeconds == remainingSeconds_)
+	{
+		return;
+	}
+	remainingSeconds_ = remainingSeconds;
+
+	std::string text = label_.empty() ? commandInstance.getCommandId() : label_;
+	if (remainingSeconds_ >= 0)
+	{
+		text += " (" + std::to_string(remainingSeconds_) + "s remaining)";
 	}
+	dlg_->setLabelText(text);
 }
 
 /// Set "ProgressValue" QML property value with current progressValue_
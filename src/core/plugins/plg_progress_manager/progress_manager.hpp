@@ -6,6 +6,7 @@
 #include "core_dependency_system/depends.hpp"
 #include "core_logging_system/interfaces/i_logging_system.hpp"
 #include "core_command_system/i_command_manager.hpp"
+#include "core_command_system/command_progress.hpp"
 #include "core_ui_framework/i_ui_framework.hpp"
 
 #include <vector>
@@ -55,8 +56,11 @@ private:
 	/// Clean up when a command is completed
 	void progressCompleted(const char* commandId = nullptr) const;
 
-	/// Increment the progress dialog value when the command made a progress
-	void perform() const;
+	/// Update the progress dialog from the progress the command published
+	void perform(const CommandInstance& commandInstance) const;
+
+	/// Show the command's label and the estimated time remaining
+	void updateLabel(const CommandInstance& commandInstance) const;
 
 	/// Set "ProgressValue" QML property value with current progressValue_
 	void setProgressValueProperty() const;
@@ -77,6 +81,10 @@ private:
 	mutable CommandIdList::iterator curCommandId_;
 	mutable bool isViewVisible_;
 	mutable IProgressDialogPtr dlg_;
+	mutable ProgressEstimator estimator_;
+	mutable uint32_t labelSequence_;
+	mutable std::string label_;
+	mutable int remainingSeconds_;
 };
 } // end namespace wgt
 #endif // PROGRESS_MANAGER_HPP
@@ -28,6 +28,10 @@ ListView {
     /** The itemIndex of the current hovered item.*/
     property var hoveredIndex: null
 
+    /** The first and last rows fetched by the last prefetch.*/
+    property int prefetchedFirst: -1
+    property int prefetchedLast: -1
+
     /** Signals that an item received a mouse press.
     \param mouse The mouse data at the time.
     \param itemIndex The index of the item.
@@ -50,6 +54,39 @@ ListView {
 
     highlightFollowsCurrentItem: false
 
+    /** Fetches the data of the visible rows, plus a page either side, in one go
+    so the rows do not query the model cell by cell when they are created.*/
+    function prefetchVisibleRows() {
+        if (view == null || count <= 0) {
+            return;
+        }
+
+        var firstVisible = indexAt(contentX, contentY);
+        var lastVisible = indexAt(contentX, contentY + height - 1);
+        firstVisible = firstVisible < 0 ? 0 : firstVisible;
+        lastVisible = lastVisible < 0 ? count - 1 : lastVisible;
+        if (firstVisible >= prefetchedFirst && lastVisible <= prefetchedLast) {
+            return;
+        }
+
+        var page = lastVisible - firstVisible + 1;
+        prefetchedFirst = Math.max(firstVisible - page, 0);
+        prefetchedLast = Math.min(lastVisible + page, count - 1);
+        var roles = view.columnRoles.length > 0 ? view.columnRoles : [view.columnRole];
+        view.prefetch(prefetchedFirst, prefetchedLast - prefetchedFirst + 1, roles);
+    }
+
+    function resetPrefetchedRows() {
+        prefetchedFirst = -1;
+        prefetchedLast = -1;
+        prefetchVisibleRows();
+    }
+
+    onContentYChanged: prefetchVisibleRows()
+    onHeightChanged: prefetchVisibleRows()
+    onCountChanged: resetPrefetchedRows()
+    onModelChanged: resetPrefetchedRows()
+
     delegate: WGItemRow {
         id: itemRow
         view: listViewBase.view
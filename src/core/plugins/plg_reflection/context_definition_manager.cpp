@@ -170,6 +170,14 @@ void ContextDefinitionManager::registerPropertyAccessorListener(std::shared_ptr<
 	pBaseManager_->registerPropertyAccessorListener(listener);
 }
 
+//==============================================================================
+void ContextDefinitionManager::registerPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+                                                                const RefObjectId& objectId, const char* path)
+{
+	TF_ASSERT(pBaseManager_);
+	pBaseManager_->registerPropertyAccessorListener(listener, objectId, path);
+}
+
 //==============================================================================
 void ContextDefinitionManager::deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener)
 {
@@ -177,6 +185,14 @@ void ContextDefinitionManager::deregisterPropertyAccessorListener(std::shared_pt
 	pBaseManager_->deregisterPropertyAccessorListener(listener);
 }
 
+//==============================================================================
+void ContextDefinitionManager::deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+                                                                  const RefObjectId& objectId)
+{
+	TF_ASSERT(pBaseManager_);
+	pBaseManager_->deregisterPropertyAccessorListener(listener, objectId);
+}
+
 //==============================================================================
 const IDefinitionManager::PropertyAccessorListeners& ContextDefinitionManager::getPropertyAccessorListeners() const
 {
@@ -184,6 +200,14 @@ const IDefinitionManager::PropertyAccessorListeners& ContextDefinitionManager::g
 	return pBaseManager_->getPropertyAccessorListeners();
 }
 
+//==============================================================================
+void ContextDefinitionManager::getPropertyAccessorListeners(const PropertyAccessor& accessor,
+                                                            PropertyAccessorListeners& o_Listeners) const
+{
+	TF_ASSERT(pBaseManager_);
+	pBaseManager_->getPropertyAccessorListeners(accessor, o_Listeners);
+}
+
 //==============================================================================
 bool ContextDefinitionManager::serializeDefinitions(ISerializer& serializer)
 {
@@ -47,10 +47,19 @@ private:
 
 	void registerPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener) override;
 
+	void registerPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+	                                      const RefObjectId& objectId, const char* path = nullptr) override;
+
 	void deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener) override;
 
+	void deregisterPropertyAccessorListener(std::shared_ptr<PropertyAccessorListener>& listener,
+	                                        const RefObjectId& objectId) override;
+
 	const PropertyAccessorListeners& getPropertyAccessorListeners() const override;
 
+	void getPropertyAccessorListeners(const PropertyAccessor& accessor,
+	                                  PropertyAccessorListeners& o_Listeners) const override;
+
 	std::unique_ptr<IClassDefinitionDetails> createGenericDefinition(const char* name) const override;
 
 private:
@@ -136,6 +136,17 @@ bool AddIntegerNode::Validate(std::string& errorMessage)
 	return true;
 }
 
+bool AddIntegerNode::Evaluate(std::string& errorMessage)
+{
+	int result = 0;
+	for (auto& inputSlot : inputSlots_)
+	{
+		result += static_cast<IntegerSlot*>(inputSlot.get())->Value();
+	}
+	static_cast<IntegerSlot*>(outputSlots_.front().get())->SetValue(result);
+	return true;
+}
+
 void AddIntegerNode::OnConnect(ObjectHandleT<ISlot> mySlot, ObjectHandleT<ISlot> otherSlot)
 {
 	NGT_ERROR_MSG("METHOD IS NOT IMPLEMENTED\n");
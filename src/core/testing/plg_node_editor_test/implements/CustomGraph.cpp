@@ -4,6 +4,7 @@
 #include "IntToStringNode.h"
 #include "AddIntegerNode.h"
 #include "PrintNode.h"
+#include "IntegerSlot.h"
 
 #include "core_logging/logging.hpp"
 #include "core_object/managed_object.hpp"
@@ -47,6 +48,17 @@ ObjectHandleT<INode> CustomGraph::CreateNode(std::string nodeClass, float x, flo
 	Collection& nodes = nodesModel_.getSource();
 	nodes.insertValue(nodes.size(), node);
 
+	nodeIndex_[node->Id()] = node;
+	evaluator_.AddNode(node->Id(), [node](std::string& errorMessage) { return node->Evaluate(errorMessage); });
+	for (const auto& slotVariant : node->GetInputSlots()->getSource())
+	{
+		evaluator_.AddSlot(node->Id(), slotVariant.value<ObjectHandleT<ISlot>>()->Id(), true);
+	}
+	for (const auto& slotVariant : node->GetOutputSlots()->getSource())
+	{
+		evaluator_.AddSlot(node->Id(), slotVariant.value<ObjectHandleT<ISlot>>()->Id(), false);
+	}
+
 	return node;
 }
 
@@ -103,6 +115,8 @@ void CustomGraph::DeleteNode(size_t nodeId)
 	auto ownedNodesIter = ownedNodes_.begin();
 	std::advance(ownedNodesIter, index);
 
+	evaluator_.RemoveNode(nodeId);
+	nodeIndex_.erase(nodeId);
 	nodes.erase(nodeIter);
 	ownedNodes_.erase(ownedNodesIter);
 }
@@ -118,19 +132,14 @@ ObjectHandleT<IConnection> CustomGraph::CreateConnection(size_t nodeIdFrom, size
 	bool result = false;
 	while (true)
 	{
-		auto callbackFrom = [nodeIdFrom](const Variant& nodeVariant) {
-			auto node = nodeVariant.value<ObjectHandleT<INode>>();
-			return nodeIdFrom == node->Id();
-		};
-
-		auto nodeIterFrom = std::find_if(nodes_.begin(), nodes_.end(), callbackFrom);
-		if (nodeIterFrom == nodes_.end())
+		auto nodeIterFrom = nodeIndex_.find(nodeIdFrom);
+		if (nodeIterFrom == nodeIndex_.end())
 		{
 			NGT_ERROR_MSG("Failed to get node with id: %d\n", nodeIdFrom);
 			break;
 		}
 
-		nodeFrom = *nodeIterFrom;
+		nodeFrom = nodeIterFrom->second;
 		slotFrom = nodeFrom->GetSlotById(slotIdFrom);
 		if (slotFrom == nullptr)
 		{
@@ -138,19 +147,14 @@ ObjectHandleT<IConnection> CustomGraph::CreateConnection(size_t nodeIdFrom, size
 			break;
 		}
 
-		auto callbackTo = [nodeIdTo](const Variant& nodeVariant) {
-			auto node = nodeVariant.value<ObjectHandleT<INode>>();
-			return nodeIdTo == node->Id();
-		};
-
-		auto nodeIterTo = std::find_if(nodes_.begin(), nodes_.end(), callbackTo);
-		if (nodeIterTo == nodes_.end())
+		auto nodeIterTo = nodeIndex_.find(nodeIdTo);
+		if (nodeIterTo == nodeIndex_.end())
 		{
 			NGT_ERROR_MSG("Failed to get node with id: %d\n", nodeIdTo);
 			break;
 		}
 
-		nodeTo = *nodeIterTo;
+		nodeTo = nodeIterTo->second;
 		slotTo = nodeTo->GetSlotById(slotIdTo);
 		if (slotTo == nullptr)
 		{
@@ -175,6 +179,7 @@ ObjectHandleT<IConnection> CustomGraph::CreateConnection(size_t nodeIdFrom, size
 	{
 		Collection& connections = connectionsModel_.getSource();
 		connections.insertValue(connections.size(), connection);
+		evaluator_.AddConnection(connection->Id(), slotFrom->Id(), slotTo->Id());
 		return connection;
 	}
 
@@ -204,6 +209,8 @@ void CustomGraph::DeleteConnection(size_t connectionId)
 		NGT_ERROR_MSG("Failed to unbind slots\n");
 	}
 
+	evaluator_.RemoveConnection(connectionId);
+
 	auto index = std::distance(connections.begin(), connectionPos);
 	auto ownedConnnectionsIter = ownedConnections_.begin();
 	std::advance(ownedConnnectionsIter, index);
@@ -214,7 +221,38 @@ void CustomGraph::DeleteConnection(size_t connectionId)
 
 bool CustomGraph::Validate(std::string& errorMessage)
 {
-	NGT_ERROR_MSG("METHOD IS NOT IMPLEMENTED\n");
+	return evaluator_.Validate(errorMessage);
+}
+
+bool CustomGraph::Evaluate(std::string& errorMessage)
+{
+	return evaluator_.Evaluate(errorMessage);
+}
+
+void CustomGraph::InvalidateSlot(size_t slotId)
+{
+	evaluator_.SlotChanged(slotId);
+}
+
+bool CustomGraph::SetIntegerValue(size_t nodeId, size_t slotId, int value)
+{
+	auto nodeIter = nodeIndex_.find(nodeId);
+	if (nodeIter == nodeIndex_.end())
+	{
+		NGT_ERROR_MSG("Failed to get node with id: %d\n", nodeId);
+		return false;
+	}
+
+	auto slot = nodeIter->second->GetSlotById(slotId);
+	auto integerSlot = slot != nullptr ? dynamic_cast<IntegerSlot*>(slot.get()) : nullptr;
+	if (integerSlot == nullptr || !integerSlot->IsInput())
+	{
+		NGT_ERROR_MSG("Slot with id: %d is not an integer input\n", slotId);
+		return false;
+	}
+
+	integerSlot->SetValue(value);
+	InvalidateSlot(slotId);
 	return true;
 }
 
@@ -10,7 +10,9 @@
 #include "plugins/plg_node_editor/interfaces/i_graph.hpp"
 #include "plugins/plg_node_editor/interfaces/i_node.hpp"
 #include "plugins/plg_node_editor/interfaces/i_connection.hpp"
+#include "plugins/plg_node_editor/graph_evaluator.hpp"
 
+#include <unordered_map>
 #include <vector>
 
 namespace wgt
@@ -32,9 +34,19 @@ public:
     void DeleteConnection(size_t connectionId) override;
     
     bool Validate(std::string& errorMessage) override;
+    bool Evaluate(std::string& errorMessage) override;
+    void InvalidateSlot(size_t slotId) override;
     void Save(std::string fileName) override;
     void Load(std::string fileName) override;
 
+    /*! Sets the value of an integer input slot, which is used while nothing is connected to it
+    @param nodeId The id of the node containing the slot
+    @param slotId The id of the slot
+    @param value The new value
+    @return true if the value is set, false if there is no such integer input slot
+    */
+    bool SetIntegerValue(size_t nodeId, size_t slotId, int value);
+
 private:
     const AbstractListModel* GetNodesModel() const override { return &nodesModel_; }
     const AbstractListModel* GetConnectionsModel() const override { return &connectionsModel_; }
@@ -49,6 +61,8 @@ private:
 	std::vector<ObjectHandleT<INode>> nodes_;
 	std::vector<ObjectHandleT<IConnection>> connections_;
 	std::vector<ObjectHandleT<IGroup>> groups_;
+	std::unordered_map<size_t, ObjectHandleT<INode>> nodeIndex_;
+	GraphEvaluator evaluator_;
 
 	CollectionModel nodeClassesModel_;
 	CollectionModel nodesModel_;
@@ -123,6 +123,13 @@ bool IntToStringNode::Validate(std::string& errorMessage)
 	return true;
 }
 
+bool IntToStringNode::Evaluate(std::string& errorMessage)
+{
+	auto value = static_cast<IntegerSlot*>(inputSlots_.front().get())->Value();
+	static_cast<StringSlot*>(outputSlots_.front().get())->SetValue(std::to_string(value));
+	return true;
+}
+
 void IntToStringNode::OnConnect(ObjectHandleT<ISlot> mySlot, ObjectHandleT<ISlot> otherSlot)
 {
 	NGT_ERROR_MSG("METHOD IS NOT IMPLEMENTED\n");
@@ -45,6 +45,7 @@ public:
 
     bool CanConnect(ObjectHandleT<ISlot> mySlot, ObjectHandleT<ISlot> otherSlot) override;
     bool Validate(std::string &errorMessage) override;
+    bool Evaluate(std::string &errorMessage) override;
 
     void OnConnect(ObjectHandleT<ISlot> mySlot, ObjectHandleT<ISlot> otherSlot) override;
     void OnDisconnect(ObjectHandleT<ISlot> mySlot, ObjectHandleT<ISlot> otherSlot) override;
@@ -9,7 +9,7 @@ const std::string INTEGER_SLOT_COLOR = "green";
 
 IntegerSlot::IntegerSlot(ObjectHandleT<INode> node, bool isInput)
     : m_label(INTEGER_SLOT_LABEL), m_icon(INTEGER_SLOT_ICON), m_color(INTEGER_SLOT_COLOR), m_editable(true),
-      m_isInput(isInput), m_pNode(node)
+      m_isInput(isInput), m_value(0), m_pNode(node)
 {
 	m_id = reinterpret_cast<size_t>(this);
 	connectedSlotsModel.setSource(Collection(m_connectedSlots));
@@ -96,4 +96,22 @@ bool IntegerSlot::Disconnect(size_t connectionID, ObjectHandleT<ISlot> slot)
 
 	return result;
 }
+
+int IntegerSlot::Value() const
+{
+	if (m_isInput && !m_connectedSlots.empty())
+	{
+		auto connectedSlot = dynamic_cast<const IntegerSlot*>(m_connectedSlots.front().get());
+		if (connectedSlot != nullptr)
+		{
+			return connectedSlot->m_value;
+		}
+	}
+	return m_value;
+}
+
+void IntegerSlot::SetValue(int value)
+{
+	m_value = value;
+}
 } // end namespace wgt
@@ -126,6 +126,19 @@ bool PrintNode::Validate(std::string& errorMessage)
 	return true;
 }
 
+bool PrintNode::Evaluate(std::string& errorMessage)
+{
+	// Prints nothing until a value is connected
+	auto valueSlot = static_cast<StringSlot*>(inputSlots_[1].get());
+	if (!valueSlot->IsConnected())
+	{
+		return true;
+	}
+
+	NGT_MSG("%s\n", valueSlot->Value().c_str());
+	return true;
+}
+
 void PrintNode::OnConnect(ObjectHandleT<ISlot> mySlot, ObjectHandleT<ISlot> otherSlot)
 {
 	NGT_ERROR_MSG("METHOD IS NOT IMPLEMENTED\n");
@@ -96,4 +96,22 @@ bool StringSlot::Disconnect(size_t connectionID, ObjectHandleT<ISlot> slot)
 
 	return result;
 }
+
+std::string StringSlot::Value() const
+{
+	if (m_isInput && !m_connectedSlots.empty())
+	{
+		auto connectedSlot = dynamic_cast<const StringSlot*>(m_connectedSlots.front().get());
+		if (connectedSlot != nullptr)
+		{
+			return connectedSlot->m_value;
+		}
+	}
+	return m_value;
+}
+
+void StringSlot::SetValue(const std::string& value)
+{
+	m_value = value;
+}
 } // end namespace wgt
@@ -36,6 +36,11 @@ public:
 
     bool Connect(size_t connectionID, ObjectHandleT<ISlot> slot) override;
     bool Disconnect(size_t connectionID, ObjectHandleT<ISlot> slot) override;
+
+    /*! Returns the value of the output slot connected to this slot, or the slot's own value otherwise
+    */
+    std::string Value() const;
+    void SetValue(const std::string& value);
 private:
 
 	mutable ObjectHandleT<ISlot> thisSlot_;
@@ -60,6 +65,7 @@ private:
 
     bool m_editable;
     bool m_isInput;
+    std::string m_value;
 
 	ObjectHandleT<INode> m_pNode;
     std::set<size_t> m_connectionIds;
@@ -1,10 +1,13 @@
 #include <memory>
+#include <string>
+#include <vector>
 #include "core_generic_plugin/generic_plugin.hpp"
 #include "core_reflection/type_class_definition.hpp"
 #include "core_reflection/interfaces/i_definition_helper.hpp"
 
 #include "plugins/plg_node_editor/interfaces/i_node_editor.hpp"
 #include "implements/CustomGraph.h"
+#include "core_logging/logging.hpp"
 
 namespace wgt
 {
@@ -30,8 +33,50 @@ public:
 		auto nodeEditor = contextManager.queryInterface<INodeEditor>();
 		assert(nodeEditor != nullptr);
 
-		std::shared_ptr<IGraph> graph(new CustomGraph());
+		std::shared_ptr<CustomGraph> graph(new CustomGraph());
 		nodeEditor->SetGraph(graph);
+		CreateSampleGraph(*graph);
+	}
+
+private:
+	static std::vector<size_t> GetSlotIds(const CollectionModel* slots)
+	{
+		std::vector<size_t> slotIds;
+		for (const auto& slotVariant : slots->getSource())
+		{
+			slotIds.push_back(slotVariant.value<ObjectHandleT<ISlot>>()->Id());
+		}
+		return slotIds;
+	}
+
+	// Adds two integers and prints the result, then changes one of them so only the nodes after it run again
+	static void CreateSampleGraph(CustomGraph& graph)
+	{
+		auto addNode = graph.CreateNode("AddInteger", 0.0f, 0.0f);
+		auto toStringNode = graph.CreateNode("IntToString", 250.0f, 0.0f);
+		auto printNode = graph.CreateNode("Print", 500.0f, 0.0f);
+
+		auto addInputs = GetSlotIds(addNode->GetInputSlots());
+		auto addOutputs = GetSlotIds(addNode->GetOutputSlots());
+		auto toStringInputs = GetSlotIds(toStringNode->GetInputSlots());
+		auto toStringOutputs = GetSlotIds(toStringNode->GetOutputSlots());
+		auto printInputs = GetSlotIds(printNode->GetInputSlots());
+		graph.CreateConnection(addNode->Id(), addOutputs[0], toStringNode->Id(), toStringInputs[0]);
+		graph.CreateConnection(toStringNode->Id(), toStringOutputs[0], printNode->Id(), printInputs[1]);
+
+		std::string errorMessage;
+		graph.SetIntegerValue(addNode->Id(), addInputs[0], 1);
+		graph.SetIntegerValue(addNode->Id(), addInputs[1], 2);
+		if (!graph.Evaluate(errorMessage))
+		{
+			NGT_WARNING_MSG("%s", errorMessage.c_str());
+		}
+
+		graph.SetIntegerValue(addNode->Id(), addInputs[1], 40);
+		if (!graph.Evaluate(errorMessage))
+		{
+			NGT_WARNING_MSG("%s", errorMessage.c_str());
+		}
 	}
 };
 